@@ -5,20 +5,97 @@
 #include "UeConnection/UeConnectionSpawner.hpp"
 #include "UeRelay/UeRelay.hpp"
 #include "ConsoleCommands.hpp"
+#include <algorithm>
 
 namespace bts
 {
 
+namespace
+{
+
+OutboundQueue::Limits outboundLimits(IApplicationEnvironment& environment)
+{
+    OutboundQueue::Limits limits;
+    limits.highWatermark = environment.getProperty("outboundHighWatermark", static_cast<std::int32_t>(limits.highWatermark));
+    limits.lowWatermark = environment.getProperty("outboundLowWatermark", static_cast<std::int32_t>(limits.lowWatermark));
+    limits.policy = environment.getProperty("outboundDropOldest", 0) ? OutboundQueue::Policy::DropOldest
+                                                                     : OutboundQueue::Policy::Reject;
+    limits.talkWeight = environment.getProperty("egressTalkWeight", static_cast<std::int32_t>(limits.talkWeight));
+    limits.smsWeight = environment.getProperty("egressSmsWeight", static_cast<std::int32_t>(limits.smsWeight));
+    return limits;
+}
+
+AdmissionControl::Limits admissionLimits(IApplicationEnvironment& environment)
+{
+    // admissionRate=0 disables admission control, burst below 1 taken as 1 - see AdmissionControl::Limits
+    AdmissionControl::Limits limits;
+    limits.acceptRate = environment.getProperty("admissionRate", static_cast<std::int32_t>(limits.acceptRate));
+    limits.burst = environment.getProperty("admissionBurst", static_cast<std::int32_t>(limits.burst));
+    limits.maxPending = std::max(0, environment.getProperty("admissionMaxPending", static_cast<std::int32_t>(limits.maxPending)));
+    return limits;
+}
+
+std::shared_ptr<IngressThrottle> ingressThrottle(IApplicationEnvironment& environment)
+{
+    // opt-in - throttled messages are dropped, UE is not told about that
+    auto budgets = environment.getProperty("throttle", 0) ? IngressThrottle::defaultBudgets() : IngressThrottle::Budgets{};
+    const char* classNames[TRAFFIC_CLASS_COUNT] = {"Control", "Talk", "Sms"};
+    for (std::size_t i = 0; i < TRAFFIC_CLASS_COUNT; ++i)
+    {
+        const std::string prefix = std::string("throttle") + classNames[i];
+        budgets[i].ratePerSecond = environment.getProperty(prefix + "Rate", static_cast<std::int32_t>(budgets[i].ratePerSecond));
+        budgets[i].burst = environment.getProperty(prefix + "Burst", static_cast<std::int32_t>(budgets[i].burst));
+    }
+    return std::make_shared<IngressThrottle>(budgets);
+}
+
+SmsStore::Limits smsStoreLimits(IApplicationEnvironment& environment)
+{
+    SmsStore::Limits limits;
+    limits.perRecipient = environment.getProperty("smsStorePerRecipient", static_cast<std::int32_t>(limits.perRecipient));
+    limits.totalBytes = environment.getProperty("smsStoreBytes", static_cast<std::int32_t>(limits.totalBytes));
+    limits.ttl = std::chrono::seconds(environment.getProperty("smsStoreTtl", static_cast<std::int32_t>(limits.ttl.count())));
+    return limits;
+}
+
+common::AttachFeatures supportedFeatures(IApplicationEnvironment& environment)
+{
+    // flow control accepted only with non-zero creditWindow
+    common::AttachFeatures features = common::get(common::AttachFeature::FlowControl);
+    if (environment.getProperty("batching", 1))
+    {
+        features |= common::get(common::AttachFeature::Batching);
+    }
+    if (environment.getProperty("compression", 1))
+    {
+        features |= common::get(common::AttachFeature::Compression);
+    }
+    return features;
+}
+
+std::uint16_t creditWindow(IApplicationEnvironment& environment)
+{
+    const auto window = environment.getProperty("creditWindow", InboundCredits::DEFAULT_WINDOW);
+    return static_cast<std::uint16_t>(std::clamp<std::int32_t>(window, 0, UINT16_MAX));
+}
+
+}
+
 std::unique_ptr<IComponent> createApplication(IApplicationEnvironment& environment)
 {
     auto syncGuard = std::make_shared<SyncGuard>();
     auto& logger = environment.getLogger();
 
-    auto ueRelay = std::make_shared<UeRelay>(environment.getLogger());
-    auto ueConnectionFactory = std::make_shared<UeConnectionFactory>(environment.getLogger(), syncGuard);
-    auto ueConnectionSpawner = std::make_shared<UeConnectionSpawner>(environment, ueConnectionFactory, ueRelay, syncGuard);
+    auto ueRelay = std::make_shared<UeRelay>(environment.getLogger(), smsStoreLimits(environment));
+    auto throttle = ingressThrottle(environment);
+    auto ueConnectionFactory = std::make_shared<UeConnectionFactory>(environment.getLogger(), syncGuard,
+                                                                      outboundLimits(environment), creditWindow(environment),
+                                                                      throttle, supportedFeatures(environment));
+    auto ueConnectionSpawner = std::make_shared<UeConnectionSpawner>(environment, ueConnectionFactory, ueRelay, syncGuard,
+                                                                      admissionLimits(environment));
     auto sibMolester = std::make_shared<SibMolester>(ueRelay, syncGuard, environment.getBtsId(), environment.getLogger());
-    auto consoleCommands = std::make_shared<ConsoleCommands>(environment.getConsole(), environment, environment.getLogger(), ueRelay, syncGuard);
+    auto consoleCommands = std::make_shared<ConsoleCommands>(environment.getConsole(), environment, environment.getLogger(), ueRelay, syncGuard,
+                                                             throttle);
     std::initializer_list<std::shared_ptr<IComponent>> components = {ueConnectionSpawner, sibMolester, consoleCommands};
     return std::make_unique<Application>(environment.getLogger(), components);
 }
@@ -1,5 +1,6 @@
 #include "ConsoleCommands.hpp"
 #include "TestCommands/TestCommands.hpp"
+#include <sstream>
 
 namespace bts
 {
@@ -8,12 +9,14 @@ ConsoleCommands::ConsoleCommands(IConsole& console,
                                  IApplicationEnvironment &environment,
                                  common::ILogger& logger,
                                  std::shared_ptr<IUeRelay> ueRelay,
-                                 SyncGuardPtr syncGuard)
+                                 SyncGuardPtr syncGuard,
+                                 std::shared_ptr<IngressThrottle> ingressThrottle)
     : syncGuard(syncGuard),
       logger(logger, "[CONSOLE]"),
       console(console),
       environment(environment),
-      ueRelay(ueRelay)
+      ueRelay(ueRelay),
+      ingressThrottle(ingressThrottle)
 {}
 
 ConsoleCommands::~ConsoleCommands()
@@ -27,6 +30,8 @@ void ConsoleCommands::start()
     console.addCommand("a", "Show address", std::bind(&ConsoleCommands::showAddress, this, argsArgument, streamArgument));
     console.addCommand("s", "Show status", std::bind(&ConsoleCommands::showStatus, this, argsArgument, streamArgument));
     console.addCommand("l", "List attached ue", std::bind(&ConsoleCommands::listAttachedUe, this, argsArgument, streamArgument));
+    console.addCommand("e", "Show egress latency per traffic class", std::bind(&ConsoleCommands::showEgressStats, this, argsArgument, streamArgument));
+    console.addCommand("r", "Rate limits per sender: [control|talk|sms <rate/s> <burst>]", std::bind(&ConsoleCommands::throttleCommand, this, argsArgument, streamArgument));
     console.addCloseCommand();
     console.addHelpCommand();
     console.addCommand("t", "Test commands - details in implementation",std::bind(&ConsoleCommands::testCommands, this, argsArgument, streamArgument));
@@ -63,6 +68,51 @@ void ConsoleCommands::listAttachedUe(std::string, std::ostream& os)
     });
 }
 
+void ConsoleCommands::showEgressStats(std::string, std::ostream& os)
+{
+    SyncLock lock(*syncGuard);
+
+    EgressStats stats{};
+    ueRelay->visitAttachedUe([&stats](IUeConnection const& ue)
+    {
+        stats += ue.getEgressStats();
+    });
+    os << "egress to attached ue: \n" << stats;
+}
+
+void ConsoleCommands::throttleCommand(std::string args, std::ostream& os)
+{
+    SyncLock lock(*syncGuard);
+
+    std::istringstream is(args);
+    std::string className;
+    if (is >> className)
+    {
+        IngressThrottle::Budget budget;
+        std::size_t classIndex = 0;
+        while (classIndex < TRAFFIC_CLASS_COUNT and to_string(static_cast<TrafficClass>(classIndex)) != className)
+        {
+            ++classIndex;
+        }
+        if (classIndex == TRAFFIC_CLASS_COUNT or not (is >> budget.ratePerSecond >> budget.burst))
+        {
+            os << "usage: r [control|talk|sms <rate/s> <burst>] - zero rate: no limit\n";
+            return;
+        }
+        ingressThrottle->setBudget(static_cast<TrafficClass>(classIndex), budget);
+        logger.logInfo("Rate limit of ", className, " set to: ", budget.ratePerSecond, "/s, burst: ", budget.burst);
+    }
+
+    os << "rate limits per sender: \n";
+    for (std::size_t i = 0; i < TRAFFIC_CLASS_COUNT; ++i)
+    {
+        const auto trafficClass = static_cast<TrafficClass>(i);
+        const auto budget = ingressThrottle->getBudget(trafficClass);
+        os << " > " << trafficClass << ": " << budget.ratePerSecond << "/s, burst: " << budget.burst
+           << ", throttled: " << ingressThrottle->throttledCount(trafficClass) << "\n";
+    }
+}
+
 void ConsoleCommands::testCommands(std::string args, std::ostream &os)
 {
     using common::TestCommands;
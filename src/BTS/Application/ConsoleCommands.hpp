@@ -6,6 +6,7 @@
 #include "UeRelay/IUeRelay.hpp"
 #include "IApplicationEnvironment.hpp"
 #include "IComponent.hpp"
+#include "UeConnection/IngressThrottle.hpp"
 
 namespace bts
 {
@@ -17,7 +18,8 @@ public:
                     IApplicationEnvironment& environment,
                     common::ILogger& logger,
                     std::shared_ptr<IUeRelay> ueRelay,
-                    SyncGuardPtr syncGuard);
+                    SyncGuardPtr syncGuard,
+                    std::shared_ptr<IngressThrottle> ingressThrottle);
     ~ConsoleCommands();
 
     void start() override;
@@ -27,6 +29,8 @@ private:
     void showAddress(std::string args, std::ostream &os);
     void showStatus(std::string args, std::ostream &os);
     void listAttachedUe(std::string args, std::ostream &os);
+    void showEgressStats(std::string args, std::ostream &os);
+    void throttleCommand(std::string args, std::ostream &os);
     void testCommands(std::string args, std::ostream &os);
 
     SyncGuardPtr syncGuard;
@@ -34,6 +38,7 @@ private:
     IConsole& console;
     IApplicationEnvironment& environment;
     std::shared_ptr<IUeRelay> ueRelay;
+    std::shared_ptr<IngressThrottle> ingressThrottle;
 };
 
 }
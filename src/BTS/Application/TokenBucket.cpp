@@ -0,0 +1,42 @@
+#include "TokenBucket.hpp"
+#include <algorithm>
+
+namespace bts
+{
+
+TokenBucket::TokenBucket(double ratePerSecond, double burst, Clock::time_point now)
+    : ratePerSecond(ratePerSecond),
+      burst(burst),
+      tokens(burst),
+      lastRefill(now)
+{}
+
+bool TokenBucket::tryTake(Clock::time_point now)
+{
+    refill(now);
+    if (tokens < 1.0)
+    {
+        return false;
+    }
+    tokens -= 1.0;
+    return true;
+}
+
+double TokenBucket::available(Clock::time_point now)
+{
+    refill(now);
+    return tokens;
+}
+
+void TokenBucket::refill(Clock::time_point now)
+{
+    if (now <= lastRefill)
+    {
+        return;
+    }
+    const std::chrono::duration<double> elapsed = now - lastRefill;
+    tokens = std::min(burst, tokens + elapsed.count() * ratePerSecond);
+    lastRefill = now;
+}
+
+}
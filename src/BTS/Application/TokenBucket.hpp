@@ -0,0 +1,31 @@
+#pragma once
+
+#include <chrono>
+
+namespace bts
+{
+
+/**
+ * Classic token bucket: refilled with rate tokens per second, holds at most burst tokens.
+ * Time is given by caller - so it can be shared by many buckets and faked in tests.
+ */
+class TokenBucket
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    TokenBucket(double ratePerSecond, double burst, Clock::time_point now);
+
+    bool tryTake(Clock::time_point now);
+    double available(Clock::time_point now);
+
+private:
+    void refill(Clock::time_point now);
+
+    double ratePerSecond;
+    double burst;
+    double tokens;
+    Clock::time_point lastRefill;
+};
+
+}
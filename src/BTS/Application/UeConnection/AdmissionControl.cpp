@@ -0,0 +1,88 @@
+#include "AdmissionControl.hpp"
+#include <algorithm>
+
+namespace bts
+{
+
+namespace
+{
+
+AdmissionControl::Limits validated(AdmissionControl::Limits limits)
+{
+    limits.acceptRate = std::max(0.0, limits.acceptRate);
+    limits.burst = std::max(1.0, limits.burst);
+    return limits;
+}
+
+}
+
+AdmissionControl::AdmissionControl(Limits limits, Clock::time_point now)
+    : limits(validated(limits)),
+      acceptBucket(this->limits.acceptRate, this->limits.burst, now)
+{}
+
+AdmissionControl::Decision AdmissionControl::onConnected(ITransportPtr transport, Clock::time_point now)
+{
+    if (isDisabled())
+    {
+        return Decision::Admit;
+    }
+    // no overtaking of those already waiting
+    if (pending.empty() and acceptBucket.tryTake(now))
+    {
+        return Decision::Admit;
+    }
+    if (pending.size() >= limits.maxPending)
+    {
+        ++rejected;
+        return Decision::Reject;
+    }
+    pending.push_back(std::move(transport));
+    return Decision::Defer;
+}
+
+std::vector<ITransportPtr> AdmissionControl::admitPending(Clock::time_point now)
+{
+    if (isDisabled())
+    {
+        return takeAllPending();
+    }
+    std::vector<ITransportPtr> admitted;
+    while (not pending.empty() and acceptBucket.tryTake(now))
+    {
+        admitted.push_back(std::move(pending.front()));
+        pending.pop_front();
+    }
+    return admitted;
+}
+
+void AdmissionControl::removePending(const ITransport* transport)
+{
+    pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                 [transport](const ITransportPtr& pendingTransport) { return pendingTransport.get() == transport; }),
+                  pending.end());
+}
+
+std::vector<ITransportPtr> AdmissionControl::takeAllPending()
+{
+    std::vector<ITransportPtr> all(std::make_move_iterator(pending.begin()), std::make_move_iterator(pending.end()));
+    pending.clear();
+    return all;
+}
+
+std::size_t AdmissionControl::pendingCount() const
+{
+    return pending.size();
+}
+
+std::size_t AdmissionControl::rejectedCount() const
+{
+    return rejected;
+}
+
+bool AdmissionControl::isDisabled() const
+{
+    return limits.acceptRate <= 0.0;
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include "ITransport.hpp"
+#include "TokenBucket.hpp"
+
+namespace bts
+{
+
+/**
+ * Paces admission of new UE connections - so mass reconnect does not starve attached UEs.
+ *
+ * Connections are admitted at acceptRate per second (with burst). Above that they wait,
+ * in arrival order, for at most maxPending places - the rest is rejected (UE reconnects later).
+ */
+class AdmissionControl
+{
+public:
+    using Clock = TokenBucket::Clock;
+
+    enum class Decision
+    {
+        Admit,
+        Defer,
+        Reject
+    };
+
+    struct Limits
+    {
+        // zero (or below): admission control disabled - every connection admitted at once
+        double acceptRate = 200.0;
+        // below 1 no connection would ever be admitted - 1 taken then
+        double burst = 50.0;
+        std::size_t maxPending = 2000u;
+    };
+
+    AdmissionControl(Limits limits, Clock::time_point now);
+
+    /**
+     * Deferred connection is kept till admitPending() or removePending()
+     */
+    Decision onConnected(ITransportPtr transport, Clock::time_point now);
+    std::vector<ITransportPtr> admitPending(Clock::time_point now);
+    void removePending(const ITransport* transport);
+    std::vector<ITransportPtr> takeAllPending();
+
+    std::size_t pendingCount() const;
+    std::size_t rejectedCount() const;
+
+private:
+    bool isDisabled() const;
+
+    const Limits limits;
+    TokenBucket acceptBucket;
+    std::deque<ITransportPtr> pending;
+    std::size_t rejected = 0u;
+};
+
+}
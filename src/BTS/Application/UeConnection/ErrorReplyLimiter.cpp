@@ -0,0 +1,71 @@
+#include "ErrorReplyLimiter.hpp"
+#include <utility>
+
+namespace bts
+{
+
+ErrorReplyLimiter::ErrorReplyLimiter(Clock::duration interval)
+    : interval(interval)
+{}
+
+std::optional<std::size_t> ErrorReplyLimiter::admit(common::MessageId reply, const common::MessageHeader& header,
+                                                    Clock::time_point now)
+{
+    const Key key{reply, header.from, header.to, header.messageId};
+    auto window = windows.find(key);
+    if (window != windows.end() and now - window->second.start < interval)
+    {
+        ++window->second.suppressed;
+        return std::nullopt;
+    }
+    if (window == windows.end() and windows.size() >= MAX_TRACKED)
+    {
+        forgetExpired(now);
+        if (windows.size() >= MAX_TRACKED)
+        {
+            // storm of distinct errors - still bounded
+            ++unreported;
+            return std::nullopt;
+        }
+    }
+
+    std::size_t suppressed = std::exchange(unreported, 0u);
+    if (window != windows.end())
+    {
+        suppressed += window->second.suppressed;
+        window->second = Window{now};
+    }
+    else
+    {
+        windows.emplace(key, Window{now});
+    }
+    return suppressed;
+}
+
+std::size_t ErrorReplyLimiter::takeSuppressed()
+{
+    std::size_t suppressed = std::exchange(unreported, 0u);
+    for (auto& [key, window] : windows)
+    {
+        suppressed += std::exchange(window.suppressed, 0u);
+    }
+    return suppressed;
+}
+
+void ErrorReplyLimiter::forgetExpired(Clock::time_point now)
+{
+    for (auto window = windows.begin(); window != windows.end(); )
+    {
+        if (now - window->second.start >= interval)
+        {
+            unreported += window->second.suppressed;
+            window = windows.erase(window);
+        }
+        else
+        {
+            ++window;
+        }
+    }
+}
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <tuple>
+#include "Messages/MessageHeader.hpp"
+
+namespace bts
+{
+
+/**
+ * Coalesces error replies (UnknownSender, UnknownRecipient) to one UE:
+ * at most one per (reply, sender, recipient, message type) in each interval, others are only counted.
+ * At most MAX_TRACKED such keys are remembered - above that new ones are suppressed too.
+ */
+class ErrorReplyLimiter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t MAX_TRACKED = 256u;
+
+    explicit ErrorReplyLimiter(Clock::duration interval = std::chrono::seconds(1));
+
+    /**
+     * @return empty when reply shall be suppressed, otherwise number of replies suppressed
+     *         since previous one (including those of forgotten keys)
+     */
+    std::optional<std::size_t> admit(common::MessageId reply, const common::MessageHeader& header, Clock::time_point now);
+    /**
+     * @return all suppressed and not yet reported - e.g. on disconnect
+     */
+    std::size_t takeSuppressed();
+
+private:
+    using Key = std::tuple<common::MessageId, common::PhoneNumber, common::PhoneNumber, common::MessageId>;
+    struct Window
+    {
+        Clock::time_point start;
+        std::size_t suppressed = 0u;
+    };
+
+    void forgetExpired(Clock::time_point now);
+
+    const Clock::duration interval;
+    std::map<Key, Window> windows;
+    std::size_t unreported = 0u;
+};
+
+}
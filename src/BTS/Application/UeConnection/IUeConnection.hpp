@@ -6,6 +6,8 @@
 
 #include "Messages.hpp"
 #include "Messages/BtsId.hpp"
+#include "ITransport.hpp"
+#include "TrafficClass.hpp"
 
 
 namespace bts
@@ -23,10 +25,23 @@ public:
     virtual ~IUeConnection() = default;
 
     virtual void start(UeSlot ueSlot) = 0;
-    virtual void sendMessage(BinaryMessage message) = 0;
+    /**
+     * @return false when UE is too busy to take the message
+     */
+    virtual bool sendMessage(BinaryMessage message) = 0;
     virtual void sendSib(BtsId btsId) = 0;
+    /**
+     * As if received from transport - for input which came before connection was started
+     */
+    virtual void receiveMessage(BinaryMessage message) = 0;
     virtual PhoneNumber getPhoneNumber() const = 0;
     virtual bool isAttached() const = 0;
+    virtual ITransportPtr getTransport() const = 0;
+    virtual EgressStats getEgressStats() const = 0;
+    /**
+     * Direct handle to the other side of established call (nullptr when none) - kept valid by UeRelay
+     */
+    virtual void setTalkPeer(IUeConnection* peer) = 0;
     virtual void print(std::ostream&) const = 0;
 };
 
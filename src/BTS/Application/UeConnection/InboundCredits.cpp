@@ -0,0 +1,80 @@
+#include "InboundCredits.hpp"
+#include <algorithm>
+
+namespace bts
+{
+
+InboundCredits::InboundCredits(std::uint16_t window)
+    : window(window)
+{}
+
+std::uint16_t InboundCredits::enable()
+{
+    if (window == 0u)
+    {
+        return 0u;
+    }
+    // UE asking again (e.g. re-attach) starts from full window
+    enabled = true;
+    credits = window;
+    consumed = 0u;
+    return window;
+}
+
+void InboundCredits::disable()
+{
+    enabled = false;
+    credits = 0u;
+    consumed = 0u;
+}
+
+bool InboundCredits::isEnabled() const
+{
+    return enabled;
+}
+
+bool InboundCredits::consume()
+{
+    if (not enabled)
+    {
+        return true;
+    }
+    if (credits == 0u)
+    {
+        ++violations;
+        return false;
+    }
+    --credits;
+    ++consumed;
+    return true;
+}
+
+std::uint16_t InboundCredits::replenish()
+{
+    const std::uint16_t threshold = std::max<std::uint16_t>(1u, window / 2u);
+    if (not enabled or consumed < threshold)
+    {
+        return 0u;
+    }
+    const std::uint16_t grant = consumed;
+    credits += grant;
+    consumed = 0u;
+    return grant;
+}
+
+std::uint16_t InboundCredits::windowSize() const
+{
+    return window;
+}
+
+std::uint16_t InboundCredits::available() const
+{
+    return credits;
+}
+
+std::uint32_t InboundCredits::violationCount() const
+{
+    return violations;
+}
+
+}
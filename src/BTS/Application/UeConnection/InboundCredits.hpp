@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+namespace bts
+{
+
+/**
+ * Send credits granted to one UE - negotiated at attach (AttachFeature::FlowControl),
+ * or by CreditRequest after successful attach from UE not offering that feature.
+ *
+ * UE may have at most window messages on the way to BTS; consumed credits are granted back
+ * in batches (half of the window) once BTS handled the messages, so a flooding UE is paced
+ * by BTS processing and cannot take more than its window from BTS ingress.
+ * Window equal to zero disables flow control - CreditRequest is then left without grant.
+ */
+class InboundCredits
+{
+public:
+    static constexpr std::uint16_t DEFAULT_WINDOW = 32u;
+
+    explicit InboundCredits(std::uint16_t window = DEFAULT_WINDOW);
+
+    /**
+     * @return initial grant, zero when flow control is disabled
+     */
+    std::uint16_t enable();
+    void disable();
+    bool isEnabled() const;
+
+    /**
+     * @return false when UE sent without credit
+     */
+    bool consume();
+    /**
+     * @return credits to grant back, zero when not enough consumed yet
+     */
+    std::uint16_t replenish();
+
+    std::uint16_t windowSize() const;
+    std::uint16_t available() const;
+    std::uint32_t violationCount() const;
+
+private:
+    const std::uint16_t window;
+    bool enabled = false;
+    std::uint16_t credits = 0u;
+    std::uint16_t consumed = 0u;
+    std::uint32_t violations = 0u;
+};
+
+}
@@ -0,0 +1,73 @@
+#include "IngressThrottle.hpp"
+#include <algorithm>
+
+namespace bts
+{
+
+namespace
+{
+
+IngressThrottle::Budget validated(IngressThrottle::Budget budget)
+{
+    if (budget.ratePerSecond > 0.0 and budget.burst < 1.0)
+    {
+        budget.burst = std::max(1.0, budget.ratePerSecond);
+    }
+    return budget;
+}
+
+}
+
+IngressThrottle::Budgets IngressThrottle::defaultBudgets()
+{
+    Budgets defaults;
+    defaults[static_cast<std::size_t>(TrafficClass::Control)] = {20.0, 40.0};
+    defaults[static_cast<std::size_t>(TrafficClass::Talk)] = {100.0, 200.0};
+    defaults[static_cast<std::size_t>(TrafficClass::Sms)] = {10.0, 20.0};
+    return defaults;
+}
+
+IngressThrottle::IngressThrottle()
+    : IngressThrottle(defaultBudgets())
+{}
+
+IngressThrottle::IngressThrottle(Budgets budgets)
+{
+    std::transform(budgets.begin(), budgets.end(), this->budgets.begin(), validated);
+}
+
+bool IngressThrottle::allow(common::PhoneNumber sender, TrafficClass trafficClass, Clock::time_point now)
+{
+    const auto index = static_cast<std::size_t>(trafficClass);
+    const Budget& budget = budgets[index];
+    if (budget.ratePerSecond <= 0.0)
+    {
+        return true;
+    }
+    auto bucket = buckets[index].try_emplace(sender, budget.ratePerSecond, budget.burst, now).first;
+    if (bucket->second.tryTake(now))
+    {
+        return true;
+    }
+    ++throttled[index];
+    return false;
+}
+
+void IngressThrottle::setBudget(TrafficClass trafficClass, Budget budget)
+{
+    const auto index = static_cast<std::size_t>(trafficClass);
+    budgets[index] = validated(budget);
+    buckets[index].clear();
+}
+
+IngressThrottle::Budget IngressThrottle::getBudget(TrafficClass trafficClass) const
+{
+    return budgets[static_cast<std::size_t>(trafficClass)];
+}
+
+std::size_t IngressThrottle::throttledCount(TrafficClass trafficClass) const
+{
+    return throttled[static_cast<std::size_t>(trafficClass)];
+}
+
+}
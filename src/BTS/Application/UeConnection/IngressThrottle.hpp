@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <map>
+#include "TokenBucket.hpp"
+#include "TrafficClass.hpp"
+#include "Messages/PhoneNumber.hpp"
+
+namespace bts
+{
+
+/**
+ * Per sender (PhoneNumber) rate limits of messages from UE, separate budget for each TrafficClass.
+ * Shared by all UE connections - so reconnecting does not refill the budget.
+ * Not synchronized - used under SyncGuard.
+ */
+class IngressThrottle
+{
+public:
+    using Clock = TokenBucket::Clock;
+
+    struct Budget
+    {
+        // zero rate: no limit
+        double ratePerSecond = 0.0;
+        // below 1 (e.g. not configured) no message would ever pass - max(1, rate) taken then
+        double burst = 0.0;
+    };
+    using Budgets = std::array<Budget, TRAFFIC_CLASS_COUNT>;
+
+    static Budgets defaultBudgets();
+
+    IngressThrottle();
+    explicit IngressThrottle(Budgets budgets);
+
+    bool allow(common::PhoneNumber sender, TrafficClass trafficClass, Clock::time_point now);
+
+    /**
+     * Buckets of given class start again full
+     */
+    void setBudget(TrafficClass trafficClass, Budget budget);
+    Budget getBudget(TrafficClass trafficClass) const;
+    std::size_t throttledCount(TrafficClass trafficClass) const;
+
+private:
+    using SenderBuckets = std::map<common::PhoneNumber, TokenBucket>;
+
+    Budgets budgets;
+    std::array<SenderBuckets, TRAFFIC_CLASS_COUNT> buckets;
+    std::array<std::size_t, TRAFFIC_CLASS_COUNT> throttled{};
+};
+
+}
@@ -0,0 +1,151 @@
+#include "OutboundQueue.hpp"
+#include <algorithm>
+
+namespace bts
+{
+
+OutboundQueue::OutboundQueue()
+    : OutboundQueue(Limits{})
+{}
+
+OutboundQueue::OutboundQueue(Limits limits)
+    : OutboundQueue(limits, &Clock::now)
+{}
+
+OutboundQueue::OutboundQueue(Limits limits, Now now)
+    : limits(limits),
+      now(std::move(now))
+{}
+
+bool OutboundQueue::push(BinaryMessage message)
+{
+    const TrafficClass trafficClass = classify(message);
+    if (busy and limits.policy == Policy::Reject and trafficClass != TrafficClass::Control)
+    {
+        ++rejected;
+        return false;
+    }
+    queuedBytes += message.value.size();
+    ++queuedMessages;
+    queueOf(trafficClass).push_back({std::move(message), now()});
+    while (queuedBytes > limits.highWatermark and limits.policy == Policy::DropOldest and queuedMessages > 1u)
+    {
+        if (not dropOldestBulk())
+        {
+            break;
+        }
+    }
+    updateBusy();
+    return true;
+}
+
+std::optional<BinaryMessage> OutboundQueue::pop()
+{
+    if (empty())
+    {
+        return std::nullopt;
+    }
+    const TrafficClass trafficClass = nextClass();
+    Queue& queue = queueOf(trafficClass);
+    Entry entry = std::move(queue.front());
+    queue.pop_front();
+    --queuedMessages;
+    queuedBytes -= entry.message.value.size();
+    latency[static_cast<std::size_t>(trafficClass)].record(now() - entry.enqueued);
+    updateBusy();
+    return std::move(entry.message);
+}
+
+void OutboundQueue::recordSentDirectly(const BinaryMessage& message)
+{
+    latency[static_cast<std::size_t>(classify(message))].record({});
+}
+
+OutboundQueue::Queue& OutboundQueue::queueOf(TrafficClass trafficClass)
+{
+    return queues[static_cast<std::size_t>(trafficClass)];
+}
+
+TrafficClass OutboundQueue::nextClass()
+{
+    if (not queueOf(TrafficClass::Control).empty())
+    {
+        return TrafficClass::Control;
+    }
+    if (queueOf(TrafficClass::Talk).empty())
+    {
+        return TrafficClass::Sms;
+    }
+    if (queueOf(TrafficClass::Sms).empty())
+    {
+        return TrafficClass::Talk;
+    }
+    if (bulkTurnLeft == 0u)
+    {
+        bulkTurn = bulkTurn == TrafficClass::Talk ? TrafficClass::Sms : TrafficClass::Talk;
+        bulkTurnLeft = std::max(1u, bulkTurn == TrafficClass::Talk ? limits.talkWeight : limits.smsWeight);
+    }
+    --bulkTurnLeft;
+    return bulkTurn;
+}
+
+bool OutboundQueue::dropOldestBulk()
+{
+    // late talk is worth less than SMS
+    for (TrafficClass trafficClass : {TrafficClass::Talk, TrafficClass::Sms})
+    {
+        Queue& queue = queueOf(trafficClass);
+        if (not queue.empty())
+        {
+            queuedBytes -= queue.front().message.value.size();
+            --queuedMessages;
+            queue.pop_front();
+            ++dropped;
+            return true;
+        }
+    }
+    return false;
+}
+
+void OutboundQueue::updateBusy()
+{
+    busy = busy ? queuedBytes > limits.lowWatermark
+                : queuedBytes >= limits.highWatermark;
+}
+
+bool OutboundQueue::isBusy() const
+{
+    return busy;
+}
+
+bool OutboundQueue::empty() const
+{
+    return queuedMessages == 0u;
+}
+
+std::size_t OutboundQueue::size() const
+{
+    return queuedMessages;
+}
+
+std::size_t OutboundQueue::bytes() const
+{
+    return queuedBytes;
+}
+
+std::size_t OutboundQueue::rejectedCount() const
+{
+    return rejected;
+}
+
+std::size_t OutboundQueue::droppedCount() const
+{
+    return dropped;
+}
+
+const EgressStats& OutboundQueue::stats() const
+{
+    return latency;
+}
+
+}
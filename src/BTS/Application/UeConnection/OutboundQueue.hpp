@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <optional>
+#include "Messages/BinaryMessage.hpp"
+#include "TrafficClass.hpp"
+
+namespace bts
+{
+
+using common::BinaryMessage;
+
+/**
+ * Messages to one UE waiting while its transport reports backpressure.
+ *
+ * Bounded by bytes: when highWatermark is reached the queue is busy - then, depending on policy,
+ * new bulk messages are rejected, or oldest bulk ones are dropped. It stops being busy below lowWatermark.
+ * Control messages are never rejected nor dropped and always leave first; Talk and Sms
+ * are served round robin by their weights. Time spent in queue is gathered per TrafficClass.
+ */
+class OutboundQueue
+{
+public:
+    enum class Policy
+    {
+        Reject,
+        DropOldest
+    };
+
+    struct Limits
+    {
+        std::size_t highWatermark = 256u * 1024u;
+        std::size_t lowWatermark = 64u * 1024u;
+        Policy policy = Policy::Reject;
+        // messages served in a row when both bulk classes wait
+        unsigned talkWeight = 3u;
+        unsigned smsWeight = 1u;
+    };
+
+    using Clock = std::chrono::steady_clock;
+    using Now = std::function<Clock::time_point()>;
+
+    OutboundQueue();
+    explicit OutboundQueue(Limits limits);
+    OutboundQueue(Limits limits, Now now);
+
+    /**
+     * @return false when message rejected
+     */
+    bool push(BinaryMessage message);
+    std::optional<BinaryMessage> pop();
+    /**
+     * Message which did not wait in queue - for complete stats
+     */
+    void recordSentDirectly(const BinaryMessage& message);
+
+    bool isBusy() const;
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t bytes() const;
+
+    std::size_t rejectedCount() const;
+    std::size_t droppedCount() const;
+    const EgressStats& stats() const;
+
+private:
+    struct Entry
+    {
+        BinaryMessage message;
+        Clock::time_point enqueued;
+    };
+    using Queue = std::deque<Entry>;
+
+    Queue& queueOf(TrafficClass trafficClass);
+    TrafficClass nextClass();
+    bool dropOldestBulk();
+    void updateBusy();
+
+    const Limits limits;
+    const Now now;
+    std::array<Queue, TRAFFIC_CLASS_COUNT> queues;
+    std::size_t queuedMessages = 0u;
+    std::size_t queuedBytes = 0u;
+    bool busy = false;
+    std::size_t rejected = 0u;
+    std::size_t dropped = 0u;
+    // first turn goes to Talk
+    TrafficClass bulkTurn = TrafficClass::Sms;
+    unsigned bulkTurnLeft = 0u;
+    EgressStats latency;
+};
+
+}
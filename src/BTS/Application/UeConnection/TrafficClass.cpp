@@ -0,0 +1,95 @@
+#include "TrafficClass.hpp"
+#include "Messages/MessageId.hpp"
+#include <algorithm>
+#include <ostream>
+
+namespace bts
+{
+
+using common::MessageId;
+
+TrafficClass classify(const common::BinaryMessage& message)
+{
+    if (message.value.size() == 0u)
+    {
+        return TrafficClass::Sms;
+    }
+    auto messageId = static_cast<MessageId>(message.value[0]);
+    if (messageId == MessageId::Compressed and message.value.size() > 3u)
+    {
+        // class of what is compressed
+        messageId = static_cast<MessageId>(message.value[3]);
+    }
+    switch (messageId)
+    {
+    case MessageId::Sms:
+    case MessageId::GroupSms:
+        return TrafficClass::Sms;
+    case MessageId::CallTalk:
+        return TrafficClass::Talk;
+    default:
+        // Sib, attach, call setup/teardown, error indications, credits
+        return TrafficClass::Control;
+    }
+}
+
+std::ostream& operator << (std::ostream& os, TrafficClass trafficClass)
+{
+    return os << to_string(trafficClass);
+}
+
+std::string to_string(TrafficClass trafficClass)
+{
+    switch (trafficClass)
+    {
+    case TrafficClass::Control: return "control";
+    case TrafficClass::Talk: return "talk";
+    case TrafficClass::Sms: return "sms";
+    }
+    return "unknown";
+}
+
+void LatencyStats::record(Duration latency)
+{
+    ++count;
+    total += latency;
+    max = std::max(max, latency);
+}
+
+LatencyStats::Duration LatencyStats::average() const
+{
+    return count == 0u ? Duration{} : total / static_cast<Duration::rep>(count);
+}
+
+LatencyStats& LatencyStats::operator += (const LatencyStats& other)
+{
+    count += other.count;
+    total += other.total;
+    max = std::max(max, other.max);
+    return *this;
+}
+
+EgressStats& operator += (EgressStats& stats, const EgressStats& other)
+{
+    for (std::size_t i = 0; i < TRAFFIC_CLASS_COUNT; ++i)
+    {
+        stats[i] += other[i];
+    }
+    return stats;
+}
+
+std::ostream& operator << (std::ostream& os, const EgressStats& stats)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    for (std::size_t i = 0; i < TRAFFIC_CLASS_COUNT; ++i)
+    {
+        os << " > " << static_cast<TrafficClass>(i)
+           << ": sent: " << stats[i].count
+           << ", avg: " << duration_cast<microseconds>(stats[i].average()).count() << "us"
+           << ", max: " << duration_cast<microseconds>(stats[i].max).count() << "us\n";
+    }
+    return os;
+}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include "Messages/BinaryMessage.hpp"
+
+namespace bts
+{
+
+/**
+ * Egress priority of messages to UE - by MessageId.
+ * Control is served first, bulk classes share the rest by weights.
+ */
+enum class TrafficClass : std::size_t
+{
+    Control,
+    Talk,
+    Sms
+};
+
+constexpr std::size_t TRAFFIC_CLASS_COUNT = 3u;
+
+TrafficClass classify(const common::BinaryMessage& message);
+std::ostream& operator << (std::ostream&, TrafficClass);
+std::string to_string(TrafficClass);
+
+struct LatencyStats
+{
+    using Duration = std::chrono::steady_clock::duration;
+
+    std::size_t count = 0u;
+    Duration total{};
+    Duration max{};
+
+    void record(Duration latency);
+    Duration average() const;
+    LatencyStats& operator += (const LatencyStats& other);
+};
+
+using EgressStats = std::array<LatencyStats, TRAFFIC_CLASS_COUNT>;
+
+EgressStats& operator += (EgressStats& stats, const EgressStats& other);
+std::ostream& operator << (std::ostream&, const EgressStats&);
+
+}
@@ -1,17 +1,60 @@
 #include "UeConnection.hpp"
 #include "Messages/IncomingMessage.hpp"
 #include "Messages/OutgoingMessage.hpp"
+#include "Messages/MessageCompression.hpp"
 
 namespace bts
 {
 
 using namespace std::placeholders;
 using common::MessageId;
+using common::AttachFeature;
 
-UeConnection::UeConnection(ITransportPtr transport, common::ILogger &logger, SyncGuardPtr syncGuard)
+namespace
+{
+
+// appended to error coalesced by ErrorReplyLimiter
+struct SimilarSuppressed
+{
+    std::size_t count;
+};
+
+std::ostream& operator<<(std::ostream& os, SimilarSuppressed suppressed)
+{
+    if (suppressed.count > 0u)
+    {
+        os << " (" << suppressed.count << " similar suppressed)";
+    }
+    return os;
+}
+
+std::optional<common::AttachFeatures> readOfferedFeatures(common::IncomingMessage& reader)
+{
+    // older UE sends neither BtsId nor features
+    if (reader.isEndOfMessage())
+    {
+        return std::nullopt;
+    }
+    reader.readBtsId();
+    if (reader.isEndOfMessage())
+    {
+        return std::nullopt;
+    }
+    return reader.readNumber<common::AttachFeatures>();
+}
+
+}
+
+UeConnection::UeConnection(ITransportPtr transport, common::ILogger &logger, SyncGuardPtr syncGuard,
+                           OutboundQueue::Limits outboundLimits, std::uint16_t creditWindow,
+                           std::shared_ptr<IngressThrottle> ingressThrottle, common::AttachFeatures supportedFeatures)
     : syncGuard(syncGuard),
+      logger(logger, std::bind(&UeConnection::printPrefix, this, _1)),
       transport(transport),
-      logger(logger, std::bind(&UeConnection::printPrefix, this, _1))
+      outboundQueue(outboundLimits),
+      inboundCredits(creditWindow),
+      ingressThrottle(ingressThrottle),
+      supportedFeatures(supportedFeatures)
 {
 }
 
@@ -25,18 +68,24 @@ void UeConnection::start(UeSlot ueSlot)
     this->ueSlot = ueSlot;
     transport->registerDisconnectedCallback(std::bind(&UeConnection::onUeDisconnectedCallback, this));
     transport->registerMessageCallback(std::bind(&UeConnection::onUeMessageCallback, this, _1));
+    transport->registerBackpressureCallback(std::bind(&UeConnection::onBackpressureCallback, this, _1));
 }
 
 void UeConnection::stop()
 {
     transport->registerMessageCallback(nullptr);
     transport->registerDisconnectedCallback(nullptr);
+    transport->registerBackpressureCallback(nullptr);
 }
 
-void UeConnection::sendAttachResponse(bool success, PhoneNumber phoneNumber)
+void UeConnection::sendAttachResponse(bool success, PhoneNumber phoneNumber, std::optional<common::AttachFeatures> features)
 {
     common::OutgoingMessage messageBuilder(MessageId::AttachResponse, PhoneNumber{}, phoneNumber);
     messageBuilder.writeNumber<bool>(success);
+    if (features)
+    {
+        messageBuilder.writeNumber(*features);
+    }
     sendMessage(messageBuilder.getMessage());
 }
 
@@ -47,14 +96,113 @@ void UeConnection::sendSib(BtsId btsId)
     sendMessage(messageBuilder.getMessage());
 }
 
+void UeConnection::receiveMessage(BinaryMessage message)
+{
+    onUeMessageCallback(std::move(message));
+}
+
 PhoneNumber UeConnection::getPhoneNumber() const
 {
     return ueSlot.getPhoneNumber();
 }
 
-void UeConnection::sendMessage(BinaryMessage messageToSend)
+bool UeConnection::sendMessage(BinaryMessage messageToSend)
+{
+    if (hasFeature(AttachFeature::Compression))
+    {
+        // before queueing - queue limits count bytes really to be sent
+        if (auto compressed = common::compressMessage(messageToSend))
+        {
+            messageToSend = std::move(*compressed);
+        }
+    }
+    if (not transportCongested and outboundQueue.empty())
+    {
+        outboundQueue.recordSentDirectly(messageToSend);
+        if (corked)
+        {
+            corkedMessages.push_back(std::move(messageToSend));
+        }
+        else
+        {
+            transport->sendMessage(std::move(messageToSend));
+        }
+        return true;
+    }
+    const std::size_t droppedBefore = outboundQueue.droppedCount();
+    if (not outboundQueue.push(std::move(messageToSend)))
+    {
+        logger.logError("Busy - message rejected, queued: ", outboundQueue.size(), " messages, ", outboundQueue.bytes(), " bytes");
+        return false;
+    }
+    if (outboundQueue.droppedCount() != droppedBefore)
+    {
+        logger.logError("Busy - oldest messages dropped, total dropped: ", outboundQueue.droppedCount());
+    }
+    return true;
+}
+
+void UeConnection::onBackpressureCallback(bool congested)
+{
+    SyncLock lock(*syncGuard);
+    logger.logDebug(congested ? "Transport congested" : "Transport relieved", ", queued: ", outboundQueue.bytes(), " bytes");
+    transportCongested = congested;
+    drainOutboundQueue();
+}
+
+void UeConnection::drainOutboundQueue()
+{
+    common::MessageBatch batch(PhoneNumber{}, getPhoneNumber());
+    // transport might report congestion from within sendMessage
+    while (not transportCongested)
+    {
+        auto message = outboundQueue.pop();
+        if (not message)
+        {
+            break;
+        }
+        transmit(batch, std::move(*message));
+    }
+    flush(batch);
+    grantConsumedCredits();
+}
+
+void UeConnection::sendCorked()
 {
-    transport->sendMessage(std::move(messageToSend));
+    common::MessageBatch batch(PhoneNumber{}, getPhoneNumber());
+    for (auto& message : corkedMessages)
+    {
+        transmit(batch, std::move(message));
+    }
+    corkedMessages.clear();
+    flush(batch);
+}
+
+void UeConnection::transmit(common::MessageBatch& batch, BinaryMessage message)
+{
+    if (not hasFeature(AttachFeature::Batching))
+    {
+        transport->sendMessage(std::move(message));
+        return;
+    }
+    if (not batch.add(message))
+    {
+        transport->sendMessage(batch.take());
+        batch.add(message);
+    }
+}
+
+bool UeConnection::hasFeature(AttachFeature feature) const
+{
+    return (features & common::get(feature)) != 0u;
+}
+
+void UeConnection::flush(common::MessageBatch& batch)
+{
+    if (not batch.empty())
+    {
+        transport->sendMessage(batch.take());
+    }
 }
 
 void UeConnection::sendUnknownRecipient(const MessageHeader &messageHeader)
@@ -64,6 +212,19 @@ void UeConnection::sendUnknownRecipient(const MessageHeader &messageHeader)
     sendMessage(messageBuilder.getMessage());
 }
 
+void UeConnection::sendGroupSmsResult(std::uint16_t groupSmsId, std::uint8_t recipientCount,
+                                      const std::vector<std::uint8_t>& failedBitmap)
+{
+    common::OutgoingMessage messageBuilder(MessageId::GroupSmsResult, PhoneNumber{}, getPhoneNumber());
+    messageBuilder.writeNumber(groupSmsId);
+    messageBuilder.writeNumber(recipientCount);
+    for (auto bits : failedBitmap)
+    {
+        messageBuilder.writeNumber(bits);
+    }
+    sendMessage(messageBuilder.getMessage());
+}
+
 void UeConnection::sendUnknownSender(const MessageHeader &messageHeader)
 {
     common::OutgoingMessage messageBuilder(MessageId::UnknownSender, PhoneNumber{}, getPhoneNumber());
@@ -71,6 +232,48 @@ void UeConnection::sendUnknownSender(const MessageHeader &messageHeader)
     sendMessage(messageBuilder.getMessage());
 }
 
+void UeConnection::sendCreditGrant(std::uint16_t credits)
+{
+    common::OutgoingMessage messageBuilder(MessageId::CreditGrant, PhoneNumber{}, getPhoneNumber());
+    messageBuilder.writeNumber(credits);
+    sendMessage(messageBuilder.getMessage());
+}
+
+void UeConnection::grantInitialCredits()
+{
+    // UE counts its messages from attach accept - so does BTS, no CreditRequest comes
+    if (hasFeature(AttachFeature::FlowControl))
+    {
+        const auto credits = inboundCredits.enable();
+        logger.logDebug("Flow control negotiated, window: ", credits);
+        sendCreditGrant(credits);
+    }
+}
+
+void UeConnection::grantConsumedCredits()
+{
+    // UE not reading what we send gets no more credits
+    if (transportCongested or not outboundQueue.empty())
+    {
+        return;
+    }
+    if (auto credits = inboundCredits.replenish())
+    {
+        sendCreditGrant(credits);
+    }
+}
+
+bool UeConnection::admitErrorReply(MessageId reply, const MessageHeader& messageHeader, const char* reason)
+{
+    auto suppressed = errorReplyLimiter.admit(reply, messageHeader, ErrorReplyLimiter::Clock::now());
+    if (not suppressed)
+    {
+        return false;
+    }
+    logger.logError(reason, messageHeader, SimilarSuppressed{*suppressed});
+    return true;
+}
+
 void UeConnection::attach(PhoneNumber phoneNumber)
 {
     ueSlot.attach(phoneNumber);
@@ -87,32 +290,142 @@ bool UeConnection::isAttached() const
     return ueSlot.isAttached();
 }
 
+EgressStats UeConnection::getEgressStats() const
+{
+    return outboundQueue.stats();
+}
+
+void UeConnection::setTalkPeer(IUeConnection* peer)
+{
+    talkPeer = peer;
+    talkPeerNumber = peer ? peer->getPhoneNumber() : PhoneNumber{};
+}
+
+ITransportPtr UeConnection::getTransport() const
+{
+    return transport;
+}
+
 void UeConnection::onUeMessageCallbackBody(BinaryMessage message)
 {
+    if (common::MessageBatch::isBatch(message))
+    {
+        onBatch(message);
+        return;
+    }
+    if (common::isCompressed(message))
+    {
+        message = common::decompressMessage(message);
+    }
+    if (isTalkToPeer(message))
+    {
+        // fast path: header already known, peer already resolved
+        onForwardRequest(std::move(message), MessageHeader{MessageId::CallTalk, getPhoneNumber(), talkPeerNumber});
+        return;
+    }
+
     common::IncomingMessage incomingMessage(message);
     MessageHeader messageHeader = incomingMessage.readMessageHeader();
 
     if (messageHeader.messageId == MessageId::AttachRequest)
     {
-        onAttachRequest(messageHeader.from);
+        // credits are negotiated again after each attach
+        inboundCredits.disable();
+        onAttachRequest(messageHeader.from, readOfferedFeatures(incomingMessage));
     }
-    else
+    else if (not isAttached() or getPhoneNumber() != messageHeader.from)
     {
-        if (not isAttached() or getPhoneNumber() != messageHeader.from)
+        if (admitErrorReply(MessageId::UnknownSender, messageHeader, "Not ready for: "))
         {
-            logger.logError("Not ready for: ", messageHeader);
             sendUnknownSender(messageHeader);
         }
-        else if (not forwardMessage(std::move(message), messageHeader.to))
+    }
+    else if (messageHeader.messageId == MessageId::CreditRequest)
+    {
+        onCreditRequest(messageHeader);
+    }
+    else
+    {
+        onForwardRequest(std::move(message), messageHeader);
+    }
+}
+
+void UeConnection::onBatch(const BinaryMessage& message)
+{
+    if (corked)
+    {
+        throw common::IncomingMessage::ReadEx("Batch nested in batch");
+    }
+    auto messages = common::MessageBatch::unpack(message);
+    logger.logDebug("Batch of: ", messages.size(), " messages");
+    corked = true;
+    for (auto& entry : messages)
+    {
+        // one broken message shall not lose the others
+        try
         {
-            logger.logError("Cannot forward: ", messageHeader);
-            sendUnknownRecipient(messageHeader);
+            onUeMessageCallbackBody(std::move(entry));
         }
-        else
+        catch (std::exception& ex)
         {
-            logger.logDebug("Forwarded: ", messageHeader);
+            logger.logError("Ue message handling error: ", ex.what());
         }
     }
+    corked = false;
+    sendCorked();
+}
+
+void UeConnection::onCreditRequest(const MessageHeader& messageHeader)
+{
+    if (auto credits = inboundCredits.enable())
+    {
+        logger.logDebug("Flow control enabled, window: ", credits);
+        sendCreditGrant(credits);
+    }
+    else
+    {
+        logger.logDebug("Flow control disabled, ignored: ", messageHeader);
+    }
+}
+
+void UeConnection::onForwardRequest(BinaryMessage message, const MessageHeader& messageHeader)
+{
+    if (not inboundCredits.consume())
+    {
+        if (auto suppressed = noCreditLogLimiter.admit(messageHeader.messageId, messageHeader, ErrorReplyLimiter::Clock::now()))
+        {
+            logger.logError("No credit - dropped: ", messageHeader, SimilarSuppressed{*suppressed},
+                            ", total dropped: ", inboundCredits.violationCount());
+        }
+        return;
+    }
+    const TrafficClass trafficClass = classify(message);
+    if (ingressThrottle and not ingressThrottle->allow(messageHeader.from, trafficClass, IngressThrottle::Clock::now()))
+    {
+        if (auto suppressed = throttledLogLimiter.admit(messageHeader.messageId, messageHeader, ErrorReplyLimiter::Clock::now()))
+        {
+            logger.logError("Throttled: ", messageHeader, SimilarSuppressed{*suppressed}, ", total ", trafficClass,
+                            " throttled: ", ingressThrottle->throttledCount(trafficClass));
+        }
+    }
+    else if (messageHeader.messageId == MessageId::GroupSms)
+    {
+        fanOutGroupSms(message, messageHeader);
+    }
+    else if (not forwardMessage(std::move(message), messageHeader.to))
+    {
+        trackCall(messageHeader, false);
+        if (admitErrorReply(MessageId::UnknownRecipient, messageHeader, "Cannot forward: "))
+        {
+            sendUnknownRecipient(messageHeader);
+        }
+    }
+    else
+    {
+        trackCall(messageHeader, true);
+        logger.logDebug("Forwarded: ", messageHeader);
+    }
+    grantConsumedCredits();
 }
 
 void UeConnection::onUeMessageCallback(BinaryMessage message)
@@ -128,13 +441,25 @@ void UeConnection::onUeMessageCallback(BinaryMessage message)
     }
 }
 
-void UeConnection::onAttachRequest(PhoneNumber phoneNumber)
+void UeConnection::onAttachRequest(PhoneNumber phoneNumber, std::optional<common::AttachFeatures> offeredFeatures)
 {
+    // answer with features only to UE which knows about them
+    std::optional<common::AttachFeatures> acceptedFeatures;
+    if (offeredFeatures)
+    {
+        acceptedFeatures = *offeredFeatures & supportedFeatures;
+        if (inboundCredits.windowSize() == 0u)
+        {
+            *acceptedFeatures &= ~common::get(AttachFeature::FlowControl);
+        }
+    }
+    features = common::get(AttachFeature::None);
+
     if (phoneNumber == PhoneNumber{})
     {
         // special case #1
         logger.logError("Attach with UE number equal to zero rejected");
-        sendAttachResponse(false, phoneNumber);
+        sendAttachResponse(false, phoneNumber, acceptedFeatures);
         return;
     }
 
@@ -142,9 +467,11 @@ void UeConnection::onAttachRequest(PhoneNumber phoneNumber)
     {
         if ( this->getPhoneNumber() == phoneNumber)
         {
-            // special case #2
-            logger.logError("Attach to UE already attached with identical number accepted");
-            sendAttachResponse(true, phoneNumber);
+            // special case #2 - e.g. after connection was taken over from previous BTS process
+            logger.logInfo("Attach to UE already attached with identical number accepted");
+            sendAttachResponse(true, phoneNumber, acceptedFeatures);
+            features = acceptedFeatures.value_or(features);
+            grantInitialCredits();
             return;
         }
         // special case #3
@@ -156,19 +483,92 @@ void UeConnection::onAttachRequest(PhoneNumber phoneNumber)
     if (not isAttached())
     {
         logger.logError("Attach failed for number: ", phoneNumber);
-        sendAttachResponse(false, phoneNumber);
+        sendAttachResponse(false, phoneNumber, acceptedFeatures);
         return;
     }
 
     logger.logInfo("Attached");
-    sendAttachResponse(true, phoneNumber);
+    sendAttachResponse(true, phoneNumber, acceptedFeatures);
+    features = acceptedFeatures.value_or(features);
+    grantInitialCredits();
+    // only after accept - UE ignores anything else before
+    ueSlot.deliverStored();
 }
 
 bool UeConnection::forwardMessage(BinaryMessage message, PhoneNumber to)
 {
+    if (talkPeer and to == talkPeerNumber)
+    {
+        return talkPeer->sendMessage(std::move(message));
+    }
     return ueSlot.sendMessage(std::move(message), to);
 }
 
+void UeConnection::fanOutGroupSms(const BinaryMessage& message, const MessageHeader& messageHeader)
+{
+    common::IncomingMessage reader(message);
+    reader.readMessageHeader();
+    // echoed in result - UE matches it with request, not all requests are answered (e.g. throttled)
+    const auto groupSmsId = reader.readNumber<std::uint16_t>();
+    const auto recipientCount = reader.readNumber<std::uint8_t>();
+    std::vector<PhoneNumber> recipients(recipientCount);
+    for (auto& recipient : recipients)
+    {
+        recipient = reader.readPhoneNumber();
+    }
+
+    // payload encoded once - for each recipient only "to" byte of header is changed
+    common::OutgoingMessage smsBuilder(MessageId::Sms, messageHeader.from, PhoneNumber{});
+    smsBuilder.writeText(reader.readRemainingText());
+    BinaryMessage sms = smsBuilder.getMessage();
+    constexpr std::size_t TO_POSITION = 2u;
+
+    std::vector<std::uint8_t> failedBitmap((recipientCount + 7u) / 8u);
+    std::size_t failedCount = 0u;
+    for (std::size_t i = 0u; i < recipients.size(); ++i)
+    {
+        sms.value[TO_POSITION] = recipients[i].value;
+        if (not forwardMessage(sms, recipients[i]))
+        {
+            failedBitmap[i / 8u] |= static_cast<std::uint8_t>(1u << (i % 8u));
+            ++failedCount;
+        }
+    }
+    logger.logDebug("Group SMS forwarded to: ", recipients.size() - failedCount, ", failed: ", failedCount);
+    sendGroupSmsResult(groupSmsId, recipientCount, failedBitmap);
+}
+
+bool UeConnection::isTalkToPeer(const BinaryMessage& message) const
+{
+    const auto& bytes = message.value;
+    return talkPeer
+        and bytes.size() >= 3u
+        and bytes[0] == common::get(MessageId::CallTalk)
+        and bytes[1] == getPhoneNumber().value
+        and bytes[2] == talkPeerNumber.value;
+}
+
+void UeConnection::trackCall(const MessageHeader& messageHeader, bool forwarded)
+{
+    switch (messageHeader.messageId)
+    {
+    case MessageId::CallRequest:
+    case MessageId::CallAccepted:
+    case MessageId::ConferenceInvite:
+        if (forwarded)
+        {
+            ueSlot.trackCall(messageHeader);
+        }
+        break;
+    case MessageId::CallDropped:
+        // even if peer is gone - session must end
+        ueSlot.trackCall(messageHeader);
+        break;
+    default:
+        break;
+    }
+}
+
 void UeConnection::onUeDisconnectedCallback()
 {
     SyncLock lock(*syncGuard);
@@ -176,6 +576,18 @@ void UeConnection::onUeDisconnectedCallback()
     try
     {
         logger.logInfo("Disconnected");
+        if (auto suppressed = errorReplyLimiter.takeSuppressed())
+        {
+            logger.logError("Error replies suppressed before disconnect: ", suppressed);
+        }
+        if (auto suppressed = noCreditLogLimiter.takeSuppressed())
+        {
+            logger.logError("No credit drops not logged before disconnect: ", suppressed);
+        }
+        if (auto suppressed = throttledLogLimiter.takeSuppressed())
+        {
+            logger.logError("Throttled messages not logged before disconnect: ", suppressed);
+        }
         detach();
     }
     catch (std::exception& ex)
@@ -4,10 +4,16 @@
 #include "ITransport.hpp"
 #include "UeRelay/IUeRelay.hpp"
 #include "Synchronization.hpp"
+#include "OutboundQueue.hpp"
+#include "InboundCredits.hpp"
+#include "IngressThrottle.hpp"
+#include "ErrorReplyLimiter.hpp"
 #include "Logger/ILogger.hpp"
 
 #include "Messages/MessageHeader.hpp"
 #include "Messages/IncomingMessage.hpp"
+#include "Messages/MessageBatch.hpp"
+#include "Messages/AttachFeature.hpp"
 #include "Logger/PrefixedLogger.hpp"
 
 namespace bts
@@ -17,30 +23,55 @@ using common::MessageHeader;
 class UeConnection : public IUeConnection
 {
 public:
-    UeConnection(ITransportPtr transport, common::ILogger& logger, SyncGuardPtr syncGuard);
+    UeConnection(ITransportPtr transport, common::ILogger& logger, SyncGuardPtr syncGuard,
+                 OutboundQueue::Limits outboundLimits = {},
+                 std::uint16_t creditWindow = InboundCredits::DEFAULT_WINDOW,
+                 std::shared_ptr<IngressThrottle> ingressThrottle = nullptr,
+                 common::AttachFeatures supportedFeatures = common::ALL_ATTACH_FEATURES);
     ~UeConnection() override;
 
     void start(UeSlot ueSlot) override;
 
-    void sendMessage(BinaryMessage message) override;
+    bool sendMessage(BinaryMessage message) override;
     void sendSib(BtsId btsId) override;
+    void receiveMessage(BinaryMessage message) override;
     PhoneNumber getPhoneNumber() const override;
     bool isAttached() const override;
+    ITransportPtr getTransport() const override;
+    EgressStats getEgressStats() const override;
+    void setTalkPeer(IUeConnection* peer) override;
 
     void print(std::ostream& os) const override;
 private:
 
     void onUeMessageCallback(BinaryMessage message);
     void onUeMessageCallbackBody(BinaryMessage message);
-    void onAttachRequest(PhoneNumber phoneNumber);
+    void onAttachRequest(PhoneNumber phoneNumber, std::optional<common::AttachFeatures> offeredFeatures);
+    void onBatch(const BinaryMessage& message);
+    void onCreditRequest(const MessageHeader& messageHeader);
+    void onForwardRequest(BinaryMessage message, const MessageHeader& messageHeader);
     bool forwardMessage(BinaryMessage message, PhoneNumber to);
+    void fanOutGroupSms(const BinaryMessage& message, const MessageHeader& messageHeader);
+    bool isTalkToPeer(const BinaryMessage& message) const;
+    void trackCall(const MessageHeader& messageHeader, bool forwarded);
 
     void onUeDisconnectedCallback();
+    void onBackpressureCallback(bool congested);
+    void drainOutboundQueue();
+    void sendCorked();
+    void transmit(common::MessageBatch& batch, BinaryMessage message);
+    void flush(common::MessageBatch& batch);
+    bool hasFeature(common::AttachFeature feature) const;
     void stop();
 
-    void sendAttachResponse(bool success, PhoneNumber phoneNumber);
+    void sendAttachResponse(bool success, PhoneNumber phoneNumber, std::optional<common::AttachFeatures> features);
     void sendUnknownRecipient(const MessageHeader& messageHeader);
     void sendUnknownSender(const MessageHeader& messageHeader);
+    bool admitErrorReply(common::MessageId reply, const MessageHeader& messageHeader, const char* reason);
+    void sendCreditGrant(std::uint16_t credits);
+    void sendGroupSmsResult(std::uint16_t groupSmsId, std::uint8_t recipientCount, const std::vector<std::uint8_t>& failedBitmap);
+    void grantInitialCredits();
+    void grantConsumedCredits();
 
     void attach(PhoneNumber phoneNumber);
     void detach();
@@ -51,6 +82,24 @@ private:
     UeSlot ueSlot;
     common::PrefixedLogger logger;
     ITransportPtr transport;
+    OutboundQueue outboundQueue;
+    bool transportCongested = false;
+    InboundCredits inboundCredits;
+    std::shared_ptr<IngressThrottle> ingressThrottle;
+    ErrorReplyLimiter errorReplyLimiter;
+    // messages dropped for lack of credit, and throttled ones, logged as error replies are -
+    // at most one per interval of each kind
+    ErrorReplyLimiter noCreditLogLimiter;
+    ErrorReplyLimiter throttledLogLimiter;
+    // other side of established call - set by UeRelay
+    IUeConnection* talkPeer = nullptr;
+    PhoneNumber talkPeerNumber{};
+    const common::AttachFeatures supportedFeatures;
+    // negotiated at attach
+    common::AttachFeatures features = common::get(common::AttachFeature::None);
+    // while handling a batch from UE, replies wait here to leave as one container
+    bool corked = false;
+    std::vector<BinaryMessage> corkedMessages;
 };
 
 }
@@ -5,14 +5,22 @@
 namespace bts
 {
 
-UeConnectionFactory::UeConnectionFactory(common::ILogger &logger, std::shared_ptr<SyncGuard> syncGuard)
+UeConnectionFactory::UeConnectionFactory(common::ILogger &logger, std::shared_ptr<SyncGuard> syncGuard,
+                                         OutboundQueue::Limits outboundLimits, std::uint16_t creditWindow,
+                                         std::shared_ptr<IngressThrottle> ingressThrottle,
+                                         common::AttachFeatures supportedFeatures)
     : logger(logger),
-      syncGuard(syncGuard)
+      syncGuard(syncGuard),
+      outboundLimits(outboundLimits),
+      creditWindow(creditWindow),
+      ingressThrottle(ingressThrottle),
+      supportedFeatures(supportedFeatures)
 {}
 
 IUeRelay::UePtr UeConnectionFactory::createConnection(ITransportPtr transport)
 {
-    return std::make_unique<UeConnection>(transport, logger, syncGuard);
+    return std::make_unique<UeConnection>(transport, logger, syncGuard, outboundLimits, creditWindow, ingressThrottle,
+                                          supportedFeatures);
 }
 
 }
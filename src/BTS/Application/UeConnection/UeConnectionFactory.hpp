@@ -3,6 +3,10 @@
 #include "IUeConnectionFactory.hpp"
 #include "Logger/ILogger.hpp"
 #include "Synchronization.hpp"
+#include "OutboundQueue.hpp"
+#include "InboundCredits.hpp"
+#include "IngressThrottle.hpp"
+#include "Messages/AttachFeature.hpp"
 
 namespace bts
 {
@@ -11,7 +15,11 @@ class UeConnectionFactory : public IUeConnectionFactory
 {
 public:
     UeConnectionFactory(common::ILogger& logger,
-                        std::shared_ptr<SyncGuard> syncGuard);
+                        std::shared_ptr<SyncGuard> syncGuard,
+                        OutboundQueue::Limits outboundLimits = {},
+                        std::uint16_t creditWindow = InboundCredits::DEFAULT_WINDOW,
+                        std::shared_ptr<IngressThrottle> ingressThrottle = nullptr,
+                        common::AttachFeatures supportedFeatures = common::ALL_ATTACH_FEATURES);
 
     IUeRelay::UePtr createConnection(ITransportPtr transport) override;
 
@@ -19,6 +27,10 @@ private:
     std::shared_ptr<IUeRelay> ueRelay;
     common::ILogger& logger;
     std::shared_ptr<SyncGuard> syncGuard;
+    OutboundQueue::Limits outboundLimits;
+    std::uint16_t creditWindow;
+    std::shared_ptr<IngressThrottle> ingressThrottle;
+    common::AttachFeatures supportedFeatures;
 };
 
 }
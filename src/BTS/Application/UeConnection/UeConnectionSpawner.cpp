@@ -8,44 +8,203 @@ using namespace std::placeholders;
 UeConnectionSpawner::UeConnectionSpawner(IApplicationEnvironment& environment,
                                          std::shared_ptr<IUeConnectionFactory> ueConnectionFactory,
                                          std::shared_ptr<IUeRelay> ueRelay,
-                                         SyncGuardPtr syncGuard)
+                                         SyncGuardPtr syncGuard,
+                                         AdmissionControl::Limits admissionLimits,
+                                         std::chrono::milliseconds admissionTick)
     : environment(environment),
       ueConnectionFactory(ueConnectionFactory),
       ueRelay(ueRelay),
       logger(environment.getLogger(), "[SPAWNER]"),
       btsId(environment.getBtsId()),
-      syncGuard(syncGuard)
+      syncGuard(syncGuard),
+      admission(admissionLimits, AdmissionControl::Clock::now()),
+      ADMISSION_TICK(admissionTick)
 {}
 
 UeConnectionSpawner::~UeConnectionSpawner()
-{}
+{
+    stopAdmission();
+}
 
 void UeConnectionSpawner::start()
 {
     logger.logDebug("Listen to new connections");
     SyncLock lock(*syncGuard);
     environment.registerUeConnectedCallback(std::bind(&UeConnectionSpawner::spawnConnection, this, std::placeholders::_1));
+    environment.registerHandoffCallbacks(std::bind(&UeConnectionSpawner::takeOverConnection, this, std::placeholders::_1),
+                                         std::bind(&UeConnectionSpawner::collectAttachments, this));
+    if (false == admitting.exchange(true))
+    {
+        admitter = std::thread(std::bind(&UeConnectionSpawner::runAdmission, this));
+    }
 }
 
 void UeConnectionSpawner::stop()
 {
     logger.logDebug("Stop listenning to new connections");
+    {
+        SyncLock lock(*syncGuard);
+        environment.registerUeConnectedCallback(nullptr);
+        environment.registerHandoffCallbacks(nullptr, nullptr);
+    }
+    stopAdmission();
+}
+
+void UeConnectionSpawner::stopAdmission()
+{
+    if (true == admitting.exchange(false))
+    {
+        admitter.join();
+    }
     SyncLock lock(*syncGuard);
-    environment.registerUeConnectedCallback(nullptr);
+    for (auto& transport : admission.takeAllPending())
+    {
+        transport->registerDisconnectedCallback(nullptr);
+        transport->registerMessageCallback(nullptr);
+    }
+    earlyMessages.clear();
+}
+
+void UeConnectionSpawner::runAdmission()
+{
+    while (admitting)
+    {
+        std::this_thread::sleep_for(ADMISSION_TICK);
+        {
+            SyncLock lock(*syncGuard);
+            if (admission.pendingCount() == 0u)
+            {
+                continue;
+            }
+        }
+        environment.runInMessageLoop([this, alive = std::weak_ptr<bool>(alive)]
+        {
+            if (not alive.expired())
+            {
+                admitPending();
+            }
+        });
+    }
+}
+
+void UeConnectionSpawner::admitPending()
+{
+    SyncLock lock(*syncGuard);
+    for (auto& transport : admission.admitPending(AdmissionControl::Clock::now()))
+    {
+        admitConnection(std::move(transport));
+    }
 }
 
 
 void UeConnectionSpawner::spawnConnection(ITransportPtr transport)
 {
     logger.logDebug("new connection: ", transport->addressToString());
+
+    SyncLock lock(*syncGuard);
+    switch (admission.onConnected(transport, AdmissionControl::Clock::now()))
+    {
+    case AdmissionControl::Decision::Admit:
+        admitConnection(std::move(transport));
+        break;
+    case AdmissionControl::Decision::Defer:
+        deferConnection(std::move(transport));
+        break;
+    case AdmissionControl::Decision::Reject:
+        logger.logError("too many pending connections, rejected: ", transport->addressToString(),
+                        ", total rejected: ", admission.rejectedCount());
+        // not left connected without SIB - UE sees disconnect and reconnects with backoff
+        transport->close();
+        break;
+    }
+}
+
+void UeConnectionSpawner::admitConnection(ITransportPtr transport)
+{
+    auto newUe = ueConnectionFactory->createConnection(transport);
+    auto* newUePtr = newUe.get();
+
+    SyncLock lock(*syncGuard);
+    auto early = earlyMessages.extract(transport.get());
+    auto ueSlot = ueRelay->add(std::move(newUe));
+    newUePtr->start(ueSlot);
+    if (early)
+    {
+        for (auto& message : early.mapped())
+        {
+            newUePtr->receiveMessage(std::move(message));
+        }
+    }
+    // SIB only now - so attach requests come at admission pace; UE which attached without it knows BTS
+    if (not newUePtr->isAttached())
+    {
+        newUePtr->sendSib(btsId);
+    }
+}
+
+void UeConnectionSpawner::deferConnection(ITransportPtr transport)
+{
+    logger.logDebug("connection deferred: ", transport->addressToString(), ", pending: ", admission.pendingCount());
+    transport->registerDisconnectedCallback([this, pendingTransport = transport.get()]
+    {
+        SyncLock lock(*syncGuard);
+        earlyMessages.erase(pendingTransport);
+        admission.removePending(pendingTransport);
+    });
+    // e.g. attach request of UE reconnecting without waiting for SIB
+    transport->registerMessageCallback([this, pendingTransport = transport.get()](BinaryMessage message)
+    {
+        holdEarlyMessage(pendingTransport, std::move(message));
+    });
+}
+
+void UeConnectionSpawner::holdEarlyMessage(const ITransport* transport, BinaryMessage message)
+{
+    SyncLock lock(*syncGuard);
+    auto& messages = earlyMessages[transport];
+    if (messages.size() >= MAX_EARLY_MESSAGES)
+    {
+        logger.logError("message before admission dropped: ", transport->addressToString());
+        return;
+    }
+    messages.push_back(std::move(message));
+}
+
+void UeConnectionSpawner::takeOverConnection(UeAttachment attachment)
+{
+    auto& [transport, phoneNumber] = attachment;
+    logger.logDebug("connection taken over: ", transport->addressToString(), ", attached as: ", phoneNumber);
     auto newUe = ueConnectionFactory->createConnection(transport);
     auto* newUePtr = newUe.get();
 
     SyncLock lock(*syncGuard);
     auto ueSlot = ueRelay->add(std::move(newUe));
+    if (phoneNumber == PhoneNumber{})
+    {
+        // SIB sent by previous process already
+        newUePtr->start(ueSlot);
+        return;
+    }
+    ueSlot.attach(phoneNumber);
     newUePtr->start(ueSlot);
+    // only number is handed over - on SIB attached UE attaches again, negotiating features and credits
     newUePtr->sendSib(btsId);
 }
 
+UeAttachments UeConnectionSpawner::collectAttachments()
+{
+    SyncLock lock(*syncGuard);
+    UeAttachments attachments;
+    attachments.reserve(ueRelay->count());
+    auto collect = [&attachments](IUeConnection& ue)
+    {
+        attachments.emplace_back(ue.getTransport(), ue.getPhoneNumber());
+    };
+    ueRelay->visitAttachedUe(collect);
+    ueRelay->visitNotAttachedUe(collect);
+    logger.logInfo("handing over ", attachments.size(), " connections");
+    return attachments;
+}
+
 
 }
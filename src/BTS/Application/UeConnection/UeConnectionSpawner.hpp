@@ -6,6 +6,12 @@
 #include "Logger/PrefixedLogger.hpp"
 #include "Synchronization.hpp"
 #include "IComponent.hpp"
+#include "AdmissionControl.hpp"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
 
 namespace bts
 {
@@ -16,14 +22,27 @@ public:
     UeConnectionSpawner(IApplicationEnvironment& environment,
                         std::shared_ptr<IUeConnectionFactory> ueConnectionFactory,
                         std::shared_ptr<IUeRelay> ueRelay,
-                        SyncGuardPtr syncGuard);
+                        SyncGuardPtr syncGuard,
+                        AdmissionControl::Limits admissionLimits = {},
+                        std::chrono::milliseconds admissionTick = std::chrono::milliseconds(20));
     ~UeConnectionSpawner();
 
     void start() override;
     void stop() override;
 
+    // input of deferred connection kept till admission, above that dropped
+    static constexpr std::size_t MAX_EARLY_MESSAGES = 16u;
+
 private:
     void spawnConnection(ITransportPtr transport);
+    void admitConnection(ITransportPtr transport);
+    void deferConnection(ITransportPtr transport);
+    void runAdmission();
+    void admitPending();
+    void holdEarlyMessage(const ITransport* transport, BinaryMessage message);
+    void stopAdmission();
+    void takeOverConnection(UeAttachment attachment);
+    UeAttachments collectAttachments();
 
     IApplicationEnvironment& environment;
     std::shared_ptr<IUeConnectionFactory> ueConnectionFactory;
@@ -31,6 +50,14 @@ private:
     common::PrefixedLogger logger;
     BtsId btsId;
     SyncGuardPtr syncGuard;
+    AdmissionControl admission;
+    const std::chrono::milliseconds ADMISSION_TICK;
+    // by deferred connections, till admitted
+    std::map<const ITransport*, std::vector<BinaryMessage>> earlyMessages;
+    std::atomic_bool admitting{false};
+    std::thread admitter;
+    // admitter only ticks - transports are touched in message loop thread; tasks left there after us do nothing
+    std::shared_ptr<bool> alive = std::make_shared<bool>(true);
 };
 
 }
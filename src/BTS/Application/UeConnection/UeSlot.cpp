@@ -11,6 +11,8 @@ public:
     bool isAttached() const override;
     PhoneNumber getPhoneNumber() const override;
     void remove() override;
+    void trackCall(const common::MessageHeader& header) override;
+    void deliverStored() override;
 };
 
 UeSlot::UeSlot() : UeSlot(std::make_shared<NullImpl>())
@@ -45,6 +47,16 @@ void UeSlot::remove()
     impl->remove();
 }
 
+void UeSlot::trackCall(const common::MessageHeader& header)
+{
+    impl->trackCall(header);
+}
+
+void UeSlot::deliverStored()
+{
+    impl->deliverStored();
+}
+
 bool UeSlot::NullImpl::sendMessage(BinaryMessage message, PhoneNumber to)
 {
     return false;
@@ -69,4 +81,12 @@ void UeSlot::NullImpl::remove()
 {
 }
 
+void UeSlot::NullImpl::trackCall(const common::MessageHeader&)
+{
+}
+
+void UeSlot::NullImpl::deliverStored()
+{
+}
+
 }
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include "UeConnection/IUeConnection.hpp"
+#include "Messages/MessageHeader.hpp"
 
 
 namespace bts
@@ -21,6 +22,14 @@ public:
         virtual bool isAttached() const = 0;
         virtual PhoneNumber getPhoneNumber() const = 0;
         virtual void remove() = 0;
+        /**
+         * Call setup/teardown seen from this UE - see UeRelay call sessions
+         */
+        virtual void trackCall(const common::MessageHeader& header) = 0;
+        /**
+         * Sends messages stored while this UE was not attached - see UeRelay SMS store
+         */
+        virtual void deliverStored() = 0;
     };
 
     UeSlot();
@@ -30,6 +39,8 @@ public:
     bool isAttached() const;
     PhoneNumber getPhoneNumber() const;
     void remove();
+    void trackCall(const common::MessageHeader& header);
+    void deliverStored();
 
 private:
     IImplPtr impl;
@@ -0,0 +1,101 @@
+#include "ConferenceBridge.hpp"
+#include <algorithm>
+
+namespace bts
+{
+
+bool ConferenceBridge::invite(PhoneNumber host, std::optional<PhoneNumber> peer, PhoneNumber invitee)
+{
+    if (isMember(host) and not isHost(host))
+    {
+        return false;
+    }
+    auto conference = conferences.find(host);
+    if (conference == conferences.end())
+    {
+        conference = conferences.emplace(host, Conference{Members{host}, {}}).first;
+        hostOf[host] = host;
+        if (peer)
+        {
+            conference->second.members.push_back(*peer);
+            hostOf[*peer] = host;
+        }
+    }
+    conference->second.invited.insert(invitee);
+    return true;
+}
+
+const ConferenceBridge::Members* ConferenceBridge::join(PhoneNumber invitee, PhoneNumber host)
+{
+    auto conference = conferences.find(host);
+    if (conference == conferences.end() or conference->second.invited.erase(invitee) == 0u or isMember(invitee))
+    {
+        return nullptr;
+    }
+    conference->second.members.push_back(invitee);
+    hostOf[invitee] = host;
+    return &conference->second.members;
+}
+
+bool ConferenceBridge::decline(PhoneNumber invitee, PhoneNumber host)
+{
+    auto conference = conferences.find(host);
+    return conference != conferences.end() and conference->second.invited.erase(invitee) > 0u;
+}
+
+std::optional<ConferenceBridge::Leave> ConferenceBridge::leave(PhoneNumber member)
+{
+    auto host = hostOf.find(member);
+    if (host == hostOf.end())
+    {
+        return std::nullopt;
+    }
+    auto conference = conferences.find(host->second);
+    Leave result{host->second, {}, false};
+    auto& members = conference->second.members;
+    members.erase(std::find(members.begin(), members.end(), member));
+    hostOf.erase(host);
+    result.remaining = members;
+
+    result.ended = member == result.host or members.size() < 2u;
+    if (result.ended)
+    {
+        for (auto remaining : members)
+        {
+            hostOf.erase(remaining);
+        }
+        conferences.erase(conference);
+    }
+    return result;
+}
+
+void ConferenceBridge::forgetInvitations(PhoneNumber phone)
+{
+    for (auto& [host, conference] : conferences)
+    {
+        conference.invited.erase(phone);
+    }
+}
+
+const ConferenceBridge::Members* ConferenceBridge::findMembers(PhoneNumber member) const
+{
+    auto host = hostOf.find(member);
+    return host == hostOf.end() ? nullptr : &conferences.at(host->second).members;
+}
+
+bool ConferenceBridge::isHost(PhoneNumber phone) const
+{
+    return conferences.count(phone) > 0u;
+}
+
+bool ConferenceBridge::isMember(PhoneNumber phone) const
+{
+    return hostOf.count(phone) > 0u;
+}
+
+std::size_t ConferenceBridge::count() const
+{
+    return conferences.size();
+}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+#include "Messages/PhoneNumber.hpp"
+
+namespace bts
+{
+
+using common::PhoneNumber;
+
+/**
+ * Membership of conference calls - host invites participants one by one,
+ * CallTalk of any member goes to all others (see UeRelay).
+ * Host leaving ends the conference, as does leaving of the last participant.
+ */
+class ConferenceBridge
+{
+public:
+    using Members = std::vector<PhoneNumber>; // host first
+
+    struct Leave
+    {
+        PhoneNumber host;
+        Members remaining;
+        bool ended;
+    };
+
+    /**
+     * @param peer other side of host 1:1 call - it becomes first participant of new conference
+     * @return false when host is participant of other conference
+     */
+    bool invite(PhoneNumber host, std::optional<PhoneNumber> peer, PhoneNumber invitee);
+    /**
+     * @return members after join - nullptr when invitee was not invited by host
+     */
+    const Members* join(PhoneNumber invitee, PhoneNumber host);
+    /**
+     * @return true when there was such invitation
+     */
+    bool decline(PhoneNumber invitee, PhoneNumber host);
+    std::optional<Leave> leave(PhoneNumber member);
+    /**
+     * Forgets invitations of or to phone - when it detaches
+     */
+    void forgetInvitations(PhoneNumber phone);
+
+    const Members* findMembers(PhoneNumber member) const;
+    bool isHost(PhoneNumber phone) const;
+    bool isMember(PhoneNumber phone) const;
+    std::size_t count() const;
+
+private:
+    struct Conference
+    {
+        Members members;
+        std::set<PhoneNumber> invited;
+    };
+
+    std::map<PhoneNumber, Conference> conferences; // by host
+    std::map<PhoneNumber, PhoneNumber> hostOf;     // by member
+};
+
+}
@@ -0,0 +1,128 @@
+#include "SmsStore.hpp"
+
+namespace bts
+{
+
+SmsStore::SmsStore()
+    : SmsStore(Limits{})
+{}
+
+SmsStore::SmsStore(Limits limits)
+    : limits(limits)
+{}
+
+bool SmsStore::isEnabled() const
+{
+    return limits.perRecipient > 0u;
+}
+
+bool SmsStore::store(common::PhoneNumber to, common::BinaryMessage message, Clock::time_point now)
+{
+    if (not isEnabled())
+    {
+        return false;
+    }
+    const std::size_t size = message.value.size();
+    if (bytes + size > limits.totalBytes)
+    {
+        // full sweep only when it can help
+        forgetExpired(now);
+        if (bytes + size > limits.totalBytes)
+        {
+            return false;
+        }
+    }
+    auto& queue = queues[to];
+    forgetExpired(queue, now);
+    if (queue.size() >= limits.perRecipient)
+    {
+        return false;
+    }
+    queue.push_back(Entry{std::move(message), now + limits.ttl});
+    ++count;
+    bytes += size;
+    return true;
+}
+
+std::vector<common::BinaryMessage> SmsStore::take(common::PhoneNumber to, Clock::time_point now)
+{
+    std::vector<common::BinaryMessage> messages;
+    auto queue = queues.find(to);
+    if (queue == queues.end())
+    {
+        return messages;
+    }
+    forgetExpired(queue->second, now);
+    messages.reserve(queue->second.size());
+    for (auto& entry : queue->second)
+    {
+        --count;
+        bytes -= entry.message.value.size();
+        messages.push_back(std::move(entry.message));
+    }
+    queues.erase(queue);
+    return messages;
+}
+
+std::size_t SmsStore::deliver(common::PhoneNumber to, Clock::time_point now, const Send& send)
+{
+    auto queue = queues.find(to);
+    if (queue == queues.end())
+    {
+        return 0u;
+    }
+    forgetExpired(queue->second, now);
+    std::size_t sent = 0u;
+    while (not queue->second.empty())
+    {
+        auto& entry = queue->second.front();
+        if (not send(entry.message))
+        {
+            return sent;
+        }
+        --count;
+        bytes -= entry.message.value.size();
+        queue->second.pop_front();
+        ++sent;
+    }
+    queues.erase(queue);
+    return sent;
+}
+
+std::size_t SmsStore::storedCount() const
+{
+    return count;
+}
+
+std::size_t SmsStore::storedBytes() const
+{
+    return bytes;
+}
+
+std::size_t SmsStore::expiredCount() const
+{
+    return expired;
+}
+
+void SmsStore::forgetExpired(Queue& queue, Clock::time_point now)
+{
+    // ttl is the same for all - so queue is ordered by expiry
+    while (not queue.empty() and queue.front().expiry <= now)
+    {
+        --count;
+        bytes -= queue.front().message.value.size();
+        ++expired;
+        queue.pop_front();
+    }
+}
+
+void SmsStore::forgetExpired(Clock::time_point now)
+{
+    for (auto queue = queues.begin(); queue != queues.end(); )
+    {
+        forgetExpired(queue->second, now);
+        queue = queue->second.empty() ? queues.erase(queue) : std::next(queue);
+    }
+}
+
+}
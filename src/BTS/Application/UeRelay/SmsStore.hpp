@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <vector>
+#include "Messages/BinaryMessage.hpp"
+#include "Messages/PhoneNumber.hpp"
+
+namespace bts
+{
+
+/**
+ * Store-and-forward for SMS sent to UE not attached at the moment.
+ * Bounded per recipient (messages) and in total (bytes) - above that messages are refused,
+ * each message expires after ttl.
+ */
+class SmsStore
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Limits
+    {
+        std::size_t perRecipient = 16u; // 0 - store disabled
+        std::size_t totalBytes = 1024u * 1024u;
+        std::chrono::seconds ttl = std::chrono::hours(1);
+    };
+
+    SmsStore();
+    explicit SmsStore(Limits limits);
+
+    bool isEnabled() const;
+    /**
+     * @return false when refused - over limits or disabled
+     */
+    bool store(common::PhoneNumber to, common::BinaryMessage message, Clock::time_point now);
+    /**
+     * @return all not expired messages for recipient - in order of storing
+     */
+    std::vector<common::BinaryMessage> take(common::PhoneNumber to, Clock::time_point now);
+    using Send = std::function<bool(common::BinaryMessage)>;
+    /**
+     * Sends not expired messages for recipient in order of storing, stops on first not sent one -
+     * it and the rest stay stored.
+     * @return number of sent messages
+     */
+    std::size_t deliver(common::PhoneNumber to, Clock::time_point now, const Send& send);
+
+    std::size_t storedCount() const;
+    std::size_t storedBytes() const;
+    std::size_t expiredCount() const;
+
+private:
+    struct Entry
+    {
+        common::BinaryMessage message;
+        Clock::time_point expiry;
+    };
+    using Queue = std::deque<Entry>;
+
+    void forgetExpired(Queue& queue, Clock::time_point now);
+    void forgetExpired(Clock::time_point now);
+
+    const Limits limits;
+    std::map<common::PhoneNumber, Queue> queues;
+    std::size_t count = 0u;
+    std::size_t bytes = 0u;
+    std::size_t expired = 0u;
+};
+
+}
@@ -1,4 +1,6 @@
 #include "UeRelay.hpp"
+#include "Messages/OutgoingMessage.hpp"
+#include <algorithm>
 
 namespace bts
 {
@@ -8,6 +10,8 @@ class UeRelay::UeSlotBase : public UeSlot::IImpl
 public:
     UeSlotBase(UeRelay& relay);
     bool sendMessage(BinaryMessage message, PhoneNumber to) override;
+    void trackCall(const common::MessageHeader& header) override;
+    void deliverStored() override;
 protected:
     UeRelay& relay;
     template <typename ...Arg>
@@ -45,8 +49,9 @@ private:
 };
 
 
-UeRelay::UeRelay(common::ILogger &logger)
-    : logger(logger, "[RELAY]")
+UeRelay::UeRelay(common::ILogger &logger, SmsStore::Limits smsStoreLimits)
+    : smsStore(smsStoreLimits),
+      logger(logger, "[RELAY]")
 {}
 
 UeSlot UeRelay::add(UePtr ue)
@@ -56,16 +61,300 @@ UeSlot UeRelay::add(UePtr ue)
 
 bool UeRelay::sendMessage(BinaryMessage message, PhoneNumber to)
 {
+    if (fanOutConferenceTalk(message))
+    {
+        return true;
+    }
     auto ueSlot = attachedUe.find(to);
     if (ueSlot == attachedUe.end())
     {
+        if (storeSms(message, to))
+        {
+            return true;
+        }
         logger.logError("Connection does not exist for: ", to);
         return false;
     }
-    ueSlot->second->sendMessage(message);
+    return ueSlot->second->sendMessage(message);
+}
+
+bool UeRelay::storeSms(const BinaryMessage& message, PhoneNumber to)
+{
+    if (message.value.empty() or message.value[0] != common::get(common::MessageId::Sms))
+    {
+        return false;
+    }
+    if (not smsStore.store(to, message, SmsStore::Clock::now()))
+    {
+        if (smsStore.isEnabled())
+        {
+            logger.logError("SMS store full, refused for: ", to);
+        }
+        return false;
+    }
+    logger.logDebug("SMS stored for: ", to, ", total stored: ", smsStore.storedCount());
     return true;
 }
 
+void UeRelay::deliverStored(PhoneNumber phone)
+{
+    auto* ue = findAttached(phone);
+    if (not ue)
+    {
+        return;
+    }
+    bool refused = false;
+    const auto sent = smsStore.deliver(phone, SmsStore::Clock::now(), [ue, &refused](BinaryMessage message)
+    {
+        refused = not ue->sendMessage(std::move(message));
+        return not refused;
+    });
+    if (sent > 0u)
+    {
+        logger.logInfo("Delivered stored SMS: ", sent, ", to: ", phone);
+    }
+    if (refused)
+    {
+        logger.logError("Stored SMS not delivered, kept for next attach of: ", phone);
+    }
+}
+
+IUeConnection* UeRelay::findAttached(PhoneNumber phone)
+{
+    auto ueSlot = attachedUe.find(phone);
+    return ueSlot == attachedUe.end() ? nullptr : ueSlot->second.get();
+}
+
+void UeRelay::trackCall(const common::MessageHeader& header)
+{
+    using common::MessageId;
+    switch (header.messageId)
+    {
+    case MessageId::CallRequest:
+        ringingCalls[header.from] = header.to;
+        break;
+    case MessageId::ConferenceInvite:
+        inviteToConference(header.from, header.to);
+        break;
+    case MessageId::CallAccepted:
+    {
+        if (joinConference(header.from, header.to))
+        {
+            break;
+        }
+        auto call = ringingCalls.find(header.to);
+        if (call != ringingCalls.end() and call->second == header.from)
+        {
+            ringingCalls.erase(call);
+            establishCall(header.to, header.from);
+        }
+        break;
+    }
+    case MessageId::CallDropped:
+    {
+        const auto* members = conferenceBridge.findMembers(header.from);
+        if (members and std::find(members->begin(), members->end(), header.to) != members->end())
+        {
+            leaveConference(header.from, header.to);
+        }
+        else if (not conferenceBridge.decline(header.from, header.to))
+        {
+            endCall(header.from, header.to);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void UeRelay::establishCall(PhoneNumber caller, PhoneNumber callee)
+{
+    endCallsOf(caller);
+    endCallsOf(callee);
+    establishedCalls[caller] = callee;
+    establishedCalls[callee] = caller;
+    setTalkPeer(caller, findAttached(callee));
+    setTalkPeer(callee, findAttached(caller));
+    logger.logDebug("Call established: ", caller, " - ", callee);
+}
+
+void UeRelay::endCall(PhoneNumber phone, PhoneNumber peer)
+{
+    auto call = establishedCalls.find(phone);
+    if (call != establishedCalls.end() and call->second == peer)
+    {
+        establishedCalls.erase(call);
+        establishedCalls.erase(peer);
+        setTalkPeer(phone, nullptr);
+        setTalkPeer(peer, nullptr);
+        logger.logDebug("Call ended: ", phone, " - ", peer);
+    }
+    // dropped by caller or rejected by callee
+    auto ringing = ringingCalls.find(phone);
+    if (ringing != ringingCalls.end() and ringing->second == peer)
+    {
+        ringingCalls.erase(ringing);
+    }
+    ringing = ringingCalls.find(peer);
+    if (ringing != ringingCalls.end() and ringing->second == phone)
+    {
+        ringingCalls.erase(ringing);
+    }
+}
+
+void UeRelay::endCallsOf(PhoneNumber phone)
+{
+    leaveConference(phone, std::nullopt);
+    conferenceBridge.forgetInvitations(phone);
+    // peers are told at once - not when their call timers expire
+    auto call = establishedCalls.find(phone);
+    if (call != establishedCalls.end())
+    {
+        const PhoneNumber peer = call->second;
+        endCall(phone, peer);
+        sendCallDropped(phone, peer);
+    }
+    for (auto ringing = ringingCalls.begin(); ringing != ringingCalls.end(); )
+    {
+        if (ringing->first == phone or ringing->second == phone)
+        {
+            const PhoneNumber peer = ringing->first == phone ? ringing->second : ringing->first;
+            ringing = ringingCalls.erase(ringing);
+            sendCallDropped(phone, peer);
+        }
+        else
+        {
+            ++ringing;
+        }
+    }
+}
+
+void UeRelay::inviteToConference(PhoneNumber host, PhoneNumber invitee)
+{
+    std::optional<PhoneNumber> peer;
+    if (not conferenceBridge.isMember(host))
+    {
+        auto call = establishedCalls.find(host);
+        if (call == establishedCalls.end())
+        {
+            logger.logError("Conference invite outside of call ignored, from: ", host);
+            return;
+        }
+        // from now on talk is fanned out by relay - no direct handles
+        peer = call->second;
+        establishedCalls.erase(call);
+        establishedCalls.erase(*peer);
+        setTalkPeer(host, nullptr);
+        setTalkPeer(*peer, nullptr);
+    }
+    if (not conferenceBridge.invite(host, peer, invitee))
+    {
+        logger.logError("Conference invite from participant ignored, from: ", host);
+        return;
+    }
+    logger.logDebug("Conference invite: ", host, " -> ", invitee);
+}
+
+bool UeRelay::joinConference(PhoneNumber invitee, PhoneNumber host)
+{
+    const auto* members = conferenceBridge.join(invitee, host);
+    if (not members)
+    {
+        return false;
+    }
+    logger.logInfo("Conference of: ", host, " joined by: ", invitee, ", members: ", members->size());
+    sendConferenceMembers(*members);
+    return true;
+}
+
+void UeRelay::leaveConference(PhoneNumber member, std::optional<PhoneNumber> alreadyTold)
+{
+    auto left = conferenceBridge.leave(member);
+    if (not left)
+    {
+        return;
+    }
+    if (not left->ended)
+    {
+        logger.logInfo("Conference of: ", left->host, " left by: ", member, ", members: ", left->remaining.size());
+        sendConferenceMembers(left->remaining);
+        return;
+    }
+    logger.logInfo("Conference of: ", left->host, " ended by: ", member);
+    for (auto remaining : left->remaining)
+    {
+        if (remaining != alreadyTold)
+        {
+            sendCallDropped(member, remaining);
+        }
+    }
+}
+
+bool UeRelay::fanOutConferenceTalk(BinaryMessage& message)
+{
+    auto& bytes = message.value;
+    if (bytes.size() < 3u or bytes[0] != common::get(common::MessageId::CallTalk))
+    {
+        return false;
+    }
+    const PhoneNumber from{bytes[1]};
+    const auto* members = conferenceBridge.findMembers(from);
+    if (not members)
+    {
+        return false;
+    }
+    sendToEach(message, *members, from);
+    return true;
+}
+
+void UeRelay::sendConferenceMembers(const ConferenceBridge::Members& members)
+{
+    common::OutgoingMessage builder(common::MessageId::ConferenceMembers, PhoneNumber{}, PhoneNumber{});
+    builder.writeNumber(static_cast<std::uint8_t>(members.size()));
+    for (auto member : members)
+    {
+        builder.writePhoneNumber(member);
+    }
+    BinaryMessage message = builder.getMessage();
+    sendToEach(message, members, PhoneNumber{});
+}
+
+void UeRelay::sendToEach(BinaryMessage& message, const ConferenceBridge::Members& receivers, PhoneNumber except)
+{
+    constexpr std::size_t TO_POSITION = 2u;
+    for (auto receiver : receivers)
+    {
+        if (receiver == except)
+        {
+            continue;
+        }
+        if (auto* ue = findAttached(receiver))
+        {
+            message.value[TO_POSITION] = receiver.value;
+            ue->sendMessage(message);
+        }
+    }
+}
+
+void UeRelay::setTalkPeer(PhoneNumber phone, IUeConnection* peer)
+{
+    if (auto* ue = findAttached(phone))
+    {
+        ue->setTalkPeer(peer);
+    }
+}
+
+void UeRelay::sendCallDropped(PhoneNumber from, PhoneNumber to)
+{
+    if (auto* ue = findAttached(to))
+    {
+        logger.logInfo("Call dropped on behalf of: ", from, ", sent to: ", to);
+        common::OutgoingMessage callDropped(common::MessageId::CallDropped, from, to);
+        ue->sendMessage(callDropped.getMessage());
+    }
+}
+
 std::size_t UeRelay::count() const
 {
     return countAttached() + countNotAttached();
@@ -118,6 +407,19 @@ bool UeRelay::UeSlotBase::sendMessage(BinaryMessage message, PhoneNumber to)
     return relay.sendMessage(std::move(message), to);
 }
 
+void UeRelay::UeSlotBase::trackCall(const common::MessageHeader& header)
+{
+    relay.trackCall(header);
+}
+
+void UeRelay::UeSlotBase::deliverStored()
+{
+    if (isAttached())
+    {
+        relay.deliverStored(getPhoneNumber());
+    }
+}
+
 UeRelay::UeSlotAdded::UeSlotAdded(UeRelay &relay, UePtr ue)
     : UeSlotBase(relay),
       whereAdded(relay.notAttachedUe.insert(relay.notAttachedUe.begin(), std::move(ue)))
@@ -170,6 +472,7 @@ UeSlot::IImplPtr UeRelay::UeSlotAttached::attach(PhoneNumber phone)
         return shared_from_this();
     }
 
+    relay.endCallsOf(whereAdded->first);
     UePtr ue = std::move(whereAdded->second);
     struct EraseOnExit
     {
@@ -209,6 +512,7 @@ PhoneNumber UeRelay::UeSlotAttached::getPhoneNumber() const
 
 void UeRelay::UeSlotAttached::remove()
 {
+    relay.endCallsOf(whereAdded->first);
     UePtr ue = std::move(whereAdded->second);
     logDebug("Removed attached: ", *ue);
     relay.attachedUe.erase(whereAdded);
@@ -5,6 +5,8 @@
 #include <memory>
 #include <tuple>
 #include "IUeRelay.hpp"
+#include "SmsStore.hpp"
+#include "ConferenceBridge.hpp"
 #include "Logger/PrefixedLogger.hpp"
 
 namespace bts
@@ -13,7 +15,7 @@ namespace bts
 class UeRelay : public IUeRelay
 {
 public:
-    UeRelay(common::ILogger& logger);
+    UeRelay(common::ILogger& logger, SmsStore::Limits smsStoreLimits = {});
 
     UeSlot add(UePtr) override;
 
@@ -36,9 +38,33 @@ private:
     using AttachedUe = std::map<PhoneNumber, UePtr>;
     using NotAttachedUe = std::list<UePtr>;
 
+    // call sessions - caller to callee while ringing, both directions when established
+    void trackCall(const common::MessageHeader& header);
+    void establishCall(PhoneNumber caller, PhoneNumber callee);
+    void endCall(PhoneNumber phone, PhoneNumber peer);
+    void endCallsOf(PhoneNumber phone);
+    void setTalkPeer(PhoneNumber phone, IUeConnection* peer);
+    void sendCallDropped(PhoneNumber from, PhoneNumber to);
+    IUeConnection* findAttached(PhoneNumber phone);
+
+    void inviteToConference(PhoneNumber host, PhoneNumber invitee);
+    bool joinConference(PhoneNumber invitee, PhoneNumber host);
+    void leaveConference(PhoneNumber member, std::optional<PhoneNumber> alreadyTold);
+    bool fanOutConferenceTalk(BinaryMessage& message);
+    void sendConferenceMembers(const ConferenceBridge::Members& members);
+    // every receiver gets the same message - only "to" of header differs
+    void sendToEach(BinaryMessage& message, const ConferenceBridge::Members& receivers, PhoneNumber except);
+
+    bool storeSms(const BinaryMessage& message, PhoneNumber to);
+    void deliverStored(PhoneNumber phone);
+
 
     AttachedUe attachedUe;
     NotAttachedUe notAttachedUe;
+    std::map<PhoneNumber, PhoneNumber> ringingCalls;
+    std::map<PhoneNumber, PhoneNumber> establishedCalls;
+    SmsStore smsStore;
+    ConferenceBridge conferenceBridge;
     common::PrefixedLogger logger;
 
 };
@@ -18,9 +18,22 @@ public:
 
     virtual IConsole& getConsole() = 0;
     virtual void registerUeConnectedCallback(UeConnectedCallback) = 0;
+
+    /**
+     * Restart without dropping UE connections:
+     *  - UeTakenOverCallback is called for each UE connection received from previous BTS process,
+     *  - UeAttachmentsProvider is asked for all UE connections when they are handed over to next BTS process.
+     */
+    virtual void registerHandoffCallbacks(UeTakenOverCallback, UeAttachmentsProvider) = 0;
     virtual ILogger& getLogger() = 0;
     virtual BtsId getBtsId() const = 0;
     virtual std::string getAddress() const = 0;
+    virtual std::int32_t getProperty(std::string const& name, std::int32_t defaultValue) const = 0;
+    /**
+     * Task is run later in message loop thread - the one calling back from transports.
+     * Thread-safe.
+     */
+    virtual void runInMessageLoop(std::function<void()> task) = 0;
 
     virtual void startMessageLoop() = 0;
 };
@@ -2,6 +2,8 @@
 
 #include <memory>
 #include <functional>
+#include <utility>
+#include <vector>
 #include "CommonEnvironment/ITransport.hpp"
 #include "Messages.hpp"
 
@@ -10,7 +12,14 @@ namespace bts
 
 using common::ITransport;
 using common::BinaryMessage;
+using common::PhoneNumber;
 using ITransportPtr = std::shared_ptr<ITransport>;
 using UeConnectedCallback=std::function<void(ITransportPtr)>;
 
+// connection of UE to BTS process, with number the UE is attached as - or PhoneNumber{} when not attached
+using UeAttachment = std::pair<ITransportPtr, PhoneNumber>;
+using UeAttachments = std::vector<UeAttachment>;
+using UeTakenOverCallback=std::function<void(UeAttachment)>;
+using UeAttachmentsProvider=std::function<UeAttachments()>;
+
 }
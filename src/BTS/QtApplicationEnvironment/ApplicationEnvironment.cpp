@@ -14,12 +14,14 @@ namespace bts
 
 ApplicationEnvironment::ApplicationEnvironment(int& argc, char* argv[])
     : configuration(ApplicationEnvironment::readConfiguration(argc, argv)),
-      btsId(BtsId{configuration->getNumber("id", generateBtsId().value)}),
+      takenOver(QtTransportEnvironment::requestHandoff(*configuration)),
+      // UEs shall not notice restart
+      btsId(takenOver ? BtsId{takenOver->id} : BtsId{configuration->getNumber("id", generateBtsId().value)}),
       logFile(logFilename(btsId)),
       logger(logFile),
       qApplication(argc, argv),
       console(logger),
-      transportEnvironment(logger, *configuration)
+      transportEnvironment(logger, *configuration, btsId, std::move(takenOver))
 {
     QObject::connect(&console, SIGNAL(quit()), &qApplication, SLOT(quit()));
 }
@@ -34,6 +36,11 @@ void ApplicationEnvironment::registerUeConnectedCallback(UeConnectedCallback new
     transportEnvironment.registerUeConnectedCallback(newCallback);
 }
 
+void ApplicationEnvironment::registerHandoffCallbacks(UeTakenOverCallback ueTakenOverCallback, UeAttachmentsProvider ueAttachmentsProvider)
+{
+    transportEnvironment.registerHandoffCallbacks(ueTakenOverCallback, ueAttachmentsProvider);
+}
+
 ILogger &ApplicationEnvironment::getLogger()
 {
     return logger;
@@ -49,6 +56,16 @@ std::string ApplicationEnvironment::getAddress() const
     return transportEnvironment.getAddress();
 }
 
+std::int32_t ApplicationEnvironment::getProperty(std::string const& name, std::int32_t defaultValue) const
+{
+    return configuration->getNumber<std::int32_t>(name, defaultValue);
+}
+
+void ApplicationEnvironment::runInMessageLoop(std::function<void()> task)
+{
+    QMetaObject::invokeMethod(&qApplication, std::move(task), Qt::QueuedConnection);
+}
+
 void ApplicationEnvironment::startMessageLoop()
 {
     std::thread consoleThread([this] {
@@ -60,6 +77,12 @@ void ApplicationEnvironment::startMessageLoop()
     transportEnvironment.exec();
     qApplication.exec();
     logger.logDebug("Application loop finished");
+    if (transportEnvironment.isHandedOver())
+    {
+        // console of new BTS instance takes over, this one stays blocked on input
+        consoleThread.detach();
+        return;
+    }
     consoleThread.join();
 }
 
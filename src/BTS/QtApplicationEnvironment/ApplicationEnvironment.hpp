@@ -7,6 +7,7 @@
 #include "Config/MultiLineConfig.hpp"
 #include "Transport/QtTransportEnvironment.hpp"
 #include <fstream>
+#include <optional>
 
 namespace bts
 {
@@ -17,15 +18,19 @@ public:
     ApplicationEnvironment(int& argc, char* argv[]);
     IConsole& getConsole() override;
     void registerUeConnectedCallback(UeConnectedCallback) override;
+    void registerHandoffCallbacks(UeTakenOverCallback, UeAttachmentsProvider) override;
     ILogger& getLogger() override;
     BtsId getBtsId() const override;
     std::string getAddress() const override;
+    std::int32_t getProperty(std::string const& name, std::int32_t defaultValue) const override;
+    void runInMessageLoop(std::function<void()> task) override;
 
 
     void startMessageLoop() override;
 
 private:
     std::unique_ptr<common::MultiLineConfig> configuration;
+    std::optional<common::HandoffState> takenOver;
     BtsId btsId;
     std::ofstream logFile;
     common::Logger logger;
@@ -0,0 +1,71 @@
+#include "QtShmTransport.hpp"
+#include <QThread>
+
+namespace bts
+{
+
+QtShmTransport::QtShmTransport(common::ILogger &logger, common::ShmChannel channel)
+    : common::ShmTransport(logger, std::move(channel)),
+      doorbellNotifier(watch(doorbellFd())),
+      controlNotifier(watch(controlFd()))
+{
+    registerDisconnectedCallback(nullptr);
+}
+
+QtShmTransport::~QtShmTransport()
+{
+    // notifiers are deleted later - they might be the ones which called us
+    doorbellNotifier->setEnabled(false);
+    controlNotifier->setEnabled(false);
+    QObject::disconnect(doorbellNotifier.get(), nullptr, this, nullptr);
+    QObject::disconnect(controlNotifier.get(), nullptr, this, nullptr);
+}
+
+bool QtShmTransport::sendMessage(BinaryMessage message)
+{
+    // rings are single producer - all writes from Qt thread, as in QtTransport
+    if (QThread::currentThread() == thread())
+    {
+        return common::ShmTransport::sendMessage(std::move(message));
+    }
+    return QMetaObject::invokeMethod(this, [this, message = std::move(message)]
+    {
+        common::ShmTransport::sendMessage(message);
+    }, Qt::QueuedConnection);
+}
+
+void QtShmTransport::close()
+{
+    // descriptors are closed below - not to be watched anymore
+    doorbellNotifier->setEnabled(false);
+    controlNotifier->setEnabled(false);
+    common::ShmTransport::close();
+}
+
+void QtShmTransport::registerDisconnectedCallback(DisconnectedCallback disconnectedCallback)
+{
+    common::ShmTransport::registerDisconnectedCallback([this, disconnectedCallback]
+    {
+        // hangup stays readable - stop watching before application possibly drops us
+        doorbellNotifier->setEnabled(false);
+        controlNotifier->setEnabled(false);
+        if (disconnectedCallback)
+        {
+            disconnectedCallback();
+        }
+    });
+}
+
+QtShmTransport::Notifier QtShmTransport::watch(int fd)
+{
+    Notifier notifier(new QSocketNotifier(fd, QSocketNotifier::Read));
+    QObject::connect(notifier.get(), &QSocketNotifier::activated, this, &QtShmTransport::handleActivated);
+    return notifier;
+}
+
+void QtShmTransport::handleActivated()
+{
+    poll();
+}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QObject>
+#include <memory>
+#include <QSocketNotifier>
+#include "ITransport.hpp"
+#include "Transport/ShmTransport.hpp"
+
+namespace bts
+{
+
+/**
+ * common::ShmTransport driven by Qt event loop of BTS.
+ */
+class QtShmTransport : public QObject, public common::ShmTransport
+{
+    Q_OBJECT;
+public:
+    QtShmTransport(common::ILogger& logger, common::ShmChannel channel);
+    ~QtShmTransport();
+
+    void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
+    bool sendMessage(BinaryMessage message) override;
+    void close() override;
+
+private:
+    struct DeleteLater
+    {
+        void operator()(QObject* object) const { object->deleteLater(); }
+    };
+    using Notifier = std::unique_ptr<QSocketNotifier, DeleteLater>;
+
+    Notifier watch(int fd);
+    void handleActivated();
+
+    Notifier doorbellNotifier;
+    Notifier controlNotifier;
+};
+
+}
@@ -1,26 +1,34 @@
 #include "QtTransport.hpp"
 #include <QTcpSocket>
 #include <QHostAddress>
-#include "Messages/OutgoingMessage.hpp"
-#include "Messages/IncomingMessage.hpp"
+#include <fcntl.h>
 
 namespace bts
 {
 
-QtTransport::QtTransport(common::ILogger &logger, QAbstractSocket *socket)
+QtTransport::QtTransport(common::ILogger &logger, QAbstractSocket *socket, std::string address)
     : logger(logger),
-      socket(socket)
+      socket(socket),
+      address(address.empty() ? socket->peerAddress().toString().toStdString() + "-" + std::to_string(socket->peerPort())
+                              : std::move(address))
 {
     QObject::connect(socket, &QAbstractSocket::readyRead, std::bind(&QtTransport::readMessageFromSocket, this));
     QObject::connect(socket, &QAbstractSocket::disconnected, std::bind(&QtTransport::handleClosingConnection, this));
+    QObject::connect(socket, &QAbstractSocket::bytesWritten, std::bind(&QtTransport::updateBackpressure, this));
     QObject::connect(this, SIGNAL(sendMessageSignal(QByteArray)), this, SLOT(sendMessageSlot(QByteArray)));
 }
 
 QtTransport::~QtTransport()
+{
+    disconnectSocket();
+    logger.logDebug("QtTransport: bye");
+}
+
+void QtTransport::disconnectSocket()
 {
     QObject::disconnect(socket, &QAbstractSocket::readyRead, 0, 0);
     QObject::disconnect(socket, &QAbstractSocket::disconnected, 0, 0);
-    logger.logDebug("QtTransport: bye");
+    QObject::disconnect(socket, &QAbstractSocket::bytesWritten, 0, 0);
 }
 
 void QtTransport::registerMessageCallback(ITransport::MessageCallback messageCallback)
@@ -33,29 +41,96 @@ void QtTransport::registerDisconnectedCallback(ITransport::DisconnectedCallback
     this->disconnectedCallback = disconnectedCallback;
 }
 
-bool QtTransport::sendMessage(BinaryMessage message)
+void QtTransport::registerBackpressureCallback(ITransport::BackpressureCallback backpressureCallback)
 {
-    common::OutgoingMessage sizeEncoder;
-    sizeEncoder.writeNumber<BinaryMessage::SizeType>(message.value.size());
-    BinaryMessage size = sizeEncoder.getMessage();
+    this->backpressureCallback = backpressureCallback;
+}
 
-    QByteArray array{};
-    array.append(reinterpret_cast<char*>(size.value.data()), size.value.size());
-    array.append(reinterpret_cast<char*>(message.value.data()), message.value.size());
+bool QtTransport::sendMessage(BinaryMessage message)
+{
+    const common::FrameBytes frame = common::encodeFrame(message);
+    QByteArray array(reinterpret_cast<const char*>(frame.data()), frame.size());
     return emit sendMessageSignal(std::move(array));
 }
 
 bool QtTransport::sendMessageSlot(QByteArray message)
 {
+    if (handedOver)
+    {
+        logger.logDebug("Message to: ", addressToString(), " dropped, connection handed over");
+        return false;
+    }
+    if (closed)
+    {
+        logger.logDebug("Message to: ", addressToString(), " dropped, connection closed");
+        return false;
+    }
     logger.logDebug("Send message to: ", addressToString());
     socket->write(std::move(message));
     socket->flush();
+    updateBackpressure();
     return true;
 }
 
+void QtTransport::updateBackpressure()
+{
+    const qint64 pending = socket->bytesToWrite();
+    const bool nowCongested = congested ? pending > LOW_WATERMARK
+                                        : pending > HIGH_WATERMARK;
+    if (nowCongested == congested)
+    {
+        return;
+    }
+    congested = nowCongested;
+    logger.logDebug("Connection to: ", addressToString(), (congested ? " congested" : " relieved"),
+                    ", bytes to write: ", pending);
+    if (backpressureCallback)
+    {
+        backpressureCallback(congested);
+    }
+}
+
+void QtTransport::close()
+{
+    disconnectSocket();
+    closed = true;
+    logger.logDebug("Close connection to: ", addressToString());
+    socket->abort();
+    // socket of listening server is its child till then - released together with us now
+    socket->setParent(this);
+}
+
 std::string QtTransport::addressToString() const
 {
-    return socket->peerAddress().toString().toStdString() + "-" + std::to_string(socket->peerPort());
+    return address;
+}
+
+void QtTransport::receivePending(const common::FrameBytes& pendingInput)
+{
+    feedDecoder(pendingInput.data(), pendingInput.size());
+}
+
+int QtTransport::handOver(common::FrameBytes& pendingInput)
+{
+    disconnectSocket();
+    handedOver = true;
+    // whatever was written shall reach UE before new owner writes anything
+    while (socket->bytesToWrite() > 0 and socket->waitForBytesWritten(HANDOVER_WRITE_TIMEOUT_MS))
+    {}
+    if (socket->bytesToWrite() > 0)
+    {
+        logger.logError("Connection to: ", addressToString(), " handed over with ", socket->bytesToWrite(), " bytes not sent");
+    }
+
+    const common::FrameBytes incompleteFrame = frameDecoder.takeBuffered();
+    pendingInput.insert(pendingInput.end(), incompleteFrame.begin(), incompleteFrame.end());
+    const QByteArray unread = socket->readAll();
+    pendingInput.insert(pendingInput.end(), unread.begin(), unread.end());
+
+    // closing own descriptor is not noticed by peer while duplicate is open
+    const int duplicate = ::fcntl(socket->socketDescriptor(), F_DUPFD_CLOEXEC, 0);
+    socket->abort();
+    return duplicate;
 }
 
 void QtTransport::handleClosingConnection()
@@ -73,34 +148,33 @@ void QtTransport::handleClosingConnection()
 
 void QtTransport::readMessageFromSocket()
 {
-    const std::size_t sizeSize = sizeof(BinaryMessage::SizeType);
-    quint64 bytesAvailable;
-    while ((bytesAvailable = socket->bytesAvailable()) >= sizeSize)
+    const QByteArray bytes = socket->readAll();
+    feedDecoder(reinterpret_cast<const std::uint8_t*>(bytes.constData()), bytes.size());
+}
+
+void QtTransport::feedDecoder(const std::uint8_t* data, std::size_t size)
+{
+    try
+    {
+        frameDecoder.feed(data, size, std::bind(&QtTransport::handleMessage, this, std::placeholders::_1));
+    }
+    catch (common::FrameDecoder::FrameEx& ex)
+    {
+        logger.logError("Stream from: ", addressToString(), " corrupted: ", ex.what());
+    }
+}
+
+void QtTransport::handleMessage(BinaryMessage message)
+{
+    logger.logDebug("Message received from: ", addressToString(), " body: ", message);
+
+    if (messageCallback)
+    {
+        messageCallback(std::move(message));
+    }
+    else
     {
-        BinaryMessage sizeEncoded{ BinaryMessage::Value(sizeSize) };
-        socket->read(reinterpret_cast<char*>(sizeEncoded.value.data()), sizeSize);
-        common::IncomingMessage sizeDecoder(sizeEncoded);
-        BinaryMessage::SizeType messageLength = sizeDecoder.readNumber<BinaryMessage::SizeType>();
-
-        if (bytesAvailable < sizeSize + messageLength)
-        {
-            logger.logError("Wrong size: ", std::size_t(messageLength),
-                            " - available bytes: ", bytesAvailable);
-            continue;
-        }
-
-        BinaryMessage message{ BinaryMessage::Value(messageLength) };
-        socket->read(reinterpret_cast<char*>(message.value.data()), messageLength);
-        logger.logDebug("Message received from: ", addressToString(), " body: ", message);
-
-        if (messageCallback)
-        {
-            messageCallback(std::move(message));
-        }
-        else
-        {
-            logger.logError("Message received from: ", addressToString(), " - application not interested");
-        }
+        logger.logError("Message received from: ", addressToString(), " - application not interested");
     }
 }
 
@@ -4,6 +4,7 @@
 #include <QByteArray>
 #include "ITransport.hpp"
 #include "Logger/ILogger.hpp"
+#include "Transport/FrameCodec.hpp"
 
 class QAbstractSocket;
 
@@ -14,23 +15,55 @@ class QtTransport : public QObject, public ITransport
 {
     Q_OBJECT;
 public:
-    QtTransport(common::ILogger& logger, QAbstractSocket* socket);
+    /**
+     * @param address when empty peer address of socket is used
+     */
+    QtTransport(common::ILogger& logger, QAbstractSocket* socket, std::string address = {});
     ~QtTransport();
 
     void registerMessageCallback(MessageCallback messageCallback) override;
     void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
+    void registerBackpressureCallback(BackpressureCallback backpressureCallback) override;
     bool sendMessage(BinaryMessage message) override;
+    void close() override;
 
     std::string addressToString() const override;
+
+    /**
+     * Input received by previous owner of the socket, see handOver().
+     */
+    void receivePending(const common::FrameBytes& pendingInput);
+    /**
+     * Detaches from the socket, so the connection can be passed to other process - without peer noticing.
+     * Messages are neither sent nor received anymore. What is received but not handled yet is appended to pendingInput.
+     * @return duplicate of socket descriptor - owned by caller, -1 on failure
+     */
+    int handOver(common::FrameBytes& pendingInput);
+
 private:
     void readMessageFromSocket();
+    void feedDecoder(const std::uint8_t* data, std::size_t size);
+    void handleMessage(BinaryMessage message);
     void handleClosingConnection();
+    void updateBackpressure();
+    void disconnectSocket();
+
+    // bytes queued inside socket, i.e. not yet accepted by OS
+    static constexpr qint64 HIGH_WATERMARK = 256 * 1024;
+    static constexpr qint64 LOW_WATERMARK = 64 * 1024;
+    static constexpr int HANDOVER_WRITE_TIMEOUT_MS = 1000;
 
     common::ILogger& logger;
     QAbstractSocket* socket;
+    const std::string address;
+    common::FrameDecoder frameDecoder;
+    bool congested = false;
+    bool handedOver = false;
+    bool closed = false;
 
     MessageCallback messageCallback;
     DisconnectedCallback disconnectedCallback;
+    BackpressureCallback backpressureCallback;
 
 private slots:
     bool sendMessageSlot(QByteArray message);
@@ -1,15 +1,40 @@
 #include "QtTransportEnvironment.hpp"
 #include "QtTransport.hpp"
+#include "QtShmTransport.hpp"
+#include <QCoreApplication>
 #include <QTcpSocket>
+#include <QSocketNotifier>
 #include <QtNetwork>
 #include <QByteArray>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <sys/time.h>
 
 namespace bts
 {
 
-QtTransportEnvironment::QtTransportEnvironment(common::ILogger& logger, common::MultiLineConfig &config)
+namespace
+{
+constexpr time_t HANDOFF_TIMEOUT_S = 10;
+}
+
+struct QtTransportEnvironment::PendingShmChannel
+{
+    common::ShmChannel channel;
+    std::unique_ptr<QSocketNotifier> notifier;
+};
+
+QtTransportEnvironment::QtTransportEnvironment(common::ILogger& logger, common::MultiLineConfig &config, common::BtsId btsId,
+                                               std::optional<common::HandoffState> takenOver)
     : logger(logger),
-      port(config.getNumber<decltype(port)>("port", 8181))
+      btsId(btsId),
+      port(config.getNumber<decltype(port)>("port", 8181)),
+      transportType(config.getString("transport", "tcp")),
+      shmPath(config.getString("shmPath", "/tmp/bts_" + std::to_string(port) + ".shm")),
+      unixPath(config.getString("unixPath", "/tmp/bts_" + std::to_string(port) + ".sock")),
+      handoffPath(configuredHandoffPath(config)),
+      takenOver(takenOver ? std::move(*takenOver) : common::HandoffState{})
 {}
 
 QtTransportEnvironment::~QtTransportEnvironment()
@@ -18,21 +43,88 @@ QtTransportEnvironment::~QtTransportEnvironment()
         QObject::disconnect(session.get(), &QNetworkSession::opened, 0, 0);
     if (server)
         server->close();
+    common::closeHandoff(takenOver);
+}
+
+std::string QtTransportEnvironment::configuredHandoffPath(common::MultiLineConfig &config)
+{
+    const auto port = config.getNumber<std::uint32_t>("port", 8181);
+    return config.getString("handoffPath", "/tmp/bts_" + std::to_string(port) + ".handoff");
+}
+
+std::optional<common::HandoffState> QtTransportEnvironment::requestHandoff(common::MultiLineConfig &config)
+{
+    if (not config.getNumber<int>("takeover", 0))
+    {
+        return std::nullopt;
+    }
+    const std::string path = configuredHandoffPath(config);
+    int socket = -1;
+    try
+    {
+        socket = common::connectUnix(path, SOCK_SEQPACKET);
+        const timeval timeout{HANDOFF_TIMEOUT_S, 0};
+        ::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        auto state = common::receiveHandoff(socket);
+        common::closeFd(socket);
+        std::clog << "Note: taken over " << state.connections.size() << " UE connections from \"" << path << "\"" << std::endl;
+        return state;
+    }
+    catch (common::UnixSocketEx& ex)
+    {
+        common::closeFd(socket);
+        std::clog << "Note: taking over from \"" << path << "\" failed: " << ex.what() << "\n\t((starting from scratch))" << std::endl;
+        return std::nullopt;
+    }
 }
 
 void QtTransportEnvironment::exec()
 {
-    QNetworkConfigurationManager manager{};
-    if (manager.capabilities() & QNetworkConfigurationManager::NetworkSessionRequired)
+    listenHandoff();
+    if (uses("shm"))
+    {
+        listenShm();
+    }
+    if (uses("unix"))
+    {
+        listenUnix();
+    }
+    if (uses("tcp"))
+    {
+        listenTcp();
+    }
+    takeOverConnections();
+}
+
+void QtTransportEnvironment::listenTcp()
+{
+    if (takenOver.tcpListener >= 0)
     {
-        logger.logDebug("Session needed");
-        session.reset(new QNetworkSession(manager.defaultConfiguration()));
-        QObject::connect(session.get(), &QNetworkSession::opened, std::bind(&QtTransportEnvironment::sessionOpened, this));
-        session->open();
+        server.reset(new QTcpServer());
+        if (server->setSocketDescriptor(takenOver.tcpListener))
+        {
+            logger.logInfo("server taken over, port: ", server->serverPort());
+            takenOver.tcpListener = -1;
+        }
+        else
+        {
+            logger.logError("server could not be taken over: ", server->errorString().toStdString());
+        }
     }
     else
     {
-        sessionOpened();
+        QNetworkConfigurationManager manager{};
+        if (manager.capabilities() & QNetworkConfigurationManager::NetworkSessionRequired)
+        {
+            logger.logDebug("Session needed");
+            session.reset(new QNetworkSession(manager.defaultConfiguration()));
+            QObject::connect(session.get(), &QNetworkSession::opened, std::bind(&QtTransportEnvironment::sessionOpened, this));
+            session->open();
+        }
+        else
+        {
+            sessionOpened();
+        }
     }
     QObject::connect(server.get(), &QTcpServer::newConnection, std::bind(&QtTransportEnvironment::handleNewConnection, this));
 }
@@ -51,9 +143,27 @@ void bts::QtTransportEnvironment::registerUeConnectedCallback(UeConnectedCallbac
     this->ueConnectedCallback = ueConnectedCallback;
 }
 
+void QtTransportEnvironment::registerHandoffCallbacks(UeTakenOverCallback ueTakenOverCallback, UeAttachmentsProvider ueAttachmentsProvider)
+{
+    this->ueTakenOverCallback = ueTakenOverCallback;
+    this->ueAttachmentsProvider = ueAttachmentsProvider;
+}
+
 std::string QtTransportEnvironment::getAddress() const
 {
     std::string result;
+    if (uses("shm"))
+    {
+        result += "\nshm:" + shmPath;
+    }
+    if (uses("unix"))
+    {
+        result += "\nunix:" + unixPath;
+    }
+    if (not uses("tcp"))
+    {
+        return result;
+    }
     std::string port = std::to_string(this->port);
     QList<QHostAddress> list = QNetworkInterface::allAddresses();
     for(auto&& host: list)
@@ -70,25 +180,325 @@ std::string QtTransportEnvironment::getAddress() const
     return result;
 }
 
+bool QtTransportEnvironment::isHandedOver() const
+{
+    return handedOver;
+}
+
 void QtTransportEnvironment::handleNewConnection()
 {
     QAbstractSocket* socket = server->nextPendingConnection();
     if (socket)
     {
-        auto ueTransport = std::make_shared<QtTransport>(logger, socket);
-        logger.logDebug("New connection from: ", ueTransport->addressToString());
-        if (ueConnectedCallback)
+        notifyUeConnected(std::make_shared<QtTransport>(logger, socket));
+    }
+    else
+    {
+        logger.logError("No new socked for new connection!");
+    }
+}
+
+bool QtTransportEnvironment::uses(const std::string &type) const
+{
+    std::istringstream types(transportType);
+    std::string configured;
+    while (std::getline(types, configured, ','))
+    {
+        if (configured == type or configured == "all")
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void QtTransportEnvironment::listenShm()
+{
+    try
+    {
+        shmListener = std::make_unique<common::ShmListener>(shmPath);
+        shmNotifier = std::make_unique<QSocketNotifier>(shmListener->fd(), QSocketNotifier::Read);
+        QObject::connect(shmNotifier.get(), &QSocketNotifier::activated, std::bind(&QtTransportEnvironment::handleNewShmConnection, this));
+        logger.logInfo("shared memory server started, path: ", shmPath);
+    }
+    catch (common::UnixSocketEx& ex)
+    {
+        logger.logError("shared memory server could not start: ", ex.what());
+    }
+}
+
+void QtTransportEnvironment::handleNewShmConnection()
+{
+    try
+    {
+        while (auto channel = shmListener->accept())
+        {
+            if (channel->isEstablished())
+            {
+                notifyUeConnected(std::make_shared<QtShmTransport>(logger, std::move(*channel)));
+            }
+            else
+            {
+                watchShmRendezvous(std::move(*channel));
+            }
+        }
+    }
+    catch (common::UnixSocketEx& ex)
+    {
+        logger.logError("Shared memory connection failed: ", ex.what());
+    }
+}
+
+void QtTransportEnvironment::watchShmRendezvous(common::ShmChannel channel)
+{
+    const int control = channel.controlFd();
+    auto notifier = std::make_unique<QSocketNotifier>(control, QSocketNotifier::Read);
+    QObject::connect(notifier.get(), &QSocketNotifier::activated, std::bind(&QtTransportEnvironment::handleShmRendezvous, this, control));
+    pendingShmChannels[control].reset(new PendingShmChannel{std::move(channel), std::move(notifier)});
+}
+
+void QtTransportEnvironment::handleShmRendezvous(int control)
+{
+    auto found = pendingShmChannels.find(control);
+    if (found == pendingShmChannels.end())
+    {
+        return;
+    }
+    std::unique_ptr<PendingShmChannel> pending;
+    try
+    {
+        if (not found->second->channel.completeRendezvous())
+        {
+            return;
+        }
+        pending = std::move(found->second);
+        pendingShmChannels.erase(found);
+    }
+    catch (common::UnixSocketEx& ex)
+    {
+        logger.logError("Shared memory connection failed: ", ex.what());
+        pending = std::move(found->second);
+        pendingShmChannels.erase(found);
+    }
+    // called from its own signal - so deleted later
+    pending->notifier->setEnabled(false);
+    pending->notifier.release()->deleteLater();
+    if (pending->channel.isEstablished())
+    {
+        notifyUeConnected(std::make_shared<QtShmTransport>(logger, std::move(pending->channel)));
+    }
+}
+
+void QtTransportEnvironment::listenUnix()
+{
+    try
+    {
+        if (takenOver.unixListener >= 0)
+        {
+            unixListener = std::make_unique<common::UnixListener>(std::exchange(takenOver.unixListener, -1));
+        }
+        else
+        {
+            unixListener = std::make_unique<common::UnixListener>(unixPath, SOCK_STREAM);
+        }
+        unixNotifier = std::make_unique<QSocketNotifier>(unixListener->fd(), QSocketNotifier::Read);
+        QObject::connect(unixNotifier.get(), &QSocketNotifier::activated, std::bind(&QtTransportEnvironment::handleNewUnixConnection, this));
+        logger.logInfo("unix socket server started, path: ", unixListener->getPath());
+    }
+    catch (common::UnixSocketEx& ex)
+    {
+        logger.logError("unix socket server could not start: ", ex.what());
+    }
+}
+
+void QtTransportEnvironment::handleNewUnixConnection()
+{
+    try
+    {
+        for (int fd = unixListener->accept(); fd >= 0; fd = unixListener->accept())
+        {
+            // Qt handles stream unix sockets as any other stream socket - as QLocalSocket does
+            auto socket = new QTcpSocket();
+            if (not socket->setSocketDescriptor(fd))
+            {
+                logger.logError("Unix socket connection rejected: ", socket->errorString().toStdString());
+                delete socket;
+                common::closeFd(fd);
+                continue;
+            }
+            auto transport = std::make_shared<QtTransport>(logger, socket, unixAddress(*socket));
+            socket->setParent(transport.get());
+            notifyUeConnected(transport);
+        }
+    }
+    catch (common::UnixSocketEx& ex)
+    {
+        logger.logError("Unix socket connection failed: ", ex.what());
+    }
+}
+
+std::string QtTransportEnvironment::unixAddress(QAbstractSocket &socket)
+{
+    if (not socket.peerAddress().isNull())
+    {
+        return {};
+    }
+    return "unix-pid" + std::to_string(common::peerPid(socket.socketDescriptor()))
+         + "-fd" + std::to_string(socket.socketDescriptor());
+}
+
+void QtTransportEnvironment::listenHandoff()
+{
+    try
+    {
+        if (takenOver.handoffListener >= 0)
+        {
+            handoffListener = std::make_unique<common::UnixListener>(std::exchange(takenOver.handoffListener, -1));
+        }
+        else
+        {
+            handoffListener = std::make_unique<common::UnixListener>(handoffPath, SOCK_SEQPACKET);
+        }
+        handoffNotifier = std::make_unique<QSocketNotifier>(handoffListener->fd(), QSocketNotifier::Read);
+        QObject::connect(handoffNotifier.get(), &QSocketNotifier::activated, std::bind(&QtTransportEnvironment::handleHandoffRequest, this));
+        logger.logInfo("ready to hand over, path: ", handoffListener->getPath());
+    }
+    catch (common::UnixSocketEx& ex)
+    {
+        logger.logError("handoff unavailable: ", ex.what());
+    }
+}
+
+void QtTransportEnvironment::handleHandoffRequest()
+{
+    int requester = -1;
+    try
+    {
+        requester = handoffListener->accept();
+    }
+    catch (common::UnixSocketEx& ex)
+    {
+        logger.logError("Handoff request failed: ", ex.what());
+    }
+    if (requester < 0)
+    {
+        return;
+    }
+
+    handOver(requester);
+    common::closeFd(requester);
+    stopListening();
+    handedOver = true;
+    QCoreApplication::quit();
+}
+
+void QtTransportEnvironment::handOver(int requester)
+{
+    logger.logInfo("Handing over to process: ", common::peerPid(requester));
+
+    // nothing is accepted meanwhile - pending connections stay in listening sockets for new owner
+    common::HandoffState state;
+    state.id = btsId.value;
+    state.tcpListener = server ? server->socketDescriptor() : -1;
+    state.unixListener = unixListener ? unixListener->fd() : -1;
+    state.handoffListener = handoffListener->fd();
+
+    const UeAttachments attachments = ueAttachmentsProvider ? ueAttachmentsProvider() : UeAttachments{};
+    for (const auto& [transport, phoneNumber] : attachments)
+    {
+        auto qtTransport = std::dynamic_pointer_cast<QtTransport>(transport);
+        if (not qtTransport)
+        {
+            // e.g. shared memory - UE will reconnect
+            logger.logInfo("Connection: ", transport->addressToString(), " cannot be handed over");
+            continue;
+        }
+        common::HandoffConnection connection;
+        connection.phoneNumber = phoneNumber;
+        connection.socket = qtTransport->handOver(connection.pendingInput);
+        if (connection.socket < 0)
+        {
+            logger.logError("Connection: ", transport->addressToString(), " could not be handed over");
+            continue;
+        }
+        state.connections.push_back(std::move(connection));
+    }
+
+    try
+    {
+        common::sendHandoff(requester, state);
+        logger.logInfo("Handed over ", state.connections.size(), " of ", attachments.size(), " connections");
+    }
+    catch (common::UnixSocketEx& ex)
+    {
+        logger.logError("Handoff failed, connections will be dropped: ", ex.what());
+    }
+    // listeners are still owned by this object, see stopListening()
+    for (auto& connection : state.connections)
+    {
+        common::closeFd(connection.socket);
+    }
+}
+
+void QtTransportEnvironment::stopListening()
+{
+    // sockets are not owned anymore - so neither paths shall be removed
+    shmNotifier.reset();
+    unixNotifier.reset();
+    handoffNotifier.reset();
+    for (auto* listener : {unixListener.get(), handoffListener.get()})
+    {
+        if (listener)
         {
-            ueConnectedCallback(ueTransport);
+            int fd = listener->release();
+            common::closeFd(fd);
+        }
+    }
+    if (server)
+    {
+        QObject::disconnect(server.get(), &QTcpServer::newConnection, 0, 0);
+        server->close();
+    }
+}
+
+void QtTransportEnvironment::takeOverConnections()
+{
+    for (auto& connection : takenOver.connections)
+    {
+        auto socket = new QTcpSocket();
+        if (not socket->setSocketDescriptor(connection.socket))
+        {
+            logger.logError("Connection could not be taken over: ", socket->errorString().toStdString());
+            delete socket;
+            continue;
+        }
+        connection.socket = -1;
+        auto transport = std::make_shared<QtTransport>(logger, socket, unixAddress(*socket));
+        socket->setParent(transport.get());
+        logger.logDebug("Connection taken over: ", transport->addressToString());
+        if (ueTakenOverCallback)
+        {
+            ueTakenOverCallback({transport, connection.phoneNumber});
         }
         else
         {
-            logger.logError("New connection from: ", ueTransport->addressToString(), " discarded, application not interested!");
+            logger.logError("Connection: ", transport->addressToString(), " taken over, but application not interested!");
         }
+        transport->receivePending(connection.pendingInput);
+    }
+    common::closeHandoff(takenOver);
+}
+
+void QtTransportEnvironment::notifyUeConnected(ITransportPtr ueTransport)
+{
+    logger.logDebug("New connection from: ", ueTransport->addressToString());
+    if (ueConnectedCallback)
+    {
+        ueConnectedCallback(ueTransport);
     }
     else
     {
-        logger.logError("No new socked for new connection!");
+        logger.logError("New connection from: ", ueTransport->addressToString(), " discarded, application not interested!");
     }
 }
 
@@ -1,11 +1,24 @@
 #pragma once
+#include <map>
+#include <memory>
+#include <optional>
 #include "ITransport.hpp"
+#include "Messages/BtsId.hpp"
 #include "Logger/ILogger.hpp"
 #include "Config/MultiLineConfig.hpp"
+#include "Transport/Handoff.hpp"
 
 class QTcpServer;
 class QNetworkSession;
 class QAbstractSocket;
+class QSocketNotifier;
+
+namespace common
+{
+class ShmChannel;
+class ShmListener;
+class UnixListener;
+}
 
 namespace bts
 {
@@ -13,22 +26,71 @@ namespace bts
 class QtTransportEnvironment
 {
 public:
-    QtTransportEnvironment(common::ILogger& logger, common::MultiLineConfig& config);
+    /**
+     * @param takenOver state handed over by previous BTS instance, see requestHandoff()
+     */
+    QtTransportEnvironment(common::ILogger& logger, common::MultiLineConfig& config, common::BtsId btsId,
+                           std::optional<common::HandoffState> takenOver = std::nullopt);
     ~QtTransportEnvironment();
 
+    /**
+     * When "takeover" is configured: asks running BTS (listening on the same "handoffPath")
+     * to hand over its listening sockets and all UE connections - then it quits.
+     * Called before logger exists - so reports to std::clog.
+     */
+    static std::optional<common::HandoffState> requestHandoff(common::MultiLineConfig& config);
+
     void exec();
     void registerUeConnectedCallback(UeConnectedCallback ueConnectedCallback);
+    void registerHandoffCallbacks(UeTakenOverCallback ueTakenOverCallback, UeAttachmentsProvider ueAttachmentsProvider);
     std::string getAddress() const;
+    bool isHandedOver() const;
 
 private:
     void sessionOpened();
     void handleNewConnection();
+    bool uses(const std::string& type) const;
+    void listenTcp();
+    void listenShm();
+    void handleNewShmConnection();
+    void watchShmRendezvous(common::ShmChannel channel);
+    void handleShmRendezvous(int control);
+    void listenUnix();
+    void handleNewUnixConnection();
+    void listenHandoff();
+    void handleHandoffRequest();
+    void handOver(int requester);
+    void stopListening();
+    void takeOverConnections();
+    void notifyUeConnected(ITransportPtr ueTransport);
+
+    static std::string configuredHandoffPath(common::MultiLineConfig& config);
+    static std::string unixAddress(QAbstractSocket& socket);
 
     common::ILogger& logger;
+    const common::BtsId btsId;
     std::uint32_t port;
+    // comma separated: "tcp", "unix", "shm" (both for co-located UEs only) - or "all"
+    std::string transportType;
+    std::string shmPath;
+    std::string unixPath;
+    std::string handoffPath;
+    common::HandoffState takenOver;
+    bool handedOver = false;
     std::unique_ptr<QTcpServer> server;
     std::unique_ptr<QNetworkSession> session;
+    std::unique_ptr<common::ShmListener> shmListener;
+    std::unique_ptr<QSocketNotifier> shmNotifier;
+    // accepted, but descriptors not received yet - by control fd
+    struct PendingShmChannel;
+    std::map<int, std::unique_ptr<PendingShmChannel>> pendingShmChannels;
+    std::unique_ptr<common::UnixListener> unixListener;
+    std::unique_ptr<QSocketNotifier> unixNotifier;
+    std::unique_ptr<common::UnixListener> handoffListener;
+    std::unique_ptr<QSocketNotifier> handoffNotifier;
     UeConnectedCallback ueConnectedCallback;
+    UeTakenOverCallback ueTakenOverCallback;
+    UeAttachmentsProvider ueAttachmentsProvider;
 };
 
 }
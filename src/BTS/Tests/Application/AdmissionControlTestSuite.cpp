@@ -0,0 +1,89 @@
+#include "AdmissionControlTestSuite.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+using Decision = AdmissionControl::Decision;
+
+ITransportPtr AdmissionControlTestSuite::makeTransport()
+{
+    return std::make_shared<NiceMock<common::ITransportMock>>();
+}
+
+TEST_F(AdmissionControlTestSuite, shallAdmitBurstAtOnce)
+{
+    ASSERT_EQ(Decision::Admit, objectUnderTest.onConnected(makeTransport(), START));
+    ASSERT_EQ(Decision::Admit, objectUnderTest.onConnected(makeTransport(), START));
+    ASSERT_EQ(Decision::Defer, objectUnderTest.onConnected(makeTransport(), START));
+    ASSERT_EQ(1u, objectUnderTest.pendingCount());
+}
+
+TEST_F(AdmissionControlTestSuite, shallRejectWhenTooManyPending)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        objectUnderTest.onConnected(makeTransport(), START);
+    }
+    ASSERT_EQ(Decision::Reject, objectUnderTest.onConnected(makeTransport(), START));
+    ASSERT_EQ(1u, objectUnderTest.rejectedCount());
+}
+
+TEST_F(AdmissionControlTestSuite, shallAdmitPendingInOrderWithRate)
+{
+    objectUnderTest.onConnected(makeTransport(), START);
+    objectUnderTest.onConnected(makeTransport(), START);
+    auto first = makeTransport();
+    auto second = makeTransport();
+    objectUnderTest.onConnected(first, START);
+    objectUnderTest.onConnected(second, START);
+
+    ASSERT_THAT(objectUnderTest.admitPending(START + ADMISSION_PERIOD), ElementsAre(first));
+    ASSERT_THAT(objectUnderTest.admitPending(START + ADMISSION_PERIOD), IsEmpty());
+    ASSERT_THAT(objectUnderTest.admitPending(START + 2 * ADMISSION_PERIOD), ElementsAre(second));
+}
+
+TEST_F(AdmissionControlTestSuite, shallNotLetNewConnectionOvertakePending)
+{
+    objectUnderTest.onConnected(makeTransport(), START);
+    objectUnderTest.onConnected(makeTransport(), START);
+    objectUnderTest.onConnected(makeTransport(), START);
+
+    ASSERT_EQ(Decision::Defer, objectUnderTest.onConnected(makeTransport(), START + ADMISSION_PERIOD));
+}
+
+TEST_F(AdmissionControlTestSuite, shallForgetRemovedPending)
+{
+    objectUnderTest.onConnected(makeTransport(), START);
+    objectUnderTest.onConnected(makeTransport(), START);
+    auto pending = makeTransport();
+    objectUnderTest.onConnected(pending, START);
+
+    objectUnderTest.removePending(pending.get());
+
+    ASSERT_EQ(0u, objectUnderTest.pendingCount());
+    ASSERT_THAT(objectUnderTest.admitPending(START + ADMISSION_PERIOD), IsEmpty());
+}
+
+TEST_F(AdmissionControlTestSuite, shallAdmitEveryConnectionWhenDisabled)
+{
+    AdmissionControl disabled{{0.0, 0.0, 0u}, START};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(Decision::Admit, disabled.onConnected(makeTransport(), START));
+    }
+    ASSERT_EQ(0u, disabled.rejectedCount());
+}
+
+TEST_F(AdmissionControlTestSuite, shallAdmitAtLeastOneConnectionWithBurstBelowOne)
+{
+    AdmissionControl lowBurst{{10.0, 0.0, 2u}, START};
+
+    ASSERT_EQ(Decision::Admit, lowBurst.onConnected(makeTransport(), START));
+    ASSERT_EQ(Decision::Defer, lowBurst.onConnected(makeTransport(), START));
+    ASSERT_THAT(lowBurst.admitPending(START + ADMISSION_PERIOD), SizeIs(1u));
+}
+
+}
@@ -0,0 +1,23 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeConnection/AdmissionControl.hpp"
+#include "Mocks/ITransportMock.hpp"
+
+namespace bts
+{
+
+class AdmissionControlTestSuite : public ::testing::Test
+{
+protected:
+    static ITransportPtr makeTransport();
+
+    const AdmissionControl::Limits LIMITS{10.0, 2.0, 2u};
+    const AdmissionControl::Clock::time_point START{};
+    // one connection admitted
+    const std::chrono::milliseconds ADMISSION_PERIOD{100};
+
+    AdmissionControl objectUnderTest{LIMITS, START};
+};
+
+}
@@ -0,0 +1,84 @@
+#include "ConferenceBridgeTestSuite.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+ConferenceBridgeTestSuite::ConferenceBridgeTestSuite()
+{
+    objectUnderTest.invite(HOST, PEER, INVITEE);
+}
+
+TEST_F(ConferenceBridgeTestSuite, shallStartConferenceWithPeerOfHost)
+{
+    ASSERT_TRUE(objectUnderTest.isHost(HOST));
+    ASSERT_THAT(*objectUnderTest.findMembers(PEER), ElementsAre(HOST, PEER));
+    ASSERT_FALSE(objectUnderTest.isMember(INVITEE));
+}
+
+TEST_F(ConferenceBridgeTestSuite, shallJoinOnlyInvited)
+{
+    ASSERT_EQ(nullptr, objectUnderTest.join(OTHER, HOST));
+
+    const auto* members = objectUnderTest.join(INVITEE, HOST);
+
+    ASSERT_NE(nullptr, members);
+    ASSERT_THAT(*members, ElementsAre(HOST, PEER, INVITEE));
+    ASSERT_EQ(nullptr, objectUnderTest.join(INVITEE, HOST));
+}
+
+TEST_F(ConferenceBridgeTestSuite, shallNotJoinAfterDecline)
+{
+    ASSERT_TRUE(objectUnderTest.decline(INVITEE, HOST));
+
+    ASSERT_EQ(nullptr, objectUnderTest.join(INVITEE, HOST));
+}
+
+TEST_F(ConferenceBridgeTestSuite, shallNotLetParticipantInvite)
+{
+    ASSERT_FALSE(objectUnderTest.invite(PEER, std::nullopt, OTHER));
+}
+
+TEST_F(ConferenceBridgeTestSuite, shallContinueWhenParticipantLeaves)
+{
+    objectUnderTest.join(INVITEE, HOST);
+
+    auto left = objectUnderTest.leave(PEER);
+
+    ASSERT_TRUE(left);
+    ASSERT_FALSE(left->ended);
+    ASSERT_THAT(left->remaining, ElementsAre(HOST, INVITEE));
+    ASSERT_FALSE(objectUnderTest.isMember(PEER));
+}
+
+TEST_F(ConferenceBridgeTestSuite, shallEndWhenLastParticipantLeaves)
+{
+    auto left = objectUnderTest.leave(PEER);
+
+    ASSERT_TRUE(left);
+    ASSERT_TRUE(left->ended);
+    ASSERT_THAT(left->remaining, ElementsAre(HOST));
+    ASSERT_EQ(0u, objectUnderTest.count());
+    ASSERT_FALSE(objectUnderTest.isMember(HOST));
+}
+
+TEST_F(ConferenceBridgeTestSuite, shallEndWhenHostLeaves)
+{
+    objectUnderTest.join(INVITEE, HOST);
+
+    auto left = objectUnderTest.leave(HOST);
+
+    ASSERT_TRUE(left);
+    ASSERT_TRUE(left->ended);
+    ASSERT_THAT(left->remaining, ElementsAre(PEER, INVITEE));
+    ASSERT_FALSE(objectUnderTest.isMember(PEER));
+    ASSERT_FALSE(objectUnderTest.isMember(INVITEE));
+}
+
+TEST_F(ConferenceBridgeTestSuite, shallIgnoreLeaveOfNotMember)
+{
+    ASSERT_FALSE(objectUnderTest.leave(OTHER));
+}
+
+}
@@ -0,0 +1,22 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeRelay/ConferenceBridge.hpp"
+
+namespace bts
+{
+
+class ConferenceBridgeTestSuite : public ::testing::Test
+{
+protected:
+    ConferenceBridgeTestSuite();
+
+    const PhoneNumber HOST{1};
+    const PhoneNumber PEER{2};
+    const PhoneNumber INVITEE{3};
+    const PhoneNumber OTHER{4};
+
+    ConferenceBridge objectUnderTest;
+};
+
+}
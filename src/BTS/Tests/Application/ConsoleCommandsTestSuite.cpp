@@ -11,7 +11,7 @@ ConsoleCommandsTestSuite::ConsoleCommandsTestSuite()
 {
     ueRelayMock = std::make_shared<StrictMock<IUeRelayMock>>();
     syncGuard = std::make_shared<SyncGuard>();
-    objectUnderTest = std::make_unique<ConsoleCommands>(consoleMock, environmentMock, loggerMock, ueRelayMock, syncGuard);
+    objectUnderTest = std::make_unique<ConsoleCommands>(consoleMock, environmentMock, loggerMock, ueRelayMock, syncGuard, ingressThrottle);
 }
 
 void ConsoleCommandsTestSuite::expectRegisterCallback(IConsoleMock &consoleMock,
@@ -26,6 +26,8 @@ void ConsoleCommandsTestSuite::expectRegisterCallbacks()
     expectRegisterCallback(consoleMock, "a", showAddressCallback);
     expectRegisterCallback(consoleMock, "s", showStatusCallback);
     expectRegisterCallback(consoleMock, "l", listAttachedUeCallback);
+    expectRegisterCallback(consoleMock, "e", showEgressStatsCallback);
+    expectRegisterCallback(consoleMock, "r", throttleCallback);
     EXPECT_CALL(consoleMock, addCloseCommand(_, _, _));
     EXPECT_CALL(consoleMock, addHelpCommand(_, _));
     expectRegisterCallback(consoleMock, "t", testCommandsCallback);
@@ -145,4 +147,41 @@ TEST_F(ConsoleCommandsAfterStartTestSuite, shallListAttached)
     assertResultContainsAttachedPrintouts();
 }
 
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallSumEgressStatsOfAttached)
+{
+    EgressStats stats{};
+    stats[static_cast<std::size_t>(TrafficClass::Control)].record(std::chrono::microseconds(40));
+    for (auto& ue : ueConnectionAttachedMock)
+    {
+        EXPECT_CALL(ue, getEgressStats()).WillOnce(Return(stats));
+    }
+    EXPECT_CALL(*ueRelayMock, visitAttachedUe(_)).WillOnce([this](auto visitor) { applyUeAttached(visitor); });
+
+    onCallback(showEgressStatsCallback);
+
+    ASSERT_THAT(result, HasSubstr("control: sent: " + std::to_string(COUNT_ATTACHED_TO_VISIT) + ", avg: 40us, max: 40us"));
+    ASSERT_THAT(result, HasSubstr("sms: sent: 0"));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallShowRateLimits)
+{
+    onCallback(throttleCallback);
+    ASSERT_THAT(result, HasSubstr("sms: 10/s, burst: 20, throttled: 0"));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallChangeRateLimit)
+{
+    onCallback(throttleCallback, "sms 5 7");
+    ASSERT_EQ(5.0, ingressThrottle->getBudget(TrafficClass::Sms).ratePerSecond);
+    ASSERT_EQ(7.0, ingressThrottle->getBudget(TrafficClass::Sms).burst);
+    ASSERT_THAT(result, HasSubstr("sms: 5/s, burst: 7"));
+}
+
+TEST_F(ConsoleCommandsAfterStartTestSuite, shallNotChangeRateLimitOnWrongArguments)
+{
+    onCallback(throttleCallback, "voice 5 7");
+    ASSERT_THAT(result, HasSubstr("usage"));
+    ASSERT_EQ(10.0, ingressThrottle->getBudget(TrafficClass::Sms).ratePerSecond);
+}
+
 }
@@ -25,11 +25,14 @@ protected:
     testing::StrictMock<IApplicationEnvironmentMock> environmentMock;
     testing::NiceMock<common::ILoggerMock> loggerMock;
     std::shared_ptr<IUeRelayMock> ueRelayMock;
+    std::shared_ptr<IngressThrottle> ingressThrottle = std::make_shared<IngressThrottle>();
     std::unique_ptr<ConsoleCommands> objectUnderTest;
 
     IConsole::CommandCallback showAddressCallback;
     IConsole::CommandCallback showStatusCallback;
     IConsole::CommandCallback listAttachedUeCallback;
+    IConsole::CommandCallback showEgressStatsCallback;
+    IConsole::CommandCallback throttleCallback;
     IConsole::CommandCallback testCommandsCallback;
 };
 
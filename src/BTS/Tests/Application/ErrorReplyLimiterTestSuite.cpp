@@ -0,0 +1,48 @@
+#include "ErrorReplyLimiterTestSuite.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+using common::MessageId;
+
+TEST_F(ErrorReplyLimiterTestSuite, shallAdmitOneReplyPerInterval)
+{
+    ASSERT_THAT(objectUnderTest.admit(MessageId::UnknownRecipient, HEADER, NOW), Optional(0u));
+    ASSERT_EQ(std::nullopt, objectUnderTest.admit(MessageId::UnknownRecipient, HEADER, NOW));
+    ASSERT_EQ(std::nullopt, objectUnderTest.admit(MessageId::UnknownRecipient, HEADER, NOW + INTERVAL / 2));
+
+    ASSERT_THAT(objectUnderTest.admit(MessageId::UnknownRecipient, HEADER, NOW + INTERVAL), Optional(2u));
+}
+
+TEST_F(ErrorReplyLimiterTestSuite, shallLimitEachKeySeparately)
+{
+    objectUnderTest.admit(MessageId::UnknownRecipient, HEADER, NOW);
+
+    ASSERT_THAT(objectUnderTest.admit(MessageId::UnknownRecipient, OTHER_HEADER, NOW), Optional(0u));
+    ASSERT_THAT(objectUnderTest.admit(MessageId::UnknownSender, HEADER, NOW), Optional(0u));
+}
+
+TEST_F(ErrorReplyLimiterTestSuite, shallReportSuppressedOnTake)
+{
+    objectUnderTest.admit(MessageId::UnknownSender, HEADER, NOW);
+    objectUnderTest.admit(MessageId::UnknownSender, HEADER, NOW);
+
+    ASSERT_EQ(1u, objectUnderTest.takeSuppressed());
+    ASSERT_EQ(0u, objectUnderTest.takeSuppressed());
+}
+
+TEST_F(ErrorReplyLimiterTestSuite, shallSuppressNewKeysWhenTooManyTracked)
+{
+    for (std::size_t to = 0; to < ErrorReplyLimiter::MAX_TRACKED; ++to)
+    {
+        const common::MessageHeader header{MessageId::Sms, common::PhoneNumber{1}, common::PhoneNumber{static_cast<std::uint8_t>(to)}};
+        ASSERT_TRUE(objectUnderTest.admit(MessageId::UnknownRecipient, header, NOW));
+    }
+    ASSERT_EQ(std::nullopt, objectUnderTest.admit(MessageId::UnknownSender, HEADER, NOW));
+
+    ASSERT_THAT(objectUnderTest.admit(MessageId::UnknownSender, HEADER, NOW + INTERVAL), Optional(1u));
+}
+
+}
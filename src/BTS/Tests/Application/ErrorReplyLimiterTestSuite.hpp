@@ -0,0 +1,20 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeConnection/ErrorReplyLimiter.hpp"
+
+namespace bts
+{
+
+class ErrorReplyLimiterTestSuite : public ::testing::Test
+{
+protected:
+    const std::chrono::seconds INTERVAL{1};
+    const ErrorReplyLimiter::Clock::time_point NOW{};
+    const common::MessageHeader HEADER{common::MessageId::Sms, common::PhoneNumber{1}, common::PhoneNumber{2}};
+    const common::MessageHeader OTHER_HEADER{common::MessageId::Sms, common::PhoneNumber{1}, common::PhoneNumber{3}};
+
+    ErrorReplyLimiter objectUnderTest{INTERVAL};
+};
+
+}
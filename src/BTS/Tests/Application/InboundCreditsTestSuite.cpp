@@ -0,0 +1,53 @@
+#include "InboundCreditsTestSuite.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+TEST_F(InboundCreditsTestSuite, shallNotLimitUntilEnabled)
+{
+    for (int i = 0; i < 2 * WINDOW; ++i)
+    {
+        ASSERT_TRUE(objectUnderTest.consume());
+    }
+    ASSERT_EQ(0u, objectUnderTest.replenish());
+}
+
+TEST_F(InboundCreditsTestSuite, shallGrantWholeWindowOnEnable)
+{
+    ASSERT_EQ(WINDOW, objectUnderTest.enable());
+    ASSERT_TRUE(objectUnderTest.isEnabled());
+    ASSERT_EQ(WINDOW, objectUnderTest.available());
+}
+
+TEST_F(InboundCreditsTestSuite, shallRejectWhenOutOfCredit)
+{
+    objectUnderTest.enable();
+    for (int i = 0; i < WINDOW; ++i)
+    {
+        ASSERT_TRUE(objectUnderTest.consume());
+    }
+    ASSERT_FALSE(objectUnderTest.consume());
+    ASSERT_EQ(1u, objectUnderTest.violationCount());
+}
+
+TEST_F(InboundCreditsTestSuite, shallReplenishInBatchesOfHalfWindow)
+{
+    objectUnderTest.enable();
+    objectUnderTest.consume();
+    ASSERT_EQ(0u, objectUnderTest.replenish());
+    objectUnderTest.consume();
+    ASSERT_EQ(WINDOW / 2u, objectUnderTest.replenish());
+    ASSERT_EQ(WINDOW, objectUnderTest.available());
+}
+
+TEST_F(InboundCreditsTestSuite, shallNeverEnableWithZeroWindow)
+{
+    InboundCredits disabled{0u};
+    ASSERT_EQ(0u, disabled.enable());
+    ASSERT_FALSE(disabled.isEnabled());
+    ASSERT_TRUE(disabled.consume());
+}
+
+}
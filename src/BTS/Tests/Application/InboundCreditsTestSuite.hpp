@@ -0,0 +1,17 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeConnection/InboundCredits.hpp"
+
+namespace bts
+{
+
+class InboundCreditsTestSuite : public ::testing::Test
+{
+protected:
+    static constexpr std::uint16_t WINDOW = 4u;
+
+    InboundCredits objectUnderTest{WINDOW};
+};
+
+}
@@ -0,0 +1,70 @@
+#include "IngressThrottleTestSuite.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+IngressThrottleTestSuite::IngressThrottleTestSuite()
+    : objectUnderTest(IngressThrottle::Budgets{})
+{
+    objectUnderTest.setBudget(TrafficClass::Sms, SMS_BUDGET);
+}
+
+TEST_F(IngressThrottleTestSuite, shallThrottleSenderAboveBudget)
+{
+    ASSERT_TRUE(objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW));
+    ASSERT_TRUE(objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW));
+    ASSERT_FALSE(objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW));
+    ASSERT_EQ(1u, objectUnderTest.throttledCount(TrafficClass::Sms));
+}
+
+TEST_F(IngressThrottleTestSuite, shallKeepSeparateBudgetPerSender)
+{
+    objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW);
+    objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW);
+
+    ASSERT_TRUE(objectUnderTest.allow(OTHER_SENDER, TrafficClass::Sms, NOW));
+}
+
+TEST_F(IngressThrottleTestSuite, shallNotLimitClassWithoutRate)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(objectUnderTest.allow(SENDER, TrafficClass::Talk, NOW));
+    }
+}
+
+TEST_F(IngressThrottleTestSuite, shallRefillBudgetWhenChanged)
+{
+    objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW);
+    objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW);
+
+    objectUnderTest.setBudget(TrafficClass::Sms, {1.0, 1.0});
+
+    ASSERT_TRUE(objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW));
+    ASSERT_FALSE(objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW));
+}
+
+TEST_F(IngressThrottleTestSuite, shallTakeRateAsBurstWhenBurstNotGiven)
+{
+    objectUnderTest.setBudget(TrafficClass::Sms, {2.0, 0.0});
+
+    ASSERT_DOUBLE_EQ(2.0, objectUnderTest.getBudget(TrafficClass::Sms).burst);
+    ASSERT_TRUE(objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW));
+    ASSERT_TRUE(objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW));
+    ASSERT_FALSE(objectUnderTest.allow(SENDER, TrafficClass::Sms, NOW));
+}
+
+TEST_F(IngressThrottleTestSuite, shallLetAtLeastOneMessageThroughWithLowRate)
+{
+    IngressThrottle::Budgets budgets{};
+    budgets[static_cast<std::size_t>(TrafficClass::Talk)] = {0.5, 0.0};
+    IngressThrottle throttle(budgets);
+
+    ASSERT_DOUBLE_EQ(1.0, throttle.getBudget(TrafficClass::Talk).burst);
+    ASSERT_TRUE(throttle.allow(SENDER, TrafficClass::Talk, NOW));
+    ASSERT_FALSE(throttle.allow(SENDER, TrafficClass::Talk, NOW));
+}
+
+}
@@ -0,0 +1,22 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeConnection/IngressThrottle.hpp"
+
+namespace bts
+{
+
+class IngressThrottleTestSuite : public ::testing::Test
+{
+protected:
+    IngressThrottleTestSuite();
+
+    const common::PhoneNumber SENDER{11};
+    const common::PhoneNumber OTHER_SENDER{12};
+    const IngressThrottle::Clock::time_point NOW{};
+    const IngressThrottle::Budget SMS_BUDGET{1.0, 2.0};
+
+    IngressThrottle objectUnderTest;
+};
+
+}
@@ -14,9 +14,12 @@ public:
 
     MOCK_METHOD(IConsole&, getConsole, (), (final));
     MOCK_METHOD(void, registerUeConnectedCallback, (UeConnectedCallback), (final));
+    MOCK_METHOD(void, registerHandoffCallbacks, (UeTakenOverCallback, UeAttachmentsProvider), (final));
     MOCK_METHOD(ILogger&, getLogger, (), (final));
     MOCK_METHOD(BtsId, getBtsId, (), (const, final));
     MOCK_METHOD(std::string, getAddress, (), (const, final));
+    MOCK_METHOD(int32_t, getProperty, (const std::string &name, int32_t defaultValue), (const, final));
+    MOCK_METHOD(void, runInMessageLoop, (std::function<void()> task), (final));
     MOCK_METHOD(void, startMessageLoop, (), (final));
 };
 
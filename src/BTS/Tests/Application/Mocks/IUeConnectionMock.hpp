@@ -14,10 +14,14 @@ public:
     ~IUeConnectionMock() override;
 
     MOCK_METHOD(void, start, (UeSlot ueSlot), (final));
-    MOCK_METHOD(void, sendMessage, (BinaryMessage message), (final));
+    MOCK_METHOD(bool, sendMessage, (BinaryMessage message), (final));
     MOCK_METHOD(void, sendSib, (BtsId btsId), (final));
+    MOCK_METHOD(void, receiveMessage, (BinaryMessage message), (final));
     MOCK_METHOD(PhoneNumber, getPhoneNumber, (), (const, final));
     MOCK_METHOD(bool, isAttached, (), (const, final));
+    MOCK_METHOD(ITransportPtr, getTransport, (), (const, final));
+    MOCK_METHOD(EgressStats, getEgressStats, (), (const, final));
+    MOCK_METHOD(void, setTalkPeer, (IUeConnection* peer), (final));
     MOCK_METHOD(void, print, (std::ostream&), (const, final));
 };
 
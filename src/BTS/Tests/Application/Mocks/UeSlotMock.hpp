@@ -18,6 +18,8 @@ public:
     MOCK_METHOD(bool, isAttached, (), (const, final));
     MOCK_METHOD(PhoneNumber, getPhoneNumber, (), (const, final));
     MOCK_METHOD(void, remove, (), (final));
+    MOCK_METHOD(void, trackCall, (const common::MessageHeader& header), (final));
+    MOCK_METHOD(void, deliverStored, (), (final));
 };
 
 
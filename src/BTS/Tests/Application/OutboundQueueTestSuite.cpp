@@ -0,0 +1,151 @@
+#include "OutboundQueueTestSuite.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+BinaryMessage OutboundQueueTestSuite::makeMessage(std::size_t size, std::uint8_t tag)
+{
+    BinaryMessage message{BinaryMessage::Value(size, tag)};
+    message.value[0] = common::get(common::MessageId::Sms);
+    return message;
+}
+
+BinaryMessage OutboundQueueTestSuite::makeMessage(common::MessageId messageId, std::uint8_t tag)
+{
+    BinaryMessage message{BinaryMessage::Value(MESSAGE_SIZE, tag)};
+    message.value[0] = common::get(messageId);
+    return message;
+}
+
+OutboundQueue::Now OutboundQueueTestSuite::fakeClock()
+{
+    return [this] { return currentTime; };
+}
+
+TEST_F(OutboundQueueTestSuite, shallKeepOrderAndCountBytes)
+{
+    OutboundQueue objectUnderTest;
+    ASSERT_TRUE(objectUnderTest.push(makeMessage(MESSAGE_SIZE, 1)));
+    ASSERT_TRUE(objectUnderTest.push(makeMessage(MESSAGE_SIZE, 2)));
+    ASSERT_EQ(2u * MESSAGE_SIZE, objectUnderTest.bytes());
+
+    ASSERT_EQ(makeMessage(MESSAGE_SIZE, 1).value, objectUnderTest.pop()->value);
+    ASSERT_EQ(makeMessage(MESSAGE_SIZE, 2).value, objectUnderTest.pop()->value);
+    ASSERT_FALSE(objectUnderTest.pop());
+    ASSERT_EQ(0u, objectUnderTest.bytes());
+}
+
+TEST_F(OutboundQueueTestSuite, shallRejectWhenBusyUntilLowWatermark)
+{
+    OutboundQueue objectUnderTest({HIGH_WATERMARK, LOW_WATERMARK, OutboundQueue::Policy::Reject});
+    while (not objectUnderTest.isBusy())
+    {
+        ASSERT_TRUE(objectUnderTest.push(makeMessage(MESSAGE_SIZE, 0)));
+    }
+    ASSERT_EQ(4u, objectUnderTest.size());
+    ASSERT_FALSE(objectUnderTest.push(makeMessage(1u, 0)));
+    ASSERT_EQ(1u, objectUnderTest.rejectedCount());
+
+    objectUnderTest.pop();
+    objectUnderTest.pop();
+    ASSERT_TRUE(objectUnderTest.isBusy()) << "still above low watermark";
+    objectUnderTest.pop();
+    ASSERT_FALSE(objectUnderTest.isBusy());
+    ASSERT_TRUE(objectUnderTest.push(makeMessage(1u, 0)));
+}
+
+TEST_F(OutboundQueueTestSuite, shallDropOldestToStayBelowHighWatermark)
+{
+    OutboundQueue objectUnderTest({HIGH_WATERMARK, LOW_WATERMARK, OutboundQueue::Policy::DropOldest});
+    for (std::uint8_t tag = 1; tag <= 5; ++tag)
+    {
+        ASSERT_TRUE(objectUnderTest.push(makeMessage(MESSAGE_SIZE, tag)));
+    }
+    ASSERT_EQ(3u, objectUnderTest.size());
+    ASSERT_EQ(2u, objectUnderTest.droppedCount());
+    ASSERT_EQ(makeMessage(MESSAGE_SIZE, 3).value, objectUnderTest.pop()->value);
+}
+
+TEST_F(OutboundQueueTestSuite, shallAcceptSingleMessageAboveLimit)
+{
+    OutboundQueue objectUnderTest({HIGH_WATERMARK, LOW_WATERMARK, OutboundQueue::Policy::DropOldest});
+    ASSERT_TRUE(objectUnderTest.push(makeMessage(2u * HIGH_WATERMARK, 1)));
+    ASSERT_EQ(1u, objectUnderTest.size());
+    ASSERT_EQ(0u, objectUnderTest.droppedCount());
+}
+
+TEST_F(OutboundQueueTestSuite, shallSendControlFirst)
+{
+    OutboundQueue objectUnderTest;
+    objectUnderTest.push(makeMessage(common::MessageId::Sms, 1));
+    objectUnderTest.push(makeMessage(common::MessageId::CallTalk, 2));
+    objectUnderTest.push(makeMessage(common::MessageId::CallRequest, 3));
+
+    ASSERT_EQ(makeMessage(common::MessageId::CallRequest, 3).value, objectUnderTest.pop()->value);
+}
+
+TEST_F(OutboundQueueTestSuite, shallShareBulkByWeights)
+{
+    OutboundQueue objectUnderTest({HIGH_WATERMARK * 10u, LOW_WATERMARK, OutboundQueue::Policy::Reject, 2u, 1u});
+    for (std::uint8_t tag = 1; tag <= 3; ++tag)
+    {
+        objectUnderTest.push(makeMessage(common::MessageId::Sms, tag));
+        objectUnderTest.push(makeMessage(common::MessageId::CallTalk, tag));
+    }
+
+    std::vector<std::uint8_t> order;
+    while (auto message = objectUnderTest.pop())
+    {
+        order.push_back(message->value[0]);
+    }
+    const auto SMS = common::get(common::MessageId::Sms);
+    const auto TALK = common::get(common::MessageId::CallTalk);
+    ASSERT_THAT(order, ElementsAre(TALK, TALK, SMS, TALK, SMS, SMS));
+}
+
+TEST_F(OutboundQueueTestSuite, shallAcceptControlWhenBusy)
+{
+    OutboundQueue objectUnderTest({HIGH_WATERMARK, LOW_WATERMARK, OutboundQueue::Policy::Reject});
+    while (not objectUnderTest.isBusy())
+    {
+        objectUnderTest.push(makeMessage(MESSAGE_SIZE, 0));
+    }
+    ASSERT_FALSE(objectUnderTest.push(makeMessage(common::MessageId::CallTalk, 0)));
+    ASSERT_TRUE(objectUnderTest.push(makeMessage(common::MessageId::CallDropped, 0)));
+}
+
+TEST_F(OutboundQueueTestSuite, shallDropTalkBeforeSmsButKeepControl)
+{
+    OutboundQueue objectUnderTest({HIGH_WATERMARK, LOW_WATERMARK, OutboundQueue::Policy::DropOldest});
+    objectUnderTest.push(makeMessage(common::MessageId::AttachResponse, 1));
+    objectUnderTest.push(makeMessage(common::MessageId::CallRequest, 2));
+    objectUnderTest.push(makeMessage(common::MessageId::CallTalk, 3));
+    objectUnderTest.push(makeMessage(common::MessageId::Sms, 4));
+
+    ASSERT_EQ(1u, objectUnderTest.droppedCount());
+    ASSERT_EQ(3u, objectUnderTest.size());
+    ASSERT_EQ(makeMessage(common::MessageId::AttachResponse, 1).value, objectUnderTest.pop()->value);
+    ASSERT_EQ(makeMessage(common::MessageId::CallRequest, 2).value, objectUnderTest.pop()->value);
+    ASSERT_EQ(makeMessage(common::MessageId::Sms, 4).value, objectUnderTest.pop()->value);
+}
+
+TEST_F(OutboundQueueTestSuite, shallGatherLatencyPerClass)
+{
+    OutboundQueue objectUnderTest({}, fakeClock());
+    objectUnderTest.push(makeMessage(common::MessageId::Sms, 1));
+    objectUnderTest.recordSentDirectly(makeMessage(common::MessageId::CallAccepted, 2));
+    currentTime += std::chrono::milliseconds(10);
+    objectUnderTest.pop();
+
+    const auto& stats = objectUnderTest.stats();
+    const auto& sms = stats[static_cast<std::size_t>(TrafficClass::Sms)];
+    const auto& control = stats[static_cast<std::size_t>(TrafficClass::Control)];
+    ASSERT_EQ(1u, sms.count);
+    ASSERT_EQ(std::chrono::milliseconds(10), sms.max);
+    ASSERT_EQ(1u, control.count);
+    ASSERT_EQ(LatencyStats::Duration{}, control.max);
+}
+
+}
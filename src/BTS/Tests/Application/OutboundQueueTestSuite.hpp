@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeConnection/OutboundQueue.hpp"
+#include "Messages/MessageId.hpp"
+
+namespace bts
+{
+
+class OutboundQueueTestSuite : public ::testing::Test
+{
+protected:
+    static BinaryMessage makeMessage(std::size_t size, std::uint8_t tag);
+    static BinaryMessage makeMessage(common::MessageId messageId, std::uint8_t tag);
+    OutboundQueue::Now fakeClock();
+
+    static constexpr std::size_t HIGH_WATERMARK = 100u;
+    static constexpr std::size_t LOW_WATERMARK = 40u;
+    static constexpr std::size_t MESSAGE_SIZE = 30u;
+
+    OutboundQueue::Clock::time_point currentTime{};
+};
+
+}
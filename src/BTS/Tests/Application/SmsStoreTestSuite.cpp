@@ -0,0 +1,98 @@
+#include "SmsStoreTestSuite.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+SmsStore::Limits SmsStoreTestSuite::makeLimits()
+{
+    return SmsStore::Limits{PER_RECIPIENT, TOTAL_BYTES, TTL};
+}
+
+common::BinaryMessage SmsStoreTestSuite::makeSms(std::uint8_t tag)
+{
+    return common::BinaryMessage{{common::get(common::MessageId::Sms), 0, 1, tag}};
+}
+
+TEST_F(SmsStoreTestSuite, shallGiveBackStoredInOrder)
+{
+    ASSERT_TRUE(objectUnderTest.store(RECIPIENT, makeSms(1), NOW));
+    ASSERT_TRUE(objectUnderTest.store(RECIPIENT, makeSms(2), NOW));
+
+    auto messages = objectUnderTest.take(RECIPIENT, NOW);
+
+    ASSERT_EQ(2u, messages.size());
+    ASSERT_EQ(makeSms(1).value, messages[0].value);
+    ASSERT_EQ(makeSms(2).value, messages[1].value);
+    ASSERT_THAT(objectUnderTest.take(RECIPIENT, NOW), IsEmpty());
+    ASSERT_EQ(0u, objectUnderTest.storedCount());
+    ASSERT_EQ(0u, objectUnderTest.storedBytes());
+}
+
+TEST_F(SmsStoreTestSuite, shallRefuseAbovePerRecipientLimit)
+{
+    objectUnderTest.store(RECIPIENT, makeSms(1), NOW);
+    objectUnderTest.store(RECIPIENT, makeSms(2), NOW);
+
+    ASSERT_FALSE(objectUnderTest.store(RECIPIENT, makeSms(3), NOW));
+    ASSERT_TRUE(objectUnderTest.store(OTHER_RECIPIENT, makeSms(3), NOW));
+}
+
+TEST_F(SmsStoreTestSuite, shallRefuseAboveTotalBytes)
+{
+    objectUnderTest.store(RECIPIENT, makeSms(1), NOW);
+    objectUnderTest.store(RECIPIENT, makeSms(2), NOW);
+    objectUnderTest.store(OTHER_RECIPIENT, makeSms(3), NOW);
+
+    ASSERT_FALSE(objectUnderTest.store(OTHER_RECIPIENT, makeSms(4), NOW));
+    ASSERT_EQ(TOTAL_BYTES, objectUnderTest.storedBytes());
+}
+
+TEST_F(SmsStoreTestSuite, shallNotGiveBackExpired)
+{
+    objectUnderTest.store(RECIPIENT, makeSms(1), NOW);
+    objectUnderTest.store(RECIPIENT, makeSms(2), NOW + TTL / 2);
+
+    auto messages = objectUnderTest.take(RECIPIENT, NOW + TTL);
+
+    ASSERT_EQ(1u, messages.size());
+    ASSERT_EQ(makeSms(2).value, messages[0].value);
+    ASSERT_EQ(1u, objectUnderTest.expiredCount());
+}
+
+TEST_F(SmsStoreTestSuite, shallMakeRoomByForgettingExpired)
+{
+    objectUnderTest.store(RECIPIENT, makeSms(1), NOW);
+    objectUnderTest.store(RECIPIENT, makeSms(2), NOW);
+    objectUnderTest.store(OTHER_RECIPIENT, makeSms(3), NOW);
+
+    ASSERT_TRUE(objectUnderTest.store(OTHER_RECIPIENT, makeSms(4), NOW + TTL));
+    ASSERT_EQ(1u, objectUnderTest.storedCount());
+    ASSERT_EQ(3u, objectUnderTest.expiredCount());
+}
+
+TEST_F(SmsStoreTestSuite, shallStoreNothingWhenDisabled)
+{
+    SmsStore disabled{SmsStore::Limits{0u, TOTAL_BYTES, TTL}};
+
+    ASSERT_FALSE(disabled.isEnabled());
+    ASSERT_FALSE(disabled.store(RECIPIENT, makeSms(1), NOW));
+}
+
+TEST_F(SmsStoreTestSuite, shallKeepNotDeliveredInOrder)
+{
+    objectUnderTest.store(RECIPIENT, makeSms(1), NOW);
+    objectUnderTest.store(RECIPIENT, makeSms(2), NOW);
+    StrictMock<MockFunction<bool(common::BinaryMessage)>> send;
+
+    EXPECT_CALL(send, Call(Field(&common::BinaryMessage::value, makeSms(1).value))).WillOnce(Return(true));
+    EXPECT_CALL(send, Call(Field(&common::BinaryMessage::value, makeSms(2).value))).WillOnce(Return(false));
+    ASSERT_EQ(1u, objectUnderTest.deliver(RECIPIENT, NOW, send.AsStdFunction()));
+
+    auto messages = objectUnderTest.take(RECIPIENT, NOW);
+    ASSERT_EQ(1u, messages.size());
+    ASSERT_EQ(makeSms(2).value, messages[0].value);
+}
+
+}
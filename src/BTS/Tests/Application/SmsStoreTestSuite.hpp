@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "UeRelay/SmsStore.hpp"
+#include "Messages/MessageId.hpp"
+
+namespace bts
+{
+
+class SmsStoreTestSuite : public ::testing::Test
+{
+protected:
+    static SmsStore::Limits makeLimits();
+    static common::BinaryMessage makeSms(std::uint8_t tag);
+
+    static constexpr std::size_t PER_RECIPIENT = 2u;
+    static constexpr std::size_t SMS_SIZE = 4u;
+    static constexpr std::size_t TOTAL_BYTES = 3u * SMS_SIZE;
+    static constexpr std::chrono::seconds TTL{60};
+    const SmsStore::Clock::time_point NOW{};
+    const common::PhoneNumber RECIPIENT{1};
+    const common::PhoneNumber OTHER_RECIPIENT{2};
+
+    SmsStore objectUnderTest{makeLimits()};
+};
+
+}
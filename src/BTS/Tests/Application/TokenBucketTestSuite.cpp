@@ -0,0 +1,31 @@
+#include "TokenBucketTestSuite.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+TEST_F(TokenBucketTestSuite, shallAllowBurstAtOnce)
+{
+    for (int i = 0; i < BURST; ++i)
+    {
+        ASSERT_TRUE(objectUnderTest.tryTake(START));
+    }
+    ASSERT_FALSE(objectUnderTest.tryTake(START));
+}
+
+TEST_F(TokenBucketTestSuite, shallRefillWithRate)
+{
+    while (objectUnderTest.tryTake(START))
+    {}
+    ASSERT_FALSE(objectUnderTest.tryTake(START + TOKEN_PERIOD / 2));
+    ASSERT_TRUE(objectUnderTest.tryTake(START + TOKEN_PERIOD));
+    ASSERT_FALSE(objectUnderTest.tryTake(START + TOKEN_PERIOD));
+}
+
+TEST_F(TokenBucketTestSuite, shallNotRefillAboveBurst)
+{
+    ASSERT_DOUBLE_EQ(BURST, objectUnderTest.available(START + 100 * TOKEN_PERIOD));
+}
+
+}
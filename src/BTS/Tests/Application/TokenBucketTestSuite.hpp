@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "TokenBucket.hpp"
+
+namespace bts
+{
+
+class TokenBucketTestSuite : public ::testing::Test
+{
+protected:
+    static constexpr double RATE = 10.0;
+    static constexpr double BURST = 3.0;
+    const TokenBucket::Clock::time_point START{};
+    // one token refilled
+    const std::chrono::milliseconds TOKEN_PERIOD{100};
+
+    TokenBucket objectUnderTest{RATE, BURST, START};
+};
+
+}
@@ -1,5 +1,6 @@
 #include "UeConnectionSpawnerTestSuite.hpp"
 #include "Messages/MessageHeader.hpp"
+#include "Mocks/UeSlotMock.hpp"
 
 using namespace ::testing;
 
@@ -24,6 +25,8 @@ void UeConnectionSpawnerTestSuite::setUpEnvironmentMock()
 void UeConnectionSpawnerTestSuite::expectRegisterCallback()
 {
     EXPECT_CALL(environmentMock, registerUeConnectedCallback(_)).WillOnce(SaveArg<0>(&ueConnectedCallback));
+    EXPECT_CALL(environmentMock, registerHandoffCallbacks(_, _)).WillOnce(DoAll(SaveArg<0>(&ueTakenOverCallback),
+                                                                               SaveArg<1>(&ueAttachmentsProvider)));
 }
 
 TEST_F(UeConnectionSpawnerTestSuite, shallRegisterOnStart)
@@ -31,6 +34,8 @@ TEST_F(UeConnectionSpawnerTestSuite, shallRegisterOnStart)
     expectRegisterCallback();
     objectUnderTest->start();
     ASSERT_NE(nullptr, ueConnectedCallback);
+    ASSERT_NE(nullptr, ueTakenOverCallback);
+    ASSERT_NE(nullptr, ueAttachmentsProvider);
 }
 
 TEST_F(UeConnectionSpawnerTestSuite, shallDeregisterOnStop)
@@ -38,6 +43,8 @@ TEST_F(UeConnectionSpawnerTestSuite, shallDeregisterOnStop)
     expectRegisterCallback();
     objectUnderTest->stop();
     ASSERT_FALSE(ueConnectedCallback);
+    ASSERT_FALSE(ueTakenOverCallback);
+    ASSERT_FALSE(ueAttachmentsProvider);
 }
 
 
@@ -92,4 +99,167 @@ TEST_F(UeConnectionStartedSpawnerTestSuite, shallSpawnConnectionOnNewTransport)
     onNewConnectionCallback();
 }
 
+TEST_F(UeConnectionStartedSpawnerTestSuite, shallTakeOverAttachedConnectionAndSendSibToAttachAgain)
+{
+    auto ueSlotImplMock = std::make_shared<StrictMock<IUeSlotImplMock>>();
+    auto attachedSlotImplMock = std::make_shared<StrictMock<IUeSlotImplMock>>();
+    expectUeCreated();
+    EXPECT_CALL(*ueRelayMock, add(_)).WillOnce([&](auto p_arg)
+    {
+        this->ueConnection = std::move(p_arg);
+        return UeSlot(ueSlotImplMock);
+    });
+    EXPECT_CALL(*ueSlotImplMock, attach(PHONE_NUMBER)).WillOnce(Return(attachedSlotImplMock));
+    EXPECT_CALL(*ueConnectionMock, start(_));
+    expectSibSent();
+
+    ueTakenOverCallback({transportMock, PHONE_NUMBER});
+}
+
+TEST_F(UeConnectionStartedSpawnerTestSuite, shallTakeOverNotAttachedConnection)
+{
+    auto ueSlotImplMock = std::make_shared<StrictMock<IUeSlotImplMock>>();
+    expectUeCreated();
+    EXPECT_CALL(*ueRelayMock, add(_)).WillOnce([&](auto p_arg)
+    {
+        this->ueConnection = std::move(p_arg);
+        return UeSlot(ueSlotImplMock);
+    });
+    EXPECT_CALL(*ueConnectionMock, start(_));
+
+    ueTakenOverCallback({transportMock, PhoneNumber{}});
+}
+
+TEST_F(UeConnectionStartedSpawnerTestSuite, shallCollectAllConnections)
+{
+    auto notAttachedTransportMock = std::make_shared<StrictMock<common::ITransportMock>>();
+    StrictMock<IUeConnectionMock> notAttachedUeMock;
+    EXPECT_CALL(*ueRelayMock, count()).WillOnce(Return(2u));
+    EXPECT_CALL(*ueRelayMock, visitAttachedUe(_)).WillOnce([&](auto visitor) { visitor(*ueConnectionMock); });
+    EXPECT_CALL(*ueRelayMock, visitNotAttachedUe(_)).WillOnce([&](auto visitor) { visitor(notAttachedUeMock); });
+    EXPECT_CALL(*ueConnectionMock, getTransport()).WillOnce(Return(transportMock));
+    EXPECT_CALL(*ueConnectionMock, getPhoneNumber()).WillOnce(Return(PHONE_NUMBER));
+    EXPECT_CALL(notAttachedUeMock, getTransport()).WillOnce(Return(notAttachedTransportMock));
+    EXPECT_CALL(notAttachedUeMock, getPhoneNumber()).WillOnce(Return(PhoneNumber{}));
+
+    const UeAttachments attachments = ueAttachmentsProvider();
+
+    ASSERT_THAT(attachments, ElementsAre(UeAttachment(transportMock, PHONE_NUMBER),
+                                         UeAttachment(notAttachedTransportMock, PhoneNumber{})));
+}
+
+UeConnectionSpawnerAdmissionTestSuite::UeConnectionSpawnerAdmissionTestSuite()
+{
+    objectUnderTest = std::make_unique<UeConnectionSpawner>(environmentMock, ueConnectionFactoryMock, ueRelayMock, syncGuard,
+                                                            ADMISSION_LIMITS, ADMISSION_TICK);
+    EXPECT_CALL(*ueConnectionFactoryMock, createConnection(_)).WillRepeatedly([this](auto&&)
+    {
+        ++createdCount;
+        return std::make_unique<NiceMock<IUeConnectionMock>>();
+    });
+    EXPECT_CALL(*ueRelayMock, add(_)).WillRepeatedly([this](auto connection)
+    {
+        addedConnections.push_back(std::move(connection));
+        return UeSlot{};
+    });
+    EXPECT_CALL(environmentMock, runInMessageLoop(_)).WillRepeatedly([](auto task) { task(); });
+    expectRegisterCallback();
+    objectUnderTest->start();
+}
+
+UeConnectionSpawnerAdmissionTestSuite::~UeConnectionSpawnerAdmissionTestSuite()
+{
+    objectUnderTest.reset();
+}
+
+std::shared_ptr<common::ITransportMock> UeConnectionSpawnerAdmissionTestSuite::makeTransport()
+{
+    return std::make_shared<NiceMock<common::ITransportMock>>();
+}
+
+bool UeConnectionSpawnerAdmissionTestSuite::waitForCreatedCount(int expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + MAX_WAIT;
+    while (createdCount < expected and std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(ADMISSION_TICK);
+    }
+    return createdCount == expected;
+}
+
+TEST_F(UeConnectionSpawnerAdmissionTestSuite, shallDeferConnectionAboveAcceptRate)
+{
+    auto deferred = makeTransport();
+    EXPECT_CALL(*deferred, registerDisconnectedCallback(_));
+
+    ueConnectedCallback(makeTransport());
+    ueConnectedCallback(deferred);
+    ASSERT_EQ(1, createdCount);
+
+    ASSERT_TRUE(waitForCreatedCount(2));
+}
+
+TEST_F(UeConnectionSpawnerAdmissionTestSuite, shallRejectConnectionWhenTooManyPending)
+{
+    ueConnectedCallback(makeTransport());
+    ueConnectedCallback(makeTransport());
+    auto rejected = makeTransport();
+    ueConnectedCallback(rejected);
+
+    ASSERT_TRUE(waitForCreatedCount(2));
+    std::this_thread::sleep_for(2 * ADMISSION_TICK);
+    ASSERT_EQ(2, createdCount);
+    ASSERT_EQ(1, rejected.use_count()) << "not kept anywhere";
+}
+
+TEST_F(UeConnectionSpawnerAdmissionTestSuite, shallCloseRejectedConnection)
+{
+    auto rejected = makeTransport();
+    EXPECT_CALL(*rejected, close());
+
+    ueConnectedCallback(makeTransport());
+    ueConnectedCallback(makeTransport());
+    ueConnectedCallback(rejected);
+}
+
+TEST_F(UeConnectionSpawnerAdmissionTestSuite, shallForgetDeferredConnectionOnDisconnect)
+{
+    auto deferred = makeTransport();
+    ITransport::DisconnectedCallback disconnectedCallback;
+    EXPECT_CALL(*deferred, registerDisconnectedCallback(_)).WillOnce(SaveArg<0>(&disconnectedCallback))
+                                                          .WillRepeatedly(Return());
+
+    ueConnectedCallback(makeTransport());
+    ueConnectedCallback(deferred);
+    ASSERT_TRUE(disconnectedCallback);
+    disconnectedCallback();
+
+    ASSERT_EQ(1, deferred.use_count());
+    ASSERT_EQ(1, createdCount);
+}
+
+TEST_F(UeConnectionSpawnerAdmissionTestSuite, shallPassInputReceivedBeforeAdmission)
+{
+    const BinaryMessage ATTACH_REQUEST{{common::get(common::MessageId::AttachRequest), 1, 0}};
+    auto deferred = makeTransport();
+    ITransport::MessageCallback messageCallback;
+    EXPECT_CALL(*deferred, registerMessageCallback(_)).WillOnce(SaveArg<0>(&messageCallback));
+    auto deferredUe = std::make_unique<NiceMock<IUeConnectionMock>>();
+    EXPECT_CALL(*deferredUe, receiveMessage(Field(&BinaryMessage::value, ATTACH_REQUEST.value)));
+    EXPECT_CALL(*deferredUe, isAttached()).WillOnce(Return(true));
+    EXPECT_CALL(*deferredUe, sendSib(_)).Times(0);
+    EXPECT_CALL(*ueConnectionFactoryMock, createConnection(Eq(deferred))).WillOnce([&](auto&&)
+    {
+        ++createdCount;
+        return std::move(deferredUe);
+    });
+
+    ueConnectedCallback(makeTransport());
+    ueConnectedCallback(deferred);
+    ASSERT_TRUE(messageCallback);
+    messageCallback(ATTACH_REQUEST);
+
+    ASSERT_TRUE(waitForCreatedCount(2));
+}
+
 }
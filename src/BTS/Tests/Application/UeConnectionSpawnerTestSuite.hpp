@@ -29,6 +29,8 @@ protected:
     std::shared_ptr<IUeRelayMock> ueRelayMock;
     std::shared_ptr<IUeConnectionFactoryMock> ueConnectionFactoryMock;
     UeConnectedCallback ueConnectedCallback;
+    UeTakenOverCallback ueTakenOverCallback;
+    UeAttachmentsProvider ueAttachmentsProvider;
     IUeRelay::UePtr ueConnection;
 
     std::unique_ptr<UeConnectionSpawner> objectUnderTest;
@@ -48,6 +50,7 @@ protected:
 
     const UeSlot UE_SLOT;
     const std::string TRANSPORT_ADDRESS = "ABCDEF";
+    const PhoneNumber PHONE_NUMBER{112};
 
     std::shared_ptr<common::ITransportMock> transportMock;
     std::unique_ptr<IUeConnectionMock> ueConnectionMockPtr = std::make_unique<IUeConnectionMock>();
@@ -56,5 +59,22 @@ protected:
 
 };
 
+class UeConnectionSpawnerAdmissionTestSuite : public UeConnectionSpawnerTestSuite
+{
+protected:
+    UeConnectionSpawnerAdmissionTestSuite();
+    ~UeConnectionSpawnerAdmissionTestSuite();
+
+    std::shared_ptr<common::ITransportMock> makeTransport();
+    bool waitForCreatedCount(int expected);
+
+    // one at once, next after 100ms
+    const AdmissionControl::Limits ADMISSION_LIMITS{10.0, 1.0, 1u};
+    const std::chrono::milliseconds ADMISSION_TICK{5};
+    const std::chrono::milliseconds MAX_WAIT{1000};
+
+    std::atomic_int createdCount{0};
+    std::vector<IUeRelay::UePtr> addedConnections;
+};
 
 }
@@ -1,6 +1,9 @@
 #include "UeConnectionTestSuite.hpp"
 #include "Messages/IncomingMessage.hpp"
 #include "Messages/OutgoingMessage.hpp"
+#include "Messages/MessageBatch.hpp"
+#include "Messages/MessageCompression.hpp"
+#include "Messages/AttachFeature.hpp"
 #include "Mocks/UeSlotMock.hpp"
 
 using namespace ::testing;
@@ -9,6 +12,8 @@ namespace bts
 {
 using common::IncomingMessage;
 using common::OutgoingMessage;
+using common::MessageBatch;
+using common::AttachFeature;
 
 namespace
 {
@@ -55,7 +60,10 @@ UeConnectionTestSuite::UeConnectionTestSuite()
     ueSlotReattachedMock = std::make_shared<StrictMock<IUeSlotImplMock>>();
     syncGuard = std::make_shared<SyncGuard>();
     transportMock = std::make_shared<StrictMock<common::ITransportMock>>();
-    objectUnderTest = std::make_unique<UeConnection>(transportMock, loggerMock, syncGuard);
+    ingressThrottle = std::make_shared<IngressThrottle>(IngressThrottle::Budgets{});
+    ingressThrottle->setBudget(TrafficClass::Sms, SMS_BUDGET);
+    objectUnderTest = std::make_unique<UeConnection>(transportMock, loggerMock, syncGuard, OUTBOUND_LIMITS, CREDIT_WINDOW,
+                                                     ingressThrottle);
     verifyAndClearExpectations();
 }
 
@@ -82,12 +90,18 @@ void UeConnectionTestSuite::assertDestruction()
     objectUnderTest.reset();
     ASSERT_FALSE(ueDisconnectedCallback);
     ASSERT_FALSE(ueMessageCallback);
+    ASSERT_FALSE(backpressureCallback);
     verifyAndClearExpectations();
 }
 
 void UeConnectionTestSuite::TearDown()
 {
     assertDestruction();
+    // expectations in sequence keep each other - slot returned by attach would never be released
+    Mock::VerifyAndClearExpectations(ueSlotNotAttachedMock.get());
+    Mock::VerifyAndClearExpectations(ueSlotFailedAttachedMock.get());
+    Mock::VerifyAndClearExpectations(ueSlotAttachedMock.get());
+    Mock::VerifyAndClearExpectations(ueSlotReattachedMock.get());
     Test::TearDown();
 }
 
@@ -95,6 +109,7 @@ void UeConnectionTestSuite::expectRegisterCallbacks()
 {
     EXPECT_CALL(*transportMock, registerDisconnectedCallback(_)).WillOnce(SaveArg<0>(&ueDisconnectedCallback));
     EXPECT_CALL(*transportMock, registerMessageCallback(_)).WillOnce(SaveArg<0>(&ueMessageCallback));
+    EXPECT_CALL(*transportMock, registerBackpressureCallback(_)).WillOnce(SaveArg<0>(&backpressureCallback));
 }
 
 void UeConnectionTestSuite::verifyAndClearExpectations()
@@ -183,6 +198,7 @@ TEST_F(UeConnectionWithConnectedTransportTestSuite, shallAcceptAttachOnRequestFr
     InSequence seq;
     EXPECT_CALL(*ueSlotNotAttachedMock, attach(PHONE)).WillOnce(Return(ueSlotAttachedMock));
     EXPECT_CALL(*transportMock, sendMessage(eqAttachResponseMessage(true)));
+    EXPECT_CALL(*ueSlotAttachedMock, deliverStored());
 
     handleAttachRequest(PHONE);
     ASSERT_EQ(PHONE, objectUnderTest->getPhoneNumber());
@@ -215,6 +231,46 @@ TEST_F(UeConnectionWithConnectedTransportTestSuite, shallIndicateUnknownSenderFo
     ueMessageCallback(otherThanAttachRequestMessage);
 }
 
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallQueueMessagesWhileTransportCongested)
+{
+    const BinaryMessage MESSAGE{ {1, 2, 3} };
+    backpressureCallback(true);
+    ASSERT_TRUE(objectUnderTest->sendMessage(MESSAGE));
+
+    EXPECT_CALL(*transportMock, sendMessage(Field(&BinaryMessage::value, MESSAGE.value)));
+    backpressureCallback(false);
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallRejectMessagesWhenQueueBusy)
+{
+    // bulk - control messages are never rejected
+    const BinaryMessage MESSAGE{ BinaryMessage::Value(OUTBOUND_LIMITS.highWatermark / 2u, common::get(MessageId::Sms)) };
+    backpressureCallback(true);
+    ASSERT_TRUE(objectUnderTest->sendMessage(MESSAGE));
+    ASSERT_TRUE(objectUnderTest->sendMessage(MESSAGE));
+    ASSERT_FALSE(objectUnderTest->sendMessage(MESSAGE));
+
+    EXPECT_CALL(*transportMock, sendMessage(_)).Times(3);
+    backpressureCallback(false);
+    ASSERT_TRUE(objectUnderTest->sendMessage(MESSAGE)) << "sent directly";
+}
+
+TEST_F(UeConnectionWithConnectedTransportTestSuite, shallStopDrainingWhenTransportCongestedAgain)
+{
+    const BinaryMessage FIRST{ {1} };
+    const BinaryMessage SECOND{ {2} };
+    backpressureCallback(true);
+    objectUnderTest->sendMessage(FIRST);
+    objectUnderTest->sendMessage(SECOND);
+
+    EXPECT_CALL(*transportMock, sendMessage(Field(&BinaryMessage::value, FIRST.value)))
+            .WillOnce(InvokeWithoutArgs([this] { backpressureCallback(true); return true; }));
+    backpressureCallback(false);
+
+    EXPECT_CALL(*transportMock, sendMessage(Field(&BinaryMessage::value, SECOND.value)));
+    backpressureCallback(false);
+}
+
 TEST_F(UeConnectionWithConnectedTransportTestSuite, shallPrintAsNotAttached)
 {
     std::ostringstream os;
@@ -231,10 +287,33 @@ UeConnectionAttachedTestSuite::UeConnectionAttachedTestSuite()
     UeConnectionWithConnectedTransportTestSuite::SetUp();
     EXPECT_CALL(*ueSlotNotAttachedMock, attach(PHONE)).WillOnce(Return(ueSlotAttachedMock));
     EXPECT_CALL(*transportMock, sendMessage(eqAttachResponseMessage(true)));
+    EXPECT_CALL(*ueSlotAttachedMock, deliverStored());
     handleAttachRequest(PHONE);
     verifyAndClearExpectations();
 }
 
+void UeConnectionAttachedTestSuite::handleCreditRequest()
+{
+    OutgoingMessage creditRequestBuilder(MessageId::CreditRequest, PHONE, PhoneNumber{});
+    ueMessageCallback(creditRequestBuilder.getMessage());
+}
+
+void UeConnectionAttachedTestSuite::negotiateBatching()
+{
+    OutgoingMessage attachRequestBuilder(MessageId::AttachRequest, PHONE, PhoneNumber{});
+    attachRequestBuilder.writeBtsId(BTS_ID);
+    attachRequestBuilder.writeNumber(common::get(AttachFeature::Batching));
+    EXPECT_CALL(*transportMock, sendMessage(AllOf(eqAttachResponseMessage(true),
+                                                  EqMessageNumber(HEADER_SIZE + 1u, common::get(AttachFeature::Batching)))));
+    ueMessageCallback(attachRequestBuilder.getMessage());
+}
+
+auto UeConnectionAttachedTestSuite::eqCreditGrantMessage(std::uint16_t expectedCredits)
+{
+    return AllOf(EqMessageHeader(0, MessageId::CreditGrant, NO_PHONE, PHONE),
+                 EqMessageNumber(HEADER_SIZE, expectedCredits));
+}
+
 TEST_F(UeConnectionAttachedTestSuite, shallCloseConnectionOnDisconnect)
 {
     EXPECT_CALL(*ueSlotAttachedMock, remove());
@@ -251,6 +330,7 @@ TEST_F(UeConnectionAttachedTestSuite, shallReattachOnRequestWithNewPhone)
 {
     EXPECT_CALL(*ueSlotAttachedMock, attach(OTHER_PHONE)).WillOnce(Return(ueSlotReattachedMock));
     EXPECT_CALL(*transportMock, sendMessage(eqAttachResponseMessage(true, OTHER_PHONE)));
+    EXPECT_CALL(*ueSlotReattachedMock, deliverStored());
 
     handleAttachRequest(OTHER_PHONE);
 
@@ -300,6 +380,18 @@ TEST_F(UeConnectionAttachedTestSuite, shallIndicateUnknownRecipientForMessageTha
     ueMessageCallback(otherThanAttachRequestMessage);
 }
 
+TEST_F(UeConnectionAttachedTestSuite, shallCoalesceRepeatedUnknownRecipientIndications)
+{
+    auto otherThanAttachRequestMessage = buildOtherThanAttachRequestMessage();
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(_, OTHER_PHONE)).Times(3).WillRepeatedly(Return(false));
+    EXPECT_CALL(*transportMock, sendMessage(EqMessageHeader(0, MessageId::UnknownRecipient, NO_PHONE, PHONE)));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ueMessageCallback(otherThanAttachRequestMessage);
+    }
+}
+
 TEST_F(UeConnectionAttachedTestSuite, shallIndicateUnknownSenderForMessageThatHasWrongFromPhone)
 {
     auto otherThanAttachRequestMessageWithWrongFromPhone = buildOtherThanAttachRequestMessage(NOT_MY_PHONE);
@@ -319,6 +411,216 @@ TEST_F(UeConnectionAttachedTestSuite, shallHandleExceptionWhenHandlingMessage)
     ueMessageCallback(otherThanAttachRequestMessage);
 }
 
+TEST_F(UeConnectionAttachedTestSuite, shallGrantWindowOnCreditRequest)
+{
+    EXPECT_CALL(*transportMock, sendMessage(eqCreditGrantMessage(CREDIT_WINDOW)));
+    handleCreditRequest();
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallGrantBackCreditsOfForwardedMessages)
+{
+    EXPECT_CALL(*transportMock, sendMessage(eqCreditGrantMessage(CREDIT_WINDOW)));
+    handleCreditRequest();
+
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(_, OTHER_PHONE)).Times(2).WillRepeatedly(Return(true));
+    EXPECT_CALL(*transportMock, sendMessage(eqCreditGrantMessage(CREDIT_WINDOW / 2u)));
+    ueMessageCallback(buildOtherThanAttachRequestMessage());
+    ueMessageCallback(buildOtherThanAttachRequestMessage());
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallDropMessagesSentWithoutCredit)
+{
+    EXPECT_CALL(*transportMock, sendMessage(eqCreditGrantMessage(CREDIT_WINDOW)));
+    handleCreditRequest();
+
+    // no credits granted back while UE does not read
+    backpressureCallback(true);
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(_, OTHER_PHONE)).Times(CREDIT_WINDOW).WillRepeatedly(Return(true));
+    for (int i = 0; i <= CREDIT_WINDOW; ++i)
+    {
+        ueMessageCallback(buildOtherThanAttachRequestMessage());
+    }
+
+    EXPECT_CALL(*transportMock, sendMessage(eqCreditGrantMessage(CREDIT_WINDOW)));
+    backpressureCallback(false);
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallLogMessagesDroppedWithoutCreditOncePerInterval)
+{
+    constexpr int DROPPED = 5;
+    EXPECT_CALL(*transportMock, sendMessage(eqCreditGrantMessage(CREDIT_WINDOW)));
+    handleCreditRequest();
+    backpressureCallback(true);
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(_, OTHER_PHONE)).Times(CREDIT_WINDOW).WillRepeatedly(Return(true));
+    EXPECT_CALL(loggerMock, log(_, _)).Times(AnyNumber());
+    EXPECT_CALL(loggerMock, log(common::ILogger::ERROR_LEVEL, HasSubstr("No credit - dropped"))).Times(1);
+    EXPECT_CALL(loggerMock, log(common::ILogger::ERROR_LEVEL,
+                                AllOf(HasSubstr("No credit"), HasSubstr("before disconnect"),
+                                      HasSubstr(std::to_string(DROPPED - 1)))));
+
+    for (int i = 0; i < CREDIT_WINDOW + DROPPED; ++i)
+    {
+        ueMessageCallback(buildOtherThanAttachRequestMessage());
+    }
+
+    EXPECT_CALL(*ueSlotAttachedMock, remove());
+    handleDisconnect();
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallNotForwardMessagesAboveSenderRateLimit)
+{
+    OutgoingMessage smsBuilder(MessageId::Sms, PHONE, OTHER_PHONE);
+    smsBuilder.writeText("spam");
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(_, OTHER_PHONE)).WillOnce(Return(true));
+    EXPECT_CALL(loggerMock, log(_, _)).Times(AnyNumber());
+    EXPECT_CALL(loggerMock, log(common::ILogger::ERROR_LEVEL, HasSubstr("Throttled"))).Times(1);
+
+    ueMessageCallback(smsBuilder.getMessage());
+    ueMessageCallback(smsBuilder.getMessage());
+    ueMessageCallback(smsBuilder.getMessage());
+
+    ASSERT_EQ(2u, ingressThrottle->throttledCount(TrafficClass::Sms));
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallFanOutGroupSmsAndReportFailedRecipients)
+{
+    const std::uint16_t GROUP_SMS_ID = 0x1234;
+    OutgoingMessage groupSmsBuilder(MessageId::GroupSms, PHONE, NO_PHONE);
+    groupSmsBuilder.writeNumber(GROUP_SMS_ID);
+    groupSmsBuilder.writeNumber(std::uint8_t{2});
+    groupSmsBuilder.writePhoneNumber(OTHER_PHONE);
+    groupSmsBuilder.writePhoneNumber(NOT_MY_PHONE);
+    groupSmsBuilder.writeText("hello all");
+
+    auto eqSms = [this](PhoneNumber to)
+    {
+        OutgoingMessage smsBuilder(MessageId::Sms, PHONE, to);
+        smsBuilder.writeText("hello all");
+        return Field(&BinaryMessage::value, smsBuilder.getMessage().value);
+    };
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(eqSms(OTHER_PHONE), OTHER_PHONE)).WillOnce(Return(true));
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(eqSms(NOT_MY_PHONE), NOT_MY_PHONE)).WillOnce(Return(false));
+    EXPECT_CALL(*transportMock, sendMessage(AllOf(EqMessageHeader(0, MessageId::GroupSmsResult, NO_PHONE, PHONE),
+                                                  EqMessageNumber(HEADER_SIZE, GROUP_SMS_ID),
+                                                  EqMessageNumber(HEADER_SIZE + 2u, std::uint8_t{2}),
+                                                  EqMessageNumber(HEADER_SIZE + 3u, std::uint8_t{0b10}))));
+    ueMessageCallback(groupSmsBuilder.getMessage());
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallTrackForwardedCallSetup)
+{
+    OutgoingMessage callRequestBuilder(MessageId::CallRequest, PHONE, OTHER_PHONE);
+    InSequence seq;
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(_, OTHER_PHONE)).WillOnce(Return(true));
+    EXPECT_CALL(*ueSlotAttachedMock, trackCall(AllOf(Field(&MessageHeader::messageId, MessageId::CallRequest),
+                                                     Field(&MessageHeader::to, OTHER_PHONE))));
+    ueMessageCallback(callRequestBuilder.getMessage());
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallForwardCallTalkDirectlyToTalkPeer)
+{
+    StrictMock<IUeConnectionMock> talkPeerMock;
+    EXPECT_CALL(talkPeerMock, getPhoneNumber()).WillOnce(Return(OTHER_PHONE));
+    objectUnderTest->setTalkPeer(&talkPeerMock);
+
+    auto callTalkMessage = buildOtherThanAttachRequestMessage();
+    EXPECT_CALL(talkPeerMock, sendMessage(Field(&BinaryMessage::value, callTalkMessage.value))).WillOnce(Return(true));
+    ueMessageCallback(callTalkMessage);
+
+    objectUnderTest->setTalkPeer(nullptr);
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallGrantWindowRightAfterAttachWithFlowControl)
+{
+    OutgoingMessage attachRequestBuilder(MessageId::AttachRequest, PHONE, PhoneNumber{});
+    attachRequestBuilder.writeBtsId(BTS_ID);
+    attachRequestBuilder.writeNumber(common::get(AttachFeature::FlowControl));
+
+    InSequence seq;
+    EXPECT_CALL(*transportMock, sendMessage(AllOf(eqAttachResponseMessage(true),
+                                                  EqMessageNumber(HEADER_SIZE + 1u, common::get(AttachFeature::FlowControl)))));
+    EXPECT_CALL(*transportMock, sendMessage(eqCreditGrantMessage(CREDIT_WINDOW)));
+    ueMessageCallback(attachRequestBuilder.getMessage());
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallAnswerWithoutFeaturesWhenNoneOffered)
+{
+    EXPECT_CALL(*transportMock, sendMessage(Field(&BinaryMessage::value, SizeIs(HEADER_SIZE + 1u))));
+    handleAttachRequest(PHONE);
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallHandleEachMessageOfBatchAndPackReplies)
+{
+    negotiateBatching();
+    MessageBatch batch(PHONE, NO_PHONE);
+    batch.add(buildOtherThanAttachRequestMessage(NOT_MY_PHONE));
+    batch.add(OutgoingMessage(MessageId::CallTalk, NOT_MY_PHONE, NO_PHONE).getMessage());
+
+    auto eqUnknownSenderBatch = Truly([](const BinaryMessage& message)
+    {
+        auto messages = MessageBatch::unpack(message);
+        return messages.size() == 2u
+           and messages[0].value[0] == common::get(MessageId::UnknownSender)
+           and messages[1].value[0] == common::get(MessageId::UnknownSender);
+    });
+    EXPECT_CALL(*transportMock, sendMessage(eqUnknownSenderBatch));
+    ueMessageCallback(batch.take());
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallPackQueuedMessagesWhenDraining)
+{
+    negotiateBatching();
+    const BinaryMessage FIRST{ {1, 2, 3} };
+    const BinaryMessage SECOND{ {4, 5, 6} };
+    backpressureCallback(true);
+    objectUnderTest->sendMessage(FIRST);
+    objectUnderTest->sendMessage(SECOND);
+
+    EXPECT_CALL(*transportMock, sendMessage(Truly([&](const BinaryMessage& message)
+    {
+        auto messages = MessageBatch::unpack(message);
+        return messages.size() == 2u and messages[0].value == FIRST.value and messages[1].value == SECOND.value;
+    })));
+    backpressureCallback(false);
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallNotPackWithoutBatchingNegotiated)
+{
+    const BinaryMessage FIRST{ {1, 2, 3} };
+    const BinaryMessage SECOND{ {4, 5, 6} };
+    backpressureCallback(true);
+    objectUnderTest->sendMessage(FIRST);
+    objectUnderTest->sendMessage(SECOND);
+
+    EXPECT_CALL(*transportMock, sendMessage(_)).Times(2);
+    backpressureCallback(false);
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallForwardCompressedSmsDecompressed)
+{
+    OutgoingMessage smsBuilder(MessageId::Sms, PHONE, OTHER_PHONE);
+    smsBuilder.writeText(std::string(200u, 'a'));
+    const BinaryMessage sms = smsBuilder.getMessage();
+
+    EXPECT_CALL(*ueSlotAttachedMock, sendMessage(Field(&BinaryMessage::value, sms.value), OTHER_PHONE))
+            .WillOnce(Return(true));
+    ueMessageCallback(*common::compressMessage(sms));
+}
+
+TEST_F(UeConnectionAttachedTestSuite, shallCompressLongTextWhenNegotiated)
+{
+    OutgoingMessage attachRequestBuilder(MessageId::AttachRequest, PHONE, PhoneNumber{});
+    attachRequestBuilder.writeBtsId(BTS_ID);
+    attachRequestBuilder.writeNumber(common::get(AttachFeature::Compression));
+    EXPECT_CALL(*transportMock, sendMessage(EqMessageNumber(HEADER_SIZE + 1u, common::get(AttachFeature::Compression))));
+    ueMessageCallback(attachRequestBuilder.getMessage());
+
+    OutgoingMessage smsBuilder(MessageId::Sms, OTHER_PHONE, PHONE);
+    smsBuilder.writeText(std::string(200u, 'a'));
+    EXPECT_CALL(*transportMock, sendMessage(Truly([](const BinaryMessage& message) { return common::isCompressed(message); })));
+    objectUnderTest->sendMessage(smsBuilder.getMessage());
+}
+
 TEST_F(UeConnectionAttachedTestSuite, shallPrintAsAttached)
 {
     std::ostringstream os;
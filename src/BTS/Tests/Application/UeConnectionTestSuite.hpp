@@ -33,6 +33,9 @@ protected:
     const PhoneNumber PHONE{113};
     const PhoneNumber NOT_MY_PHONE{13};
     const PhoneNumber OTHER_PHONE{31};
+    const OutboundQueue::Limits OUTBOUND_LIMITS{20u, 10u, OutboundQueue::Policy::Reject};
+    const std::uint16_t CREDIT_WINDOW = 4u;
+    const IngressThrottle::Budget SMS_BUDGET{1.0, 1.0};
 
     std::shared_ptr<IUeSlotImplMock> ueSlotNotAttachedMock;
     std::shared_ptr<IUeSlotImplMock> ueSlotFailedAttachedMock;
@@ -44,7 +47,9 @@ protected:
 
     ITransport::MessageCallback ueMessageCallback;
     ITransport::DisconnectedCallback ueDisconnectedCallback;
+    ITransport::BackpressureCallback backpressureCallback;
 
+    std::shared_ptr<IngressThrottle> ingressThrottle;
     std::unique_ptr<UeConnection> objectUnderTest;
 };
 
@@ -69,6 +74,10 @@ class UeConnectionAttachedTestSuite : public UeConnectionWithConnectedTransportT
 {
 protected:
     UeConnectionAttachedTestSuite();
+
+    void handleCreditRequest();
+    void negotiateBatching();
+    auto eqCreditGrantMessage(std::uint16_t expectedCredits);
 };
 
 }
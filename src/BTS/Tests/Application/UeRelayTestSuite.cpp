@@ -1,6 +1,9 @@
 #include "UeRelayTestSuite.hpp"
+#include "Messages/OutgoingMessage.hpp"
+#include <chrono>
 
 using namespace ::testing;
+using common::OutgoingMessage;
 
 namespace bts
 {
@@ -47,6 +50,19 @@ IUeRelay::UeVisitor UeRelayTestSuite::getAction()
     return [this](IUeConnection& ue) { ue.sendSib(BTS_ID); };
 }
 
+void UeRelayTestSuite::trackCall(ConnectionMock& from, common::MessageId messageId, ConnectionMock& to)
+{
+    from.connectionSlot.trackCall(common::MessageHeader{messageId, from.phoneNumber, to.phoneNumber});
+}
+
+void UeRelayTestSuite::establishCall()
+{
+    trackCall(connectionAttached, common::MessageId::CallRequest, connectionReAttached);
+    connectionAttached.expectTalkPeer(connectionReAttached.connectionMock);
+    connectionReAttached.expectTalkPeer(connectionAttached.connectionMock);
+    trackCall(connectionReAttached, common::MessageId::CallAccepted, connectionAttached);
+}
+
 UeRelayTestSuite::ConnectionMock::ConnectionMock()
     : connectionMock(new ::testing::StrictMock<IUeConnectionMock>()),
       connectionPtr(connectionMock)
@@ -78,7 +94,7 @@ void UeRelayTestSuite::ConnectionMock::remove()
 void UeRelayTestSuite::ConnectionMock::expectSendMessage(const BinaryMessage& message)
 {
     auto matchMessage = Field(&BinaryMessage::value, (message.value));
-    EXPECT_CALL(*connectionMock, sendMessage(matchMessage));
+    EXPECT_CALL(*connectionMock, sendMessage(matchMessage)).WillOnce(Return(true));
 }
 
 void UeRelayTestSuite::ConnectionMock::expectSendSib(BtsId btsId)
@@ -86,6 +102,11 @@ void UeRelayTestSuite::ConnectionMock::expectSendSib(BtsId btsId)
     EXPECT_CALL(*connectionMock, sendSib(btsId));
 }
 
+void UeRelayTestSuite::ConnectionMock::expectTalkPeer(IUeConnection* peer)
+{
+    EXPECT_CALL(*connectionMock, setTalkPeer(peer));
+}
+
 TEST_F(UeRelayTestSuite, shallNewlyAddedBeNotAttached)
 {
     ASSERT_FALSE(connectionAdded.connectionSlot.isAttached());
@@ -146,6 +167,12 @@ TEST_F(UeRelayTestSuite, shallForwardMessageToReAttachedUe)
     shallForwardMessage(connectionReAttached);
 }
 
+TEST_F(UeRelayTestSuite, shallNotForwardMessageToBusyUe)
+{
+    EXPECT_CALL(*connectionAttached.connectionMock, sendMessage(_)).WillOnce(Return(false));
+    ASSERT_FALSE(connectionAdded.connectionSlot.sendMessage(MESSAGE, ATTACHED_PHONE));
+}
+
 TEST_F(UeRelayTestSuite, shallCountNotAttachedConnections)
 {
     ASSERT_EQ(connectionAdded.count(), objectUnderTest->countNotAttached());
@@ -176,4 +203,177 @@ TEST_F(UeRelayTestSuite, shallVisitAttachedConnections)
     objectUnderTest->visitAttachedUe(getAction());
 }
 
+TEST_F(UeRelayTestSuite, shallSetTalkPeersWhenCallAccepted)
+{
+    establishCall();
+}
+
+TEST_F(UeRelayTestSuite, shallNotSetTalkPeersForCallAcceptedWithoutRequest)
+{
+    trackCall(connectionReAttached, common::MessageId::CallAccepted, connectionAttached);
+}
+
+TEST_F(UeRelayTestSuite, shallClearTalkPeersWhenCallDropped)
+{
+    establishCall();
+
+    connectionAttached.expectTalkPeer(nullptr);
+    connectionReAttached.expectTalkPeer(nullptr);
+    trackCall(connectionAttached, common::MessageId::CallDropped, connectionReAttached);
+}
+
+TEST_F(UeRelayTestSuite, shallDropCallOnBehalfOfRemovedUe)
+{
+    establishCall();
+
+    const BinaryMessage CALL_DROPPED{{common::get(common::MessageId::CallDropped),
+                                      ATTACHED_PHONE.value, REATTACHED_PHONE.value}};
+    connectionAttached.expectTalkPeer(nullptr);
+    connectionReAttached.expectTalkPeer(nullptr);
+    connectionReAttached.expectSendMessage(CALL_DROPPED);
+    connectionAttached.remove();
+}
+
+TEST_F(UeRelayTestSuite, shallDeliverSmsStoredForNotAttachedUeWhenAttached)
+{
+    const BinaryMessage SMS{{common::get(common::MessageId::Sms), ATTACHED_PHONE.value, NOT_ATTACHED_PHONE.value, 'x'}};
+    ASSERT_TRUE(connectionAttached.connectionSlot.sendMessage(SMS, NOT_ATTACHED_PHONE));
+
+    connectionAdded.attach(NOT_ATTACHED_PHONE);
+    connectionAdded.expectSendMessage(SMS);
+    connectionAdded.connectionSlot.deliverStored();
+}
+
+TEST_F(UeRelayTestSuite, shallKeepStoredSmsNotDelivered)
+{
+    const BinaryMessage SMS{{common::get(common::MessageId::Sms), ATTACHED_PHONE.value, NOT_ATTACHED_PHONE.value, 'x'}};
+    ASSERT_TRUE(connectionAttached.connectionSlot.sendMessage(SMS, NOT_ATTACHED_PHONE));
+    connectionAdded.attach(NOT_ATTACHED_PHONE);
+
+    EXPECT_CALL(*connectionAdded.connectionMock, sendMessage(_)).WillOnce(Return(false));
+    connectionAdded.connectionSlot.deliverStored();
+
+    connectionAdded.expectSendMessage(SMS);
+    connectionAdded.connectionSlot.deliverStored();
+}
+
+TEST_F(UeRelayTestSuite, shallFanOutTalkToConferenceMembers)
+{
+    using common::MessageId;
+    establishCall();
+    connectionAttached.expectTalkPeer(nullptr);
+    connectionReAttached.expectTalkPeer(nullptr);
+    connectionAdded.attach(NOT_ATTACHED_PHONE);
+    trackCall(connectionAttached, MessageId::ConferenceInvite, connectionAdded);
+
+    for (auto* connection : {&connectionAttached, &connectionReAttached, &connectionAdded})
+    {
+        OutgoingMessage membersBuilder(MessageId::ConferenceMembers, PhoneNumber{}, connection->phoneNumber);
+        membersBuilder.writeNumber(std::uint8_t{3});
+        membersBuilder.writePhoneNumber(ATTACHED_PHONE);
+        membersBuilder.writePhoneNumber(REATTACHED_PHONE);
+        membersBuilder.writePhoneNumber(NOT_ATTACHED_PHONE);
+        connection->expectSendMessage(membersBuilder.getMessage());
+    }
+    trackCall(connectionAdded, MessageId::CallAccepted, connectionAttached);
+
+    const std::uint8_t TALK = common::get(MessageId::CallTalk);
+    connectionAttached.expectSendMessage(BinaryMessage{{TALK, REATTACHED_PHONE.value, ATTACHED_PHONE.value, 'x'}});
+    connectionAdded.expectSendMessage(BinaryMessage{{TALK, REATTACHED_PHONE.value, NOT_ATTACHED_PHONE.value, 'x'}});
+    ASSERT_TRUE(connectionReAttached.connectionSlot.sendMessage(
+                    BinaryMessage{{TALK, REATTACHED_PHONE.value, ATTACHED_PHONE.value, 'x'}}, ATTACHED_PHONE));
+}
+
+TEST_F(UeRelayTestSuite, shallEndConferenceForAllWhenHostDrops)
+{
+    using common::MessageId;
+    establishCall();
+    connectionAttached.expectTalkPeer(nullptr);
+    connectionReAttached.expectTalkPeer(nullptr);
+    connectionAdded.attach(NOT_ATTACHED_PHONE);
+    trackCall(connectionAttached, MessageId::ConferenceInvite, connectionAdded);
+    EXPECT_CALL(*connectionAttached.connectionMock, sendMessage(_)).WillOnce(Return(true));
+    EXPECT_CALL(*connectionReAttached.connectionMock, sendMessage(_)).WillOnce(Return(true));
+    EXPECT_CALL(*connectionAdded.connectionMock, sendMessage(_)).WillOnce(Return(true));
+    trackCall(connectionAdded, MessageId::CallAccepted, connectionAttached);
+
+    // peer gets CallDropped forwarded by its own UeConnection
+    const BinaryMessage CALL_DROPPED{{common::get(MessageId::CallDropped), ATTACHED_PHONE.value, NOT_ATTACHED_PHONE.value}};
+    connectionAdded.expectSendMessage(CALL_DROPPED);
+    trackCall(connectionAttached, MessageId::CallDropped, connectionReAttached);
+}
+
+class UeRelayConferenceBenchmarkTestSuite::CountingConnection : public IUeConnection
+{
+public:
+    CountingConnection(std::size_t& received) : received(received) {}
+
+    void start(UeSlot) override {}
+    bool sendMessage(BinaryMessage) override { ++received; return true; }
+    void sendSib(BtsId) override {}
+    void receiveMessage(BinaryMessage) override {}
+    PhoneNumber getPhoneNumber() const override { return {}; }
+    bool isAttached() const override { return true; }
+    ITransportPtr getTransport() const override { return nullptr; }
+    EgressStats getEgressStats() const override { return {}; }
+    void setTalkPeer(IUeConnection*) override {}
+    void print(std::ostream& os) const override { os << "UE"; }
+
+private:
+    std::size_t& received;
+};
+
+UeRelayConferenceBenchmarkTestSuite::UeRelayConferenceBenchmarkTestSuite()
+{
+    using common::MessageId;
+    for (std::size_t i = 0; i < GetParam(); ++i)
+    {
+        slots.push_back(objectUnderTest.add(std::make_unique<CountingConnection>(received)));
+        slots.back().attach(PhoneNumber{static_cast<std::uint8_t>(i + 1u)});
+    }
+    trackCall(1u, MessageId::CallRequest, 0u);
+    trackCall(0u, MessageId::CallAccepted, 1u);
+    for (std::size_t i = 2u; i < GetParam(); ++i)
+    {
+        trackCall(0u, MessageId::ConferenceInvite, i);
+        trackCall(i, MessageId::CallAccepted, 0u);
+    }
+    received = 0u;
+}
+
+void UeRelayConferenceBenchmarkTestSuite::trackCall(std::size_t from, common::MessageId messageId, std::size_t to)
+{
+    slots[from].trackCall(common::MessageHeader{messageId, slots[from].getPhoneNumber(), slots[to].getPhoneNumber()});
+}
+
+TEST_P(UeRelayConferenceBenchmarkTestSuite, shallReportTalkFanOut)
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t TALKS = 20000u;
+    const std::size_t participants = GetParam();
+    const std::uint8_t TALK = common::get(common::MessageId::CallTalk);
+    BinaryMessage talk{BinaryMessage::Value(64u, 'x')};
+    talk.value[0] = TALK;
+
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < TALKS; ++i)
+    {
+        // everybody talks to host - like UE in conference does
+        auto& speaker = slots[1u + i % (participants - 1u)];
+        talk.value[1] = speaker.getPhoneNumber().value;
+        talk.value[2] = slots[0].getPhoneNumber().value;
+        ASSERT_TRUE(speaker.sendMessage(talk, slots[0].getPhoneNumber()));
+    }
+    const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    ASSERT_EQ(TALKS * (participants - 1u), received);
+    const double talksPerSecond = TALKS / elapsed;
+    RecordProperty("talksPerSecond", std::to_string(static_cast<std::uint64_t>(talksPerSecond)));
+    std::cout << "[CONFERENCE] " << participants << " participants: "
+              << static_cast<std::uint64_t>(talksPerSecond) << " talk/s, "
+              << static_cast<std::uint64_t>(talksPerSecond * (participants - 1u)) << " deliveries/s" << std::endl;
+}
+
+INSTANTIATE_TEST_SUITE_P(Participants, UeRelayConferenceBenchmarkTestSuite, ::testing::Values(2u, 4u, 8u, 16u, 32u, 64u));
+
 }
@@ -20,6 +20,8 @@ protected:
     void shallNotForwardMessage(PhoneNumber phoneNumber);
     void expectAction(ConnectionMock& connnection);
     IUeRelay::UeVisitor getAction();
+    void trackCall(ConnectionMock& from, common::MessageId messageId, ConnectionMock& to);
+    void establishCall();
 
     struct ConnectionMock
     {
@@ -36,6 +38,7 @@ protected:
 
         void expectSendMessage(const BinaryMessage& message);
         void expectSendSib(BtsId btsId);
+        void expectTalkPeer(IUeConnection* peer);
 
         void printConnection(std::ostream &os);
 
@@ -59,5 +62,19 @@ protected:
     std::unique_ptr<UeRelay> objectUnderTest;
 };
 
+class UeRelayConferenceBenchmarkTestSuite : public ::testing::TestWithParam<std::size_t>
+{
+protected:
+    class CountingConnection;
+
+    UeRelayConferenceBenchmarkTestSuite();
+    void trackCall(std::size_t from, common::MessageId messageId, std::size_t to);
+
+    ::testing::NiceMock<common::ILoggerMock> loggerMock{};
+    UeRelay objectUnderTest{loggerMock};
+    std::vector<UeSlot> slots;
+    std::size_t received = 0u;
+};
+
 
 }
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <QCoreApplication>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include "Transport/QtTransport.hpp"
+#include "Transport/TransportConformance.hpp"
+#include "Mocks/ILoggerMock.hpp"
+
+using namespace ::testing;
+
+namespace bts
+{
+
+using common::TransportConformanceTestSuite;
+using common::TransportThroughputTestSuite;
+
+namespace
+{
+
+void ensureApplication()
+{
+    static int argc = 1;
+    static char name[] = "BtsTransportUT";
+    static char* argv[] = {name, nullptr};
+    static QCoreApplication application(argc, argv);
+}
+
+class QtTransportConnection : public common::ITransportConnection
+{
+public:
+    QtTransportConnection()
+    {
+        ensureApplication();
+        if (not server.listen(QHostAddress::LocalHost, 0))
+        {
+            throw std::runtime_error("Cannot listen: " + server.errorString().toStdString());
+        }
+        clientSocket.connectToHost(QHostAddress::LocalHost, server.serverPort());
+        if (not clientSocket.waitForConnected(TIMEOUT_MS) or not server.waitForNewConnection(TIMEOUT_MS))
+        {
+            throw std::runtime_error("Cannot connect to port: " + std::to_string(server.serverPort()));
+        }
+        serverSocket = server.nextPendingConnection();
+        clientTransport = std::make_unique<QtTransport>(logger, &clientSocket);
+        serverTransport = std::make_unique<QtTransport>(logger, serverSocket);
+    }
+
+    ITransport& client() override
+    {
+        return *clientTransport;
+    }
+
+    ITransport& server() override
+    {
+        return *serverTransport;
+    }
+
+    void poll() override
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents);
+    }
+
+    void writeRawFromClient(const common::FrameBytes& bytes) override
+    {
+        clientSocket.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        clientSocket.flush();
+    }
+
+    void closeClient() override
+    {
+        clientSocket.disconnectFromHost();
+    }
+
+private:
+    static constexpr int TIMEOUT_MS = 5000;
+
+    NiceMock<common::ILoggerMock> logger;
+    QTcpServer server;
+    QTcpSocket clientSocket;
+    QTcpSocket* serverSocket = nullptr; // owned by server
+    std::unique_ptr<QtTransport> clientTransport;
+    std::unique_ptr<QtTransport> serverTransport;
+};
+
+common::TransportBackend qtTcpTransportBackend()
+{
+    return common::TransportBackend{"QtTcp",
+                                    [] { return std::make_unique<QtTransportConnection>(); },
+                                    true};
+}
+
+}
+
+INSTANTIATE_TEST_SUITE_P(QtTcp, TransportConformanceTestSuite,
+                         Values(qtTcpTransportBackend()), common::transportBackendName);
+
+INSTANTIATE_TEST_SUITE_P(QtTcp, TransportThroughputTestSuite,
+                         Values(qtTcpTransportBackend()), common::transportBackendName);
+
+class QtTransportHandOverTestSuite : public Test
+{
+protected:
+    template <typename Condition>
+    void pollUntil(Condition condition)
+    {
+        for (int i = 0; i < MAX_POLLS and not condition(); ++i)
+        {
+            connection.poll();
+        }
+    }
+
+    static constexpr int MAX_POLLS = 1000;
+    const BinaryMessage MESSAGE{{1, 2, 3}};
+    const common::FrameBytes FRAME = common::encodeFrame(MESSAGE);
+
+    NiceMock<common::ILoggerMock> logger;
+    QtTransportConnection connection;
+};
+
+TEST_F(QtTransportHandOverTestSuite, shallPassUnhandledInputToNewOwner)
+{
+    auto& oldOwner = dynamic_cast<QtTransport&>(connection.server());
+    std::vector<BinaryMessage> handledByOld;
+    oldOwner.registerMessageCallback([&](BinaryMessage message) { handledByOld.push_back(message); });
+
+    // one frame and start of next one
+    common::FrameBytes bytes = FRAME;
+    bytes.insert(bytes.end(), FRAME.begin(), FRAME.begin() + 2);
+    connection.writeRawFromClient(bytes);
+    pollUntil([&] { return handledByOld.size() == 1u; });
+    ASSERT_EQ(1u, handledByOld.size());
+
+    common::FrameBytes pendingInput;
+    const int fd = oldOwner.handOver(pendingInput);
+    ASSERT_GE(fd, 0);
+    ASSERT_FALSE(oldOwner.sendMessage(MESSAGE));
+
+    auto* socket = new QTcpSocket();
+    ASSERT_TRUE(socket->setSocketDescriptor(fd));
+    QtTransport newOwner(logger, socket);
+    socket->setParent(&newOwner);
+    std::vector<BinaryMessage> handledByNew;
+    newOwner.registerMessageCallback([&](BinaryMessage message) { handledByNew.push_back(message); });
+    newOwner.receivePending(pendingInput);
+
+    // rest of frame arrives after handover
+    connection.writeRawFromClient(common::FrameBytes(FRAME.begin() + 2, FRAME.end()));
+    pollUntil([&] { return handledByNew.size() == 1u; });
+
+    ASSERT_EQ(1u, handledByOld.size());
+    ASSERT_EQ(1u, handledByNew.size());
+    ASSERT_EQ(MESSAGE.value, handledByNew[0].value);
+}
+
+}
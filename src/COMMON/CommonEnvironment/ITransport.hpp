@@ -11,14 +11,38 @@ class ITransport
 public:
     using MessageCallback=std::function<void (BinaryMessage)>;
     using DisconnectedCallback=std::function<void()>;
+    using BackpressureCallback=std::function<void(bool /*congested*/)>;
+    using ConnectedCallback=std::function<void()>;
 
     virtual ~ITransport() = default;
 
     virtual void registerMessageCallback(MessageCallback) = 0;
     virtual void registerDisconnectedCallback(DisconnectedCallback) = 0;
 
+    /**
+     * @return false when message was not accepted for sending
+     */
     virtual bool sendMessage(BinaryMessage) = 0;
 
+    /**
+     * Called with true when not yet sent data crosses the transport high watermark,
+     * and with false when it drops back below the low watermark.
+     * Transports without such accounting never call it.
+     */
+    virtual void registerBackpressureCallback(BackpressureCallback) {}
+
+    /**
+     * Called each time connection is (re)established - after disconnection reported before.
+     * Transports which do not reconnect never call it.
+     */
+    virtual void registerConnectedCallback(ConnectedCallback) {}
+
+    /**
+     * Closes connection on application request - peer sees it as disconnected, own disconnected callback is not called.
+     * Transports which keep connection up by themselves (e.g. reconnecting ones) ignore it.
+     */
+    virtual void close() {}
+
     virtual std::string addressToString() const = 0;
 };
 
@@ -31,6 +31,8 @@ public:
     // user might define more levels, these are just predefined...
 
     virtual void log(Level level, const std::string& message) = 0;
+    // messages of disabled level are not even formatted
+    virtual bool isEnabled(Level level) const;
 
     // shortcuts machinery
     template <typename ...Value>
@@ -58,6 +60,10 @@ inline void ILogger::logDebug(Value&& ...value)
 template <typename ...Value>
 inline void ILogger::log(Level level, Value&& ...value)
 {
+    if (not isEnabled(level))
+    {
+        return;
+    }
     std::ostringstream os;
     ((os << std::forward<Value>(value)), ...);
     const std::string message = std::move(os).str();
@@ -66,7 +72,15 @@ inline void ILogger::log(Level level, Value&& ...value)
 
 inline void ILogger::log(Level level, std::string_view value)
 {
-    log(level, std::string(value));
+    if (isEnabled(level))
+    {
+        log(level, std::string(value));
+    }
+}
+
+inline bool ILogger::isEnabled(Level) const
+{
+    return true;
 }
 
 } // namespace common
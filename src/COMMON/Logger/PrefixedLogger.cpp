@@ -21,6 +21,11 @@ PrefixedLogger::PrefixedLogger(ILogger& adaptee, const std::string& prefix)
     : PrefixedLogger(adaptee, [prefix] (std::ostream& os){ os << prefix; })
 {}
 
+bool PrefixedLogger::isEnabled(Level level) const
+{
+    return adaptee.isEnabled(level);
+}
+
 void PrefixedLogger::log(Level level, const std::string &message)
 {
     adaptee.log(level, prefix, message);
@@ -36,6 +36,7 @@ public:
     PrefixedLogger(ILogger& adaptee, const std::string& prefix);
 
     void log(Level level, const std::string& message) override;
+    bool isEnabled(Level level) const override;
 
 private:
     ILogger& adaptee;
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace common
+{
+
+/**
+ * Features UE offers after BtsId in AttachRequest, BTS answers with accepted ones after
+ * the accept flag of AttachResponse. Absent byte means no features (older peer).
+ */
+enum class AttachFeature : std::uint8_t
+{
+    None = 0x00,
+    Batching = 0x01,
+    Compression = 0x02,
+    // BTS counts messages of UE from attach accept, UE sends only when credited by CreditGrant -
+    // the first one, with the whole window, right after AttachResponse
+    FlowControl = 0x04
+};
+
+constexpr auto get(AttachFeature feature)
+{
+    return static_cast<std::underlying_type_t<AttachFeature>>(feature);
+}
+
+using AttachFeatures = std::underlying_type_t<AttachFeature>;
+constexpr AttachFeatures ALL_ATTACH_FEATURES = get(AttachFeature::Batching) | get(AttachFeature::Compression)
+                                             | get(AttachFeature::FlowControl);
+
+}
@@ -74,6 +74,11 @@ void IncomingMessage::checkEndOfMessage()
     }
 }
 
+bool IncomingMessage::isEndOfMessage() const
+{
+    return cursor == end;
+}
+
 std::string IncomingMessage::readTextTo(Cursor end)
 {
     std::string text(cursor, end);
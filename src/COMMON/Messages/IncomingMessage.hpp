@@ -50,6 +50,7 @@ public:
     MessageHeader readMessageHeader();
 
     void checkEndOfMessage();
+    bool isEndOfMessage() const;
 private:
     using Cursor = BinaryMessage::Value::const_iterator;
     std::string readTextTo(Cursor position);
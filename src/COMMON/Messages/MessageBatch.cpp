@@ -0,0 +1,97 @@
+#include "MessageBatch.hpp"
+#include "IncomingMessage.hpp"
+#include "OutgoingMessage.hpp"
+
+namespace common
+{
+
+MessageBatch::MessageBatch(PhoneNumber from, PhoneNumber to)
+    : from(from),
+      to(to)
+{}
+
+bool MessageBatch::add(const BinaryMessage& message)
+{
+    if (count == 0u)
+    {
+        first = message;
+        count = 1u;
+        return true;
+    }
+    const std::size_t packedSize = (count == 1u ? HEADER_SIZE + ENTRY_HEADER_SIZE + first.value.size()
+                                                : container.value.size());
+    if (packedSize + ENTRY_HEADER_SIZE + message.value.size() > BinaryMessage::MAX_SIZE)
+    {
+        return false;
+    }
+    if (count == 1u)
+    {
+        container = OutgoingMessage(MessageId::Batch, from, to).getMessage();
+        append(first);
+    }
+    append(message);
+    ++count;
+    return true;
+}
+
+void MessageBatch::append(const BinaryMessage& message)
+{
+    const auto length = static_cast<BinaryMessage::SizeType>(message.value.size());
+    container.value.push_back(static_cast<std::uint8_t>(length >> 8u));
+    container.value.push_back(static_cast<std::uint8_t>(length & 0xFF));
+    for (auto byte : message.value)
+    {
+        container.value.push_back(byte);
+    }
+}
+
+bool MessageBatch::empty() const
+{
+    return count == 0u;
+}
+
+std::size_t MessageBatch::size() const
+{
+    return count;
+}
+
+BinaryMessage MessageBatch::take()
+{
+    BinaryMessage message = std::move(count == 1u ? first : container);
+    first = BinaryMessage{};
+    container = BinaryMessage{};
+    count = 0u;
+    return message;
+}
+
+bool MessageBatch::isBatch(const BinaryMessage& message)
+{
+    return message.value.size() >= HEADER_SIZE
+       and message.value[0] == get(MessageId::Batch);
+}
+
+std::vector<BinaryMessage> MessageBatch::unpack(const BinaryMessage& message)
+{
+    IncomingMessage reader(message);
+    reader.readMessageHeader();
+    std::vector<BinaryMessage> messages;
+    while (not reader.isEndOfMessage())
+    {
+        const auto length = reader.readNumber<BinaryMessage::SizeType>();
+        const std::string bytes = reader.readText(length);
+        BinaryMessage entry;
+        entry.value.reserve(length);
+        for (char byte : bytes)
+        {
+            entry.value.push_back(static_cast<std::uint8_t>(byte));
+        }
+        if (isBatch(entry))
+        {
+            throw IncomingMessage::ReadEx("Batch nested in batch");
+        }
+        messages.push_back(std::move(entry));
+    }
+    return messages;
+}
+
+}
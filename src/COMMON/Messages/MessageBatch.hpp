@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Messages/BinaryMessage.hpp"
+#include "Messages/PhoneNumber.hpp"
+
+namespace common
+{
+
+/**
+ * Several messages in one frame, for peers which negotiated AttachFeature::Batching:
+ *
+ *   [Batch][from][to] then for each message [BinaryMessage::SizeType length (big endian)][message]
+ *
+ * Single message is not worth a container - it is sent as is.
+ */
+class MessageBatch
+{
+public:
+    static constexpr std::size_t HEADER_SIZE = 3u;
+    static constexpr std::size_t ENTRY_HEADER_SIZE = sizeof(BinaryMessage::SizeType);
+
+    MessageBatch(PhoneNumber from, PhoneNumber to);
+
+    /**
+     * First message is always taken.
+     * @return false when message does not fit in BinaryMessage::MAX_SIZE - send that batch first
+     */
+    bool add(const BinaryMessage& message);
+    bool empty() const;
+    std::size_t size() const;
+    /**
+     * The message itself when only one was added. Batch is empty afterwards.
+     */
+    BinaryMessage take();
+
+    static bool isBatch(const BinaryMessage& message);
+    /**
+     * @throw IncomingMessage::ReadEx on truncated entry or batch nested in batch
+     */
+    static std::vector<BinaryMessage> unpack(const BinaryMessage& message);
+
+private:
+    void append(const BinaryMessage& message);
+
+    const PhoneNumber from;
+    const PhoneNumber to;
+    BinaryMessage first;
+    BinaryMessage container;
+    std::size_t count = 0u;
+};
+
+}
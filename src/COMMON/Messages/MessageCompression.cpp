@@ -0,0 +1,259 @@
+#include "MessageCompression.hpp"
+#include "IncomingMessage.hpp"
+#include "OutgoingMessage.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace common
+{
+
+namespace
+{
+
+constexpr std::size_t MIN_MATCH = 4u;
+constexpr std::size_t MAX_OFFSET = 0xFFFFu;
+constexpr unsigned HASH_BITS = 12u;
+constexpr std::uint8_t NIBBLE_MAX = 15u;
+constexpr std::size_t HEADER_SIZE = 3u;
+constexpr std::size_t COMPRESSED_HEADER_SIZE = HEADER_SIZE + 1u + sizeof(std::uint16_t);
+
+std::uint32_t read32(const std::uint8_t* data)
+{
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+std::size_t hash(std::uint32_t sequence)
+{
+    return (sequence * 2654435761u) >> (32u - HASH_BITS);
+}
+
+void writeLength(CompressedBlock& block, std::size_t length)
+{
+    for (length -= NIBBLE_MAX; length >= 0xFFu; length -= 0xFFu)
+    {
+        block.push_back(0xFFu);
+    }
+    block.push_back(static_cast<std::uint8_t>(length));
+}
+
+void writeSequence(CompressedBlock& block, const std::uint8_t* literals, std::size_t literalLength,
+                   std::size_t offset, std::size_t matchLength)
+{
+    const std::size_t matchCode = matchLength == 0u ? 0u : matchLength - MIN_MATCH;
+    block.push_back(static_cast<std::uint8_t>((std::min<std::size_t>(literalLength, NIBBLE_MAX) << 4u)
+                                              | std::min<std::size_t>(matchCode, NIBBLE_MAX)));
+    if (literalLength >= NIBBLE_MAX)
+    {
+        writeLength(block, literalLength);
+    }
+    block.insert(block.end(), literals, literals + literalLength);
+    if (matchLength == 0u)
+    {
+        return;
+    }
+    block.push_back(static_cast<std::uint8_t>(offset & 0xFFu));
+    block.push_back(static_cast<std::uint8_t>(offset >> 8u));
+    if (matchCode >= NIBBLE_MAX)
+    {
+        writeLength(block, matchCode);
+    }
+}
+
+class BlockReader
+{
+public:
+    BlockReader(const std::uint8_t* data, std::size_t size)
+        : cursor(data), end(data + size)
+    {}
+
+    bool atEnd() const
+    {
+        return cursor == end;
+    }
+    std::uint8_t readByte()
+    {
+        if (cursor == end)
+        {
+            throw IncomingMessage::ReadEx("Compressed block truncated");
+        }
+        return *cursor++;
+    }
+    std::size_t readLength(std::size_t nibble)
+    {
+        std::size_t length = nibble;
+        if (nibble == NIBBLE_MAX)
+        {
+            std::uint8_t extra;
+            do
+            {
+                extra = readByte();
+                length += extra;
+            }
+            while (extra == 0xFFu);
+        }
+        return length;
+    }
+    const std::uint8_t* readBytes(std::size_t count)
+    {
+        if (static_cast<std::size_t>(end - cursor) < count)
+        {
+            throw IncomingMessage::ReadEx("Compressed block truncated");
+        }
+        const std::uint8_t* bytes = cursor;
+        cursor += count;
+        return bytes;
+    }
+
+private:
+    const std::uint8_t* cursor;
+    const std::uint8_t* const end;
+};
+
+bool isCompressible(MessageId messageId)
+{
+    return messageId == MessageId::Sms or messageId == MessageId::CallTalk;
+}
+
+}
+
+CompressedBlock compressBlock(const std::uint8_t* data, std::size_t size)
+{
+    CompressedBlock block;
+    block.reserve(size + size / 255u + 16u);
+    // positions + 1, 0 = empty slot
+    std::array<std::uint32_t, 1u << HASH_BITS> positions{};
+
+    std::size_t anchor = 0u;
+    std::size_t position = 0u;
+    while (position + MIN_MATCH <= size)
+    {
+        const std::uint32_t sequence = read32(data + position);
+        auto& slot = positions[hash(sequence)];
+        const std::size_t candidate = slot;
+        slot = static_cast<std::uint32_t>(position + 1u);
+        if (candidate == 0u
+            or position - (candidate - 1u) > MAX_OFFSET
+            or read32(data + candidate - 1u) != sequence)
+        {
+            ++position;
+            continue;
+        }
+        const std::size_t matchStart = candidate - 1u;
+        std::size_t matchLength = MIN_MATCH;
+        while (position + matchLength < size and data[matchStart + matchLength] == data[position + matchLength])
+        {
+            ++matchLength;
+        }
+        writeSequence(block, data + anchor, position - anchor, position - matchStart, matchLength);
+        position += matchLength;
+        anchor = position;
+    }
+    writeSequence(block, data + anchor, size - anchor, 0u, 0u);
+    return block;
+}
+
+std::vector<std::uint8_t> decompressBlock(const std::uint8_t* data, std::size_t size, std::size_t originalSize)
+{
+    std::vector<std::uint8_t> output;
+    output.reserve(originalSize);
+    BlockReader reader(data, size);
+    while (true)
+    {
+        const std::uint8_t token = reader.readByte();
+        const std::size_t literalLength = reader.readLength(token >> 4u);
+        if (literalLength > originalSize - output.size())
+        {
+            throw IncomingMessage::ReadEx("Compressed block longer than declared");
+        }
+        const std::uint8_t* literals = reader.readBytes(literalLength);
+        output.insert(output.end(), literals, literals + literalLength);
+        if (reader.atEnd())
+        {
+            break;
+        }
+
+        const std::size_t offsetLow = reader.readByte();
+        const std::size_t offset = offsetLow | (reader.readByte() << 8u);
+        const std::size_t matchLength = reader.readLength(token & 0x0Fu) + MIN_MATCH;
+        if (offset == 0u or offset > output.size())
+        {
+            throw IncomingMessage::ReadEx("Compressed block offset out of range: " + std::to_string(offset));
+        }
+        if (matchLength > originalSize - output.size())
+        {
+            throw IncomingMessage::ReadEx("Compressed block longer than declared");
+        }
+        // might overlap - byte by byte
+        std::size_t from = output.size() - offset;
+        for (std::size_t i = 0u; i < matchLength; ++i)
+        {
+            output.push_back(output[from + i]);
+        }
+    }
+    if (output.size() != originalSize)
+    {
+        throw IncomingMessage::ReadEx("Compressed block shorter than declared");
+    }
+    return output;
+}
+
+std::optional<BinaryMessage> compressMessage(const BinaryMessage& message, std::size_t threshold)
+{
+    const auto& bytes = message.value;
+    if (bytes.size() < HEADER_SIZE + threshold or not isCompressible(static_cast<MessageId>(bytes[0])))
+    {
+        return std::nullopt;
+    }
+    const std::size_t textSize = bytes.size() - HEADER_SIZE;
+    const CompressedBlock block = compressBlock(bytes.data() + HEADER_SIZE, textSize);
+    if (COMPRESSED_HEADER_SIZE + block.size() >= bytes.size())
+    {
+        return std::nullopt;
+    }
+
+    OutgoingMessage builder(MessageId::Compressed, PhoneNumber{bytes[1]}, PhoneNumber{bytes[2]});
+    builder.writeNumber(bytes[0]);
+    builder.writeNumber(static_cast<std::uint16_t>(textSize));
+    BinaryMessage compressed = builder.getMessage();
+    compressed.value.reserve(compressed.value.size() + block.size());
+    for (auto byte : block)
+    {
+        compressed.value.push_back(byte);
+    }
+    return compressed;
+}
+
+bool isCompressed(const BinaryMessage& message)
+{
+    return message.value.size() >= COMPRESSED_HEADER_SIZE
+       and message.value[0] == get(MessageId::Compressed);
+}
+
+BinaryMessage decompressMessage(const BinaryMessage& message)
+{
+    IncomingMessage reader(message);
+    const MessageHeader header = reader.readMessageHeader();
+    const MessageId originalId = reader.readMessageId();
+    const auto textSize = reader.readNumber<std::uint16_t>();
+    if (not isCompressible(originalId) or HEADER_SIZE + textSize > BinaryMessage::MAX_SIZE)
+    {
+        throw IncomingMessage::ReadEx("Not compressible message: " + to_string(originalId)
+                                      + ", size: " + std::to_string(textSize));
+    }
+    const auto text = decompressBlock(message.value.data() + COMPRESSED_HEADER_SIZE,
+                                      message.value.size() - COMPRESSED_HEADER_SIZE,
+                                      textSize);
+
+    BinaryMessage original = OutgoingMessage(originalId, header.from, header.to).getMessage();
+    original.value.reserve(HEADER_SIZE + text.size());
+    for (auto byte : text)
+    {
+        original.value.push_back(byte);
+    }
+    return original;
+}
+
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "Messages/BinaryMessage.hpp"
+
+namespace common
+{
+
+/**
+ * LZ4-like block format: sequences of
+ *
+ *   [token: literal length << 4 | (match length - MIN_MATCH)][extra literal length][literals]
+ *   [match offset (2 bytes, little endian)][extra match length]
+ *
+ * 15 in token nibble means length continues in extra bytes (255 - keep adding).
+ * Last sequence has literals only. Compressor state is one fixed hash table.
+ */
+using CompressedBlock = std::vector<std::uint8_t>;
+
+CompressedBlock compressBlock(const std::uint8_t* data, std::size_t size);
+/**
+ * @throw IncomingMessage::ReadEx when block does not decode to exactly originalSize bytes
+ */
+std::vector<std::uint8_t> decompressBlock(const std::uint8_t* data, std::size_t size, std::size_t originalSize);
+
+/**
+ * Text payload of Sms/CallTalk for peers which negotiated AttachFeature::Compression:
+ *
+ *   [Compressed][from][to][original MessageId][text length (2 bytes)][compressed text]
+ */
+constexpr std::size_t COMPRESSION_THRESHOLD = 64u;
+
+/**
+ * @return nothing when message is not Sms/CallTalk, its text is below threshold or does not shrink
+ */
+std::optional<BinaryMessage> compressMessage(const BinaryMessage& message,
+                                             std::size_t threshold = COMPRESSION_THRESHOLD);
+bool isCompressed(const BinaryMessage& message);
+/**
+ * @throw IncomingMessage::ReadEx on malformed message
+ */
+BinaryMessage decompressMessage(const BinaryMessage& message);
+
+}
@@ -19,6 +19,14 @@ namespace common
     ACTION(CallAccepted)            \
     ACTION(CallDropped)             \
     ACTION(CallTalk)                \
+    ACTION(CreditRequest)           \
+    ACTION(CreditGrant)             \
+    ACTION(GroupSms)                \
+    ACTION(GroupSmsResult)          \
+    ACTION(ConferenceInvite)        \
+    ACTION(ConferenceMembers)       \
+    ACTION(Batch)                   \
+    ACTION(Compressed)              \
 
 #define MESSAGE_ID_ENTRY(X) X,
 enum class MessageId : std::uint8_t
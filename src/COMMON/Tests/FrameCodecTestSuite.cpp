@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Transport/FrameCodec.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class FrameCodecTestSuite : public Test
+{
+protected:
+    const BinaryMessage MESSAGE{ {1, 2, 3} };
+    const FrameBytes MESSAGE_FRAME{0, 3, 1, 2, 3};
+
+    FrameDecoder objectUnderTest;
+    std::vector<BinaryMessage> decoded;
+
+    std::size_t feed(const FrameBytes& bytes)
+    {
+        return objectUnderTest.feed(bytes.data(), bytes.size(), [this](BinaryMessage message)
+        {
+            decoded.push_back(std::move(message));
+        });
+    }
+};
+
+TEST_F(FrameCodecTestSuite, shallEncodeLengthPrefixedFrame)
+{
+    ASSERT_THAT(encodeFrame(MESSAGE), ContainerEq(MESSAGE_FRAME));
+}
+
+TEST_F(FrameCodecTestSuite, shallEncodeBigEndianLength)
+{
+    BinaryMessage message{ BinaryMessage::Value(0x0102) };
+    const FrameBytes frame = encodeFrame(message);
+    ASSERT_EQ(FRAME_HEADER_SIZE + 0x0102, frame.size());
+    ASSERT_EQ(0x01, frame[0]);
+    ASSERT_EQ(0x02, frame[1]);
+}
+
+TEST_F(FrameCodecTestSuite, shallAppendFrames)
+{
+    FrameBytes frames;
+    appendFrame(frames, MESSAGE);
+    appendFrame(frames, BinaryMessage{});
+    ASSERT_THAT(frames, ElementsAre(0, 3, 1, 2, 3, 0, 0));
+}
+
+TEST_F(FrameCodecTestSuite, shallDecodeWholeFrame)
+{
+    ASSERT_EQ(1u, feed(MESSAGE_FRAME));
+    ASSERT_EQ(1u, decoded.size());
+    ASSERT_EQ(MESSAGE.value, decoded[0].value);
+    ASSERT_EQ(0u, objectUnderTest.bufferedBytes());
+}
+
+TEST_F(FrameCodecTestSuite, shallWaitForMissingBytes)
+{
+    ASSERT_EQ(0u, feed({0}));
+    ASSERT_EQ(0u, feed({3, 1, 2}));
+    ASSERT_EQ(4u, objectUnderTest.bufferedBytes());
+    ASSERT_EQ(1u, feed({3}));
+    ASSERT_EQ(1u, decoded.size());
+    ASSERT_EQ(MESSAGE.value, decoded[0].value);
+}
+
+TEST_F(FrameCodecTestSuite, shallDecodeSeveralFramesAndKeepRemainder)
+{
+    ASSERT_EQ(2u, feed({0, 0, 0, 3, 1, 2, 3, 0}));
+    ASSERT_EQ(2u, decoded.size());
+    ASSERT_TRUE(decoded[0].value.empty());
+    ASSERT_EQ(MESSAGE.value, decoded[1].value);
+    ASSERT_EQ(1u, objectUnderTest.bufferedBytes());
+}
+
+TEST_F(FrameCodecTestSuite, shallGiveAwayIncompleteFrame)
+{
+    ASSERT_EQ(1u, feed({0, 0, 0, 3, 1}));
+    ASSERT_EQ((FrameBytes{0, 3, 1}), objectUnderTest.takeBuffered());
+    ASSERT_EQ(0u, objectUnderTest.bufferedBytes());
+}
+
+TEST_F(FrameCodecTestSuite, shallRejectTooLongFrame)
+{
+    const BinaryMessage::SizeType TOO_LONG = BinaryMessage::MAX_SIZE + 1;
+    ASSERT_THROW(feed({std::uint8_t(TOO_LONG >> 8), std::uint8_t(TOO_LONG & 0xFF), 1}),
+                 FrameDecoder::FrameEx);
+    ASSERT_EQ(0u, objectUnderTest.bufferedBytes());
+    ASSERT_TRUE(decoded.empty());
+}
+
+TEST_F(FrameCodecTestSuite, shallAllowFeedingFromCallback)
+{
+    bool fedAgain = false;
+    const FrameBytes frames{0, 0, 0, 0};
+    objectUnderTest.feed(frames.data(), frames.size(), [&](BinaryMessage)
+    {
+        if (not fedAgain)
+        {
+            fedAgain = true;
+            feed(MESSAGE_FRAME);
+        }
+    });
+    ASSERT_EQ(1u, decoded.size());
+    ASSERT_EQ(0u, objectUnderTest.bufferedBytes());
+}
+
+}
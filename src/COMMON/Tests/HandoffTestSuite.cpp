@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <numeric>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Transport/Handoff.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class HandoffTestSuite : public Test
+{
+protected:
+    HandoffTestSuite()
+    {
+        ::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, channel);
+        const timeval timeout{1, 0};
+        ::setsockopt(channel[1], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+
+    ~HandoffTestSuite()
+    {
+        closeFd(channel[0]);
+        closeFd(channel[1]);
+        closeHandoff(sent);
+        closeHandoff(received);
+        for (int& peer : peers)
+        {
+            closeFd(peer);
+        }
+    }
+
+    int makeSocket(int type = SOCK_STREAM)
+    {
+        int pair[2];
+        ::socketpair(AF_UNIX, type, 0, pair);
+        peers.push_back(pair[1]);
+        return pair[0];
+    }
+
+    static ino_t inodeOf(int fd)
+    {
+        struct stat fdStat{};
+        ::fstat(fd, &fdStat);
+        return fdStat.st_ino;
+    }
+
+    void sendAndReceive()
+    {
+        sendHandoff(channel[0], sent);
+        received = receiveHandoff(channel[1]);
+    }
+
+    const PhoneNumber PHONE_NUMBER{112};
+    int channel[2] = {-1, -1};
+    std::vector<int> peers;
+    HandoffState sent;
+    HandoffState received;
+};
+
+TEST_F(HandoffTestSuite, shallPassIdAndListeners)
+{
+    sent.id = 0x12345678;
+    sent.tcpListener = makeSocket();
+    sent.handoffListener = makeSocket(SOCK_SEQPACKET);
+
+    sendAndReceive();
+
+    ASSERT_EQ(sent.id, received.id);
+    ASSERT_EQ(inodeOf(sent.tcpListener), inodeOf(received.tcpListener));
+    ASSERT_EQ(-1, received.unixListener);
+    ASSERT_EQ(inodeOf(sent.handoffListener), inodeOf(received.handoffListener));
+    ASSERT_THAT(received.connections, IsEmpty());
+}
+
+TEST_F(HandoffTestSuite, shallPassConnectionsWithPendingInput)
+{
+    FrameBytes longInput(100u * 1024u);
+    std::iota(longInput.begin(), longInput.end(), 0);
+    sent.connections.push_back({makeSocket(), PHONE_NUMBER, FrameBytes{1, 2, 3}});
+    sent.connections.push_back({makeSocket(), PhoneNumber{}, longInput});
+    sent.connections.push_back({makeSocket(), PhoneNumber{}, {}});
+
+    sendAndReceive();
+
+    ASSERT_EQ(sent.connections.size(), received.connections.size());
+    for (std::size_t i = 0; i < sent.connections.size(); ++i)
+    {
+        ASSERT_EQ(inodeOf(sent.connections[i].socket), inodeOf(received.connections[i].socket));
+        ASSERT_EQ(sent.connections[i].phoneNumber, received.connections[i].phoneNumber);
+        ASSERT_EQ(sent.connections[i].pendingInput, received.connections[i].pendingInput);
+    }
+}
+
+TEST_F(HandoffTestSuite, shallFailWhenSenderDiesInTheMiddle)
+{
+    sent.tcpListener = makeSocket();
+    const std::uint8_t HELLO_ONLY[] = {1, 1, 1, 0, 0, 0, 1};
+    sendWithFds(channel[0], HELLO_ONLY, sizeof(HELLO_ONLY), {sent.tcpListener});
+    closeFd(channel[0]);
+
+    ASSERT_THROW(receiveHandoff(channel[1]), UnixSocketEx);
+}
+
+TEST_F(HandoffTestSuite, shallRejectUnknownVersion)
+{
+    const std::uint8_t HELLO_V2[] = {1, 2, 0, 0, 0, 0, 1};
+    sendWithFds(channel[0], HELLO_V2, sizeof(HELLO_V2));
+
+    ASSERT_THROW(receiveHandoff(channel[1]), UnixSocketEx);
+}
+
+}
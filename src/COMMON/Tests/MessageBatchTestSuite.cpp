@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Messages/MessageBatch.hpp"
+#include "Messages/IncomingMessage.hpp"
+#include "Messages/OutgoingMessage.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class MessageBatchTestSuite : public Test
+{
+protected:
+    const PhoneNumber FROM{1};
+    const PhoneNumber TO{2};
+    const BinaryMessage FIRST{ {get(MessageId::Sms), 1, 2, 'a'} };
+    const BinaryMessage SECOND{ {get(MessageId::CallTalk), 1, 2} };
+
+    MessageBatch objectUnderTest{FROM, TO};
+};
+
+TEST_F(MessageBatchTestSuite, shallSendSingleMessageAsIs)
+{
+    ASSERT_TRUE(objectUnderTest.add(FIRST));
+    ASSERT_EQ(FIRST.value, objectUnderTest.take().value);
+    ASSERT_TRUE(objectUnderTest.empty());
+}
+
+TEST_F(MessageBatchTestSuite, shallPackLengthPrefixedMessages)
+{
+    objectUnderTest.add(FIRST);
+    objectUnderTest.add(SECOND);
+    ASSERT_EQ(2u, objectUnderTest.size());
+
+    const BinaryMessage batch = objectUnderTest.take();
+    ASSERT_TRUE(MessageBatch::isBatch(batch));
+    ASSERT_THAT(batch.value, ElementsAre(get(MessageId::Batch), 1, 2,
+                                         0, 4, get(MessageId::Sms), 1, 2, 'a',
+                                         0, 3, get(MessageId::CallTalk), 1, 2));
+}
+
+TEST_F(MessageBatchTestSuite, shallUnpackInOrder)
+{
+    objectUnderTest.add(FIRST);
+    objectUnderTest.add(SECOND);
+
+    const auto messages = MessageBatch::unpack(objectUnderTest.take());
+    ASSERT_EQ(2u, messages.size());
+    ASSERT_EQ(FIRST.value, messages[0].value);
+    ASSERT_EQ(SECOND.value, messages[1].value);
+}
+
+TEST_F(MessageBatchTestSuite, shallRefuseMessageAboveMaxSize)
+{
+    const BinaryMessage HALF{ BinaryMessage::Value(BinaryMessage::MAX_SIZE / 2u, get(MessageId::Sms)) };
+    ASSERT_TRUE(objectUnderTest.add(HALF));
+    ASSERT_FALSE(objectUnderTest.add(HALF)) << "headers do not fit";
+    ASSERT_EQ(HALF.value, objectUnderTest.take().value);
+}
+
+TEST_F(MessageBatchTestSuite, shallRejectTruncatedBatch)
+{
+    const BinaryMessage truncated{ {get(MessageId::Batch), 1, 2, 0, 5, 1, 2} };
+    ASSERT_THROW(MessageBatch::unpack(truncated), IncomingMessage::ReadEx);
+}
+
+TEST_F(MessageBatchTestSuite, shallRejectNestedBatch)
+{
+    const BinaryMessage nested{ {get(MessageId::Batch), 1, 2, 0, 3, get(MessageId::Batch), 1, 2} };
+    ASSERT_THROW(MessageBatch::unpack(nested), IncomingMessage::ReadEx);
+}
+
+}
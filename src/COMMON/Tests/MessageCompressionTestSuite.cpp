@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Messages/MessageCompression.hpp"
+#include "Messages/IncomingMessage.hpp"
+#include "Messages/OutgoingMessage.hpp"
+#include <chrono>
+#include <random>
+
+using namespace ::testing;
+
+namespace common
+{
+
+namespace
+{
+
+BinaryMessage textMessage(MessageId messageId, const std::string& text)
+{
+    OutgoingMessage builder(messageId, PhoneNumber{1}, PhoneNumber{2});
+    builder.writeText(text);
+    return builder.getMessage();
+}
+
+std::string repeated(const std::string& text, std::size_t times)
+{
+    std::string result;
+    for (std::size_t i = 0u; i < times; ++i)
+    {
+        result += text;
+    }
+    return result;
+}
+
+}
+
+class MessageCompressionTestSuite : public Test
+{
+protected:
+    const std::string LONG_TEXT = repeated("Meet me at the station at 5 pm, do not be late! ", 10u);
+};
+
+TEST_F(MessageCompressionTestSuite, shallRoundTripBlock)
+{
+    const std::string text = LONG_TEXT + "abc" + repeated("x", 300u);
+    const auto block = compressBlock(reinterpret_cast<const std::uint8_t*>(text.data()), text.size());
+    ASSERT_LT(block.size(), text.size());
+
+    const auto decompressed = decompressBlock(block.data(), block.size(), text.size());
+    ASSERT_EQ(text, std::string(decompressed.begin(), decompressed.end()));
+}
+
+TEST_F(MessageCompressionTestSuite, shallRoundTripEmptyAndShortBlock)
+{
+    for (const std::string text : {"", "a", "abcd", "abcdabcd"})
+    {
+        const auto block = compressBlock(reinterpret_cast<const std::uint8_t*>(text.data()), text.size());
+        const auto decompressed = decompressBlock(block.data(), block.size(), text.size());
+        ASSERT_EQ(text, std::string(decompressed.begin(), decompressed.end()));
+    }
+}
+
+TEST_F(MessageCompressionTestSuite, shallCompressLongSms)
+{
+    const BinaryMessage sms = textMessage(MessageId::Sms, LONG_TEXT);
+    const auto compressed = compressMessage(sms);
+    ASSERT_TRUE(compressed);
+    ASSERT_TRUE(isCompressed(*compressed));
+    ASSERT_LT(compressed->value.size(), sms.value.size());
+
+    const BinaryMessage decompressed = decompressMessage(*compressed);
+    ASSERT_EQ(sms.value, decompressed.value);
+}
+
+TEST_F(MessageCompressionTestSuite, shallNotCompressBelowThreshold)
+{
+    ASSERT_FALSE(compressMessage(textMessage(MessageId::CallTalk, "hello hello hello")));
+}
+
+TEST_F(MessageCompressionTestSuite, shallNotCompressOtherMessages)
+{
+    ASSERT_FALSE(compressMessage(textMessage(MessageId::UnknownRecipient, LONG_TEXT)));
+}
+
+TEST_F(MessageCompressionTestSuite, shallNotCompressWhenItDoesNotShrink)
+{
+    std::mt19937 random{7};
+    std::string noise(200u, '\0');
+    for (auto& c : noise)
+    {
+        c = static_cast<char>(random());
+    }
+    ASSERT_FALSE(compressMessage(textMessage(MessageId::Sms, noise)));
+}
+
+TEST_F(MessageCompressionTestSuite, shallRejectMalformedBlocks)
+{
+    const std::string text = LONG_TEXT;
+    auto block = compressBlock(reinterpret_cast<const std::uint8_t*>(text.data()), text.size());
+    ASSERT_THROW(decompressBlock(block.data(), block.size(), text.size() - 1u), IncomingMessage::ReadEx);
+    ASSERT_THROW(decompressBlock(block.data(), block.size(), text.size() + 1u), IncomingMessage::ReadEx);
+    ASSERT_THROW(decompressBlock(block.data(), block.size() / 2u, text.size()), IncomingMessage::ReadEx);
+
+    const std::uint8_t farOffset[] = {0x10, 'a', 0x20, 0x00};
+    ASSERT_THROW(decompressBlock(farOffset, sizeof(farOffset), 10u), IncomingMessage::ReadEx);
+}
+
+/**
+ * Bandwidth saved vs CPU spent on generated SMS corpora - prints results, asserts only round trip
+ */
+class MessageCompressionBenchmarkTestSuite : public TestWithParam<const char*>
+{
+protected:
+    std::vector<BinaryMessage> corpus(const std::string& name)
+    {
+        static const std::vector<std::string> phrases = {
+            "hi", "ok", "see you soon", "where are you?", "call me when you can",
+            "I will be late, traffic is terrible today", "thanks!", "love you",
+            "meeting moved to 3 pm, room 204", "can you buy milk and bread on the way home?",
+            "happy birthday!!! have a great day", "the package was delivered to the reception",
+            "your verification code is 482913, do not share it with anyone",
+            "don't forget about the dentist tomorrow at 10:30", "on my way", ":)",
+        };
+        std::mt19937 random{2025};
+        std::vector<BinaryMessage> messages;
+        for (std::size_t i = 0u; i < 2000u; ++i)
+        {
+            std::string text;
+            const std::size_t targetSize = name == "short" ? 60u + random() % 100u
+                                         : name == "long" ? 400u + random() % 1200u
+                                                          : 100u + random() % 400u;
+            while (text.size() < targetSize)
+            {
+                if (name == "noise")
+                {
+                    text.push_back(static_cast<char>(random()));
+                    continue;
+                }
+                text += phrases[random() % phrases.size()];
+                text += random() % 3u == 0u ? ". " : " ";
+            }
+            messages.push_back(textMessage(MessageId::Sms, text));
+        }
+        return messages;
+    }
+};
+
+TEST_P(MessageCompressionBenchmarkTestSuite, shallMeasureBandwidthSavedAndCpuSpent)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto messages = corpus(GetParam());
+    std::size_t plainBytes = 0u;
+    std::size_t sentBytes = 0u;
+    std::vector<BinaryMessage> sent;
+    sent.reserve(messages.size());
+
+    const auto compressStart = Clock::now();
+    for (const auto& message : messages)
+    {
+        auto compressed = compressMessage(message);
+        sent.push_back(compressed ? std::move(*compressed) : message);
+        plainBytes += message.value.size();
+        sentBytes += sent.back().value.size();
+    }
+    const auto compressTime = Clock::now() - compressStart;
+
+    const auto decompressStart = Clock::now();
+    std::size_t mismatches = 0u;
+    for (std::size_t i = 0u; i < sent.size(); ++i)
+    {
+        const BinaryMessage received = isCompressed(sent[i]) ? decompressMessage(sent[i]) : sent[i];
+        mismatches += received.value != messages[i].value;
+    }
+    const auto decompressTime = Clock::now() - decompressStart;
+    ASSERT_EQ(0u, mismatches);
+
+    auto megabytesPerSecond = [plainBytes](Clock::duration time)
+    {
+        return plainBytes / std::max(std::chrono::duration<double>(time).count(), 1e-9) / 1e6;
+    };
+    std::cout << "[COMPRESSION] " << GetParam() << ": " << plainBytes << " -> " << sentBytes << " bytes ("
+              << 100.0 * (plainBytes - sentBytes) / plainBytes << "% saved), compress "
+              << megabytesPerSecond(compressTime) << " MB/s, decompress "
+              << megabytesPerSecond(decompressTime) << " MB/s" << std::endl;
+}
+
+INSTANTIATE_TEST_SUITE_P(Corpora, MessageCompressionBenchmarkTestSuite, Values("short", "mixed", "long", "noise"));
+
+}
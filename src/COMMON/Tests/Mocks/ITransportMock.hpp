@@ -14,6 +14,9 @@ struct ITransportMock : public ITransport
     MOCK_METHOD(void, registerMessageCallback, (MessageCallback), (final));
     MOCK_METHOD(void, registerDisconnectedCallback, (DisconnectedCallback), (final));
     MOCK_METHOD(bool, sendMessage, (BinaryMessage), (final));
+    MOCK_METHOD(void, registerBackpressureCallback, (BackpressureCallback), (final));
+    MOCK_METHOD(void, registerConnectedCallback, (ConnectedCallback), (final));
+    MOCK_METHOD(void, close, (), (final));
     MOCK_METHOD(std::string, addressToString, (), (const, final));
 };
 
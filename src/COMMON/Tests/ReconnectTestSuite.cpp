@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <set>
+#include "Transport/Reconnect.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+using namespace std::chrono_literals;
+
+TEST(ReconnectBackoffTestSuite, shallDoubleDelayUpToMaximumWithJitterInUpperHalf)
+{
+    ReconnectBackoff objectUnderTest{100ms, 1000ms, 1u};
+
+    const std::chrono::milliseconds expectedBase[] = {100ms, 200ms, 400ms, 800ms, 1000ms, 1000ms};
+    for (auto base : expectedBase)
+    {
+        const auto delay = objectUnderTest.next();
+        EXPECT_LE(base / 2, delay);
+        EXPECT_GE(base, delay);
+    }
+    EXPECT_EQ(6u, objectUnderTest.attempts());
+}
+
+TEST(ReconnectBackoffTestSuite, shallStartOverAfterReset)
+{
+    ReconnectBackoff objectUnderTest{100ms, 10000ms, 1u};
+    objectUnderTest.next();
+    objectUnderTest.next();
+    objectUnderTest.next();
+
+    objectUnderTest.reset();
+
+    EXPECT_EQ(0u, objectUnderTest.attempts());
+    EXPECT_GE(100ms, objectUnderTest.next());
+}
+
+TEST(ReconnectBackoffTestSuite, shallSpreadPeersWhichLostConnectionTogether)
+{
+    std::set<std::chrono::milliseconds::rep> firstDelays;
+    for (std::uint32_t peer = 0u; peer < 100u; ++peer)
+    {
+        ReconnectBackoff backoff{1000ms, 30000ms, peer};
+        firstDelays.insert(backoff.next().count());
+    }
+    EXPECT_LT(50u, firstDelays.size());
+}
+
+TEST(OutboxTestSuite, shallKeepMessagesInOrderAndDropOldestAboveCapacity)
+{
+    Outbox<> objectUnderTest{2u};
+
+    EXPECT_TRUE(objectUnderTest.push(BinaryMessage{{1}}));
+    EXPECT_TRUE(objectUnderTest.push(BinaryMessage{{2}}));
+    EXPECT_FALSE(objectUnderTest.push(BinaryMessage{{3}}));
+    ASSERT_EQ(2u, objectUnderTest.size());
+
+    const auto messages = objectUnderTest.takeAll();
+    ASSERT_EQ(2u, messages.size());
+    EXPECT_EQ(BinaryMessage{{2}}.value, messages[0].value);
+    EXPECT_EQ(BinaryMessage{{3}}.value, messages[1].value);
+    EXPECT_TRUE(objectUnderTest.empty());
+}
+
+TEST(OutboxTestSuite, shallKeepNothingWithoutCapacity)
+{
+    Outbox<> objectUnderTest{0u};
+
+    EXPECT_FALSE(objectUnderTest.push(BinaryMessage{{1}}));
+    EXPECT_TRUE(objectUnderTest.empty());
+}
+
+}
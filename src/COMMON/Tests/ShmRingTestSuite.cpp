@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <numeric>
+#include "Transport/ShmRing.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class ShmRingTestSuite : public Test
+{
+protected:
+    static constexpr std::size_t CAPACITY = ShmRing::MIN_CAPACITY;
+
+    ShmRingTestSuite()
+    {
+        objectUnderTest.initialize();
+    }
+
+    static std::vector<std::uint8_t> makeBytes(std::size_t size, std::uint8_t seed)
+    {
+        std::vector<std::uint8_t> bytes(size);
+        std::iota(bytes.begin(), bytes.end(), seed);
+        return bytes;
+    }
+
+    struct alignas(64) Memory
+    {
+        std::uint8_t bytes[sizeof(ShmRing::Header) + CAPACITY];
+    };
+    std::unique_ptr<Memory> memory = std::make_unique<Memory>();
+    ShmRing objectUnderTest{memory.get(), CAPACITY};
+};
+
+TEST_F(ShmRingTestSuite, shallRoundCapacityToPowerOf2)
+{
+    ASSERT_EQ(ShmRing::MIN_CAPACITY, ShmRing::roundCapacity(0u));
+    ASSERT_EQ(ShmRing::MIN_CAPACITY * 2u, ShmRing::roundCapacity(ShmRing::MIN_CAPACITY + 1u));
+    ASSERT_EQ(ShmRing::MAX_CAPACITY, ShmRing::roundCapacity(ShmRing::MAX_CAPACITY * 3u));
+}
+
+TEST_F(ShmRingTestSuite, shallReadWhatWasWritten)
+{
+    const auto BYTES = makeBytes(100, 1);
+    ASSERT_TRUE(objectUnderTest.write(BYTES.data(), BYTES.size()));
+    ASSERT_EQ(BYTES.size(), objectUnderTest.usedBytes());
+
+    std::vector<std::uint8_t> read(CAPACITY);
+    ASSERT_EQ(BYTES.size(), objectUnderTest.read(read.data(), read.size()));
+    read.resize(BYTES.size());
+    ASSERT_EQ(BYTES, read);
+    ASSERT_EQ(0u, objectUnderTest.usedBytes());
+}
+
+TEST_F(ShmRingTestSuite, shallNotWritePartially)
+{
+    const auto BYTES = makeBytes(CAPACITY - 10u, 2);
+    ASSERT_TRUE(objectUnderTest.write(BYTES.data(), BYTES.size()));
+    ASSERT_FALSE(objectUnderTest.write(BYTES.data(), 11u));
+    ASSERT_EQ(BYTES.size(), objectUnderTest.usedBytes());
+    ASSERT_TRUE(objectUnderTest.write(BYTES.data(), 10u));
+}
+
+TEST_F(ShmRingTestSuite, shallWrapAround)
+{
+    std::vector<std::uint8_t> read(CAPACITY);
+    const auto FILLER = makeBytes(CAPACITY - 3u, 3);
+    ASSERT_TRUE(objectUnderTest.write(FILLER.data(), FILLER.size()));
+    ASSERT_EQ(FILLER.size(), objectUnderTest.read(read.data(), read.size()));
+
+    const auto BYTES = makeBytes(10u, 4);
+    ASSERT_TRUE(objectUnderTest.write(BYTES.data(), BYTES.size()));
+    ASSERT_EQ(BYTES.size(), objectUnderTest.read(read.data(), read.size()));
+    read.resize(BYTES.size());
+    ASSERT_EQ(BYTES, read);
+}
+
+TEST_F(ShmRingTestSuite, shallReportWaitingConsumerOnce)
+{
+    const auto BYTES = makeBytes(1u, 5);
+    // consumer is initially regarded as waiting
+    ASSERT_TRUE(objectUnderTest.write(BYTES.data(), BYTES.size()));
+    ASSERT_TRUE(objectUnderTest.takeDataWanted());
+    ASSERT_FALSE(objectUnderTest.takeDataWanted());
+
+    ASSERT_FALSE(objectUnderTest.armDataWanted()) << "data still there - shall not sleep";
+    std::uint8_t byte;
+    objectUnderTest.read(&byte, 1u);
+    ASSERT_TRUE(objectUnderTest.armDataWanted());
+    ASSERT_TRUE(objectUnderTest.takeDataWanted());
+}
+
+TEST_F(ShmRingTestSuite, shallReportWaitingProducer)
+{
+    const auto BYTES = makeBytes(100u, 6);
+    ASSERT_TRUE(objectUnderTest.write(BYTES.data(), BYTES.size()));
+    ASSERT_FALSE(objectUnderTest.takeSpaceWanted());
+
+    ASSERT_TRUE(objectUnderTest.armSpaceWanted(10u));
+    std::vector<std::uint8_t> read(CAPACITY);
+    objectUnderTest.read(read.data(), 95u);
+    ASSERT_TRUE(objectUnderTest.takeSpaceWanted());
+    ASSERT_FALSE(objectUnderTest.armSpaceWanted(10u)) << "already below limit";
+}
+
+TEST_F(ShmRingTestSuite, shallRejectPositionsBeyondCapacity)
+{
+    // as if peer moved its position arbitrarily
+    auto& header = *reinterpret_cast<ShmRing::Header*>(memory.get());
+    header.tail.store(CAPACITY + 1u);
+
+    std::vector<std::uint8_t> read(CAPACITY);
+    ASSERT_THROW(objectUnderTest.read(read.data(), read.size()), ShmRing::CorruptedEx);
+    ASSERT_THROW(objectUnderTest.write(read.data(), 1u), ShmRing::CorruptedEx);
+    ASSERT_EQ(0u, header.head.load()) << "nothing consumed";
+}
+
+}
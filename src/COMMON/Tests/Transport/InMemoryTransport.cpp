@@ -0,0 +1,149 @@
+#include "InMemoryTransport.hpp"
+#include <algorithm>
+
+namespace common
+{
+
+InMemoryTransport::InMemoryTransport(std::string address, Limits limits)
+    : address(std::move(address)),
+      limits(limits)
+{}
+
+void InMemoryTransport::registerMessageCallback(MessageCallback messageCallback)
+{
+    this->messageCallback = messageCallback;
+}
+
+void InMemoryTransport::registerDisconnectedCallback(DisconnectedCallback disconnectedCallback)
+{
+    this->disconnectedCallback = disconnectedCallback;
+}
+
+void InMemoryTransport::registerBackpressureCallback(BackpressureCallback backpressureCallback)
+{
+    this->backpressureCallback = backpressureCallback;
+}
+
+bool InMemoryTransport::sendMessage(BinaryMessage message)
+{
+    return writeRaw(encodeFrame(message));
+}
+
+std::string InMemoryTransport::addressToString() const
+{
+    return address;
+}
+
+bool InMemoryTransport::writeRaw(const FrameBytes &bytes)
+{
+    if (closed or outgoing.size() + bytes.size() > limits.sendBufferSize)
+    {
+        return false;
+    }
+    outgoing.insert(outgoing.end(), bytes.begin(), bytes.end());
+    updateBackpressure();
+    return true;
+}
+
+void InMemoryTransport::transferTo(InMemoryTransport &peer)
+{
+    if (closed)
+    {
+        peer.handlePeerClosed();
+        return;
+    }
+    const std::size_t size = std::min(outgoing.size(), limits.bytesPerPoll);
+    if (size == 0u)
+    {
+        return;
+    }
+    FrameBytes chunk(outgoing.begin(), outgoing.begin() + size);
+    outgoing.erase(outgoing.begin(), outgoing.begin() + size);
+    updateBackpressure();
+    peer.receive(chunk);
+}
+
+void InMemoryTransport::close()
+{
+    closed = true;
+    outgoing.clear();
+}
+
+void InMemoryTransport::receive(const FrameBytes &bytes)
+{
+    decoder.feed(bytes.data(), bytes.size(), [this](BinaryMessage message)
+    {
+        if (messageCallback)
+        {
+            messageCallback(std::move(message));
+        }
+    });
+}
+
+void InMemoryTransport::handlePeerClosed()
+{
+    if (peerClosedReported)
+    {
+        return;
+    }
+    peerClosedReported = true;
+    if (disconnectedCallback)
+    {
+        disconnectedCallback();
+    }
+}
+
+void InMemoryTransport::updateBackpressure()
+{
+    const bool nowCongested = congested ? outgoing.size() > limits.lowWatermark
+                                        : outgoing.size() > limits.highWatermark;
+    if (nowCongested != congested)
+    {
+        congested = nowCongested;
+        if (backpressureCallback)
+        {
+            backpressureCallback(congested);
+        }
+    }
+}
+
+InMemoryTransportConnection::InMemoryTransportConnection(InMemoryTransport::Limits limits)
+    : clientTransport("in-memory-client", limits),
+      serverTransport("in-memory-server", limits)
+{}
+
+ITransport &InMemoryTransportConnection::client()
+{
+    return clientTransport;
+}
+
+ITransport &InMemoryTransportConnection::server()
+{
+    return serverTransport;
+}
+
+void InMemoryTransportConnection::poll()
+{
+    clientTransport.transferTo(serverTransport);
+    serverTransport.transferTo(clientTransport);
+}
+
+void InMemoryTransportConnection::writeRawFromClient(const FrameBytes &bytes)
+{
+    clientTransport.writeRaw(bytes);
+}
+
+void InMemoryTransportConnection::closeClient()
+{
+    clientTransport.close();
+}
+
+TransportBackend inMemoryTransportBackend()
+{
+    constexpr InMemoryTransport::Limits LIMITS{16u * 1024u, 64u * 1024u, 256u * 1024u, 8u * 1024u};
+    return TransportBackend{"InMemory",
+                            [LIMITS] { return std::make_unique<InMemoryTransportConnection>(LIMITS); },
+                            true};
+}
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <deque>
+#include <string>
+#include "TransportConformance.hpp"
+
+namespace common
+{
+
+/**
+ * Reference ITransport for the transport harness: a byte stream kept in memory,
+ * moved to the peer only on poll(), with bounded send buffer.
+ */
+class InMemoryTransport : public ITransport
+{
+public:
+    struct Limits
+    {
+        std::size_t lowWatermark;
+        std::size_t highWatermark;
+        std::size_t sendBufferSize;
+        std::size_t bytesPerPoll;
+    };
+
+    InMemoryTransport(std::string address, Limits limits);
+
+    void registerMessageCallback(MessageCallback messageCallback) override;
+    void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
+    void registerBackpressureCallback(BackpressureCallback backpressureCallback) override;
+    bool sendMessage(BinaryMessage message) override;
+    std::string addressToString() const override;
+
+    bool writeRaw(const FrameBytes& bytes);
+    void transferTo(InMemoryTransport& peer);
+    void close() override;
+
+private:
+    void receive(const FrameBytes& bytes);
+    void handlePeerClosed();
+    void updateBackpressure();
+
+    const std::string address;
+    const Limits limits;
+    std::deque<std::uint8_t> outgoing;
+    FrameDecoder decoder;
+    bool congested = false;
+    bool closed = false;
+    bool peerClosedReported = false;
+
+    MessageCallback messageCallback;
+    DisconnectedCallback disconnectedCallback;
+    BackpressureCallback backpressureCallback;
+};
+
+class InMemoryTransportConnection : public ITransportConnection
+{
+public:
+    explicit InMemoryTransportConnection(InMemoryTransport::Limits limits);
+
+    ITransport& client() override;
+    ITransport& server() override;
+    void poll() override;
+    void writeRawFromClient(const FrameBytes& bytes) override;
+    void closeClient() override;
+
+private:
+    InMemoryTransport clientTransport;
+    InMemoryTransport serverTransport;
+};
+
+TransportBackend inMemoryTransportBackend();
+
+}
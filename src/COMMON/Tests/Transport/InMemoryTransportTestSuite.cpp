@@ -0,0 +1,14 @@
+#include "InMemoryTransport.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+INSTANTIATE_TEST_SUITE_P(InMemory, TransportConformanceTestSuite,
+                         Values(inMemoryTransportBackend()), transportBackendName);
+
+INSTANTIATE_TEST_SUITE_P(InMemory, TransportThroughputTestSuite,
+                         Values(inMemoryTransportBackend()), transportBackendName);
+
+}
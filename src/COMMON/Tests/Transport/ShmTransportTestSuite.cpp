@@ -0,0 +1,159 @@
+#include "TransportConformance.hpp"
+#include "Transport/ShmTransport.hpp"
+#include "Mocks/ILoggerMock.hpp"
+
+#include <gmock/gmock.h>
+#include <unistd.h>
+
+using namespace ::testing;
+
+namespace common
+{
+
+namespace
+{
+
+std::string uniqueSocketPath()
+{
+    static unsigned counter = 0;
+    return "/tmp/shm_transport_ut_" + std::to_string(::getpid()) + "_" + std::to_string(counter++);
+}
+
+class ShmTransportConnection : public ITransportConnection
+{
+public:
+    ShmTransportConnection()
+        : listener(uniqueSocketPath()),
+          clientTransport(logger, ShmChannel::connect(listener.getPath(), RING_CAPACITY)),
+          serverTransport(logger, acceptChannel())
+    {}
+
+    ITransport& client() override
+    {
+        return clientTransport;
+    }
+
+    ITransport& server() override
+    {
+        return serverTransport;
+    }
+
+    void poll() override
+    {
+        clientTransport.poll();
+        serverTransport.poll();
+    }
+
+    void writeRawFromClient(const FrameBytes& bytes) override
+    {
+        ASSERT_TRUE(clientTransport.writeRaw(bytes.data(), bytes.size()));
+    }
+
+    void closeClient() override
+    {
+        clientTransport.close();
+    }
+
+private:
+    static constexpr std::size_t RING_CAPACITY = 64u * 1024u;
+
+    ShmChannel acceptChannel()
+    {
+        auto channel = listener.accept();
+        if (not channel)
+        {
+            throw std::runtime_error("No pending shm connection on " + listener.getPath());
+        }
+        return std::move(*channel);
+    }
+
+    NiceMock<ILoggerMock> logger;
+    ShmListener listener;
+    ShmTransport clientTransport;
+    ShmTransport serverTransport;
+};
+
+TransportBackend shmTransportBackend()
+{
+    return TransportBackend{"SharedMemory",
+                            [] { return std::make_unique<ShmTransportConnection>(); },
+                            true};
+}
+
+}
+
+INSTANTIATE_TEST_SUITE_P(SharedMemory, TransportConformanceTestSuite,
+                         Values(shmTransportBackend()), transportBackendName);
+
+INSTANTIATE_TEST_SUITE_P(SharedMemory, TransportThroughputTestSuite,
+                         Values(shmTransportBackend()), transportBackendName);
+
+class ShmTransportTestSuite : public Test
+{
+protected:
+    NiceMock<ILoggerMock> logger;
+    ShmListener listener{uniqueSocketPath()};
+};
+
+TEST_F(ShmTransportTestSuite, shallReturnNothingWhenNoConnectionPending)
+{
+    ASSERT_FALSE(listener.accept().has_value());
+}
+
+TEST_F(ShmTransportTestSuite, shallFailToConnectWhenNobodyListens)
+{
+    ASSERT_THROW(ShmChannel::connect(listener.getPath() + "_none"), UnixSocketEx);
+}
+
+TEST_F(ShmTransportTestSuite, shallWakeUpPeerOnlyWhenItWaitsForData)
+{
+    ShmTransport client(logger, ShmChannel::connect(listener.getPath()));
+    auto channel = listener.accept();
+    ASSERT_TRUE(channel.has_value());
+    const int doorbell = channel->doorbellFd();
+    ShmTransport server(logger, std::move(*channel));
+
+    std::uint64_t counter = 0;
+    ASSERT_TRUE(client.sendMessage(BinaryMessage{ {1} }));
+    ASSERT_TRUE(client.sendMessage(BinaryMessage{ {2} }));
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(counter)), ::read(doorbell, &counter, sizeof(counter)));
+    ASSERT_EQ(1u, counter);
+
+    std::vector<BinaryMessage> received;
+    server.registerMessageCallback([&](BinaryMessage message) { received.push_back(message); });
+    server.poll();
+    ASSERT_EQ(2u, received.size());
+}
+
+TEST_F(ShmTransportTestSuite, shallNotSendAfterPeerClosed)
+{
+    auto client = std::make_unique<ShmTransport>(logger, ShmChannel::connect(listener.getPath()));
+    ShmTransport server(logger, std::move(*listener.accept()));
+    client.reset();
+
+    server.poll();
+    ASSERT_FALSE(server.sendMessage(BinaryMessage{ {1} }));
+}
+
+TEST_F(ShmTransportTestSuite, shallNotBlockWaitingForRendezvous)
+{
+    int socket = connectUnix(listener.getPath(), SOCK_STREAM);
+    auto channel = listener.accept();
+    ASSERT_TRUE(channel.has_value());
+    ASSERT_FALSE(channel->isEstablished());
+    ASSERT_FALSE(channel->completeRendezvous());
+
+    closeFd(socket);
+    ASSERT_THROW(channel->completeRendezvous(), UnixSocketEx);
+}
+
+TEST_F(ShmTransportTestSuite, shallEstablishChannelWhenDescriptorsAlreadyArrived)
+{
+    auto client = ShmChannel::connect(listener.getPath());
+    auto channel = listener.accept();
+    ASSERT_TRUE(channel.has_value());
+    ASSERT_TRUE(channel->isEstablished());
+    ASSERT_TRUE(channel->completeRendezvous());
+}
+
+}
@@ -0,0 +1,283 @@
+#include "TransportConformance.hpp"
+
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+using namespace ::testing;
+
+namespace common
+{
+
+void PrintTo(const TransportBackend &backend, std::ostream *os)
+{
+    *os << backend.name;
+}
+
+std::string transportBackendName(const TestParamInfo<TransportBackend> &info)
+{
+    return info.param.name;
+}
+
+constexpr std::chrono::seconds TransportHarnessBase::POLL_TIMEOUT;
+
+void TransportHarnessBase::SetUp()
+{
+    connection = GetParam().connect();
+    ASSERT_TRUE(connection);
+    connection->server().registerMessageCallback([this](BinaryMessage message)
+    {
+        receivedByServer.push_back(std::move(message));
+    });
+    connection->server().registerDisconnectedCallback([this]
+    {
+        ++serverDisconnections;
+    });
+    connection->client().registerMessageCallback([this](BinaryMessage message)
+    {
+        receivedByClient.push_back(std::move(message));
+    });
+}
+
+void TransportHarnessBase::TearDown()
+{
+    if (connection)
+    {
+        connection->server().registerMessageCallback(nullptr);
+        connection->server().registerDisconnectedCallback(nullptr);
+        connection->client().registerMessageCallback(nullptr);
+        connection->client().registerBackpressureCallback(nullptr);
+        connection.reset();
+    }
+}
+
+bool TransportHarnessBase::pollUntil(const std::function<bool()> &condition,
+                                     std::chrono::milliseconds timeout)
+{
+    const auto deadline = Clock::now() + timeout;
+    do
+    {
+        connection->poll();
+        if (condition())
+        {
+            return true;
+        }
+    }
+    while (Clock::now() < deadline);
+    return false;
+}
+
+BinaryMessage TransportHarnessBase::makeMessage(std::size_t size, std::uint8_t seed)
+{
+    BinaryMessage message{ BinaryMessage::Value(size) };
+    std::iota(message.value.begin(), message.value.end(), seed);
+    return message;
+}
+
+namespace
+{
+
+auto EqMessage(const BinaryMessage& expected)
+{
+    return Field(&BinaryMessage::value, ContainerEq(expected.value));
+}
+
+template <typename Duration>
+double toMicroseconds(Duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+}
+
+TEST_P(TransportConformanceTestSuite, shallDeliverMessageFromClientToServer)
+{
+    const auto MESSAGE = makeMessage(17, 1);
+    ASSERT_TRUE(connection->client().sendMessage(MESSAGE));
+
+    ASSERT_TRUE(pollUntil([this] { return not receivedByServer.empty(); }));
+    ASSERT_THAT(receivedByServer, ElementsAre(EqMessage(MESSAGE)));
+}
+
+TEST_P(TransportConformanceTestSuite, shallDeliverMessageFromServerToClient)
+{
+    const auto MESSAGE = makeMessage(17, 2);
+    ASSERT_TRUE(connection->server().sendMessage(MESSAGE));
+
+    ASSERT_TRUE(pollUntil([this] { return not receivedByClient.empty(); }));
+    ASSERT_THAT(receivedByClient, ElementsAre(EqMessage(MESSAGE)));
+}
+
+TEST_P(TransportConformanceTestSuite, shallKeepOrderAndBoundariesOfMessages)
+{
+    const std::vector<std::size_t> SIZES{0, 1, 2, 3, 255, 256, 257, 1024, BinaryMessage::MAX_SIZE};
+    std::vector<BinaryMessage> sent;
+    for (std::size_t round = 0; round < 10; ++round)
+    {
+        for (auto size : SIZES)
+        {
+            sent.push_back(makeMessage(size, static_cast<std::uint8_t>(round + size)));
+            while (not connection->client().sendMessage(sent.back()))
+            {
+                connection->poll();
+            }
+        }
+    }
+
+    ASSERT_TRUE(pollUntil([&] { return receivedByServer.size() >= sent.size(); }));
+    ASSERT_EQ(sent.size(), receivedByServer.size());
+    for (std::size_t i = 0; i < sent.size(); ++i)
+    {
+        ASSERT_THAT(receivedByServer[i], EqMessage(sent[i])) << "message #" << i;
+    }
+}
+
+TEST_P(TransportConformanceTestSuite, shallReassembleFrameDeliveredByteByByte)
+{
+    const auto MESSAGE = makeMessage(300, 3);
+    const FrameBytes frame = encodeFrame(MESSAGE);
+
+    for (std::size_t i = 0; i + 1 < frame.size(); ++i)
+    {
+        connection->writeRawFromClient(FrameBytes{frame[i]});
+        connection->poll();
+        ASSERT_THAT(receivedByServer, IsEmpty()) << "after byte #" << i;
+    }
+    connection->writeRawFromClient(FrameBytes{frame.back()});
+
+    ASSERT_TRUE(pollUntil([this] { return not receivedByServer.empty(); }));
+    ASSERT_THAT(receivedByServer, ElementsAre(EqMessage(MESSAGE)));
+}
+
+TEST_P(TransportConformanceTestSuite, shallSplitFramesDeliveredInOneChunk)
+{
+    const auto MESSAGE1 = makeMessage(5, 4);
+    const auto MESSAGE2 = makeMessage(0, 5);
+    const auto MESSAGE3 = makeMessage(1000, 6);
+    FrameBytes frames;
+    appendFrame(frames, MESSAGE1);
+    appendFrame(frames, MESSAGE2);
+    appendFrame(frames, MESSAGE3);
+    // last frame split across two chunks
+    const std::size_t SPLIT = frames.size() - 500;
+
+    connection->writeRawFromClient(FrameBytes(frames.begin(), frames.begin() + SPLIT));
+    ASSERT_TRUE(pollUntil([this] { return receivedByServer.size() >= 2u; }));
+    connection->writeRawFromClient(FrameBytes(frames.begin() + SPLIT, frames.end()));
+
+    ASSERT_TRUE(pollUntil([this] { return receivedByServer.size() >= 3u; }));
+    ASSERT_THAT(receivedByServer, ElementsAre(EqMessage(MESSAGE1),
+                                              EqMessage(MESSAGE2),
+                                              EqMessage(MESSAGE3)));
+}
+
+TEST_P(TransportConformanceTestSuite, shallReportDisconnection)
+{
+    connection->closeClient();
+
+    ASSERT_TRUE(pollUntil([this] { return serverDisconnections > 0u; }));
+    ASSERT_EQ(1u, serverDisconnections);
+}
+
+TEST_P(TransportConformanceTestSuite, shallNotCallUnregisteredCallbacks)
+{
+    connection->server().registerMessageCallback(nullptr);
+    connection->server().registerDisconnectedCallback(nullptr);
+
+    ASSERT_TRUE(connection->client().sendMessage(makeMessage(10, 7)));
+    connection->closeClient();
+    pollUntil([] { return false; }, std::chrono::milliseconds(100));
+
+    ASSERT_THAT(receivedByServer, IsEmpty());
+    ASSERT_EQ(0u, serverDisconnections);
+}
+
+TEST_P(TransportConformanceTestSuite, shallReportCongestionAndRelief)
+{
+    if (not GetParam().reportsBackpressure)
+    {
+        GTEST_SKIP() << GetParam().name << " does not report backpressure";
+    }
+    std::vector<bool> congestionReports;
+    connection->client().registerBackpressureCallback([&](bool congested)
+    {
+        congestionReports.push_back(congested);
+    });
+
+    // server is not polled - its peer must eventually get congested
+    constexpr std::size_t FLOOD_LIMIT = 256u * 1024u * 1024u;
+    std::size_t accepted = 0;
+    for (std::size_t flooded = 0; congestionReports.empty() and flooded < FLOOD_LIMIT;
+         flooded += BinaryMessage::MAX_SIZE)
+    {
+        if (connection->client().sendMessage(makeMessage(BinaryMessage::MAX_SIZE, 8)))
+        {
+            ++accepted;
+        }
+    }
+    ASSERT_THAT(congestionReports, ElementsAre(true));
+
+    ASSERT_TRUE(pollUntil([&] { return congestionReports.size() > 1u
+                                       and receivedByServer.size() == accepted; }));
+    ASSERT_THAT(congestionReports, ElementsAre(true, false));
+    ASSERT_THAT(receivedByServer.back(), EqMessage(makeMessage(BinaryMessage::MAX_SIZE, 8)));
+}
+
+TEST_P(TransportThroughputTestSuite, shallReportThroughput)
+{
+    constexpr std::size_t MESSAGES = 20000;
+    constexpr std::size_t BURST = 256;
+    const auto MESSAGE = makeMessage(64, 9);
+
+    const auto start = Clock::now();
+    for (std::size_t sent = 0; sent < MESSAGES;)
+    {
+        for (std::size_t i = 0; i < BURST and sent < MESSAGES; ++i)
+        {
+            if (not connection->client().sendMessage(MESSAGE))
+            {
+                break;
+            }
+            ++sent;
+        }
+        connection->poll();
+    }
+    ASSERT_TRUE(pollUntil([&] { return receivedByServer.size() >= MESSAGES; }));
+    const auto elapsed = Clock::now() - start;
+
+    ASSERT_EQ(MESSAGES, receivedByServer.size());
+    const double messagesPerSecond = MESSAGES / (toMicroseconds(elapsed) / 1e6);
+    RecordProperty("messagesPerSecond", std::to_string(static_cast<std::uint64_t>(messagesPerSecond)));
+    std::cout << "[ TRANSPORT] " << GetParam().name << ": "
+              << static_cast<std::uint64_t>(messagesPerSecond) << " msg/s ("
+              << MESSAGES << " x " << MESSAGE.value.size() << "B)" << std::endl;
+}
+
+TEST_P(TransportThroughputTestSuite, shallReportLatency)
+{
+    constexpr std::size_t ROUND_TRIPS = 1000;
+    const auto MESSAGE = makeMessage(64, 10);
+    std::vector<double> oneWayLatency;
+    oneWayLatency.reserve(ROUND_TRIPS);
+
+    for (std::size_t i = 0; i < ROUND_TRIPS; ++i)
+    {
+        const auto start = Clock::now();
+        ASSERT_TRUE(connection->client().sendMessage(MESSAGE));
+        ASSERT_TRUE(pollUntil([&] { return receivedByServer.size() > i; }));
+        ASSERT_TRUE(connection->server().sendMessage(MESSAGE));
+        ASSERT_TRUE(pollUntil([&] { return receivedByClient.size() > i; }));
+        oneWayLatency.push_back(toMicroseconds(Clock::now() - start) / 2);
+    }
+
+    std::sort(oneWayLatency.begin(), oneWayLatency.end());
+    const double p50 = oneWayLatency[ROUND_TRIPS / 2];
+    const double p99 = oneWayLatency[ROUND_TRIPS * 99 / 100];
+    RecordProperty("latencyP50us", std::to_string(p50));
+    RecordProperty("latencyP99us", std::to_string(p99));
+    std::cout << "[ TRANSPORT] " << GetParam().name << ": latency p50 "
+              << p50 << " us, p99 " << p99 << " us" << std::endl;
+}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CommonEnvironment/ITransport.hpp"
+#include "Transport/FrameCodec.hpp"
+
+namespace common
+{
+
+/**
+ * One established connection of the transport under test, plus the means to drive it.
+ *
+ * To run the conformance and throughput suites against a new ITransport implementation:
+ *  - implement this interface (see InMemoryTransport.hpp for the reference one),
+ *  - compile TransportConformance.cpp into your UT executable,
+ *  - INSTANTIATE_TEST_SUITE_P(YourName, TransportConformanceTestSuite, Values(TransportBackend{...}))
+ *    and the same for TransportThroughputTestSuite.
+ */
+class ITransportConnection
+{
+public:
+    virtual ~ITransportConnection() = default;
+
+    virtual ITransport& client() = 0;
+    virtual ITransport& server() = 0;
+
+    /**
+     * Does all I/O possible without waiting, in both directions.
+     */
+    virtual void poll() = 0;
+
+    /**
+     * Writes bytes on the client side of the stream, bypassing client framing.
+     */
+    virtual void writeRawFromClient(const FrameBytes& bytes) = 0;
+
+    /**
+     * Closes client side - server shall report disconnection.
+     */
+    virtual void closeClient() = 0;
+};
+
+struct TransportBackend
+{
+    std::string name;
+    std::function<std::unique_ptr<ITransportConnection>()> connect;
+    bool reportsBackpressure = false;
+};
+
+void PrintTo(const TransportBackend& backend, std::ostream* os);
+std::string transportBackendName(const ::testing::TestParamInfo<TransportBackend>& info);
+
+class TransportHarnessBase : public ::testing::TestWithParam<TransportBackend>
+{
+protected:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::chrono::seconds POLL_TIMEOUT{5};
+
+    void SetUp() override;
+    void TearDown() override;
+
+    bool pollUntil(const std::function<bool()>& condition,
+                   std::chrono::milliseconds timeout = POLL_TIMEOUT);
+
+    static BinaryMessage makeMessage(std::size_t size, std::uint8_t seed);
+
+    std::unique_ptr<ITransportConnection> connection;
+    std::vector<BinaryMessage> receivedByServer;
+    std::vector<BinaryMessage> receivedByClient;
+    unsigned serverDisconnections = 0;
+};
+
+class TransportConformanceTestSuite : public TransportHarnessBase
+{};
+
+class TransportThroughputTestSuite : public TransportHarnessBase
+{};
+
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Transport/UnixSocket.hpp"
+
+using namespace ::testing;
+
+namespace common
+{
+
+class UnixSocketTestSuite : public Test
+{
+protected:
+    ~UnixSocketTestSuite()
+    {
+        for (int fd : opened)
+        {
+            ::close(fd);
+        }
+    }
+
+    int track(int fd)
+    {
+        opened.push_back(fd);
+        return fd;
+    }
+
+    static bool exists(const std::string& path)
+    {
+        struct stat pathStat{};
+        return ::stat(path.c_str(), &pathStat) == 0;
+    }
+
+    const std::string PATH = "/tmp/unix_socket_ut_" + std::to_string(::getpid());
+    std::vector<int> opened;
+};
+
+TEST_F(UnixSocketTestSuite, shallAcceptConnection)
+{
+    UnixListener objectUnderTest(PATH, SOCK_STREAM);
+    ASSERT_EQ(-1, objectUnderTest.accept());
+
+    track(connectUnix(PATH, SOCK_STREAM));
+    ASSERT_GE(track(objectUnderTest.accept()), 0);
+}
+
+TEST_F(UnixSocketTestSuite, shallRemovePathOnDestruction)
+{
+    {
+        UnixListener objectUnderTest(PATH, SOCK_STREAM);
+        ASSERT_TRUE(exists(PATH));
+    }
+    ASSERT_FALSE(exists(PATH));
+}
+
+TEST_F(UnixSocketTestSuite, shallNotRemovePathReboundByOther)
+{
+    auto older = std::make_unique<UnixListener>(PATH, SOCK_STREAM);
+    UnixListener newer(PATH, SOCK_STREAM);
+    older.reset();
+
+    ASSERT_TRUE(exists(PATH));
+    track(connectUnix(PATH, SOCK_STREAM));
+    ASSERT_GE(track(newer.accept()), 0);
+}
+
+TEST_F(UnixSocketTestSuite, shallAdoptReleasedListener)
+{
+    auto released = std::make_unique<UnixListener>(PATH, SOCK_SEQPACKET);
+    UnixListener objectUnderTest(released->release());
+    released.reset();
+
+    ASSERT_EQ(PATH, objectUnderTest.getPath());
+    ASSERT_TRUE(exists(PATH));
+    track(connectUnix(PATH, SOCK_SEQPACKET));
+    ASSERT_GE(track(objectUnderTest.accept()), 0);
+}
+
+TEST_F(UnixSocketTestSuite, shallRejectAdoptingNotListeningSocket)
+{
+    int pair[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, pair));
+    track(pair[1]);
+    ASSERT_THROW(UnixListener{pair[0]}, UnixSocketEx);
+}
+
+TEST_F(UnixSocketTestSuite, shallPassDescriptorsWithData)
+{
+    int pair[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, pair));
+    track(pair[0]);
+    track(pair[1]);
+    int pipeFds[2];
+    ASSERT_EQ(0, ::pipe(pipeFds));
+    track(pipeFds[0]);
+    track(pipeFds[1]);
+
+    const std::vector<std::uint8_t> DATA{1, 2, 3};
+    sendWithFds(pair[0], DATA.data(), DATA.size(), {pipeFds[1]});
+
+    std::vector<std::uint8_t> received(16);
+    std::vector<int> fds;
+    ASSERT_EQ(DATA.size(), receiveWithFds(pair[1], received.data(), received.size(), fds, 4));
+    ASSERT_EQ(1u, fds.size());
+    track(fds[0]);
+    received.resize(DATA.size());
+    ASSERT_EQ(DATA, received);
+
+    // received descriptor refers to the same pipe
+    const char BYTE = 'x';
+    ASSERT_EQ(1, ::write(fds[0], &BYTE, 1));
+    char readByte = 0;
+    ASSERT_EQ(1, ::read(pipeFds[0], &readByte, 1));
+    ASSERT_EQ(BYTE, readByte);
+}
+
+TEST_F(UnixSocketTestSuite, shallReportPeerClosed)
+{
+    int pair[2];
+    ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_SEQPACKET, 0, pair));
+    track(pair[1]);
+    ::close(pair[0]);
+
+    std::uint8_t byte;
+    std::vector<int> fds;
+    ASSERT_EQ(0u, receiveWithFds(pair[1], &byte, 1u, fds, 1u));
+}
+
+TEST_F(UnixSocketTestSuite, shallReportPeerPid)
+{
+    UnixListener listener(PATH, SOCK_STREAM);
+    track(connectUnix(PATH, SOCK_STREAM));
+    ASSERT_EQ(::getpid(), peerPid(track(listener.accept())));
+}
+
+}
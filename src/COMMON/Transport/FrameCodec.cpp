@@ -0,0 +1,97 @@
+#include "FrameCodec.hpp"
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+namespace common
+{
+
+namespace
+{
+
+BinaryMessage::SizeType readFrameLength(const std::uint8_t* header)
+{
+    BinaryMessage::SizeType length{};
+    for (std::size_t i = 0u; i < FRAME_HEADER_SIZE; ++i)
+    {
+        length = (length << 8u) + header[i];
+    }
+    return length;
+}
+
+}
+
+FrameBytes encodeFrame(const BinaryMessage &message)
+{
+    FrameBytes frame;
+    frame.reserve(FRAME_HEADER_SIZE + message.value.size());
+    appendFrame(frame, message);
+    return frame;
+}
+
+void appendFrame(FrameBytes &frames, const BinaryMessage &message)
+{
+    BinaryMessage::SizeType length = message.value.size();
+    for (std::size_t i = 0u; i < FRAME_HEADER_SIZE; ++i)
+    {
+        frames.push_back((length >> (8u * (FRAME_HEADER_SIZE - i - 1))) & 0xFF);
+    }
+    frames.insert(frames.end(), message.value.begin(), message.value.end());
+}
+
+std::size_t FrameDecoder::feed(const std::uint8_t *data, std::size_t size, const FrameCallback& frameCallback)
+{
+    buffer.insert(buffer.end(), data, data + size);
+
+    std::vector<BinaryMessage> messages;
+    std::size_t position = 0u;
+    while (buffer.size() - position >= FRAME_HEADER_SIZE)
+    {
+        const std::size_t length = readFrameLength(buffer.data() + position);
+        if (length > BinaryMessage::MAX_SIZE)
+        {
+            reset();
+            throw FrameEx("Frame length out of range: " + std::to_string(length));
+        }
+        if (buffer.size() - position - FRAME_HEADER_SIZE < length)
+        {
+            break;
+        }
+
+        const auto begin = buffer.begin() + position + FRAME_HEADER_SIZE;
+        BinaryMessage message{ BinaryMessage::Value(length) };
+        std::copy(begin, begin + length, message.value.begin());
+        messages.push_back(std::move(message));
+        position += FRAME_HEADER_SIZE + length;
+    }
+    // consume before delivery - callbacks are free to feed again or throw
+    buffer.erase(buffer.begin(), buffer.begin() + position);
+
+    if (frameCallback)
+    {
+        for (auto&& message : messages)
+        {
+            frameCallback(std::move(message));
+        }
+    }
+    return messages.size();
+}
+
+std::size_t FrameDecoder::bufferedBytes() const
+{
+    return buffer.size();
+}
+
+FrameBytes FrameDecoder::takeBuffered()
+{
+    FrameBytes taken;
+    taken.swap(buffer);
+    return taken;
+}
+
+void FrameDecoder::reset()
+{
+    buffer.clear();
+}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+#include "Messages/BinaryMessage.hpp"
+
+namespace common
+{
+
+/**
+ * Framing used on all byte-stream transports:
+ *
+ *   [BinaryMessage::SizeType length (big endian)][length bytes of BinaryMessage]
+ */
+constexpr std::size_t FRAME_HEADER_SIZE = sizeof(BinaryMessage::SizeType);
+
+using FrameBytes = std::vector<std::uint8_t>;
+
+FrameBytes encodeFrame(const BinaryMessage& message);
+void appendFrame(FrameBytes& frames, const BinaryMessage& message);
+
+/**
+ * Reassembles frames from a byte stream delivered in arbitrary chunks,
+ * i.e. one chunk might contain part of a frame, or several frames.
+ */
+class FrameDecoder
+{
+public:
+    class FrameEx : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    using FrameCallback = std::function<void(BinaryMessage)>;
+
+    /**
+     * @throw FrameEx when the length prefix exceeds BinaryMessage::MAX_SIZE,
+     *        the decoder is reset then - the stream cannot be trusted anymore
+     * @return number of complete frames passed to frameCallback
+     */
+    std::size_t feed(const std::uint8_t* data, std::size_t size, const FrameCallback& frameCallback);
+
+    std::size_t bufferedBytes() const;
+    /**
+     * Gives away incomplete frame, e.g. to pass the stream to other decoder.
+     */
+    FrameBytes takeBuffered();
+    void reset();
+
+private:
+    FrameBytes buffer;
+};
+
+}
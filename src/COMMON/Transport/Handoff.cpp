@@ -0,0 +1,263 @@
+#include "Handoff.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+namespace common
+{
+
+namespace
+{
+
+constexpr std::uint8_t PROTOCOL_VERSION = 1;
+// well below default SOCK_SEQPACKET limits
+constexpr std::size_t MAX_RECORD_SIZE = 32u * 1024u;
+constexpr std::size_t MAX_FDS_PER_RECORD = 3u;
+
+enum RecordType : std::uint8_t
+{
+    HELLO = 1,
+    CONNECTION,
+    INPUT,
+    END
+};
+
+enum ListenerBit : std::uint8_t
+{
+    TCP_LISTENER = 1u << 0,
+    UNIX_LISTENER = 1u << 1,
+    HANDOFF_LISTENER = 1u << 2
+};
+
+constexpr std::size_t HELLO_SIZE = 7u;
+constexpr std::size_t CONNECTION_HEADER_SIZE = 6u;
+
+void appendUint32(FrameBytes& record, std::uint32_t value)
+{
+    for (int shift = 24; shift >= 0; shift -= 8)
+    {
+        record.push_back(static_cast<std::uint8_t>(value >> shift));
+    }
+}
+
+std::uint32_t readUint32(const std::uint8_t* data)
+{
+    return (std::uint32_t{data[0]} << 24) | (std::uint32_t{data[1]} << 16)
+         | (std::uint32_t{data[2]} << 8) | std::uint32_t{data[3]};
+}
+
+void sendRecord(int socket, const FrameBytes& record, const std::vector<int>& fds = {})
+{
+    sendWithFds(socket, record.data(), record.size(), fds);
+}
+
+void sendHello(int socket, const HandoffState& state)
+{
+    std::uint8_t listeners = 0;
+    std::vector<int> fds;
+    for (auto [fd, bit] : {std::pair{state.tcpListener, TCP_LISTENER},
+                           std::pair{state.unixListener, UNIX_LISTENER},
+                           std::pair{state.handoffListener, HANDOFF_LISTENER}})
+    {
+        if (fd >= 0)
+        {
+            listeners |= bit;
+            fds.push_back(fd);
+        }
+    }
+    FrameBytes record{HELLO, PROTOCOL_VERSION, listeners};
+    appendUint32(record, state.id);
+    sendRecord(socket, record, fds);
+}
+
+void sendConnection(int socket, const HandoffConnection& connection)
+{
+    const auto& input = connection.pendingInput;
+    auto chunkBegin = input.begin();
+    auto nextChunkEnd = [&](std::size_t header)
+    {
+        return chunkBegin + std::min<std::size_t>(input.end() - chunkBegin, MAX_RECORD_SIZE - header);
+    };
+
+    FrameBytes record{CONNECTION, connection.phoneNumber.value};
+    appendUint32(record, input.size());
+    auto chunkEnd = nextChunkEnd(CONNECTION_HEADER_SIZE);
+    record.insert(record.end(), chunkBegin, chunkEnd);
+    sendRecord(socket, record, {connection.socket});
+
+    for (chunkBegin = chunkEnd; chunkBegin != input.end(); chunkBegin = chunkEnd)
+    {
+        chunkEnd = nextChunkEnd(1u);
+        record.assign(1u, INPUT);
+        record.insert(record.end(), chunkBegin, chunkEnd);
+        sendRecord(socket, record);
+    }
+}
+
+void protocolError(const char* what)
+{
+    throw UnixSocketEx(std::string("Handoff: ") + what, EPROTO);
+}
+
+class Receiver
+{
+public:
+    Receiver(int socket, HandoffState& state)
+        : socket(socket), state(state), record(MAX_RECORD_SIZE)
+    {}
+
+    ~Receiver()
+    {
+        closeUnexpectedFds();
+    }
+
+    void receive()
+    {
+        receiveRecord();
+        if (size != HELLO_SIZE or record[0] != HELLO)
+        {
+            protocolError("HELLO expected");
+        }
+        if (record[1] != PROTOCOL_VERSION)
+        {
+            protocolError("unsupported version");
+        }
+        takeListeners(record[2]);
+        state.id = readUint32(&record[3]);
+
+        for (receiveRecord(); record[0] == CONNECTION; )
+        {
+            receiveConnection();
+        }
+        if (record[0] != END or size != 1u or not fds.empty())
+        {
+            protocolError("END expected");
+        }
+    }
+
+private:
+    void receiveRecord()
+    {
+        closeUnexpectedFds();
+        size = receiveWithFds(socket, record.data(), record.size(), fds, MAX_FDS_PER_RECORD);
+        if (size == 0u)
+        {
+            throw UnixSocketEx("Handoff: peer closed", ECONNRESET);
+        }
+    }
+
+    void closeUnexpectedFds()
+    {
+        for (int& fd : fds)
+        {
+            closeFd(fd);
+        }
+        fds.clear();
+    }
+
+    void takeListeners(std::uint8_t listeners)
+    {
+        auto next = fds.begin();
+        for (auto [fd, bit] : {std::pair{&state.tcpListener, TCP_LISTENER},
+                               std::pair{&state.unixListener, UNIX_LISTENER},
+                               std::pair{&state.handoffListener, HANDOFF_LISTENER}})
+        {
+            if (listeners & bit)
+            {
+                if (next == fds.end())
+                {
+                    protocolError("listener missing");
+                }
+                *fd = std::exchange(*next++, -1);
+            }
+        }
+        if (next != fds.end())
+        {
+            protocolError("unexpected listener");
+        }
+        fds.clear();
+    }
+
+    void receiveConnection()
+    {
+        if (size < CONNECTION_HEADER_SIZE or fds.size() != 1u)
+        {
+            protocolError("malformed CONNECTION");
+        }
+        auto& connection = state.connections.emplace_back();
+        connection.socket = std::exchange(fds[0], -1);
+        fds.clear();
+        connection.phoneNumber = PhoneNumber{record[1]};
+        expectedInputSize = readUint32(&record[2]);
+        connection.pendingInput.reserve(std::min(expectedInputSize, MAX_RECORD_SIZE));
+        appendInput(CONNECTION_HEADER_SIZE);
+
+        for (receiveRecord(); record[0] == INPUT; receiveRecord())
+        {
+            appendInput(1u);
+        }
+        if (connection.pendingInput.size() != expectedInputSize)
+        {
+            protocolError("pending input size mismatch");
+        }
+    }
+
+    void appendInput(std::size_t header)
+    {
+        auto& input = state.connections.back().pendingInput;
+        if (input.size() + size - header > expectedInputSize)
+        {
+            protocolError("pending input exceeds declared size");
+        }
+        input.insert(input.end(), record.begin() + header, record.begin() + size);
+    }
+
+    const int socket;
+    HandoffState& state;
+    FrameBytes record;
+    std::size_t size = 0u;
+    std::size_t expectedInputSize = 0u;
+    std::vector<int> fds;
+};
+
+}
+
+void sendHandoff(int socket, const HandoffState& state)
+{
+    sendHello(socket, state);
+    for (const auto& connection : state.connections)
+    {
+        sendConnection(socket, connection);
+    }
+    sendRecord(socket, FrameBytes{END});
+}
+
+HandoffState receiveHandoff(int socket)
+{
+    HandoffState state;
+    try
+    {
+        Receiver(socket, state).receive();
+    }
+    catch (UnixSocketEx&)
+    {
+        closeHandoff(state);
+        throw;
+    }
+    return state;
+}
+
+void closeHandoff(HandoffState& state)
+{
+    closeFd(state.tcpListener);
+    closeFd(state.unixListener);
+    closeFd(state.handoffListener);
+    for (auto& connection : state.connections)
+    {
+        closeFd(connection.socket);
+    }
+    state.connections.clear();
+}
+
+}
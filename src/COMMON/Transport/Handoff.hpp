@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Messages/PhoneNumber.hpp"
+#include "FrameCodec.hpp"
+#include "UnixSocket.hpp"
+
+namespace common
+{
+
+/**
+ * Live connections passed to a newer instance of the same program - so it can be restarted
+ * without its peers noticing.
+ *
+ * Sent over connected SOCK_SEQPACKET unix socket, descriptors are attached as SCM_RIGHTS:
+ *   HELLO [id, which listeners are attached] + listening sockets
+ *   CONNECTION [phone number, size of unread input, first chunk of it] + connected socket
+ *   INPUT [next chunk of unread input] ...
+ *   END
+ * Receiving side owns all descriptors from the moment they are received.
+ */
+struct HandoffConnection
+{
+    int socket = -1;
+    // not attached when PhoneNumber{}
+    PhoneNumber phoneNumber{};
+    // received from socket by previous owner, but not handled yet
+    FrameBytes pendingInput;
+};
+
+struct HandoffState
+{
+    std::uint32_t id = 0;
+    int tcpListener = -1;
+    int unixListener = -1;
+    int handoffListener = -1;
+    std::vector<HandoffConnection> connections;
+};
+
+/**
+ * Descriptors stay open in sending process, they shall not be used anymore after that.
+ * @throw UnixSocketEx
+ */
+void sendHandoff(int socket, const HandoffState& state);
+
+/**
+ * Blocks until END received, with SO_RCVTIMEO of the socket applied to each record.
+ * @throw UnixSocketEx - descriptors received so far are closed then
+ */
+HandoffState receiveHandoff(int socket);
+
+void closeHandoff(HandoffState& state);
+
+}
@@ -0,0 +1,35 @@
+#include "Reconnect.hpp"
+#include <algorithm>
+
+namespace common
+{
+
+ReconnectBackoff::ReconnectBackoff(Duration initialDelay, Duration maxDelay, std::uint32_t seed)
+    : initialDelay(std::max(initialDelay, Duration{1})),
+      maxDelay(std::max(maxDelay, this->initialDelay)),
+      currentDelay(this->initialDelay),
+      random(seed)
+{}
+
+ReconnectBackoff::Duration ReconnectBackoff::next()
+{
+    const Duration delay = currentDelay;
+    ++attemptCount;
+    currentDelay = std::min(currentDelay * 2, maxDelay);
+
+    std::uniform_int_distribution<Duration::rep> jitter(0, delay.count() / 2);
+    return delay - Duration{jitter(random)};
+}
+
+void ReconnectBackoff::reset()
+{
+    currentDelay = initialDelay;
+    attemptCount = 0u;
+}
+
+std::size_t ReconnectBackoff::attempts() const
+{
+    return attemptCount;
+}
+
+}
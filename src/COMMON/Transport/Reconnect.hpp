@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <utility>
+#include "Messages/BinaryMessage.hpp"
+
+namespace common
+{
+
+/**
+ * Delays between reconnection attempts - doubled after each attempt, up to maximum.
+ * Each delay is drawn from upper half of the current one ("equal jitter"), so peers which lost
+ * connection at the same moment spread their attempts instead of reconnecting all at once.
+ */
+class ReconnectBackoff
+{
+public:
+    using Duration = std::chrono::milliseconds;
+
+    ReconnectBackoff(Duration initialDelay, Duration maxDelay, std::uint32_t seed = std::random_device{}());
+
+    Duration next();
+    // after connection is established
+    void reset();
+    // since last reset
+    std::size_t attempts() const;
+
+private:
+    Duration initialDelay;
+    Duration maxDelay;
+    Duration currentDelay;
+    std::size_t attemptCount = 0u;
+    std::mt19937 random;
+};
+
+/**
+ * Messages which could not be sent yet (e.g. not fitting into transport buffer), to be sent in order once possible.
+ * Bounded - oldest messages are dropped above capacity.
+ * Message is BinaryMessage, or already encoded frame of transport.
+ */
+template <typename Message = BinaryMessage>
+class Outbox
+{
+public:
+    explicit Outbox(std::size_t capacity)
+        : maxSize(capacity)
+    {}
+
+    /**
+     * @return false when oldest message was dropped to make room (or capacity is 0)
+     */
+    bool push(Message message)
+    {
+        if (maxSize == 0u)
+        {
+            return false;
+        }
+        const bool dropping = messages.size() >= maxSize;
+        if (dropping)
+        {
+            messages.pop_front();
+        }
+        messages.push_back(std::move(message));
+        return not dropping;
+    }
+
+    // oldest first, outbox is empty after that
+    std::deque<Message> takeAll()
+    {
+        std::deque<Message> taken;
+        taken.swap(messages);
+        return taken;
+    }
+
+    void clear() { messages.clear(); }
+    bool empty() const { return messages.empty(); }
+    std::size_t size() const { return messages.size(); }
+    std::size_t capacity() const { return maxSize; }
+
+private:
+    std::size_t maxSize;
+    std::deque<Message> messages;
+};
+
+}
@@ -0,0 +1,121 @@
+#include "ShmRing.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <string>
+
+namespace common
+{
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "ring positions must be usable across processes");
+static_assert(std::atomic<bool>::is_always_lock_free, "ring flags must be usable across processes");
+
+std::size_t ShmRing::roundCapacity(std::size_t requested)
+{
+    std::size_t capacity = MIN_CAPACITY;
+    while (capacity < requested and capacity < MAX_CAPACITY)
+    {
+        capacity <<= 1u;
+    }
+    return capacity;
+}
+
+std::size_t ShmRing::requiredSize(std::size_t capacity)
+{
+    return sizeof(Header) + capacity;
+}
+
+ShmRing::ShmRing(void *memory, std::size_t capacity)
+    : header(*static_cast<Header*>(memory)),
+      data(static_cast<std::uint8_t*>(memory) + sizeof(Header)),
+      capacityValue(capacity),
+      mask(capacity - 1u)
+{}
+
+void ShmRing::initialize()
+{
+    new (&header) Header{};
+    header.head.store(0u);
+    header.tail.store(0u);
+    // consumer is not polling yet - first write shall wake it
+    header.dataWanted.store(true);
+    header.spaceWanted.store(false);
+}
+
+bool ShmRing::write(const std::uint8_t *source, std::size_t size)
+{
+    const std::uint64_t tail = header.tail.load(std::memory_order_relaxed);
+    const std::uint64_t head = header.head.load(std::memory_order_acquire);
+    if (capacityValue - validUsedBytes(head, tail) < size)
+    {
+        return false;
+    }
+    const std::size_t offset = tail & mask;
+    const std::size_t firstPart = std::min(size, capacityValue - offset);
+    std::memcpy(data + offset, source, firstPart);
+    std::memcpy(data, source + firstPart, size - firstPart);
+    header.tail.store(tail + size, std::memory_order_seq_cst);
+    return true;
+}
+
+bool ShmRing::takeDataWanted()
+{
+    return header.dataWanted.load(std::memory_order_seq_cst)
+           and header.dataWanted.exchange(false, std::memory_order_seq_cst);
+}
+
+std::size_t ShmRing::read(std::uint8_t *destination, std::size_t maxSize)
+{
+    const std::uint64_t head = header.head.load(std::memory_order_relaxed);
+    const std::uint64_t tail = header.tail.load(std::memory_order_acquire);
+    const std::size_t size = std::min(maxSize, validUsedBytes(head, tail));
+    const std::size_t offset = head & mask;
+    const std::size_t firstPart = std::min(size, capacityValue - offset);
+    std::memcpy(destination, data + offset, firstPart);
+    std::memcpy(destination + firstPart, data, size - firstPart);
+    header.head.store(head + size, std::memory_order_seq_cst);
+    return size;
+}
+
+bool ShmRing::takeSpaceWanted()
+{
+    return header.spaceWanted.load(std::memory_order_seq_cst)
+           and header.spaceWanted.exchange(false, std::memory_order_seq_cst);
+}
+
+bool ShmRing::armDataWanted()
+{
+    header.dataWanted.store(true, std::memory_order_seq_cst);
+    return usedBytes() == 0u;
+}
+
+bool ShmRing::armSpaceWanted(std::size_t usedLimit)
+{
+    header.spaceWanted.store(true, std::memory_order_seq_cst);
+    return usedBytes() > usedLimit;
+}
+
+std::size_t ShmRing::usedBytes() const
+{
+    const std::uint64_t head = header.head.load(std::memory_order_seq_cst);
+    const std::uint64_t tail = header.tail.load(std::memory_order_seq_cst);
+    return tail - head;
+}
+
+std::size_t ShmRing::validUsedBytes(std::uint64_t head, std::uint64_t tail) const
+{
+    // the other side writes the peer position - never trust it for memcpy sizes
+    const std::uint64_t used = tail - head;
+    if (used > capacityValue)
+    {
+        throw CorruptedEx("Ring positions corrupted, head: " + std::to_string(head) + ", tail: " + std::to_string(tail));
+    }
+    return used;
+}
+
+std::size_t ShmRing::capacity() const
+{
+    return capacityValue;
+}
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace common
+{
+
+/**
+ * Single producer, single consumer byte ring placed in memory shared by two processes.
+ *
+ * Memory layout: [ShmRing::Header][capacity bytes of data], capacity is power of 2.
+ * Positions are free running counters, so (tail - head) is always the number of used bytes.
+ *
+ * Sleeping sides are woken via flags in the header, see dataWanted/spaceWanted:
+ * whichever side finds the flag set is responsible for waking the other one.
+ */
+class ShmRing
+{
+public:
+    /**
+     * Positions in header make no sense - peer is broken (or hostile), it shall be disconnected.
+     */
+    class CorruptedEx : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    struct Header
+    {
+        alignas(64) std::atomic<std::uint64_t> head;        // written by consumer only
+        alignas(64) std::atomic<std::uint64_t> tail;        // written by producer only
+        alignas(64) std::atomic<bool> dataWanted;           // consumer waits for data
+        std::atomic<bool> spaceWanted;                      // producer waits for space
+    };
+
+    static constexpr std::size_t MIN_CAPACITY = 8u * 1024u;
+    static constexpr std::size_t MAX_CAPACITY = 64u * 1024u * 1024u;
+
+    static std::size_t roundCapacity(std::size_t requested);
+    static std::size_t requiredSize(std::size_t capacity);
+
+    /**
+     * @param memory at least requiredSize(capacity) bytes, aligned to 64
+     */
+    ShmRing(void* memory, std::size_t capacity);
+
+    /**
+     * Only creator of the shared memory calls it, before it is shared.
+     */
+    void initialize();
+
+    /**
+     * Producer side. All or nothing.
+     * @throw CorruptedEx
+     * @return false when there is not enough free space
+     */
+    bool write(const std::uint8_t* data, std::size_t size);
+
+    /**
+     * Producer side, called after write() - true when peer shall be woken up (it waits for data)
+     */
+    bool takeDataWanted();
+
+    /**
+     * Consumer side.
+     * @throw CorruptedEx
+     * @return number of bytes copied into data
+     */
+    std::size_t read(std::uint8_t* data, std::size_t maxSize);
+
+    /**
+     * Consumer side, called after read() - true when peer shall be woken up (it waits for space)
+     */
+    bool takeSpaceWanted();
+
+    /**
+     * Consumer side, called before going to sleep.
+     * @return false when data arrived meanwhile, i.e. do not sleep, read again
+     */
+    bool armDataWanted();
+
+    /**
+     * Producer side, called when congested - same as armDataWanted but for free space
+     * @return false when space was freed meanwhile
+     */
+    bool armSpaceWanted(std::size_t usedLimit);
+
+    std::size_t usedBytes() const;
+    std::size_t capacity() const;
+
+private:
+    std::size_t validUsedBytes(std::uint64_t head, std::uint64_t tail) const;
+
+    Header& header;
+    std::uint8_t* const data;
+    const std::size_t capacityValue;
+    const std::size_t mask;
+};
+
+}
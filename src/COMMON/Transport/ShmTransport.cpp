@@ -0,0 +1,509 @@
+#include "ShmTransport.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace common
+{
+
+namespace
+{
+
+constexpr std::uint32_t SEGMENT_MAGIC = 0x53484d31; // "SHM1"
+constexpr std::uint8_t PROTOCOL_VERSION = 1;
+constexpr int REQUIRED_SEALS = F_SEAL_SHRINK | F_SEAL_SEAL;
+constexpr std::size_t FD_COUNT = 3u; // memory, doorbell of accepting side, doorbell of connecting side
+
+struct alignas(64) SegmentHeader
+{
+    std::uint32_t magic;
+    std::uint32_t ringCapacity;
+};
+
+std::size_t segmentSize(std::size_t ringCapacity)
+{
+    return sizeof(SegmentHeader) + 2u * ShmRing::requiredSize(ringCapacity);
+}
+
+void* ringMemory(void* mapping, std::size_t ringCapacity, std::size_t index)
+{
+    return static_cast<std::uint8_t*>(mapping) + sizeof(SegmentHeader) + index * ShmRing::requiredSize(ringCapacity);
+}
+
+}
+
+ShmChannel::ShmChannel(Side side, int control)
+    : side(side),
+      control(control)
+{}
+
+ShmChannel::ShmChannel(ShmChannel &&other) noexcept
+    : side(other.side)
+{
+    *this = std::move(other);
+}
+
+ShmChannel &ShmChannel::operator=(ShmChannel &&other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        side = other.side;
+        std::swap(control, other.control);
+        std::swap(memory, other.memory);
+        std::swap(doorbells, other.doorbells);
+        std::swap(peer, other.peer);
+        std::swap(mapping, other.mapping);
+        std::swap(mappingSize, other.mappingSize);
+        std::swap(rings, other.rings);
+    }
+    return *this;
+}
+
+ShmChannel::~ShmChannel()
+{
+    close();
+}
+
+ShmChannel ShmChannel::connect(const std::string &path, std::size_t ringCapacity)
+{
+    ShmChannel channel(Side::Connecting, connectUnix(path, SOCK_STREAM));
+    channel.readPeerCredentials();
+
+    ringCapacity = ShmRing::roundCapacity(ringCapacity);
+    channel.memory = ::memfd_create("ue-bts-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (channel.memory < 0)
+    {
+        throw UnixSocketEx("memfd_create", errno);
+    }
+    if (::ftruncate(channel.memory, segmentSize(ringCapacity)) < 0)
+    {
+        throw UnixSocketEx("ftruncate", errno);
+    }
+    if (::fcntl(channel.memory, F_ADD_SEALS, REQUIRED_SEALS | F_SEAL_GROW) < 0)
+    {
+        throw UnixSocketEx("F_ADD_SEALS", errno);
+    }
+    for (auto& doorbell : channel.doorbells)
+    {
+        doorbell = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (doorbell < 0)
+        {
+            throw UnixSocketEx("eventfd", errno);
+        }
+    }
+    channel.map(segmentSize(ringCapacity), true);
+
+    const std::uint8_t version = PROTOCOL_VERSION;
+    sendWithFds(channel.control, &version, sizeof(version),
+                {channel.memory, channel.doorbells[0], channel.doorbells[1]});
+    return channel;
+}
+
+void ShmChannel::map(std::size_t size, bool create)
+{
+    mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memory, 0);
+    if (mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        throw UnixSocketEx("mmap", errno);
+    }
+    mappingSize = size;
+
+    auto& segment = *static_cast<SegmentHeader*>(mapping);
+    if (create)
+    {
+        segment.ringCapacity = (size - sizeof(SegmentHeader)) / 2u - sizeof(ShmRing::Header);
+    }
+    const std::size_t capacity = segment.ringCapacity;
+    if (ShmRing::roundCapacity(capacity) != capacity or segmentSize(capacity) != size
+        or (not create and segment.magic != SEGMENT_MAGIC))
+    {
+        throw UnixSocketEx("Shared memory segment corrupted", EPROTO);
+    }
+    for (std::size_t i = 0u; i < 2u; ++i)
+    {
+        rings[i] = std::make_unique<ShmRing>(ringMemory(mapping, capacity, i), capacity);
+        if (create)
+        {
+            rings[i]->initialize();
+        }
+    }
+    if (create)
+    {
+        std::atomic_thread_fence(std::memory_order_release);
+        segment.magic = SEGMENT_MAGIC;
+    }
+}
+
+void ShmChannel::readPeerCredentials()
+{
+    peer = common::peerPid(control);
+}
+
+// ring 0: connecting -> accepting, doorbell 0: rang to wake accepting side
+ShmRing &ShmChannel::outgoing()
+{
+    return *rings[side == Side::Connecting ? 0 : 1];
+}
+
+ShmRing &ShmChannel::incoming()
+{
+    return *rings[side == Side::Connecting ? 1 : 0];
+}
+
+int ShmChannel::doorbellFd() const
+{
+    return doorbells[side == Side::Connecting ? 1 : 0];
+}
+
+int ShmChannel::controlFd() const
+{
+    return control;
+}
+
+int ShmChannel::peerPid() const
+{
+    return peer;
+}
+
+void ShmChannel::ringPeer()
+{
+    const std::uint64_t one = 1u;
+    [[maybe_unused]] auto written = ::write(doorbells[side == Side::Connecting ? 0 : 1], &one, sizeof(one));
+}
+
+void ShmChannel::clearDoorbell()
+{
+    std::uint64_t counter{};
+    [[maybe_unused]] auto read = ::read(doorbellFd(), &counter, sizeof(counter));
+}
+
+bool ShmChannel::isPeerClosed() const
+{
+    if (control < 0)
+    {
+        return true;
+    }
+    char byte;
+    const auto result = ::recv(control, &byte, sizeof(byte), MSG_PEEK | MSG_DONTWAIT);
+    return result == 0 or (result < 0 and errno != EAGAIN and errno != EWOULDBLOCK and errno != EINTR);
+}
+
+void ShmChannel::disconnect()
+{
+    if (control >= 0)
+    {
+        ::shutdown(control, SHUT_RDWR);
+    }
+}
+
+void ShmChannel::close()
+{
+    rings[0].reset();
+    rings[1].reset();
+    if (mapping)
+    {
+        ::munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0u;
+    }
+    closeFd(memory);
+    closeFd(doorbells[0]);
+    closeFd(doorbells[1]);
+    closeFd(control);
+}
+
+ShmListener::ShmListener(std::string path)
+    : listener(std::move(path), SOCK_STREAM)
+{}
+
+int ShmListener::fd() const
+{
+    return listener.fd();
+}
+
+const std::string &ShmListener::getPath() const
+{
+    return listener.getPath();
+}
+
+std::optional<ShmChannel> ShmListener::accept()
+{
+    const int control = listener.accept();
+    if (control < 0)
+    {
+        return std::nullopt;
+    }
+    ShmChannel channel(ShmChannel::Side::Accepting, control);
+    channel.readPeerCredentials();
+    // peer sends descriptors right after connecting - usually they are already here
+    channel.completeRendezvous();
+    return channel;
+}
+
+bool ShmChannel::completeRendezvous()
+{
+    if (isEstablished())
+    {
+        return true;
+    }
+    char byte;
+    const auto pending = ::recv(control, &byte, sizeof(byte), MSG_PEEK | MSG_DONTWAIT);
+    if (pending < 0 and (errno == EAGAIN or errno == EWOULDBLOCK or errno == EINTR))
+    {
+        return false;
+    }
+    if (pending <= 0)
+    {
+        throw UnixSocketEx("Peer closed before rendezvous", pending < 0 ? errno : ECONNRESET);
+    }
+
+    std::uint8_t version = 0;
+    std::vector<int> fds;
+    const std::size_t received = receiveWithFds(control, &version, sizeof(version), fds, FD_COUNT);
+    for (std::size_t i = 0; i < fds.size(); ++i)
+    {
+        (i == 0 ? memory : doorbells[i - 1]) = fds[i];
+    }
+    if (received != sizeof(version) or version != PROTOCOL_VERSION or fds.size() != FD_COUNT)
+    {
+        throw UnixSocketEx("Unexpected rendezvous message", EPROTO);
+    }
+    ::fcntl(doorbells[0], F_SETFL, O_NONBLOCK);
+    ::fcntl(doorbells[1], F_SETFL, O_NONBLOCK);
+
+    // not shrinkable by peer, otherwise any access to mapping might end with SIGBUS
+    const int seals = ::fcntl(memory, F_GET_SEALS);
+    if (seals < 0 or (seals & REQUIRED_SEALS) != REQUIRED_SEALS)
+    {
+        throw UnixSocketEx("Shared memory not sealed", EPROTO);
+    }
+    struct stat memoryStat{};
+    if (::fstat(memory, &memoryStat) < 0)
+    {
+        throw UnixSocketEx("fstat", errno);
+    }
+    map(memoryStat.st_size, false);
+    return true;
+}
+
+bool ShmChannel::isEstablished() const
+{
+    return mapping != nullptr;
+}
+
+ShmTransport::ShmTransport(ILogger &loggerBase, ShmChannel channelValue)
+    : logger(loggerBase, "[SHM]"),
+      channel(std::move(channelValue)),
+      address("shm-pid" + std::to_string(channel.peerPid()) + "-fd" + std::to_string(channel.controlFd())),
+      lowWatermark(channel.outgoing().capacity() / 4u),
+      highWatermark(channel.outgoing().capacity() / 4u * 3u),
+      incomingBytes(16u * 1024u)
+{
+    outgoingFrame.reserve(FRAME_HEADER_SIZE + BinaryMessage::MAX_SIZE);
+}
+
+ShmTransport::~ShmTransport()
+{
+    logger.logDebug("Bye: ", address);
+}
+
+void ShmTransport::registerMessageCallback(MessageCallback messageCallback)
+{
+    this->messageCallback = messageCallback;
+}
+
+void ShmTransport::registerDisconnectedCallback(DisconnectedCallback disconnectedCallback)
+{
+    this->disconnectedCallback = disconnectedCallback;
+}
+
+void ShmTransport::registerBackpressureCallback(BackpressureCallback backpressureCallback)
+{
+    this->backpressureCallback = backpressureCallback;
+}
+
+bool ShmTransport::sendMessage(BinaryMessage message)
+{
+    outgoingFrame.clear();
+    appendFrame(outgoingFrame, message);
+    return writeRaw(outgoingFrame.data(), outgoingFrame.size());
+}
+
+std::string ShmTransport::addressToString() const
+{
+    return address;
+}
+
+bool ShmTransport::writeRaw(const std::uint8_t *data, std::size_t size)
+{
+    try
+    {
+        if (closed or not channel.outgoing().write(data, size))
+        {
+            return false;
+        }
+    }
+    catch (ShmRing::CorruptedEx& ex)
+    {
+        handleCorrupted(ex);
+        return false;
+    }
+    if (channel.outgoing().takeDataWanted())
+    {
+        channel.ringPeer();
+    }
+    updateBackpressure();
+    return true;
+}
+
+void ShmTransport::poll()
+{
+    if (closed)
+    {
+        return;
+    }
+    channel.clearDoorbell();
+    readIncoming();
+    updateBackpressure();
+    if (channel.isPeerClosed())
+    {
+        handlePeerClosed();
+    }
+}
+
+void ShmTransport::close()
+{
+    closed = true;
+    channel.close();
+}
+
+int ShmTransport::doorbellFd() const
+{
+    return channel.doorbellFd();
+}
+
+int ShmTransport::controlFd() const
+{
+    return channel.controlFd();
+}
+
+void ShmTransport::readIncoming()
+{
+    ShmRing& incoming = channel.incoming();
+    while (true)
+    {
+        std::size_t size = 0u;
+        try
+        {
+            size = incoming.read(incomingBytes.data(), incomingBytes.size());
+        }
+        catch (ShmRing::CorruptedEx& ex)
+        {
+            handleCorrupted(ex);
+            return;
+        }
+        if (size == 0u)
+        {
+            if (incoming.armDataWanted())
+            {
+                return;
+            }
+            continue;
+        }
+        if (incoming.takeSpaceWanted())
+        {
+            channel.ringPeer();
+        }
+        try
+        {
+            frameDecoder.feed(incomingBytes.data(), size,
+                              std::bind(&ShmTransport::handleMessage, this, std::placeholders::_1));
+        }
+        catch (FrameDecoder::FrameEx& ex)
+        {
+            logger.logError("Stream from: ", address, " corrupted: ", ex.what());
+        }
+        if (closed)
+        {
+            return;
+        }
+    }
+}
+
+void ShmTransport::handleMessage(BinaryMessage message)
+{
+    if (messageCallback)
+    {
+        messageCallback(std::move(message));
+    }
+    else
+    {
+        logger.logError("Message received from: ", address, " - application not interested");
+    }
+}
+
+void ShmTransport::updateBackpressure()
+{
+    if (closed)
+    {
+        return;
+    }
+    ShmRing& outgoing = channel.outgoing();
+    const std::size_t pending = outgoing.usedBytes();
+    if (congested)
+    {
+        if (pending > lowWatermark and outgoing.armSpaceWanted(lowWatermark))
+        {
+            return;
+        }
+    }
+    else if (pending <= highWatermark)
+    {
+        return;
+    }
+    else
+    {
+        outgoing.armSpaceWanted(lowWatermark);
+    }
+    congested = not congested;
+    logger.logDebug("Connection to: ", address, (congested ? " congested" : " relieved"),
+                    ", bytes to read by peer: ", pending);
+    if (backpressureCallback)
+    {
+        backpressureCallback(congested);
+    }
+}
+
+void ShmTransport::handleCorrupted(const ShmRing::CorruptedEx &ex)
+{
+    logger.logError("Shared memory with: ", address, " corrupted: ", ex.what(), " - disconnecting");
+    // reported as peer closed from the next poll() - not from inside sendMessage()
+    channel.disconnect();
+}
+
+void ShmTransport::handlePeerClosed()
+{
+    closed = true;
+    if (disconnectedCallback)
+    {
+        logger.logDebug("Connection lost from: ", address);
+        // might be the last thing done with this object
+        disconnectedCallback();
+    }
+    else
+    {
+        logger.logError("Connection lost from: ", address, " - application not interested!");
+    }
+}
+
+}
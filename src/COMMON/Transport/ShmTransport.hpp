@@ -0,0 +1,163 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include "CommonEnvironment/ITransport.hpp"
+#include "Logger/PrefixedLogger.hpp"
+#include "FrameCodec.hpp"
+#include "ShmRing.hpp"
+#include "UnixSocket.hpp"
+
+namespace common
+{
+
+/**
+ * Shared memory of one connection between co-located processes:
+ *  - memfd with two ShmRing (one per direction),
+ *  - eventfd per side - ringed by peer when there is something to do,
+ *  - connected unix socket - used for rendezvous (fds are passed over it) and to detect peer hangup.
+ *
+ * Connecting side creates all of that and passes it to accepting side, see ShmListener.
+ * Memory is sealed against shrinking - accepting side does not have to fear SIGBUS on access.
+ */
+class ShmChannel
+{
+public:
+    static constexpr std::size_t DEFAULT_RING_CAPACITY = 256u * 1024u;
+
+    /**
+     * @throw UnixSocketEx
+     */
+    static ShmChannel connect(const std::string& path, std::size_t ringCapacity = DEFAULT_RING_CAPACITY);
+
+    ShmChannel(ShmChannel&& other) noexcept;
+    ShmChannel& operator=(ShmChannel&& other) noexcept;
+    ~ShmChannel();
+
+    /**
+     * Accepting side only, when controlFd() became readable - receives descriptors from connecting side.
+     * Does not block.
+     * @throw UnixSocketEx when rendezvous failed (peer closed, wrong message, corrupted memory)
+     * @return false when descriptors did not arrive yet
+     */
+    bool completeRendezvous();
+    bool isEstablished() const;
+
+    ShmRing& outgoing();
+    ShmRing& incoming();
+
+    int doorbellFd() const;
+    int controlFd() const;
+    int peerPid() const;
+
+    void ringPeer();
+    void clearDoorbell();
+    bool isPeerClosed() const;
+    /**
+     * Shuts down control socket - so both sides see peer closed on their next poll.
+     */
+    void disconnect();
+    void close();
+
+private:
+    friend class ShmListener;
+    enum class Side { Connecting, Accepting };
+
+    ShmChannel(Side side, int control);
+    void map(std::size_t size, bool create);
+    void readPeerCredentials();
+
+    Side side;
+    int control = -1;
+    int memory = -1;
+    int doorbells[2] = {-1, -1};
+    int peer = 0;
+    void* mapping = nullptr;
+    std::size_t mappingSize = 0u;
+    std::unique_ptr<ShmRing> rings[2];
+};
+
+/**
+ * Unix socket, where ShmChannel::connect() is expected.
+ */
+class ShmListener
+{
+public:
+    /**
+     * @throw UnixSocketEx
+     */
+    explicit ShmListener(std::string path);
+
+    /**
+     * To be watched for readability, then accept() shall be called.
+     */
+    int fd() const;
+    const std::string& getPath() const;
+
+    /**
+     * Does not block. Returned channel is not established (see isEstablished()) when connecting side
+     * has not sent descriptors yet - its controlFd() shall be watched then and completeRendezvous() called.
+     * @throw UnixSocketEx when rendezvous with pending connection failed
+     * @return nothing if no connection is pending
+     */
+    std::optional<ShmChannel> accept();
+
+private:
+    UnixListener listener;
+};
+
+/**
+ * ITransport over ShmChannel - same framing as the stream transports, so no changes above transport.
+ *
+ * It never blocks and has no own thread: poll() shall be called when doorbellFd() or controlFd()
+ * becomes readable (e.g. from QSocketNotifier), all callbacks are called from poll().
+ */
+class ShmTransport : public ITransport
+{
+public:
+    ShmTransport(ILogger& logger, ShmChannel channel);
+    ~ShmTransport();
+
+    void registerMessageCallback(MessageCallback messageCallback) override;
+    void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
+    void registerBackpressureCallback(BackpressureCallback backpressureCallback) override;
+    bool sendMessage(BinaryMessage message) override;
+    std::string addressToString() const override;
+
+    /**
+     * Writes bytes to peer bypassing framing - as they were part of the stream.
+     * @return false when not written at all
+     */
+    bool writeRaw(const std::uint8_t* data, std::size_t size);
+
+    void poll();
+    void close() override;
+
+    int doorbellFd() const;
+    int controlFd() const;
+
+private:
+    void readIncoming();
+    void handleMessage(BinaryMessage message);
+    void updateBackpressure();
+    void handleCorrupted(const ShmRing::CorruptedEx& ex);
+    void handlePeerClosed();
+
+    PrefixedLogger logger;
+    ShmChannel channel;
+    const std::string address;
+    const std::size_t lowWatermark;
+    const std::size_t highWatermark;
+    FrameDecoder frameDecoder;
+    FrameBytes outgoingFrame;
+    FrameBytes incomingBytes;
+    bool congested = false;
+    bool closed = false;
+
+    MessageCallback messageCallback;
+    DisconnectedCallback disconnectedCallback;
+    BackpressureCallback backpressureCallback;
+};
+
+}
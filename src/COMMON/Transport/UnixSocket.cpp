@@ -0,0 +1,252 @@
+#include "UnixSocket.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace common
+{
+
+namespace
+{
+
+sockaddr_un makeAddress(const std::string& path)
+{
+    sockaddr_un address{};
+    if (path.empty() or path.size() >= sizeof(address.sun_path))
+    {
+        throw UnixSocketEx("Invalid socket path: \"" + path + "\"", ENAMETOOLONG);
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1u);
+    return address;
+}
+
+ino_t inodeOf(const std::string& path)
+{
+    struct stat pathStat{};
+    return ::stat(path.c_str(), &pathStat) == 0 ? pathStat.st_ino : 0;
+}
+
+}
+
+UnixSocketEx::UnixSocketEx(const std::string &what, int error)
+    : std::runtime_error(what + ": " + std::strerror(error))
+{}
+
+void closeFd(int& fd)
+{
+    if (fd >= 0)
+    {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+int peerPid(int socket)
+{
+    ucred credentials{};
+    socklen_t length = sizeof(credentials);
+    if (::getsockopt(socket, SOL_SOCKET, SO_PEERCRED, &credentials, &length) < 0)
+    {
+        return 0;
+    }
+    return credentials.pid;
+}
+
+UnixListener::UnixListener(std::string pathValue, int type)
+    : path(std::move(pathValue))
+{
+    const sockaddr_un address = makeAddress(path);
+    listening = ::socket(AF_UNIX, type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listening < 0)
+    {
+        throw UnixSocketEx("socket", errno);
+    }
+    // left by previous instance that was killed
+    ::unlink(path.c_str());
+    if (::bind(listening, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0
+        or ::listen(listening, SOMAXCONN) < 0)
+    {
+        const int error = errno;
+        closeFd(listening);
+        throw UnixSocketEx("Cannot listen on " + path, error);
+    }
+    rememberInode();
+}
+
+UnixListener::UnixListener(int fd)
+    : listening(fd)
+{
+    sockaddr_un address{};
+    socklen_t length = sizeof(address);
+    int accepting = 0;
+    socklen_t acceptingLength = sizeof(accepting);
+    if (::getsockname(listening, reinterpret_cast<sockaddr*>(&address), &length) < 0
+        or address.sun_family != AF_UNIX
+        or ::getsockopt(listening, SOL_SOCKET, SO_ACCEPTCONN, &accepting, &acceptingLength) < 0
+        or not accepting)
+    {
+        closeFd(listening);
+        throw UnixSocketEx("Not a listening unix socket", ENOTSOCK);
+    }
+    path.assign(address.sun_path, ::strnlen(address.sun_path, sizeof(address.sun_path)));
+    ::fcntl(listening, F_SETFL, ::fcntl(listening, F_GETFL) | O_NONBLOCK);
+    ::fcntl(listening, F_SETFD, FD_CLOEXEC);
+    rememberInode();
+}
+
+UnixListener::~UnixListener()
+{
+    if (listening < 0)
+    {
+        return;
+    }
+    closeFd(listening);
+    if (inode != 0 and inodeOf(path) == inode)
+    {
+        ::unlink(path.c_str());
+    }
+}
+
+void UnixListener::rememberInode()
+{
+    inode = inodeOf(path);
+}
+
+int UnixListener::fd() const
+{
+    return listening;
+}
+
+const std::string &UnixListener::getPath() const
+{
+    return path;
+}
+
+int UnixListener::accept()
+{
+    const int connected = ::accept4(listening, nullptr, nullptr, SOCK_CLOEXEC);
+    if (connected < 0)
+    {
+        if (errno == EAGAIN or errno == EWOULDBLOCK or errno == EINTR or errno == ECONNABORTED)
+        {
+            return -1;
+        }
+        throw UnixSocketEx("accept on " + path, errno);
+    }
+    return connected;
+}
+
+int UnixListener::release()
+{
+    return std::exchange(listening, -1);
+}
+
+int connectUnix(const std::string &path, int type)
+{
+    const sockaddr_un address = makeAddress(path);
+    int connected = ::socket(AF_UNIX, type | SOCK_CLOEXEC, 0);
+    if (connected < 0)
+    {
+        throw UnixSocketEx("socket", errno);
+    }
+    if (::connect(connected, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        const int error = errno;
+        closeFd(connected);
+        throw UnixSocketEx("Cannot connect to " + path, error);
+    }
+    return connected;
+}
+
+void sendWithFds(int socket, const std::uint8_t *data, std::size_t size, const std::vector<int> &fds)
+{
+    iovec io{const_cast<std::uint8_t*>(data), size};
+    msghdr message{};
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+
+    std::vector<std::uint8_t> control(fds.empty() ? 0u : CMSG_SPACE(fds.size() * sizeof(int)));
+    if (not fds.empty())
+    {
+        message.msg_control = control.data();
+        message.msg_controllen = control.size();
+        cmsghdr* rights = CMSG_FIRSTHDR(&message);
+        rights->cmsg_level = SOL_SOCKET;
+        rights->cmsg_type = SCM_RIGHTS;
+        rights->cmsg_len = CMSG_LEN(fds.size() * sizeof(int));
+        std::memcpy(CMSG_DATA(rights), fds.data(), fds.size() * sizeof(int));
+    }
+
+    ssize_t sent;
+    do
+    {
+        sent = ::sendmsg(socket, &message, MSG_NOSIGNAL);
+    }
+    while (sent < 0 and errno == EINTR);
+    if (sent < 0)
+    {
+        throw UnixSocketEx("sendmsg", errno);
+    }
+    if (static_cast<std::size_t>(sent) != size)
+    {
+        throw UnixSocketEx("sendmsg: partially sent", EMSGSIZE);
+    }
+}
+
+std::size_t receiveWithFds(int socket, std::uint8_t *data, std::size_t maxSize,
+                           std::vector<int> &fds, std::size_t maxFds)
+{
+    iovec io{data, maxSize};
+    msghdr message{};
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    std::vector<std::uint8_t> control(CMSG_SPACE(maxFds * sizeof(int)));
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+
+    ssize_t received;
+    do
+    {
+        received = ::recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+    }
+    while (received < 0 and errno == EINTR);
+    if (received < 0)
+    {
+        throw UnixSocketEx("recvmsg", errno);
+    }
+
+    const std::size_t fdsBefore = fds.size();
+    for (cmsghdr* header = CMSG_FIRSTHDR(&message); header; header = CMSG_NXTHDR(&message, header))
+    {
+        if (header->cmsg_level == SOL_SOCKET and header->cmsg_type == SCM_RIGHTS)
+        {
+            const std::size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            const auto* first = reinterpret_cast<const int*>(CMSG_DATA(header));
+            for (std::size_t i = 0u; i < count; ++i)
+            {
+                int fd;
+                std::memcpy(&fd, first + i, sizeof(fd));
+                fds.push_back(fd);
+            }
+        }
+    }
+    if (message.msg_flags & (MSG_CTRUNC | MSG_TRUNC))
+    {
+        for (std::size_t i = fdsBefore; i < fds.size(); ++i)
+        {
+            closeFd(fds[i]);
+        }
+        fds.resize(fdsBefore);
+        throw UnixSocketEx("recvmsg: message truncated", EMSGSIZE);
+    }
+    return received;
+}
+
+}
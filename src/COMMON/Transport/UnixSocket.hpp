@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+namespace common
+{
+
+class UnixSocketEx : public std::runtime_error
+{
+public:
+    UnixSocketEx(const std::string& what, int error);
+};
+
+/**
+ * Listening unix domain socket bound to a path.
+ *
+ * The path is removed on destruction - unless it was rebound meanwhile by someone else
+ * (e.g. by a newer instance of the same program), or the socket was released.
+ */
+class UnixListener
+{
+public:
+    /**
+     * @param type SOCK_STREAM or SOCK_SEQPACKET
+     * @throw UnixSocketEx
+     */
+    UnixListener(std::string path, int type);
+
+    /**
+     * Takes ownership of already listening socket, e.g. one received from other process.
+     * @throw UnixSocketEx when fd is not a listening unix socket
+     */
+    explicit UnixListener(int fd);
+
+    ~UnixListener();
+
+    UnixListener(const UnixListener&) = delete;
+    UnixListener& operator=(const UnixListener&) = delete;
+
+    /**
+     * Non blocking, to be watched for readability.
+     */
+    int fd() const;
+    const std::string& getPath() const;
+
+    /**
+     * @throw UnixSocketEx
+     * @return connected socket (close on exec), or -1 if no connection is pending
+     */
+    int accept();
+
+    /**
+     * Gives up the socket - neither it is closed nor the path removed.
+     */
+    int release();
+
+private:
+    void rememberInode();
+
+    std::string path;
+    int listening = -1;
+    ino_t inode = 0;
+};
+
+/**
+ * @throw UnixSocketEx
+ * @return connected socket (close on exec)
+ */
+int connectUnix(const std::string& path, int type);
+
+/**
+ * Sends data with file descriptors attached (SCM_RIGHTS) - all or nothing.
+ * @throw UnixSocketEx
+ */
+void sendWithFds(int socket, const std::uint8_t* data, std::size_t size, const std::vector<int>& fds = {});
+
+/**
+ * Receives up to maxSize bytes, received descriptors are appended to fds (close on exec).
+ * @throw UnixSocketEx on error, or when more descriptors were sent than maxFds
+ * @return number of bytes received, 0 when peer closed
+ */
+std::size_t receiveWithFds(int socket, std::uint8_t* data, std::size_t maxSize,
+                           std::vector<int>& fds, std::size_t maxFds);
+
+/**
+ * @return pid of connected peer process, 0 if unknown
+ */
+int peerPid(int socket);
+
+void closeFd(int& fd);
+
+}
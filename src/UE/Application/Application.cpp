@@ -1,5 +1,4 @@
 #include "Application.hpp"
-#include "States/NotConnectedState.hpp"
 
 namespace ue
 {
@@ -8,8 +7,9 @@ Application::Application(common::PhoneNumber phoneNumber,
                          common::ILogger &iLogger,
                          IBtsPort &bts,
                          IUserPort &user,
-                         ITimerPort &timer)
-    : context{iLogger, bts, user, timer},
+                         ITimerPort &timer,
+                         SmsDb &smsDb)
+    : context{iLogger, bts, user, timer, smsDb},
       logger(iLogger, "[APP] ")
 {
     logger.logInfo("Started");
@@ -21,75 +21,20 @@ Application::~Application()
     logger.logInfo("Stopped");
 }
 
-void Application::handleTimeout()
-{
-    context.state->handleTimeout();
-}
-
-void Application::handleSib(common::BtsId btsId)
-{
-    context.state->handleSib(btsId);
-}
-
-void Application::handleAttachAccept()
-{
-    context.state->handleAttachAccept();
-}
-
-void Application::handleAttachReject()
-{
-    context.state->handleAttachReject();
-}
-
-void Application::handleDisconnected()
-{
-    context.state->handleDisconnected();
-}
-
-void Application::handleSms(common::PhoneNumber from, const std::string& text)
-{
-    context.state->handleSms(from, text);
-}
-
-void Application::handleCallRequest(common::PhoneNumber from)
-{
-    context.state->handleCallRequest(from);
+// qualified call of exact state type - resolved at compile time, for each alternative of StateStorage
+#define DEFINE_EVENT(name, parameters, arguments) \
+void Application::name parameters \
+{ \
+    context.handle([&](auto& state) \
+    { \
+        using State = std::remove_reference_t<decltype(state)>; \
+        state.State::name arguments; \
+    }); \
 }
 
-void Application::handleCallAccepted(common::PhoneNumber from)
-{
-    context.state->handleCallAccepted(from);
-}
-
-void Application::handleCallDropped(common::PhoneNumber from)
-{
-    context.state->handleCallDropped(from);
-}
+FOR_ALL_UE_EVENTS(DEFINE_EVENT)
 
-void Application::handleCallTalk(common::PhoneNumber from, const std::string& text)
-{
-    context.state->handleCallTalk(from, text);
-}
-
-void Application::handleUnknownRecipient()
-{
-    context.state->handleUnknownRecipient();
-}
-
-void Application::handleHomeClicked()
-{
-    context.state->handleHomeClicked();
-}
-
-void Application::handleSmsComposeClicked()
-{
-    context.state->handleSmsComposeClicked();
-}
-
-void Application::handleSmsViewClicked()
-{
-    context.state->handleSmsViewClicked();
-}
+#undef DEFINE_EVENT
 
 }
 
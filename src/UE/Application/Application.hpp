@@ -18,7 +18,8 @@ public:
                 ILogger& iLogger,
                 IBtsPort& bts,
                 IUserPort& user,
-                ITimerPort& timer);
+                ITimerPort& timer,
+                SmsDb& smsDb);
     ~Application();
 
     // ITimerEventsHandler interface
@@ -35,6 +36,8 @@ public:
     void handleCallDropped(common::PhoneNumber from) override;
     void handleCallTalk(common::PhoneNumber from, const std::string& text) override;
     void handleUnknownRecipient() override;
+    void handleGroupSmsResult(const std::vector<common::PhoneNumber>& failedRecipients) override;
+    void handleConferenceMembers(const std::vector<common::PhoneNumber>& members) override;
     
     // IUserEventsHandler interface
     void handleHomeClicked() override;
@@ -2,23 +2,77 @@
 
 #include "IEventsHandler.hpp"
 #include "Logger/ILogger.hpp"
-#include <memory>
+#include "SmsDb.hpp"
+#include "States/NotConnectedState.hpp"
+#include "States/ConnectingState.hpp"
+#include "States/ConnectedState.hpp"
+#include "States/DiallingState.hpp"
+#include "States/ReceivingCallState.hpp"
+#include "States/TalkingState.hpp"
+#include "States/ConferenceState.hpp"
+#include <tuple>
+#include <type_traits>
+#include <variant>
 
 namespace ue
 {
 
+// empty until first setState
+using StateStorage = std::variant<std::monostate,
+                                  NotConnectedState,
+                                  ConnectingState,
+                                  ConnectedState,
+                                  DiallingState,
+                                  ReceivingCallState,
+                                  TalkingState,
+                                  ConferenceState>;
+
 struct Context
 {
     common::ILogger& logger;
     IBtsPort& bts;
     IUserPort& user;
     ITimerPort& timer;
-    std::unique_ptr<IEventsHandler> state{};
+    SmsDb& smsDb;
+    StateStorage state{};
 
+    /**
+     * New state is built in place of the current one (destroyed first) - no heap allocation.
+     * Arguments are copied before, so they might be members of current state.
+     * Caller state must not touch its members after that.
+     * When new state constructor throws - there is no state (events ignored), exception is passed on.
+     */
     template <typename State, typename ...Arg>
     void setState(Arg&& ...arg)
     {
-        state = std::make_unique<State>(*this, std::forward<Arg>(arg)...);
+        std::tuple<std::decay_t<Arg>...> arguments{std::forward<Arg>(arg)...};
+        std::apply([this](auto& ...copy)
+        {
+            try
+            {
+                state.emplace<State>(*this, std::move(copy)...);
+            }
+            catch (...)
+            {
+                state.emplace<std::monostate>();
+                throw;
+            }
+        }, arguments);
+    }
+
+    /**
+     * Calls event with current state, of its exact type - no virtual call.
+     */
+    template <typename Event>
+    void handle(Event&& event)
+    {
+        std::visit([&event](auto& current)
+        {
+            if constexpr (not std::is_same_v<std::remove_reference_t<decltype(current)>, std::monostate>)
+            {
+                event(current);
+            }
+        }, state);
     }
 };
 
@@ -5,6 +5,27 @@
 #include "Ports/IUserPort.hpp"
 
 
+/**
+ * All events of IEventsHandler, as EVENT(name, (parameters), (arguments))
+ */
+#define FOR_ALL_UE_EVENTS(EVENT) \
+    EVENT(handleTimeout, (), ()) \
+    EVENT(handleSib, (common::BtsId btsId), (btsId)) \
+    EVENT(handleAttachAccept, (), ()) \
+    EVENT(handleAttachReject, (), ()) \
+    EVENT(handleDisconnected, (), ()) \
+    EVENT(handleSms, (common::PhoneNumber from, const std::string& text), (from, text)) \
+    EVENT(handleCallRequest, (common::PhoneNumber from), (from)) \
+    EVENT(handleCallAccepted, (common::PhoneNumber from), (from)) \
+    EVENT(handleCallDropped, (common::PhoneNumber from), (from)) \
+    EVENT(handleCallTalk, (common::PhoneNumber from, const std::string& text), (from, text)) \
+    EVENT(handleUnknownRecipient, (), ()) \
+    EVENT(handleGroupSmsResult, (const std::vector<common::PhoneNumber>& failedRecipients), (failedRecipients)) \
+    EVENT(handleConferenceMembers, (const std::vector<common::PhoneNumber>& members), (members)) \
+    EVENT(handleHomeClicked, (), ()) \
+    EVENT(handleSmsComposeClicked, (), ()) \
+    EVENT(handleSmsViewClicked, (), ())
+
 namespace ue
 {
 
@@ -1,10 +1,29 @@
 #include "BtsPort.hpp"
 #include "Messages/IncomingMessage.hpp"
 #include "Messages/OutgoingMessage.hpp"
+#include "Messages/MessageBatch.hpp"
+#include "Messages/MessageCompression.hpp"
+#include "Messages/AttachFeature.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
 
 namespace ue
 {
 
+namespace
+{
+
+// Sms and CallTalk might be dropped when too many wait - call setup/teardown never is, peer would be stuck
+bool isBulk(const BinaryMessage& message)
+{
+    const auto messageId = static_cast<common::MessageId>(message.value.at(0));
+    return messageId == common::MessageId::Sms or messageId == common::MessageId::GroupSms
+           or messageId == common::MessageId::CallTalk;
+}
+
+}
+
 BtsPort::BtsPort(common::ILogger &logger, common::ITransport &transport, common::PhoneNumber phoneNumber)
     : logger(logger, "[BTS-PORT]"),
       transport(transport),
@@ -14,7 +33,12 @@ BtsPort::BtsPort(common::ILogger &logger, common::ITransport &transport, common:
 void BtsPort::start(IBtsEventsHandler &handler)
 {
     transport.registerMessageCallback([this](BinaryMessage msg) {handleMessage(msg);});
-    transport.registerDisconnectedCallback([this]() { this->handler->handleDisconnected(); });
+    transport.registerDisconnectedCallback([this]()
+    {
+        resetSession();
+        this->handler->handleDisconnected();
+    });
+    transport.registerConnectedCallback([this] { handleReconnected(); });
     this->handler = &handler;
 }
 
@@ -22,13 +46,37 @@ void BtsPort::stop()
 {
     transport.registerMessageCallback(nullptr);
     transport.registerDisconnectedCallback(nullptr);
+    transport.registerConnectedCallback(nullptr);
     handler = nullptr;
+    resetSession();
+    dropPendingMessages();
 }
 
 void BtsPort::handleMessage(BinaryMessage msg)
 {
+    if (not common::MessageBatch::isBatch(msg))
+    {
+        handleSingleMessage(msg);
+        return;
+    }
     try
     {
+        for (const auto& entry : common::MessageBatch::unpack(msg))
+        {
+            handleSingleMessage(entry);
+        }
+    }
+    catch (std::exception const& ex)
+    {
+        logger.logError("handleMessage batch error: ", ex.what());
+    }
+}
+
+void BtsPort::handleSingleMessage(const BinaryMessage& received)
+{
+    try
+    {
+        const BinaryMessage msg = common::isCompressed(received) ? common::decompressMessage(received) : received;
         common::IncomingMessage reader{msg};
         auto msgId = reader.readMessageId();
         auto from = reader.readPhoneNumber();
@@ -39,16 +87,39 @@ void BtsPort::handleMessage(BinaryMessage msg)
         case common::MessageId::Sib:
         {
             auto btsId = reader.readBtsId();
-            handler->handleSib(btsId);
+            lastBtsId = btsId;
+            if (attached)
+            {
+                reattach(btsId);
+            }
+            else
+            {
+                handler->handleSib(btsId);
+            }
             break;
         }
         case common::MessageId::AttachResponse:
         {
             bool accept = reader.readNumber<std::uint8_t>() != 0u;
             if (accept)
-                handler->handleAttachAccept();
+            {
+                // older BTS does not answer with features
+                const auto features = reader.isEndOfMessage() ? common::get(common::AttachFeature::None)
+                                                              : reader.readNumber<std::uint8_t>();
+                handleAttachAccept(features);
+            }
+            else if (reattaching)
+            {
+                logger.logError("Attach again rejected - session lost, pending messages dropped: ", pendingMessages.size());
+                resetSession();
+                dropPendingMessages();
+                handler->handleDisconnected();
+            }
             else
+            {
+                dropPendingMessages();
                 handler->handleAttachReject();
+            }
             break;
         }
         case common::MessageId::Sms:
@@ -64,6 +135,18 @@ void BtsPort::handleMessage(BinaryMessage msg)
             handler->handleCallRequest(from);
             break;
         }
+        case common::MessageId::ConferenceInvite:
+        {
+            // for invitee it is just a call from host
+            logger.logDebug("Received Conference Invite from: ", from);
+            handler->handleCallRequest(from);
+            break;
+        }
+        case common::MessageId::ConferenceMembers:
+        {
+            handleConferenceMembers(reader);
+            break;
+        }
         case common::MessageId::CallAccepted:
         {
             logger.logDebug("Call Accepted from: ", from);
@@ -89,6 +172,16 @@ void BtsPort::handleMessage(BinaryMessage msg)
             handler->handleUnknownRecipient();
             break;
         }
+        case common::MessageId::CreditGrant:
+        {
+            handleCreditGrant(reader.readNumber<std::uint16_t>());
+            break;
+        }
+        case common::MessageId::GroupSmsResult:
+        {
+            handleGroupSmsResult(reader);
+            break;
+        }
         default:
             logger.logError("unknow message: ", msgId, ", from: ", from);
         }
@@ -100,14 +193,229 @@ void BtsPort::handleMessage(BinaryMessage msg)
 }
 
 
-void BtsPort::sendAttachRequest(common::BtsId btsId)
+BinaryMessage BtsPort::buildAttachRequest(common::BtsId btsId) const
 {
-    logger.logDebug("sendAttachRequest: ", btsId);
     common::OutgoingMessage msg{common::MessageId::AttachRequest,
                                 phoneNumber,
                                 common::PhoneNumber{}};
     msg.writeBtsId(btsId);
-    transport.sendMessage(msg.getMessage());
+    msg.writeNumber(common::ALL_ATTACH_FEATURES);
+    return msg.getMessage();
+}
+
+void BtsPort::sendAttachRequest(common::BtsId btsId)
+{
+    logger.logDebug("sendAttachRequest: ", btsId);
+    // credits and features are granted again after attach, pending messages wait for that
+    resetSession();
+    transport.sendMessage(buildAttachRequest(btsId));
+}
+
+void BtsPort::reattach(common::BtsId btsId)
+{
+    logger.logInfo("Sib while attached - attaching again to: ", btsId);
+    // BTS counts messages again from its accept - till then they wait, with those waiting for credits
+    reattaching = true;
+    transport.sendMessage(buildAttachRequest(btsId));
+}
+
+void BtsPort::handleAttachAccept(common::AttachFeatures features)
+{
+    batching = (features & common::get(common::AttachFeature::Batching)) != 0u;
+    compression = (features & common::get(common::AttachFeature::Compression)) != 0u;
+    attached = true;
+    const bool wasReattaching = std::exchange(reattaching, false);
+    if (features & common::get(common::AttachFeature::FlowControl))
+    {
+        // counted from now on, as BTS does - its first grant comes right after accept
+        credits = 0u;
+    }
+    else
+    {
+        credits.reset();
+        sendPending();
+    }
+    if (wasReattaching)
+    {
+        logger.logInfo("Attached again, features: ", static_cast<unsigned>(features));
+        return;
+    }
+    handler->handleAttachAccept();
+}
+
+void BtsPort::handleReconnected()
+{
+    if (not lastBtsId)
+    {
+        logger.logDebug("Connected, waiting for Sib");
+        return;
+    }
+    // as if Sib was received - BTS is most likely the same one, e.g. restarted
+    logger.logInfo("Reconnected, attaching again to: ", *lastBtsId);
+    handler->handleSib(*lastBtsId);
+}
+
+void BtsPort::handleCreditGrant(std::uint16_t granted)
+{
+    credits = credits.value_or(0u) + granted;
+    logger.logDebug("Credits granted: ", granted, ", available: ", *credits, ", pending: ", pendingMessages.size());
+    sendPending();
+}
+
+void BtsPort::handleGroupSmsResult(common::IncomingMessage& reader)
+{
+    const auto groupSmsId = reader.readNumber<std::uint16_t>();
+    const auto recipientCount = reader.readNumber<std::uint8_t>();
+    const auto answered = std::find_if(groupSmsInFlight.begin(), groupSmsInFlight.end(),
+                                       [groupSmsId](const auto& groupSms) { return groupSms.id == groupSmsId; });
+    if (answered == groupSmsInFlight.end() or answered->recipients.size() != recipientCount)
+    {
+        logger.logError("Unexpected group SMS result: ", groupSmsId, ", recipients: ", static_cast<unsigned>(recipientCount));
+        return;
+    }
+    // answered in order - those sent before got no result, BTS dropped them
+    for (auto notAnswered = groupSmsInFlight.begin(); notAnswered != answered; ++notAnswered)
+    {
+        reportGroupSmsFailed(*notAnswered, "dropped by BTS");
+    }
+    const auto recipients = std::move(answered->recipients);
+    groupSmsInFlight.erase(groupSmsInFlight.begin(), std::next(answered));
+
+    std::vector<common::PhoneNumber> failedRecipients;
+    std::uint8_t failedBits = 0u;
+    for (std::size_t i = 0u; i < recipients.size(); ++i)
+    {
+        if (i % 8u == 0u)
+        {
+            failedBits = reader.readNumber<std::uint8_t>();
+        }
+        if (failedBits & (1u << (i % 8u)))
+        {
+            failedRecipients.push_back(recipients[i]);
+        }
+    }
+    logger.logDebug("Group SMS result, failed: ", failedRecipients.size());
+    handler->handleGroupSmsResult(failedRecipients);
+}
+
+void BtsPort::handleConferenceMembers(common::IncomingMessage& reader)
+{
+    std::vector<common::PhoneNumber> members(reader.readNumber<std::uint8_t>());
+    for (auto& member : members)
+    {
+        member = reader.readPhoneNumber();
+    }
+    logger.logDebug("Conference members: ", members.size());
+    handler->handleConferenceMembers(members);
+}
+
+void BtsPort::resetSession()
+{
+    attached = false;
+    reattaching = false;
+    credits.reset();
+    batching = false;
+    compression = false;
+    // results of those sent in lost session never come
+    for (const auto& groupSms : groupSmsInFlight)
+    {
+        reportGroupSmsFailed(groupSms, "session lost");
+    }
+    groupSmsInFlight.clear();
+}
+
+void BtsPort::dropPendingMessages()
+{
+    for (const auto& pending : pendingMessages)
+    {
+        if (pending.groupSms)
+        {
+            reportGroupSmsFailed(*pending.groupSms, "not sent");
+        }
+    }
+    pendingMessages.clear();
+}
+
+void BtsPort::reportGroupSmsFailed(const GroupSms& groupSms, const char* reason)
+{
+    logger.logError("Group SMS ", groupSms.id, " ", reason, " - failed for all recipients: ", groupSms.recipients.size());
+    if (handler)
+    {
+        handler->handleGroupSmsResult(groupSms.recipients);
+    }
+}
+
+bool BtsPort::isSessionUp() const
+{
+    return attached and not reattaching;
+}
+
+void BtsPort::send(PendingMessage msg)
+{
+    if (pendingMessages.size() >= MAX_PENDING_MESSAGES)
+    {
+        const auto oldestBulk = std::find_if(pendingMessages.begin(), pendingMessages.end(),
+                                             [](const auto& pending) { return isBulk(pending.message); });
+        if (oldestBulk != pendingMessages.end())
+        {
+            logger.logError(isSessionUp() ? "Out of credits" : "Not attached", " - oldest pending message dropped");
+            if (oldestBulk->groupSms)
+            {
+                reportGroupSmsFailed(*oldestBulk->groupSms, "not sent");
+            }
+            pendingMessages.erase(oldestBulk);
+        }
+    }
+    pendingMessages.push_back(std::move(msg));
+    sendPending();
+}
+
+void BtsPort::sendPending()
+{
+    if (not isSessionUp())
+    {
+        return;
+    }
+    common::MessageBatch batch{phoneNumber, common::PhoneNumber{}};
+    while ((not credits or *credits > 0u) and not pendingMessages.empty())
+    {
+        BinaryMessage msg = encode(std::move(pendingMessages.front()));
+        pendingMessages.pop_front();
+        if (credits)
+        {
+            // each message in batch still takes its own credit
+            --*credits;
+        }
+        if (not batching)
+        {
+            transport.sendMessage(std::move(msg));
+        }
+        else if (not batch.add(msg))
+        {
+            transport.sendMessage(batch.take());
+            batch.add(msg);
+        }
+    }
+    if (not batch.empty())
+    {
+        transport.sendMessage(batch.take());
+    }
+}
+
+BinaryMessage BtsPort::encode(PendingMessage msg)
+{
+    if (msg.groupSms)
+    {
+        groupSmsInFlight.push_back(std::move(*msg.groupSms));
+    }
+    if (compression)
+    {
+        if (auto compressed = common::compressMessage(msg.message))
+        {
+            return std::move(*compressed);
+        }
+    }
+    return std::move(msg.message);
 }
 
 void BtsPort::sendSms(common::PhoneNumber recipient, const std::string& text)
@@ -117,7 +425,28 @@ void BtsPort::sendSms(common::PhoneNumber recipient, const std::string& text)
                                phoneNumber,
                                recipient};
     msg.writeText(text);
-    transport.sendMessage(msg.getMessage());
+    send({msg.getMessage()});
+}
+
+void BtsPort::sendGroupSms(const std::vector<common::PhoneNumber>& recipients, const std::string& text)
+{
+    if (recipients.empty() or recipients.size() > MAX_GROUP_SMS_RECIPIENTS)
+    {
+        throw std::invalid_argument("Group SMS recipients: " + std::to_string(recipients.size()));
+    }
+    logger.logDebug("sendGroupSms to: ", recipients.size(), " recipients, text: ", text);
+    const std::uint16_t groupSmsId = nextGroupSmsId++;
+    common::OutgoingMessage msg{common::MessageId::GroupSms,
+                               phoneNumber,
+                               common::PhoneNumber{}};
+    msg.writeNumber(groupSmsId);
+    msg.writeNumber(static_cast<std::uint8_t>(recipients.size()));
+    for (auto recipient : recipients)
+    {
+        msg.writePhoneNumber(recipient);
+    }
+    msg.writeText(text);
+    send({msg.getMessage(), GroupSms{groupSmsId, recipients}});
 }
 
 void BtsPort::sendCallRequest(common::PhoneNumber recipient)
@@ -126,7 +455,7 @@ void BtsPort::sendCallRequest(common::PhoneNumber recipient)
     common::OutgoingMessage msg{common::MessageId::CallRequest,
                                phoneNumber,
                                recipient};
-    transport.sendMessage(msg.getMessage());
+    send({msg.getMessage()});
 }
 
 void BtsPort::sendCallAccepted(common::PhoneNumber recipient)
@@ -135,7 +464,7 @@ void BtsPort::sendCallAccepted(common::PhoneNumber recipient)
     common::OutgoingMessage msg{common::MessageId::CallAccepted,
                                phoneNumber,
                                recipient};
-    transport.sendMessage(msg.getMessage());
+    send({msg.getMessage()});
 }
 
 void BtsPort::sendCallDropped(common::PhoneNumber recipient)
@@ -144,7 +473,7 @@ void BtsPort::sendCallDropped(common::PhoneNumber recipient)
     common::OutgoingMessage msg{common::MessageId::CallDropped,
                                phoneNumber,
                                recipient};
-    transport.sendMessage(msg.getMessage());
+    send({msg.getMessage()});
 }
 
 void BtsPort::sendCallTalk(common::PhoneNumber recipient, const std::string& text)
@@ -154,7 +483,16 @@ void BtsPort::sendCallTalk(common::PhoneNumber recipient, const std::string& tex
                                phoneNumber,
                                recipient};
     msg.writeText(text);
-    transport.sendMessage(msg.getMessage());
+    send({msg.getMessage()});
 }
 
-}
\ No newline at end of file
+void BtsPort::sendConferenceInvite(common::PhoneNumber invitee)
+{
+    logger.logDebug("sendConferenceInvite to: ", invitee);
+    common::OutgoingMessage msg{common::MessageId::ConferenceInvite,
+                               phoneNumber,
+                               invitee};
+    send({msg.getMessage()});
+}
+
+}
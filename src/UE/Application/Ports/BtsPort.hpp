@@ -4,6 +4,14 @@
 #include "Logger/PrefixedLogger.hpp"
 #include "ITransport.hpp"
 #include "Messages/PhoneNumber.hpp"
+#include "Messages/AttachFeature.hpp"
+#include <deque>
+#include <optional>
+
+namespace common
+{
+class IncomingMessage;
+}
 
 namespace ue
 {
@@ -17,19 +25,72 @@ public:
 
     void sendAttachRequest(common::BtsId) override;
     void sendSms(common::PhoneNumber recipient, const std::string& text) override;
+    void sendGroupSms(const std::vector<common::PhoneNumber>& recipients, const std::string& text) override;
     void sendCallRequest(common::PhoneNumber recipient) override;
     void sendCallAccepted(common::PhoneNumber recipient) override;
     void sendCallDropped(common::PhoneNumber recipient) override;
     void sendCallTalk(common::PhoneNumber recipient, const std::string& text) override;
+    void sendConferenceInvite(common::PhoneNumber invitee) override;
+
+    // messages waiting for attach or credit, oldest Sms/CallTalk dropped above that - call control is kept anyway
+    static constexpr std::size_t MAX_PENDING_MESSAGES = 64u;
 
 private:
+    struct GroupSms
+    {
+        // echoed by BTS in result
+        std::uint16_t id;
+        // result bitmap refers to them by position
+        std::vector<common::PhoneNumber> recipients;
+    };
+
+    struct PendingMessage
+    {
+        // as built - compressed only when sent, with features of session it is sent in
+        BinaryMessage message;
+        // awaiting result once sent
+        std::optional<GroupSms> groupSms;
+    };
+
     void handleMessage(BinaryMessage msg);
+    void handleSingleMessage(const BinaryMessage& received);
+    void handleCreditGrant(std::uint16_t credits);
+    void handleReconnected();
+    void handleAttachAccept(common::AttachFeatures features);
+    void reattach(common::BtsId btsId);
+    BinaryMessage buildAttachRequest(common::BtsId btsId) const;
+    void handleGroupSmsResult(common::IncomingMessage& reader);
+    void handleConferenceMembers(common::IncomingMessage& reader);
+    void send(PendingMessage msg);
+    void sendPending();
+    BinaryMessage encode(PendingMessage msg);
+    bool isSessionUp() const;
+    void resetSession();
+    void dropPendingMessages();
+    void reportGroupSmsFailed(const GroupSms& groupSms, const char* reason);
 
     common::PrefixedLogger logger;
     common::ITransport& transport;
     common::PhoneNumber phoneNumber;
 
     IBtsEventsHandler* handler = nullptr;
+    // from last Sib - to attach right after reconnection, without waiting for next Sib
+    std::optional<common::BtsId> lastBtsId;
+    // accepted by BTS - Sib then means BTS lost session of this UE (e.g. took over its connection),
+    // UE attaches again without changing its state, to negotiate features and credits anew
+    bool attached = false;
+    bool reattaching = false;
+    // empty without flow control - before attach, or when BTS did not accept AttachFeature::FlowControl
+    std::optional<std::uint32_t> credits;
+    // kept over lost connection - sent once attached again
+    std::deque<PendingMessage> pendingMessages;
+    // accepted by BTS at attach - messages released together by credits leave in one container
+    bool batching = false;
+    // accepted by BTS at attach - long Sms/CallTalk texts sent compressed
+    bool compression = false;
+    // group SMS sent in this session, awaiting result - BTS answers in order, but not all of them (e.g. throttled)
+    std::deque<GroupSms> groupSmsInFlight;
+    std::uint16_t nextGroupSmsId = 0u;
 };
 
 }
\ No newline at end of file
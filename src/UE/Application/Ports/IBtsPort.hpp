@@ -2,6 +2,7 @@
 
 #include "Messages/BtsId.hpp"
 #include "Messages/PhoneNumber.hpp"
+#include <vector>
 
 namespace ue
 {
@@ -21,19 +22,31 @@ public:
     virtual void handleCallDropped(common::PhoneNumber from) = 0;
     virtual void handleCallTalk(common::PhoneNumber from, const std::string& text) = 0;
     virtual void handleUnknownRecipient() = 0;
+    virtual void handleGroupSmsResult(const std::vector<common::PhoneNumber>& failedRecipients) = 0;
+    /**
+     * @param members host first
+     */
+    virtual void handleConferenceMembers(const std::vector<common::PhoneNumber>& members) = 0;
 };
 
 class IBtsPort
 {
 public:
+    static constexpr std::size_t MAX_GROUP_SMS_RECIPIENTS = 255u;
+
     virtual ~IBtsPort() = default;
 
     virtual void sendAttachRequest(common::BtsId) = 0;
     virtual void sendSms(common::PhoneNumber recipient, const std::string& text) = 0;
+    /**
+     * One frame for all recipients (at most MAX_GROUP_SMS_RECIPIENTS) - fanned out by BTS
+     */
+    virtual void sendGroupSms(const std::vector<common::PhoneNumber>& recipients, const std::string& text) = 0;
     virtual void sendCallRequest(common::PhoneNumber recipient) = 0;
     virtual void sendCallAccepted(common::PhoneNumber recipient) = 0;
     virtual void sendCallDropped(common::PhoneNumber recipient) = 0;
     virtual void sendCallTalk(common::PhoneNumber recipient, const std::string& text) = 0;
+    virtual void sendConferenceInvite(common::PhoneNumber invitee) = 0;
 };
 
 }
@@ -41,6 +41,7 @@ void UserPort::showConnected()
     gui.showConnected();
     IUeGui::IListViewMode& menu = gui.setListViewMode();
     menu.clearSelectionList();
+    menu.setSearchCallback(nullptr);
     menu.addSelectionListItem("Compose SMS", "");
     menu.addSelectionListItem("View SMS", "");
         
@@ -56,6 +57,7 @@ void UserPort::showSmsListView()
 {
     IUeGui::IListViewMode& menu = gui.setListViewMode();
     menu.clearSelectionList();
+    menu.setSearchCallback(nullptr);
     // Messages will be populated by the Application class
     
     setMenuCallback();
@@ -1,8 +1,68 @@
 #include "SmsDb.hpp"
+#include "SmsLog.hpp"
+#include <algorithm>
+#include <iterator>
+#include <mutex>
 
 namespace ue
 {
 
+SmsView::SmsView(std::span<const SmsMessage> messages, std::span<const std::size_t> indices)
+    : messages(messages),
+      indices(indices)
+{}
+
+std::size_t SmsView::size() const
+{
+    return indices.size();
+}
+
+bool SmsView::empty() const
+{
+    return indices.empty();
+}
+
+const SmsMessage& SmsView::operator[](std::size_t position) const
+{
+    return messages[indices[position]];
+}
+
+std::size_t SmsView::indexAt(std::size_t position) const
+{
+    return indices[position];
+}
+
+SmsDb::SmsDb() = default;
+SmsDb::~SmsDb() = default;
+
+void SmsDb::persistTo(std::unique_ptr<SmsLog> newLog)
+{
+    log = std::move(newLog);
+    if (not log)
+    {
+        return;
+    }
+    {
+        std::unique_lock lock(mutex);
+        messages.reserve(messages.size() + log->size());
+    }
+    try
+    {
+        for (std::size_t index = 0u; index < log->size(); ++index)
+        {
+            auto message = log->read(index);
+            const auto peer = message.isSent ? message.to : message.from;
+            insert(std::move(message), peer);
+        }
+    }
+    catch (...)
+    {
+        // not loaded log is not appended to - messages positions would not match
+        log.reset();
+        throw;
+    }
+}
+
 void SmsDb::addSms(PhoneNumber from, const std::string& text)
 {
     SmsMessage message;
@@ -11,7 +71,7 @@ void SmsDb::addSms(PhoneNumber from, const std::string& text)
     message.text = text;
     message.isRead = false;
     message.isSent = false;
-    messages.push_back(message);
+    add(std::move(message), from);
 }
 
 void SmsDb::addSentSms(PhoneNumber to, const std::string& text)
@@ -22,45 +82,142 @@ void SmsDb::addSentSms(PhoneNumber to, const std::string& text)
     message.text = text;
     message.isRead = true;         // Sent messages are always "read"
     message.isSent = true;
-    messages.push_back(message);
+    add(std::move(message), to);
 }
 
-bool SmsDb::hasUnreadSms() const
+void SmsDb::add(SmsMessage message, PhoneNumber peer)
 {
-    for (const auto& message : messages)
+    if (log)
     {
-        if (!message.isRead)
-        {
-            return true;
-        }
+        log->append(message);
     }
-    return false;
+    insert(std::move(message), peer);
+}
+
+void SmsDb::insert(SmsMessage message, PhoneNumber peer)
+{
+    std::unique_lock lock(mutex);
+    const std::size_t index = messages.size();
+    (message.isSent ? sentIndices : receivedIndices).push_back(index);
+    peerIndices[peer.value].push_back(index);
+    searchIndex.add(index, message.text);
+    if (not message.isRead)
+    {
+        unreadIndices.push_back(index);
+        ++unread;
+    }
+    messages.push_back(std::move(message));
+    published.store(messages.size(), std::memory_order_release);
+}
+
+bool SmsDb::hasUnreadSms() const
+{
+    return unread > 0u;
+}
+
+std::size_t SmsDb::unreadCount() const
+{
+    return unread;
 }
 
-std::vector<SmsMessage> SmsDb::getSmsMessages() const
+std::size_t SmsDb::size() const
+{
+    return published.load(std::memory_order_acquire);
+}
+
+const SmsMessage& SmsDb::at(std::size_t index) const
+{
+    return messages.at(index);
+}
+
+std::span<const SmsMessage> SmsDb::getSmsMessages() const
 {
     return messages;
 }
 
-std::vector<SmsMessage> SmsDb::getSentMessages() const
+std::span<const SmsMessage> SmsDb::getPage(std::size_t offset, std::size_t count) const
+{
+    const std::size_t first = std::min(offset, messages.size());
+    return getSmsMessages().subspan(first, std::min(count, messages.size() - first));
+}
+
+std::vector<SmsMessage> SmsDb::copyPage(std::size_t offset, std::size_t count) const
+{
+    std::shared_lock lock(mutex);
+    const auto page = getPage(offset, count);
+    return {page.begin(), page.end()};
+}
+
+SmsView SmsDb::getSentMessages() const
+{
+    return SmsView(messages, sentIndices);
+}
+
+SmsView SmsDb::getReceivedMessages() const
+{
+    return SmsView(messages, receivedIndices);
+}
+
+SmsView SmsDb::getConversation(PhoneNumber peer) const
+{
+    return SmsView(messages, peerIndices[peer.value]);
+}
+
+std::vector<std::size_t> SmsDb::search(const std::string& query, std::optional<PhoneNumber> peer) const
 {
-    std::vector<SmsMessage> sentMessages;
-    for (const auto& message : messages)
+    std::shared_lock lock(mutex);
+    if (SmsSearchIndex::tokenize(query).empty())
     {
-        if (message.isSent)
-        {
-            sentMessages.push_back(message);
-        }
+        return peer ? peerIndices[peer->value] : std::vector<std::size_t>{};
     }
-    return sentMessages;
+    auto found = searchIndex.find(query);
+    if (peer)
+    {
+        const auto& conversation = peerIndices[peer->value];
+        std::vector<std::size_t> result;
+        std::set_intersection(found.begin(), found.end(), conversation.begin(), conversation.end(),
+                              std::back_inserter(result));
+        return result;
+    }
+    return found;
 }
 
 void SmsDb::markAsRead(size_t index)
 {
-    if (index < messages.size())
+    std::unique_lock lock(mutex);
+    setRead(index);
+}
+
+void SmsDb::markAsRead(std::span<const std::size_t> indices)
+{
+    std::unique_lock lock(mutex);
+    for (auto index : indices)
+    {
+        setRead(index);
+    }
+}
+
+void SmsDb::setRead(std::size_t index)
+{
+    if (index < messages.size() and not messages[index].isRead)
     {
         messages[index].isRead = true;
+        --unread;
+        if (log)
+        {
+            log->markAsRead(index);
+        }
+    }
+}
+
+void SmsDb::markAllAsRead()
+{
+    std::unique_lock lock(mutex);
+    for (auto index : unreadIndices)
+    {
+        setRead(index);
     }
+    unreadIndices.clear();
 }
 
-}
\ No newline at end of file
+}
@@ -1,6 +1,15 @@
 #pragma once
 
 #include "Messages/PhoneNumber.hpp"
+#include "SmsSearchIndex.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -9,6 +18,8 @@ namespace ue
 
 using common::PhoneNumber;
 
+class SmsLog;
+
 struct SmsMessage
 {
     PhoneNumber from;
@@ -18,18 +29,102 @@ struct SmsMessage
     bool isSent = false; // flag to indicate if message was sent by this UE
 };
 
+/**
+ * Read-only selection of SmsDb messages, without copying them.
+ * Valid until next message is added.
+ */
+class SmsView
+{
+public:
+    SmsView(std::span<const SmsMessage> messages, std::span<const std::size_t> indices);
+
+    std::size_t size() const;
+    bool empty() const;
+    const SmsMessage& operator[](std::size_t position) const;
+    // to be used with SmsDb::markAsRead
+    std::size_t indexAt(std::size_t position) const;
+
+private:
+    std::span<const SmsMessage> messages;
+    std::span<const std::size_t> indices;
+};
+
+/**
+ * Messages are only appended, so index of message never changes.
+ * Sent/received/per-peer indices and unread counter are kept up to date on each change.
+ *
+ * One per UE (see Context), with single writer: only thread of the owning UE changes it, and
+ * its reads need no locking - spans and views are for that thread only.
+ * Other threads read counters lock-free, and copy messages or search under shared lock,
+ * taken exclusively by the writer only for the moment of change.
+ */
 class SmsDb
 {
 public:
+    SmsDb();
+    ~SmsDb();
+
+    /**
+     * Loads messages stored in log, following ones are stored there too - before any message is added.
+     * Null closes the log, leaving messages in memory.
+     */
+    void persistTo(std::unique_ptr<SmsLog> log);
+
     void addSms(PhoneNumber from, const std::string& text);
     void addSentSms(PhoneNumber to, const std::string& text);
+    // any thread
     bool hasUnreadSms() const;
-    std::vector<SmsMessage> getSmsMessages() const;
-    std::vector<SmsMessage> getSentMessages() const;
+    // any thread
+    std::size_t unreadCount() const;
+
+    // any thread
+    std::size_t size() const;
+    const SmsMessage& at(std::size_t index) const;
+    /**
+     * All messages, oldest first. Valid until next message is added.
+     */
+    std::span<const SmsMessage> getSmsMessages() const;
+    /**
+     * At most count messages starting at offset - empty past the end
+     */
+    std::span<const SmsMessage> getPage(std::size_t offset, std::size_t count) const;
+    SmsView getSentMessages() const;
+    SmsView getReceivedMessages() const;
+    // sent to and received from peer
+    SmsView getConversation(PhoneNumber peer) const;
+    /**
+     * Copy of getPage, for any thread
+     */
+    std::vector<SmsMessage> copyPage(std::size_t offset, std::size_t count) const;
+    /**
+     * Any thread.
+     * Indices (ascending) of messages with words starting with each query term, optionally sent to
+     * or received from peer. Only peer filter, when query has no terms.
+     */
+    std::vector<std::size_t> search(const std::string& query, std::optional<PhoneNumber> peer = std::nullopt) const;
+
     void markAsRead(size_t index);
+    void markAsRead(std::span<const std::size_t> indices);
+    void markAllAsRead();
 
 private:
+    void add(SmsMessage message, PhoneNumber peer);
+    void insert(SmsMessage message, PhoneNumber peer);
+    // under exclusive lock
+    void setRead(std::size_t index);
+
     std::vector<SmsMessage> messages;
+    std::vector<std::size_t> sentIndices;
+    std::vector<std::size_t> receivedIndices;
+    std::array<std::vector<std::size_t>, std::numeric_limits<decltype(PhoneNumber::value)>::max() + 1u> peerIndices;
+    // might still contain messages already read one by one - skipped by markAllAsRead
+    std::vector<std::size_t> unreadIndices;
+    // messages.size() for other threads
+    std::atomic<std::size_t> published{0u};
+    std::atomic<std::size_t> unread{0u};
+    SmsSearchIndex searchIndex;
+    std::unique_ptr<SmsLog> log;
+    mutable std::shared_mutex mutex;
 };
 
-}
\ No newline at end of file
+}
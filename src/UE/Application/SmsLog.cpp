@@ -0,0 +1,755 @@
+#include "SmsLog.hpp"
+#include "Config/MultiLineConfig.hpp"
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ue
+{
+
+namespace
+{
+
+constexpr std::uint32_t VERSION = 1u;
+constexpr char LOG_MAGIC[8] = {'U', 'E', 'S', 'M', 'S', 'L', 'O', 'G'};
+constexpr char INDEX_MAGIC[8] = {'U', 'E', 'S', 'M', 'S', 'I', 'D', 'X'};
+
+struct LogHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    // changed by each compaction - index of other generation is not used
+    std::uint64_t generation;
+    std::uint64_t committedEnd;
+    std::uint64_t smsCount;
+    std::uint64_t garbageBytes;
+};
+constexpr std::size_t LOG_HEADER_SIZE = 64u;
+static_assert(sizeof(LogHeader) <= LOG_HEADER_SIZE);
+
+struct IndexHeader
+{
+    char magic[8];
+    std::uint64_t generation;
+    std::uint64_t count;
+};
+constexpr std::size_t INDEX_HEADER_SIZE = 32u;
+static_assert(sizeof(IndexHeader) <= INDEX_HEADER_SIZE);
+
+struct IndexEntry
+{
+    std::uint32_t offset;
+    std::uint8_t flags;
+    std::uint8_t reserved[3];
+};
+static_assert(sizeof(IndexEntry) == 8u);
+// so that offsets of all records fit IndexEntry
+constexpr std::uint64_t MAX_LOG_SIZE = UINT32_MAX;
+
+enum RecordType : std::uint8_t
+{
+    SMS_RECORD = 1u,
+    READ_RECORD = 2u
+};
+
+enum SmsFlags : std::uint8_t
+{
+    READ_FLAG = 1u,
+    SENT_FLAG = 2u
+};
+
+// [u32 body size][u32 crc of body]
+constexpr std::size_t RECORD_HEADER_SIZE = 8u;
+// [type][flags][from][to]
+constexpr std::size_t SMS_BODY_HEADER_SIZE = 4u;
+constexpr std::size_t READ_BODY_SIZE = 5u;
+
+constexpr std::array<std::uint32_t, 256> makeCrcTable()
+{
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0u; i < table.size(); ++i)
+    {
+        std::uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 1u) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr auto CRC_TABLE = makeCrcTable();
+
+std::uint32_t crc32(const std::uint8_t* data, std::size_t size)
+{
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (std::size_t i = 0u; i < size; ++i)
+    {
+        crc = CRC_TABLE[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+std::uint32_t load32(const std::uint8_t* data)
+{
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+void store32(std::uint8_t* data, std::uint32_t value)
+{
+    std::memcpy(data, &value, sizeof(value));
+}
+
+std::uint8_t flagsOf(const SmsMessage& message)
+{
+    return (message.isRead ? std::uint8_t{READ_FLAG} : 0u) | (message.isSent ? std::uint8_t{SENT_FLAG} : 0u);
+}
+
+std::vector<std::uint8_t> smsBody(const SmsMessage& message, std::uint8_t flags)
+{
+    std::vector<std::uint8_t> body{SMS_RECORD, flags, message.from.value, message.to.value};
+    body.insert(body.end(), message.text.begin(), message.text.end());
+    return body;
+}
+
+std::vector<std::uint8_t> readBody(std::size_t index)
+{
+    std::vector<std::uint8_t> body(READ_BODY_SIZE, READ_RECORD);
+    store32(body.data() + 1u, static_cast<std::uint32_t>(index));
+    return body;
+}
+
+/**
+ * Record starting at offset, if it fits before end and is not damaged
+ */
+struct Record
+{
+    const std::uint8_t* body = nullptr;
+    std::size_t bodySize = 0u;
+
+    std::size_t size() const
+    {
+        return RECORD_HEADER_SIZE + bodySize;
+    }
+    bool isSms() const
+    {
+        return bodySize >= SMS_BODY_HEADER_SIZE and body[0] == SMS_RECORD;
+    }
+    bool isRead() const
+    {
+        return bodySize == READ_BODY_SIZE and body[0] == READ_RECORD;
+    }
+    std::uint32_t readIndex() const
+    {
+        return load32(body + 1u);
+    }
+};
+
+std::optional<Record> recordAt(const std::uint8_t* data, std::size_t offset, std::size_t end)
+{
+    if (offset + RECORD_HEADER_SIZE > end)
+    {
+        return std::nullopt;
+    }
+    Record record{data + offset + RECORD_HEADER_SIZE, load32(data + offset)};
+    if (record.bodySize == 0u or record.bodySize > end - offset - RECORD_HEADER_SIZE
+        or crc32(record.body, record.bodySize) != load32(data + offset + 4u))
+    {
+        return std::nullopt;
+    }
+    return record;
+}
+
+} // namespace
+
+class SmsLog::MappedFile
+{
+public:
+    enum class Mode
+    {
+        // created when missing, grown to given size when smaller
+        OpenOrCreate,
+        // previous content dropped, sized exactly as given
+        Create,
+        // given size mapped, file never resized - its owner may grow it meanwhile
+        ReadOnly
+    };
+
+    MappedFile(const std::string& path, std::size_t size, Mode mode = Mode::OpenOrCreate)
+        : path(path),
+          writable(mode != Mode::ReadOnly)
+    {
+        const int flags = mode == Mode::ReadOnly ? O_RDONLY
+                        : mode == Mode::Create   ? O_RDWR | O_CREAT | O_TRUNC
+                                                 : O_RDWR | O_CREAT;
+        fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw Error("open " + path, errno);
+        }
+        try
+        {
+            if (mode != Mode::OpenOrCreate)
+            {
+                fresh = mode == Mode::Create;
+                map(size);
+                return;
+            }
+            struct stat status{};
+            if (::fstat(fd, &status) < 0)
+            {
+                throw Error("fstat " + path, errno);
+            }
+            fresh = status.st_size == 0;
+            map(std::max<std::size_t>(status.st_size, size));
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+    }
+
+    ~MappedFile()
+    {
+        unmap();
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+
+    std::uint8_t* data() const
+    {
+        return mapping;
+    }
+
+    std::size_t size() const
+    {
+        return mappingSize;
+    }
+
+    // file was empty when opened
+    bool isFresh() const
+    {
+        return fresh;
+    }
+
+    // at least doubled when growing, to keep appends amortized O(1)
+    void reserve(std::size_t required)
+    {
+        if (required > mappingSize)
+        {
+            unmap();
+            map(std::max(required, 2u * mappingSize));
+        }
+    }
+
+    void sync()
+    {
+        ::msync(mapping, mappingSize, MS_ASYNC);
+    }
+
+private:
+    void map(std::size_t size)
+    {
+        if (writable and ::ftruncate(fd, size) < 0)
+        {
+            throw Error("ftruncate " + path, errno);
+        }
+        void* address = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            throw Error("mmap " + path, errno);
+        }
+        mapping = static_cast<std::uint8_t*>(address);
+        mappingSize = size;
+    }
+
+    void unmap()
+    {
+        if (mapping)
+        {
+            ::munmap(mapping, mappingSize);
+            mapping = nullptr;
+        }
+    }
+
+    std::string path;
+    const bool writable;
+    int fd = -1;
+    bool fresh = false;
+    std::uint8_t* mapping = nullptr;
+    std::size_t mappingSize = 0u;
+};
+
+namespace
+{
+
+LogHeader& logHeader(const SmsLog::MappedFile& file)
+{
+    return *reinterpret_cast<LogHeader*>(file.data());
+}
+
+IndexHeader& indexHeader(const SmsLog::MappedFile& file)
+{
+    return *reinterpret_cast<IndexHeader*>(file.data());
+}
+
+IndexEntry* indexEntries(const SmsLog::MappedFile& file)
+{
+    return reinterpret_cast<IndexEntry*>(file.data() + INDEX_HEADER_SIZE);
+}
+
+void initialize(LogHeader& header, std::uint64_t generation)
+{
+    std::memcpy(header.magic, LOG_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.generation = generation;
+    header.committedEnd = LOG_HEADER_SIZE;
+    header.smsCount = 0u;
+    header.garbageBytes = 0u;
+}
+
+std::string compactedPath(const std::string& path)
+{
+    return path + ".compacting";
+}
+
+std::string indexPath(const std::string& path)
+{
+    return path + ".idx";
+}
+
+} // namespace
+
+/**
+ * Shared with compaction thread: inputs are set before it starts, results read after it is joined
+ */
+struct SmsLog::Compaction
+{
+    std::string path;
+    std::uint64_t snapshotEnd;
+    std::uint64_t generation;
+
+    std::vector<std::uint32_t> offsets;
+    std::uint64_t compactedEnd = LOG_HEADER_SIZE;
+    std::string error;
+
+    void run()
+    {
+        try
+        {
+            // owner keeps appending past snapshot - growing the file, which is not to be touched here
+            MappedFile source(path, snapshotEnd, MappedFile::Mode::ReadOnly);
+            std::vector<std::uint32_t> sourceOffsets;
+            std::vector<std::uint8_t> flags;
+            for (auto offset = LOG_HEADER_SIZE; offset < snapshotEnd;)
+            {
+                const auto record = recordAt(source.data(), offset, snapshotEnd);
+                if (not record)
+                {
+                    break;
+                }
+                if (record->isSms())
+                {
+                    sourceOffsets.push_back(offset);
+                    flags.push_back(record->body[1]);
+                }
+                else if (record->isRead() and record->readIndex() < flags.size())
+                {
+                    flags[record->readIndex()] |= READ_FLAG;
+                }
+                offset += record->size();
+            }
+
+            MappedFile target(compactedPath(path), snapshotEnd, MappedFile::Mode::Create);
+            for (std::size_t i = 0u; i < sourceOffsets.size(); ++i)
+            {
+                const auto record = recordAt(source.data(), sourceOffsets[i], snapshotEnd);
+                std::uint8_t* out = target.data() + compactedEnd;
+                std::memcpy(out, source.data() + sourceOffsets[i], record->size());
+                out[RECORD_HEADER_SIZE + 1u] = flags[i];
+                store32(out + 4u, crc32(out + RECORD_HEADER_SIZE, record->bodySize));
+                offsets.push_back(compactedEnd);
+                compactedEnd += record->size();
+            }
+            auto& header = logHeader(target);
+            initialize(header, generation);
+            header.committedEnd = compactedEnd;
+            header.smsCount = offsets.size();
+        }
+        catch (std::exception& ex)
+        {
+            error = ex.what();
+        }
+    }
+};
+
+SmsLog::Error::Error(const std::string& what, int error)
+    : std::runtime_error(what + ": " + std::strerror(error))
+{}
+
+SmsLog::Options SmsLog::Options::fromConfig(const common::MultiLineConfig& configuration, PhoneNumber phoneNumber)
+{
+    Options options;
+    options.path = configuration.getString("smsLog", "ue" + to_string(phoneNumber) + "_sms.log");
+    options.initialSize = configuration.getNumber<std::size_t>("smsLogInitialSize", options.initialSize);
+    options.compactionPercent = configuration.getNumber<unsigned>("smsLogCompactionPercent", options.compactionPercent);
+    options.compactionMinBytes = configuration.getNumber<std::size_t>("smsLogCompactionMinBytes", options.compactionMinBytes);
+    return options;
+}
+
+SmsLog::SmsLog(Options options, common::ILogger& logger)
+    : options(std::move(options)),
+      logger(logger, "[SMS-LOG]")
+{
+    open();
+}
+
+SmsLog::~SmsLog()
+{
+    try
+    {
+        waitForCompaction();
+    }
+    catch (std::exception& ex)
+    {
+        logger.logError("Compaction not finished: ", ex.what());
+    }
+    if (log)
+    {
+        log->sync();
+        index->sync();
+    }
+}
+
+void SmsLog::open()
+{
+    log = std::make_unique<MappedFile>(options.path, std::max(options.initialSize, LOG_HEADER_SIZE));
+    auto& header = logHeader(*log);
+    if (log->isFresh())
+    {
+        initialize(header, 1u);
+    }
+    else if (std::memcmp(header.magic, LOG_MAGIC, sizeof(header.magic)) != 0 or header.version != VERSION
+             or header.committedEnd < LOG_HEADER_SIZE or header.committedEnd > log->size()
+             or header.committedEnd > MAX_LOG_SIZE)
+    {
+        throw Error(options.path + " is not an SMS log", EPROTO);
+    }
+    ::unlink(compactedPath(options.path).c_str());
+
+    const std::size_t indexSize = INDEX_HEADER_SIZE + header.smsCount * sizeof(IndexEntry);
+    index = std::make_unique<MappedFile>(indexPath(options.path), std::max(indexSize, options.initialSize / 8u));
+    const auto& idx = indexHeader(*index);
+    if (std::memcmp(idx.magic, INDEX_MAGIC, sizeof(idx.magic)) != 0 or idx.generation != header.generation
+        or idx.count != header.smsCount or not isCountComplete())
+    {
+        if (not log->isFresh())
+        {
+            logger.logInfo("Index not matching log - rebuilding");
+        }
+        rebuildIndex();
+    }
+    logger.logDebug("Opened ", options.path, ": ", header.smsCount, " messages, ", header.committedEnd, " bytes");
+}
+
+bool SmsLog::isCountComplete() const
+{
+    const auto& header = logHeader(*log);
+    const auto& idx = indexHeader(*index);
+    std::uint64_t offset = LOG_HEADER_SIZE;
+    if (idx.count > 0u)
+    {
+        // not found when counted before its record was committed (older files)
+        const auto lastOffset = indexEntries(*index)[idx.count - 1u].offset;
+        const auto last = recordAt(log->data(), lastOffset, header.committedEnd);
+        if (not last or not last->isSms())
+        {
+            return false;
+        }
+        offset = lastOffset + last->size();
+    }
+    // only read marks may follow - Sms record there was committed by process killed before counting it
+    while (offset < header.committedEnd)
+    {
+        const auto record = recordAt(log->data(), offset, header.committedEnd);
+        if (not record or record->isSms())
+        {
+            return false;
+        }
+        offset += record->size();
+    }
+    return true;
+}
+
+void SmsLog::rebuildIndex()
+{
+    auto& header = logHeader(*log);
+    std::vector<IndexEntry> entries;
+    std::uint64_t garbage = 0u;
+    std::uint64_t offset = LOG_HEADER_SIZE;
+    while (offset < header.committedEnd)
+    {
+        const auto record = recordAt(log->data(), offset, header.committedEnd);
+        if (not record)
+        {
+            logger.logError("Damaged record at ", offset, " - dropping ", header.committedEnd - offset, " bytes");
+            break;
+        }
+        if (record->isSms())
+        {
+            entries.push_back(IndexEntry{static_cast<std::uint32_t>(offset), record->body[1], {}});
+        }
+        else
+        {
+            if (record->isRead() and record->readIndex() < entries.size())
+            {
+                entries[record->readIndex()].flags |= READ_FLAG;
+            }
+            garbage += record->size();
+        }
+        offset += record->size();
+    }
+    header.committedEnd = offset;
+    header.smsCount = entries.size();
+    header.garbageBytes = garbage;
+
+    index->reserve(INDEX_HEADER_SIZE + entries.size() * sizeof(IndexEntry));
+    if (not entries.empty())
+    {
+        std::memcpy(indexEntries(*index), entries.data(), entries.size() * sizeof(IndexEntry));
+    }
+    auto& idx = indexHeader(*index);
+    std::memcpy(idx.magic, INDEX_MAGIC, sizeof(idx.magic));
+    idx.generation = header.generation;
+    idx.count = entries.size();
+}
+
+std::size_t SmsLog::size() const
+{
+    return logHeader(*log).smsCount;
+}
+
+SmsMessage SmsLog::read(std::size_t position) const
+{
+    const auto& entry = indexEntries(*index)[position];
+    const auto record = recordAt(log->data(), entry.offset, logHeader(*log).committedEnd);
+    if (not record or not record->isSms())
+    {
+        throw Error(options.path + ": damaged message " + std::to_string(position), EBADMSG);
+    }
+    SmsMessage message;
+    message.from = PhoneNumber{record->body[2]};
+    message.to = PhoneNumber{record->body[3]};
+    message.text.assign(reinterpret_cast<const char*>(record->body) + SMS_BODY_HEADER_SIZE,
+                        record->bodySize - SMS_BODY_HEADER_SIZE);
+    message.isRead = entry.flags & READ_FLAG;
+    message.isSent = entry.flags & SENT_FLAG;
+    return message;
+}
+
+void SmsLog::append(const SmsMessage& message)
+{
+    pollCompaction();
+    try
+    {
+        const auto body = smsBody(message, flagsOf(message));
+        const auto offset = writeRecord(body);
+        writeIndexEntry(offset, flagsOf(message));
+        commitRecord(offset, body.size());
+        ++logHeader(*log).smsCount;
+        ++indexHeader(*index).count;
+    }
+    catch (Error& ex)
+    {
+        // uncommitted part is overwritten by next append, or ignored on next open
+        logger.logError("Message not stored: ", ex.what());
+    }
+}
+
+void SmsLog::markAsRead(std::size_t position)
+{
+    pollCompaction();
+    if (position >= size() or (indexEntries(*index)[position].flags & READ_FLAG))
+    {
+        return;
+    }
+    try
+    {
+        const auto body = readBody(position);
+        const auto offset = writeRecord(body);
+        commitRecord(offset, body.size());
+        logHeader(*log).garbageBytes += RECORD_HEADER_SIZE + body.size();
+        indexEntries(*index)[position].flags |= READ_FLAG;
+    }
+    catch (Error& ex)
+    {
+        logger.logError("Read mark not stored: ", ex.what());
+    }
+    startCompactionIfNeeded();
+}
+
+std::uint32_t SmsLog::writeRecord(const std::vector<std::uint8_t>& body)
+{
+    const std::uint64_t offset = logHeader(*log).committedEnd;
+    if (offset + RECORD_HEADER_SIZE + body.size() > MAX_LOG_SIZE)
+    {
+        throw Error(options.path + " full", EFBIG);
+    }
+    log->reserve(offset + RECORD_HEADER_SIZE + body.size());
+    std::uint8_t* out = log->data() + offset;
+    store32(out, static_cast<std::uint32_t>(body.size()));
+    store32(out + 4u, crc32(body.data(), body.size()));
+    std::memcpy(out + RECORD_HEADER_SIZE, body.data(), body.size());
+    return static_cast<std::uint32_t>(offset);
+}
+
+void SmsLog::commitRecord(std::uint32_t offset, std::size_t bodySize)
+{
+    std::atomic_thread_fence(std::memory_order_release);
+    logHeader(*log).committedEnd = offset + RECORD_HEADER_SIZE + bodySize;
+}
+
+void SmsLog::writeIndexEntry(std::uint32_t offset, std::uint8_t flags)
+{
+    index->reserve(INDEX_HEADER_SIZE + (indexHeader(*index).count + 1u) * sizeof(IndexEntry));
+    const auto& header = indexHeader(*index);
+    indexEntries(*index)[header.count] = IndexEntry{offset, flags, {}};
+}
+
+std::size_t SmsLog::garbageBytes() const
+{
+    return logHeader(*log).garbageBytes;
+}
+
+std::size_t SmsLog::fileSize() const
+{
+    return logHeader(*log).committedEnd;
+}
+
+bool SmsLog::isCompacting() const
+{
+    return compaction != nullptr;
+}
+
+void SmsLog::startCompactionIfNeeded()
+{
+    const auto& header = logHeader(*log);
+    if (compaction or header.garbageBytes < options.compactionMinBytes
+        or header.garbageBytes * 100u < header.committedEnd * options.compactionPercent)
+    {
+        return;
+    }
+    logger.logInfo("Compacting: ", header.garbageBytes, " of ", header.committedEnd, " bytes are garbage");
+    compaction = std::make_unique<Compaction>();
+    compaction->path = options.path;
+    compaction->snapshotEnd = header.committedEnd;
+    compaction->generation = header.generation + 1u;
+    compactionDone = false;
+    compactionThread = std::thread([this] {
+        compaction->run();
+        compactionDone = true;
+    });
+}
+
+void SmsLog::pollCompaction()
+{
+    if (compaction and compactionDone)
+    {
+        finishCompaction();
+    }
+}
+
+void SmsLog::waitForCompaction()
+{
+    if (compaction)
+    {
+        finishCompaction();
+    }
+}
+
+void SmsLog::finishCompaction()
+{
+    compactionThread.join();
+    const auto done = std::move(compaction);
+    if (not done->error.empty())
+    {
+        logger.logError("Compaction failed: ", done->error);
+        ::unlink(compactedPath(options.path).c_str());
+        return;
+    }
+
+    const auto& header = logHeader(*log);
+    auto compacted = std::make_unique<MappedFile>(compactedPath(options.path), 0u);
+    auto offsets = done->offsets;
+    std::uint64_t garbage = 0u;
+    // appended while compaction was running
+    for (auto offset = done->snapshotEnd; offset < header.committedEnd;)
+    {
+        const auto record = recordAt(log->data(), offset, header.committedEnd);
+        if (not record)
+        {
+            break;
+        }
+        compacted->reserve(logHeader(*compacted).committedEnd + record->size());
+        auto& target = logHeader(*compacted);
+        std::memcpy(compacted->data() + target.committedEnd, log->data() + offset, record->size());
+        if (record->isSms())
+        {
+            offsets.push_back(target.committedEnd);
+        }
+        else
+        {
+            garbage += record->size();
+        }
+        target.committedEnd += record->size();
+        offset += record->size();
+    }
+    auto& target = logHeader(*compacted);
+    target.smsCount = offsets.size();
+    target.garbageBytes = garbage;
+
+    // flags of current index already include all read marks
+    auto compactedIndex = std::make_unique<MappedFile>(compactedPath(indexPath(options.path)),
+                                                       INDEX_HEADER_SIZE + offsets.size() * sizeof(IndexEntry),
+                                                       MappedFile::Mode::Create);
+    for (std::size_t i = 0u; i < offsets.size(); ++i)
+    {
+        indexEntries(*compactedIndex)[i] = IndexEntry{offsets[i], indexEntries(*index)[i].flags, {}};
+    }
+    auto& idx = indexHeader(*compactedIndex);
+    std::memcpy(idx.magic, INDEX_MAGIC, sizeof(idx.magic));
+    idx.generation = target.generation;
+    idx.count = offsets.size();
+
+    // crash between renames leaves index of other generation - rebuilt on next open
+    compacted->sync();
+    compactedIndex->sync();
+    if (::rename(compactedPath(options.path).c_str(), options.path.c_str()) < 0)
+    {
+        logger.logError("Compacted log not used: ", std::strerror(errno));
+        return;
+    }
+    // old log is unlinked already - appends go to compacted one, whether its index is in place or not
+    if (::rename(compactedPath(indexPath(options.path)).c_str(), indexPath(options.path).c_str()) < 0)
+    {
+        logger.logError("Compacted index not used, rebuilt on next open: ", std::strerror(errno));
+        ::unlink(compactedPath(indexPath(options.path)).c_str());
+    }
+    logger.logInfo("Compacted ", header.committedEnd, " to ", target.committedEnd, " bytes");
+    log = std::move(compacted);
+    index = std::move(compactedIndex);
+}
+
+}
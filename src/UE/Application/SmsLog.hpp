@@ -0,0 +1,119 @@
+#pragma once
+
+#include "SmsDb.hpp"
+#include "Logger/PrefixedLogger.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace common
+{
+class MultiLineConfig;
+}
+
+namespace ue
+{
+
+/**
+ * Persistent storage of SmsDb - append-only log in memory-mapped file, and small index beside it.
+ *
+ * Log (path):        [header][record]...   record: [u32 size][u32 crc][type][body]
+ *                    - Sms record:  [flags][from][to][text]
+ *                    - Read record: [u32 message index]
+ * Index (path.idx):  [header][entry]...    entry: [u32 record offset][flags][reserved]
+ *
+ * Record (and index entry) is written past committed end, and only then header is updated,
+ * so the part left by killed process is ignored on next open.
+ * Index carries read flags, so opening scans only read marks following the last counted message - an Sms
+ * record there was committed, but not counted. The index is rebuilt from the log only when missing or not
+ * matching it.
+ * Read records are garbage once folded into index - when they grow above configured share of the log,
+ * compaction rewrites the log without them in background thread; appends done meanwhile are copied
+ * to compacted log when it replaces the old one (see pollCompaction).
+ * Index keeps 32-bit record offsets - log does not grow past 4 GiB, appends above that are not stored.
+ */
+class SmsLog
+{
+public:
+    struct Options
+    {
+        std::string path;
+        std::size_t initialSize = 64u * 1024u;
+        // compact when read records take that percent of the log...
+        unsigned compactionPercent = 50u;
+        // ...but not before they take that many bytes
+        std::size_t compactionMinBytes = 64u * 1024u;
+
+        /**
+         * smsLog - path, "ue<phone>_sms.log" by default, empty disables persistence
+         * smsLogInitialSize, smsLogCompactionPercent, smsLogCompactionMinBytes
+         */
+        static Options fromConfig(const common::MultiLineConfig& configuration, PhoneNumber phoneNumber);
+    };
+
+    class Error : public std::runtime_error
+    {
+    public:
+        Error(const std::string& what, int error);
+    };
+
+    /**
+     * @throw Error when file cannot be opened or mapped, or it is not a log
+     */
+    SmsLog(Options options, common::ILogger& logger);
+    ~SmsLog();
+
+    SmsLog(const SmsLog&) = delete;
+    SmsLog& operator=(const SmsLog&) = delete;
+
+    std::size_t size() const;
+    /**
+     * @throw Error on corrupted record
+     */
+    SmsMessage read(std::size_t index) const;
+
+    void append(const SmsMessage& message);
+    void markAsRead(std::size_t index);
+
+    /**
+     * Replaces log with the compacted one, if background compaction is finished.
+     * Called on each change, so only needed when log stays unchanged for long.
+     */
+    void pollCompaction();
+    bool isCompacting() const;
+    void waitForCompaction();
+    std::size_t garbageBytes() const;
+    std::size_t fileSize() const;
+
+    class MappedFile;
+
+private:
+    struct Compaction;
+
+    void open();
+    // no Sms record committed but not counted - it is the last one, if any
+    bool isCountComplete() const;
+    void rebuildIndex();
+    // record is ignored until committed
+    std::uint32_t writeRecord(const std::vector<std::uint8_t>& body);
+    void commitRecord(std::uint32_t offset, std::size_t bodySize);
+    // entry is ignored until counted - after its record is committed
+    void writeIndexEntry(std::uint32_t offset, std::uint8_t flags);
+    void startCompactionIfNeeded();
+    void finishCompaction();
+
+    Options options;
+    common::PrefixedLogger logger;
+    std::unique_ptr<MappedFile> log;
+    std::unique_ptr<MappedFile> index;
+
+    std::unique_ptr<Compaction> compaction;
+    std::thread compactionThread;
+    std::atomic<bool> compactionDone{false};
+};
+
+}
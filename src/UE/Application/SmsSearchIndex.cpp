@@ -0,0 +1,111 @@
+#include "SmsSearchIndex.hpp"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+namespace ue
+{
+
+namespace
+{
+
+// bytes of UTF-8 sequences are kept, so non-ASCII words are searchable too
+bool isWordCharacter(unsigned char c)
+{
+    return std::isalnum(c) or c >= 0x80u;
+}
+
+std::vector<std::size_t> intersect(const std::vector<std::size_t>& lhs, const std::vector<std::size_t>& rhs)
+{
+    std::vector<std::size_t> result;
+    std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+    return result;
+}
+
+}
+
+std::vector<std::string> SmsSearchIndex::tokenize(std::string_view text)
+{
+    std::vector<std::string> words;
+    std::string word;
+    for (unsigned char c : text)
+    {
+        if (isWordCharacter(c))
+        {
+            word += static_cast<char>(std::tolower(c));
+        }
+        else if (not word.empty())
+        {
+            words.push_back(std::move(word));
+            word.clear();
+        }
+    }
+    if (not word.empty())
+    {
+        words.push_back(std::move(word));
+    }
+    return words;
+}
+
+void SmsSearchIndex::add(std::size_t index, const std::string& text)
+{
+    for (auto& word : tokenize(text))
+    {
+        auto& posting = postings[std::move(word)];
+        // word repeated in message
+        if (posting.empty() or posting.back() != index)
+        {
+            posting.push_back(index);
+        }
+    }
+}
+
+std::vector<std::size_t> SmsSearchIndex::findPrefix(const std::string& prefix) const
+{
+    auto first = postings.lower_bound(prefix);
+    auto last = first;
+    std::size_t words = 0u;
+    while (last != postings.end() and last->first.compare(0u, prefix.size(), prefix) == 0)
+    {
+        ++last;
+        ++words;
+    }
+    if (words == 1u)
+    {
+        return first->second;
+    }
+
+    std::vector<std::size_t> result;
+    for (auto it = first; it != last; ++it)
+    {
+        result.insert(result.end(), it->second.begin(), it->second.end());
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+std::vector<std::size_t> SmsSearchIndex::find(const std::string& query) const
+{
+    auto terms = tokenize(query);
+    if (terms.empty())
+    {
+        return {};
+    }
+    // longer terms match fewer words - cheaper to start with
+    std::sort(terms.begin(), terms.end(), [](const auto& lhs, const auto& rhs) { return lhs.size() > rhs.size(); });
+
+    auto result = findPrefix(terms.front());
+    for (auto term = std::next(terms.begin()); term != terms.end() and not result.empty(); ++term)
+    {
+        result = intersect(result, findPrefix(*term));
+    }
+    return result;
+}
+
+std::size_t SmsSearchIndex::wordCount() const
+{
+    return postings.size();
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ue
+{
+
+/**
+ * Inverted index of message words - case insensitive, words are runs of letters and digits.
+ * Messages are only added, with growing indices, so posting lists stay sorted without sorting.
+ */
+class SmsSearchIndex
+{
+public:
+    void add(std::size_t index, const std::string& text);
+
+    /**
+     * Indices (ascending) of messages having, for each query term, a word starting with it.
+     * Query without terms matches nothing.
+     */
+    std::vector<std::size_t> find(const std::string& query) const;
+
+    std::size_t wordCount() const;
+
+    static std::vector<std::string> tokenize(std::string_view text);
+
+private:
+    // messages with any word starting with prefix
+    std::vector<std::size_t> findPrefix(const std::string& prefix) const;
+
+    std::map<std::string, std::vector<std::size_t>, std::less<>> postings;
+};
+
+}
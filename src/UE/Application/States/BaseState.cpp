@@ -1,11 +1,12 @@
 #include "BaseState.hpp"
+#include "Context.hpp"
 
 namespace ue
 {
 
-BaseState::BaseState(Context &context, const std::string &name)
+BaseState::BaseState(Context &context, const char* name)
     : context(context),
-      logger(context.logger, "[" + name + "]")
+      logger(context.logger, [name](std::ostream& os) { os << '[' << name << ']'; })
 {
     logger.logDebug("entry");
 }
@@ -70,6 +71,27 @@ void BaseState::handleUnknownRecipient()
     logger.logError("Unexpected: handleUnknownRecipient");
 }
 
+void BaseState::handleGroupSmsResult(const std::vector<common::PhoneNumber>& failedRecipients)
+{
+    // result may come in any state - sending is not blocking
+    if (failedRecipients.empty())
+    {
+        logger.logInfo("Group SMS delivered to all recipients");
+        return;
+    }
+    std::string failed;
+    for (auto recipient : failedRecipients)
+    {
+        failed += " " + to_string(recipient);
+    }
+    logger.logInfo("Group SMS not delivered to:", failed);
+}
+
+void BaseState::handleConferenceMembers(const std::vector<common::PhoneNumber>& members)
+{
+    logger.logError("Unexpected: handleConferenceMembers: ", members.size());
+}
+
 void BaseState::handleHomeClicked()
 {
     logger.logError("Unexpected: handleHomeClicked");
@@ -2,15 +2,17 @@
 
 #include "IEventsHandler.hpp"
 #include "Logger/PrefixedLogger.hpp"
-#include "Context.hpp"
 
 namespace ue
 {
 
+struct Context;
+
 class BaseState : public IEventsHandler
 {
 public:
-    BaseState(Context& context, const std::string& name);
+    // name of static storage duration - only pointer to it is kept
+    BaseState(Context& context, const char* name);
     ~BaseState() override;
 
     // ITimerEventsHandler interface
@@ -27,6 +29,8 @@ public:
     void handleCallDropped(common::PhoneNumber from) override;
     void handleCallTalk(common::PhoneNumber from, const std::string& text) override;
     void handleUnknownRecipient() override;
+    void handleGroupSmsResult(const std::vector<common::PhoneNumber>& failedRecipients) override;
+    void handleConferenceMembers(const std::vector<common::PhoneNumber>& members) override;
     
     // IUserEventsHandler interface
     void handleHomeClicked() override;
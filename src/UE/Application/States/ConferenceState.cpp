@@ -0,0 +1,88 @@
+#include "ConferenceState.hpp"
+#include "Context.hpp"
+#include "ConnectedState.hpp"
+#include <algorithm>
+
+namespace ue
+{
+
+ConferenceState::ConferenceState(Context &context, common::PhoneNumber peer, std::vector<common::PhoneNumber> members)
+    : TalkingState(context, peer, "ConferenceState"),
+      members(std::move(members))
+{
+    logger.logInfo("Conference of: ", this->members.front(), ", members: ", this->members.size());
+    context.user.setCallMode().showParticipants(this->members);
+}
+
+void ConferenceState::handleCallDropped(common::PhoneNumber from)
+{
+    if (not isMember(from)) {
+        return;
+    }
+    const bool host = isHost();
+    members.erase(std::find(members.begin(), members.end(), from));
+    // host leaving or nobody else left - end of conference
+    if (from == peerPhoneNumber and not host) {
+        endConference(from);
+    } else if (members.size() < 2u) {
+        endConference(from);
+    } else {
+        logger.logInfo("Conference left by: ", from);
+        context.user.setCallMode().showParticipants(members);
+    }
+}
+
+void ConferenceState::handleCallTalk(common::PhoneNumber from, const std::string& text)
+{
+    if (isMember(from)) {
+        logger.logInfo("Received talk from: ", from, ", text: ", text);
+        context.user.setCallMode().appendIncomingText(to_string(from) + ": " + text);
+    }
+}
+
+void ConferenceState::handleConferenceMembers(const std::vector<common::PhoneNumber>& members)
+{
+    if (members.size() < 2u) {
+        // nobody to fan out talk to - plain call with peer, if it is still there
+        logger.logError("Conference of ", members.size(), " members, back to talking with: ", peerPhoneNumber);
+        context.setState<TalkingState>(peerPhoneNumber);
+        return;
+    }
+    this->members = members;
+    logger.logInfo("Conference members: ", members.size());
+    context.user.setCallMode().showParticipants(members);
+}
+
+bool ConferenceState::canInvite() const
+{
+    return isHost();
+}
+
+common::PhoneNumber ConferenceState::hangUpPeer() const
+{
+    // BTS ends conference for all when host hangs up - any member will do
+    if (isHost() and not isMember(peerPhoneNumber)) {
+        return members.at(1);
+    }
+    return peerPhoneNumber;
+}
+
+bool ConferenceState::isMember(common::PhoneNumber phone) const
+{
+    return std::find(members.begin(), members.end(), phone) != members.end();
+}
+
+bool ConferenceState::isHost() const
+{
+    // host is the only member whose peer is not the host
+    return peerPhoneNumber != members.front();
+}
+
+void ConferenceState::endConference(common::PhoneNumber by)
+{
+    logger.logInfo("Conference ended by: ", by);
+    context.user.showViewTextMode().setText("Call ended by: " + to_string(by));
+    context.setState<ConnectedState>();
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "TalkingState.hpp"
+#include <vector>
+
+namespace ue
+{
+
+/**
+ * Talking with many - BTS fans out talk of each member to all others.
+ * Peer of TalkingState is host for participants, first participant for host.
+ */
+class ConferenceState : public TalkingState
+{
+public:
+    ConferenceState(Context& context, common::PhoneNumber peer, std::vector<common::PhoneNumber> members);
+
+    // IBtsEventsHandler interface
+    void handleCallDropped(common::PhoneNumber from) override;
+    void handleCallTalk(common::PhoneNumber from, const std::string& text) override;
+    void handleConferenceMembers(const std::vector<common::PhoneNumber>& members) override;
+
+protected:
+    bool canInvite() const override;
+    common::PhoneNumber hangUpPeer() const override;
+
+private:
+    bool isMember(common::PhoneNumber phone) const;
+    bool isHost() const;
+    void endConference(common::PhoneNumber by);
+
+    std::vector<common::PhoneNumber> members;
+};
+
+}
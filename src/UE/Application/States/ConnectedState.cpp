@@ -1,12 +1,55 @@
 #include "ConnectedState.hpp"
+#include "Context.hpp"
 #include "NotConnectedState.hpp"
 #include "ReceivingCallState.hpp"
 #include "DiallingState.hpp"
-#include "SharedSmsDb.hpp"
+#include <limits>
+#include <sstream>
 
 namespace ue
 {
 
+namespace
+{
+
+/**
+ * "@123" terms filter by peer, the rest is searched in text
+ */
+std::pair<std::string, std::optional<PhoneNumber>> parseSearchQuery(const std::string& query)
+{
+    std::istringstream terms(query);
+    std::string text;
+    std::optional<PhoneNumber> peer;
+    for (std::string term; terms >> term;)
+    {
+        const bool isNumber = term.size() > 1u and term.size() <= 4u and term.front() == '@'
+                              and term.find_first_not_of("0123456789", 1u) == std::string::npos;
+        if (isNumber and std::stoul(term.substr(1u)) <= std::numeric_limits<decltype(PhoneNumber::value)>::max())
+        {
+            peer = PhoneNumber{static_cast<decltype(PhoneNumber::value)>(std::stoul(term.substr(1u)))};
+        }
+        else
+        {
+            text += term + ' ';
+        }
+    }
+    return {text, peer};
+}
+
+// built once - menu is shown on each return to ConnectedState, in order of items handled in showMenuView
+const IUeGui::IListViewMode::Items MENU_ITEMS{
+    {"Compose SMS", "Create a new SMS message"},
+    {"View SMS", "View received messages"},
+    {"Dial", "Make a call"},
+    {"Search SMS", "Find messages by words or @number"}};
+
+IUeGui::IListViewMode::Item toListItem(const SmsMessage& message)
+{
+    return {message.isSent ? "To: " + to_string(message.to) : "From: " + to_string(message.from), message.text};
+}
+
+}
+
 ConnectedState::ConnectedState(Context &context)
     : BaseState(context, "ConnectedState")
 {
@@ -21,8 +64,7 @@ void ConnectedState::handleDisconnected()
 void ConnectedState::handleSms(common::PhoneNumber from, const std::string& text)
 {
     logger.logInfo("Received SMS from: ", from, ", text: ", text);
-    auto& smsDb = SharedSmsDb::getInstance();
-    smsDb.addSms(from, text);
+    context.smsDb.addSms(from, text);
     refreshMessageIndicator();
 }
 
@@ -60,9 +102,10 @@ void ConnectedState::showMenuView()
     
     auto& listView = context.user.getListViewMode();
     listView.clearSelectionList();
-    listView.addSelectionListItem("Compose SMS", "Create a new SMS message");
-    listView.addSelectionListItem("View SMS", "View received messages");
-    listView.addSelectionListItem("Dial", "Make a call");
+    for (const auto& item : MENU_ITEMS)
+    {
+        listView.addSelectionListItem(item.label, item.tooltip);
+    }
     
     context.user.setAcceptCallback([this]() {
         auto selectedItem = context.user.getListViewMode().getCurrentItemIndex();
@@ -77,6 +120,9 @@ void ConnectedState::showMenuView()
                 case 2:  // Dial
                     handleDialClicked();
                     break;
+                case 3:  // Search SMS
+                    showSmsSearchView();
+                    break;
                 default:
                     break;
             }
@@ -88,40 +134,64 @@ void ConnectedState::showSmsListView()
 {
     context.user.showSmsListView();
     
-    auto& smsDb = SharedSmsDb::getInstance();
-    currentMessagesList = smsDb.getSmsMessages();
-    auto& menu = context.user.getListViewMode();
-    
-    for (size_t i = 0; i < currentMessagesList.size(); ++i)
+    auto& smsDb = context.smsDb;
+    const auto messages = smsDb.getSmsMessages();
+    shownMessagesCount = messages.size();
+
+    IUeGui::IListViewMode::Items items;
+    items.reserve(messages.size());
+    for (const auto& message : messages)
     {
-        const auto& message = currentMessagesList[i];
-        std::string label;
-        if (message.isSent) {
-            label = "To: " + to_string(message.to);
-        } else {
-            label = "From: " + to_string(message.from);
-        }
-        std::string tooltip = message.text;
-        menu.addSelectionListItem(label, tooltip);
-        
-        if (!message.isRead)
-        {
-            smsDb.markAsRead(i);
-        }
+        items.push_back(toListItem(message));
     }
+    context.user.getListViewMode().setSelectionList(std::move(items));
+    smsDb.markAllAsRead();
     
     context.user.setAcceptCallback([this]() {
         auto& listView = context.user.getListViewMode();
         auto selectedItem = listView.getCurrentItemIndex();
         
-        if (selectedItem.first && selectedItem.second < currentMessagesList.size()) {
-            showSmsView(currentMessagesList[selectedItem.second]);
+        if (selectedItem.first && selectedItem.second < shownMessagesCount) {
+            showSmsView(context.smsDb.at(selectedItem.second));
         }
     });
     
     refreshMessageIndicator();
 }
 
+void ConnectedState::showSmsSearchView()
+{
+    context.user.showSmsListView();
+    searchResults.clear();
+    context.user.getListViewMode().setSearchCallback([this](const std::string& query) {
+        showSearchResults(query);
+    });
+
+    context.user.setAcceptCallback([this]() {
+        auto selectedItem = context.user.getListViewMode().getCurrentItemIndex();
+        if (selectedItem.first && selectedItem.second < searchResults.size()) {
+            showSmsView(context.smsDb.at(searchResults[selectedItem.second]));
+        }
+    });
+}
+
+void ConnectedState::showSearchResults(const std::string& query)
+{
+    const auto [text, peer] = parseSearchQuery(query);
+    const auto found = context.smsDb.search(text, peer);
+    const std::size_t shown = std::min(found.size(), MAX_SEARCH_RESULTS);
+    searchResults.assign(found.rbegin(), found.rbegin() + shown);
+
+    IUeGui::IListViewMode::Items items;
+    items.reserve(searchResults.size());
+    for (auto index : searchResults)
+    {
+        items.push_back(toListItem(context.smsDb.at(index)));
+    }
+    context.user.getListViewMode().setSelectionList(std::move(items));
+    logger.logDebug("Search \"", query, "\": ", found.size(), " found");
+}
+
 void ConnectedState::showSmsComposerView()
 {
     context.user.showSmsComposerView();
@@ -144,8 +214,7 @@ void ConnectedState::handleSmsSend()
     
     context.bts.sendSms(recipient, text);
     
-    auto& smsDb = SharedSmsDb::getInstance();
-    smsDb.addSentSms(recipient, text);
+    context.smsDb.addSentSms(recipient, text);
     
     composeMode.clearSmsText();
     
@@ -176,8 +245,7 @@ void ConnectedState::showSmsView(const SmsMessage& message)
 
 void ConnectedState::refreshMessageIndicator()
 {
-    auto& smsDb = SharedSmsDb::getInstance();
-    bool hasUnread = smsDb.hasUnreadSms();
+    bool hasUnread = context.smsDb.hasUnreadSms();
     context.user.showNewSms(hasUnread);
 }
 
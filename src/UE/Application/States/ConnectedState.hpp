@@ -2,7 +2,6 @@
 
 #include "BaseState.hpp"
 #include "SmsDb.hpp"
-#include "SharedSmsDb.hpp"
 
 namespace ue
 {
@@ -22,16 +21,24 @@ public:
     void handleSmsComposeClicked() override;
     void handleSmsViewClicked() override;
     void handleDialClicked();
+
+    // newest first, at most that many shown
+    static constexpr std::size_t MAX_SEARCH_RESULTS = 100u;
     
 private:
     void showMenuView();
     void showSmsListView();
     void showSmsComposerView();
+    void showSmsSearchView();
+    void showSearchResults(const std::string& query);
     void showSmsView(const SmsMessage& message);
     void handleSmsSend();
     void refreshMessageIndicator();
     
-    std::vector<SmsMessage> currentMessagesList;
+    // messages in SmsDb never move - list shows first ones
+    std::size_t shownMessagesCount = 0u;
+    // SmsDb indices of shown search results
+    std::vector<std::size_t> searchResults;
 };
 
 }
\ No newline at end of file
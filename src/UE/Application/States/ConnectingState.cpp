@@ -1,4 +1,5 @@
 #include "ConnectingState.hpp"
+#include "Context.hpp"
 #include "ConnectedState.hpp"
 #include "NotConnectedState.hpp"
 
@@ -11,6 +12,15 @@ ConnectingState::ConnectingState(Context &context)
     context.user.showConnecting();
 }
 
+void ConnectingState::handleSib(common::BtsId btsId)
+{
+    // attach request sent right after reconnection might be lost - BTS sends Sib when it admits UE
+    logger.logDebug("Sib while attaching, attach request sent again: ", btsId);
+    using namespace std::chrono_literals;
+    context.timer.startTimer(500ms);
+    context.bts.sendAttachRequest(btsId);
+}
+
 void ConnectingState::handleAttachAccept()
 {
     context.timer.stopTimer();
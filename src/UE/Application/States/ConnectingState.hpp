@@ -11,6 +11,7 @@ public:
     ConnectingState(Context& context);
 
     // IBtsEventsHandler interface
+    void handleSib(common::BtsId btsId) override;
     void handleAttachAccept() override;
     void handleAttachReject() override;
 
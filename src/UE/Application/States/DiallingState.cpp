@@ -1,9 +1,9 @@
 #include "DiallingState.hpp"
+#include "Context.hpp"
 #include "ConnectedState.hpp"
 #include "TalkingState.hpp"
 #include "NotConnectedState.hpp"
 #include "SmsDb.hpp"
-#include "SharedSmsDb.hpp"
 #include <sstream>
 #include <cstdlib>
 
@@ -12,6 +12,12 @@ namespace ue
 
 const std::chrono::milliseconds DiallingState::CALL_TIMEOUT{60000}; // 60 seconds timeout
 
+namespace
+{
+// built once - not on each dial
+const std::string DIAL_PROMPT = "Enter phone number to call\nThen press green button to dial";
+}
+
 DiallingState::DiallingState(Context &context)
     : BaseState(context, "DiallingState")
 {
@@ -29,7 +35,7 @@ DiallingState::~DiallingState()
 void DiallingState::showDialView()
 {
     auto& textMode = context.user.showViewTextMode();
-    textMode.setText("Enter phone number to call\nThen press green button to dial");
+    textMode.setText(DIAL_PROMPT);
 
     auto& callMode = context.user.setCallMode();
     
@@ -141,8 +147,7 @@ void DiallingState::handleSms(common::PhoneNumber from, const std::string& text)
 {
     logger.logInfo("Received SMS during dialling from: ", from, ", text: ", text);
 
-    auto& smsDb = SharedSmsDb::getInstance();
-    smsDb.addSms(from, text);
+    context.smsDb.addSms(from, text);
     
     context.user.showNewSms(true);
 }
@@ -1,4 +1,5 @@
 #include "NotConnectedState.hpp"
+#include "Context.hpp"
 #include "ConnectingState.hpp"
 
 namespace ue
@@ -1,8 +1,8 @@
 #include "ReceivingCallState.hpp"
+#include "Context.hpp"
 #include "ConnectedState.hpp"
 #include "TalkingState.hpp"
 #include "SmsDb.hpp"
-#include "SharedSmsDb.hpp"
 
 namespace ue
 {
@@ -71,8 +71,7 @@ void ReceivingCallState::rejectCall()
 void ReceivingCallState::handleSms(common::PhoneNumber from, const std::string& text)
 {
     logger.logInfo("Received SMS during incoming call from: ", from, ", text: ", text);
-    auto& smsDb = SharedSmsDb::getInstance();
-    smsDb.addSms(from, text);
+    context.smsDb.addSms(from, text);
 
     context.user.showNewSms(true);
 }
@@ -1,7 +1,8 @@
 #include "TalkingState.hpp"
+#include "Context.hpp"
 #include "ConnectedState.hpp"
+#include "ConferenceState.hpp"
 #include "SmsDb.hpp"
-#include "SharedSmsDb.hpp"
 
 namespace ue
 {
@@ -14,22 +15,74 @@ TalkingState::TalkingState(Context &context, common::PhoneNumber peer)
     auto& callMode = context.user.setCallMode();
     callMode.clearIncomingText();
     callMode.clearOutgoingText();
-    
+    setCallbacks();
+}
+
+TalkingState::TalkingState(Context &context, common::PhoneNumber peer, const char* name)
+    : BaseState(context, name),
+      peerPhoneNumber(peer)
+{
+    setCallbacks();
+}
+
+void TalkingState::setCallbacks()
+{
     context.user.setAcceptCallback([this]() {
-        const std::string text = this->context.user.setCallMode().getOutgoingText();
+        auto& callMode = this->context.user.setCallMode();
+        const std::string text = callMode.getOutgoingText();
         if (!text.empty()) {
             this->context.bts.sendCallTalk(peerPhoneNumber, text);
-            this->context.user.setCallMode().clearOutgoingText();
+            callMode.clearOutgoingText();
+        } else {
+            inviteToConference(callMode.getInviteePhoneNumber());
         }
     });
     
     context.user.setRejectCallback([this]() {
         logger.logInfo("Call dropped");
-        this->context.bts.sendCallDropped(peerPhoneNumber);
+        this->context.bts.sendCallDropped(hangUpPeer());
         this->context.setState<ConnectedState>();
     });
 }
 
+bool TalkingState::canInvite() const
+{
+    return true;
+}
+
+common::PhoneNumber TalkingState::hangUpPeer() const
+{
+    return peerPhoneNumber;
+}
+
+void TalkingState::inviteToConference(common::PhoneNumber invitee)
+{
+    if (not invitee.isValid() or invitee == peerPhoneNumber) {
+        return;
+    }
+    if (not canInvite()) {
+        logger.logInfo("Only host invites to conference, not invited: ", invitee);
+        return;
+    }
+    logger.logInfo("Inviting to conference: ", invitee);
+    context.bts.sendConferenceInvite(invitee);
+}
+
+void TalkingState::handleCallAccepted(common::PhoneNumber from)
+{
+    // invitee joins - BTS sends new members to everybody
+    logger.logInfo("Conference invite accepted by: ", from);
+}
+
+void TalkingState::handleConferenceMembers(const std::vector<common::PhoneNumber>& members)
+{
+    if (members.size() < 2u) {
+        logger.logError("Conference of ", members.size(), " members ignored, still talking with: ", peerPhoneNumber);
+        return;
+    }
+    context.setState<ConferenceState>(peerPhoneNumber, members);
+}
+
 void TalkingState::handleDisconnected()
 {
     context.setState<ConnectedState>();
@@ -55,7 +108,7 @@ void TalkingState::handleCallTalk(common::PhoneNumber from, const std::string& t
 void TalkingState::handleHomeClicked()
 {
     logger.logInfo("Call dropped due to home button");
-    context.bts.sendCallDropped(peerPhoneNumber);
+    context.bts.sendCallDropped(hangUpPeer());
     context.setState<ConnectedState>();
 }
 
@@ -69,8 +122,7 @@ void TalkingState::handleSms(common::PhoneNumber from, const std::string& text)
     logger.logInfo("Received SMS during active call from: ", from, ", text: ", text);
     
 
-    auto& smsDb = SharedSmsDb::getInstance();
-    smsDb.addSms(from, text);
+    context.smsDb.addSms(from, text);
     
     context.user.showNewSms(true);
 }
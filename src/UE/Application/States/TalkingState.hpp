@@ -16,12 +16,23 @@ public:
     void handleCallTalk(common::PhoneNumber from, const std::string& text) override;
     void handleSms(common::PhoneNumber from, const std::string& text) override;
     void handleCallRequest(common::PhoneNumber from) override;
+    void handleCallAccepted(common::PhoneNumber from) override;
+    void handleConferenceMembers(const std::vector<common::PhoneNumber>& members) override;
     // IUserEventsHandler interface
     void handleHomeClicked() override;
     
-private:
+protected:
+    // for ConferenceState - keeps call view as it is
+    TalkingState(Context& context, common::PhoneNumber peer, const char* name);
+
+    virtual bool canInvite() const;
+    virtual common::PhoneNumber hangUpPeer() const;
+
     common::PhoneNumber peerPhoneNumber;
-    
+
+private:
+    void setCallbacks();
+    void inviteToConference(common::PhoneNumber invitee);
     void showConnectedView();
 };
 
@@ -0,0 +1,64 @@
+#include "ApplicationEnvironmentSetup.hpp"
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+namespace ue
+{
+
+std::unique_ptr<common::MultiLineConfig> readConfiguration(int argc, char* argv[])
+{
+    auto commandLineConfig = std::make_unique<common::MultiLineConfig>(argc - 1, argv + 1);
+
+    std::string configFile = commandLineConfig->getString("config", "config");
+
+    try
+    {
+        std::ifstream configStream;
+        configStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        configStream.open(configFile);
+
+        common::MultiLineConfig fileConfig(configStream);
+        commandLineConfig->insertFrom(fileConfig);
+    }
+    catch (...)
+    {
+        std::clog << "Note: config file: \"" << configFile << "\" is not present or reading failure.\n\t((only command line arguments are used))" << std::endl;
+    }
+    return commandLineConfig;
+}
+
+std::string logFilename(PhoneNumber phoneNumber)
+{
+    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    auto localNow = localtime(&now);
+    char timeBuff[20];
+    strftime(timeBuff, sizeof(timeBuff), "%Y%m%d%H%M%S", localNow);
+
+    std::ostringstream os;
+    os << "ue" << phoneNumber << "_syslog_" << timeBuff << ".txt";
+    return os.str();
+}
+
+std::string logPrefix(PhoneNumber phoneNumber)
+{
+    return " [phone:" + to_string(phoneNumber) + "]";
+}
+
+std::size_t residentMemoryKiB()
+{
+    // sizes in pages: total resident ...
+    std::ifstream statm("/proc/self/statm");
+    std::size_t totalPages = 0u;
+    std::size_t residentPages = 0u;
+    if (not (statm >> totalPages >> residentPages))
+    {
+        return 0u;
+    }
+    return residentPages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE)) / 1024u;
+}
+
+}
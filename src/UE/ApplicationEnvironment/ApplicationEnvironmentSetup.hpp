@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Config/MultiLineConfig.hpp"
+#include "Messages/PhoneNumber.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ue
+{
+
+using common::PhoneNumber;
+
+/**
+ * Command line arguments, completed by config file given by "config" argument (default: "config").
+ */
+std::unique_ptr<common::MultiLineConfig> readConfiguration(int argc, char* argv[]);
+// unique per UE and start time
+std::string logFilename(PhoneNumber phoneNumber);
+std::string logPrefix(PhoneNumber phoneNumber);
+// of this process, 0 when not known (only Linux /proc supported)
+std::size_t residentMemoryKiB();
+
+}
@@ -0,0 +1,340 @@
+#include "ConsoleUeGui.hpp"
+#include <charconv>
+#include <ostream>
+#include <utility>
+
+namespace ue
+{
+
+namespace
+{
+
+bool parseNumber(const std::string& text, unsigned long& value)
+{
+    const auto end = text.data() + text.size();
+    auto [last, error] = std::from_chars(text.data(), end, value);
+    return error == std::errc{} and last == end;
+}
+
+}
+
+ConsoleUeGui::ConsoleUeGui(std::ostream& output)
+    : output(output)
+{}
+
+bool ConsoleUeGui::execute(const std::string& commandLine)
+{
+    if (commandLine.empty() or commandLine.front() == '#')
+    {
+        return true;
+    }
+    const auto separator = commandLine.find(' ');
+    const std::string command = commandLine.substr(0, separator);
+    const std::string argument = separator == std::string::npos ? std::string{} : commandLine.substr(separator + 1);
+
+    unsigned long number = 0u;
+    if (command == "accept")
+    {
+        call(acceptCallback);
+    }
+    else if (command == "reject")
+    {
+        call(rejectCallback);
+    }
+    else if (command == "home")
+    {
+        call(homeCallback);
+    }
+    else if (command == "number")
+    {
+        if (not parseNumber(argument, number) or number < PhoneNumber::MIN_VALUE or number > PhoneNumber::MAX_VALUE)
+        {
+            print("error", "wrong phone number: " + argument);
+            return true;
+        }
+        phoneNumber = PhoneNumber{static_cast<PhoneNumber::Value>(number)};
+    }
+    else if (command == "text")
+    {
+        text = argument;
+    }
+    else if (command == "select")
+    {
+        if (not parseNumber(argument, number))
+        {
+            print("error", "wrong index: " + argument);
+            return true;
+        }
+        listViewMode.select(static_cast<IListViewMode::Selection>(number));
+    }
+    else if (command == "search")
+    {
+        listViewMode.search(argument);
+    }
+    else if (command == "quit")
+    {
+        if (not closeGuard or closeGuard())
+        {
+            print("quit");
+            return false;
+        }
+    }
+    else
+    {
+        print("error", "unknown command: " + command);
+    }
+    return true;
+}
+
+void ConsoleUeGui::setCloseGuard(CloseGuard newCloseGuard)
+{
+    closeGuard = std::move(newCloseGuard);
+}
+
+void ConsoleUeGui::setAcceptCallback(Callback callback)
+{
+    acceptCallback = std::move(callback);
+}
+
+void ConsoleUeGui::setRejectCallback(Callback callback)
+{
+    rejectCallback = std::move(callback);
+}
+
+void ConsoleUeGui::setHomeCallback(Callback callback)
+{
+    homeCallback = std::move(callback);
+}
+
+void ConsoleUeGui::setTitle(const std::string& title)
+{
+    print("title", title);
+}
+
+void ConsoleUeGui::showConnected()
+{
+    setAlertMode().setText("Connected");
+    print("status", "connected");
+}
+
+void ConsoleUeGui::showConnecting()
+{
+    setAlertMode().setText("Connecting");
+    print("status", "connecting");
+}
+
+void ConsoleUeGui::showNotConnected()
+{
+    setAlertMode().setText("Not connected");
+    print("status", "not connected");
+}
+
+void ConsoleUeGui::showNewSms(bool present)
+{
+    print("sms", present ? "new" : "none");
+}
+
+void ConsoleUeGui::showPeerUserNotAvailable(PhoneNumber peer)
+{
+    setAlertMode().setText("Not available: " + to_string(peer));
+}
+
+template <typename Mode>
+Mode& ConsoleUeGui::activateMode(Mode& mode, const char* name)
+{
+    print("mode", name);
+    return mode;
+}
+
+IUeGui::IListViewMode& ConsoleUeGui::setListViewMode()
+{
+    return activateMode(listViewMode, "list");
+}
+
+IUeGui::ISmsComposeMode& ConsoleUeGui::setSmsComposeMode()
+{
+    return activateMode(smsComposeMode, "sms compose");
+}
+
+IUeGui::IDialMode& ConsoleUeGui::setDialMode()
+{
+    return activateMode(dialMode, "dial");
+}
+
+IUeGui::ICallMode& ConsoleUeGui::setCallMode()
+{
+    return activateMode(callMode, "call");
+}
+
+IUeGui::ITextMode& ConsoleUeGui::setAlertMode()
+{
+    return activateMode(alertMode, "alert");
+}
+
+IUeGui::ITextMode& ConsoleUeGui::setViewTextMode()
+{
+    return activateMode(textViewMode, "view text");
+}
+
+void ConsoleUeGui::print(const std::string& what, const std::string& value)
+{
+    output << what;
+    if (not value.empty())
+    {
+        output << ' ';
+        for (char c : value)
+        {
+            if (c == '\n')
+            {
+                output << "\\n";
+            }
+            else
+            {
+                output << c;
+            }
+        }
+    }
+    // flushed - read line by line by driving script
+    output << std::endl;
+}
+
+void ConsoleUeGui::call(const Callback& callback)
+{
+    if (callback)
+    {
+        callback();
+    }
+}
+
+ConsoleUeGui::ListViewMode::ListViewMode(ConsoleUeGui& gui)
+    : gui(gui)
+{}
+
+IUeGui::IListViewMode::OptionalSelection ConsoleUeGui::ListViewMode::getCurrentItemIndex() const
+{
+    return current;
+}
+
+void ConsoleUeGui::ListViewMode::addSelectionListItem(const std::string& label, const std::string&)
+{
+    gui.print("item " + std::to_string(size++), label);
+}
+
+void ConsoleUeGui::ListViewMode::clearSelectionList()
+{
+    size = 0u;
+    current = {false, 0u};
+    gui.print("clear", "list");
+}
+
+void ConsoleUeGui::ListViewMode::setSelectionList(Items items)
+{
+    clearSelectionList();
+    for (const auto& item : items)
+    {
+        addSelectionListItem(item.label, item.tooltip);
+    }
+}
+
+void ConsoleUeGui::ListViewMode::setSearchCallback(SearchCallback callback)
+{
+    searchCallback = std::move(callback);
+}
+
+void ConsoleUeGui::ListViewMode::select(Selection selection)
+{
+    if (selection >= size)
+    {
+        gui.print("error", "no item " + std::to_string(selection));
+        return;
+    }
+    current = {true, selection};
+}
+
+void ConsoleUeGui::ListViewMode::search(const std::string& query)
+{
+    if (not searchCallback)
+    {
+        gui.print("error", "no search");
+        return;
+    }
+    searchCallback(query);
+}
+
+ConsoleUeGui::SmsComposeMode::SmsComposeMode(ConsoleUeGui& gui)
+    : gui(gui)
+{}
+
+PhoneNumber ConsoleUeGui::SmsComposeMode::getPhoneNumber() const
+{
+    return gui.phoneNumber;
+}
+
+std::string ConsoleUeGui::SmsComposeMode::getSmsText() const
+{
+    return gui.text;
+}
+
+void ConsoleUeGui::SmsComposeMode::clearSmsText()
+{
+    gui.text.clear();
+}
+
+ConsoleUeGui::DialMode::DialMode(ConsoleUeGui& gui)
+    : gui(gui)
+{}
+
+PhoneNumber ConsoleUeGui::DialMode::getPhoneNumber() const
+{
+    return gui.phoneNumber;
+}
+
+ConsoleUeGui::CallMode::CallMode(ConsoleUeGui& gui)
+    : gui(gui)
+{}
+
+void ConsoleUeGui::CallMode::appendIncomingText(const std::string& text)
+{
+    gui.print("talk", text);
+}
+
+void ConsoleUeGui::CallMode::clearIncomingText()
+{
+    gui.print("clear", "talk");
+}
+
+void ConsoleUeGui::CallMode::clearOutgoingText()
+{
+    gui.text.clear();
+}
+
+std::string ConsoleUeGui::CallMode::getOutgoingText() const
+{
+    return gui.text;
+}
+
+PhoneNumber ConsoleUeGui::CallMode::getInviteePhoneNumber() const
+{
+    return gui.phoneNumber;
+}
+
+void ConsoleUeGui::CallMode::showParticipants(const std::vector<PhoneNumber>& participants)
+{
+    std::string text;
+    for (auto participant : participants)
+    {
+        text += (text.empty() ? "" : " ") + to_string(participant);
+    }
+    gui.print("participants", text);
+}
+
+ConsoleUeGui::TextMode::TextMode(ConsoleUeGui& gui)
+    : gui(gui)
+{}
+
+void ConsoleUeGui::TextMode::setText(const std::string& text)
+{
+    gui.print("text", text);
+}
+
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "IUeGui.hpp"
+#include "UeGui/IListViewMode.hpp"
+#include "UeGui/ISmsComposeMode.hpp"
+#include "UeGui/IDialMode.hpp"
+#include "UeGui/ICallMode.hpp"
+#include "UeGui/ITextMode.hpp"
+#include <iosfwd>
+#include <string>
+
+namespace ue
+{
+
+/**
+ * IUeGui without any widgets - for automated (e.g. soak) tests of many UEs.
+ *
+ * What UE shows is written to output, one line per change, e.g. "mode alert", "text Connected",
+ * "clear list", "item 0 <label>", "talk <text>".
+ * Input is given by commands, one per line (see execute):
+ *   accept | reject | home       - buttons
+ *   number <phone>               - phone number field (dial, SMS recipient, conference invitee)
+ *   text <text>                  - text field (SMS text, call talk)
+ *   select <index>               - current item of list
+ *   search <query>               - search field of list
+ *   quit                         - as closing window
+ * Empty lines and lines starting with # are skipped.
+ */
+class ConsoleUeGui : public IUeGui
+{
+public:
+    explicit ConsoleUeGui(std::ostream& output);
+
+    /**
+     * Returns false when quit was accepted by close guard - no more commands expected then.
+     */
+    bool execute(const std::string& commandLine);
+
+    void setCloseGuard(CloseGuard closeGuard) override;
+    void setAcceptCallback(Callback) override;
+    void setRejectCallback(Callback) override;
+    void setHomeCallback(Callback) override;
+
+    void setTitle(const std::string& title) override;
+    void showConnected() override;
+    void showConnecting() override;
+    void showNotConnected() override;
+    void showNewSms(bool present) override;
+    void showPeerUserNotAvailable(PhoneNumber peer) override;
+
+    IListViewMode& setListViewMode() override;
+    ISmsComposeMode& setSmsComposeMode() override;
+    IDialMode& setDialMode() override;
+    ICallMode& setCallMode() override;
+    ITextMode& setAlertMode() override;
+    ITextMode& setViewTextMode() override;
+
+private:
+    class ListViewMode : public IListViewMode
+    {
+    public:
+        explicit ListViewMode(ConsoleUeGui& gui);
+        OptionalSelection getCurrentItemIndex() const override;
+        void addSelectionListItem(const std::string& label, const std::string& tooltip) override;
+        void clearSelectionList() override;
+        void setSelectionList(Items items) override;
+        void setSearchCallback(SearchCallback) override;
+
+        void select(Selection selection);
+        void search(const std::string& query);
+
+    private:
+        ConsoleUeGui& gui;
+        Selection size = 0u;
+        OptionalSelection current{false, 0u};
+        SearchCallback searchCallback;
+    };
+
+    class SmsComposeMode : public ISmsComposeMode
+    {
+    public:
+        explicit SmsComposeMode(ConsoleUeGui& gui);
+        PhoneNumber getPhoneNumber() const override;
+        std::string getSmsText() const override;
+        void clearSmsText() override;
+
+    private:
+        ConsoleUeGui& gui;
+    };
+
+    class DialMode : public IDialMode
+    {
+    public:
+        explicit DialMode(ConsoleUeGui& gui);
+        PhoneNumber getPhoneNumber() const override;
+
+    private:
+        ConsoleUeGui& gui;
+    };
+
+    class CallMode : public ICallMode
+    {
+    public:
+        explicit CallMode(ConsoleUeGui& gui);
+        void appendIncomingText(const std::string &text) override;
+        void clearIncomingText() override;
+        void clearOutgoingText() override;
+        std::string getOutgoingText() const override;
+        PhoneNumber getInviteePhoneNumber() const override;
+        void showParticipants(const std::vector<PhoneNumber>& participants) override;
+
+    private:
+        ConsoleUeGui& gui;
+    };
+
+    class TextMode : public ITextMode
+    {
+    public:
+        explicit TextMode(ConsoleUeGui& gui);
+        void setText(const std::string& text) override;
+
+    private:
+        ConsoleUeGui& gui;
+    };
+
+    template <typename Mode>
+    Mode& activateMode(Mode& mode, const char* name);
+    // single line per output - line breaks of texts escaped
+    void print(const std::string& what, const std::string& value = {});
+    static void call(const Callback& callback);
+
+    std::ostream& output;
+    CloseGuard closeGuard;
+    Callback acceptCallback;
+    Callback rejectCallback;
+    Callback homeCallback;
+
+    // input fields, shared by modes as in graphical UE
+    PhoneNumber phoneNumber{};
+    std::string text;
+
+    ListViewMode listViewMode{*this};
+    SmsComposeMode smsComposeMode{*this};
+    DialMode dialMode{*this};
+    CallMode callMode{*this};
+    TextMode alertMode{*this};
+    TextMode textViewMode{*this};
+};
+
+}
@@ -4,6 +4,7 @@
 #include "ITransport.hpp"
 #include "Logger/Logger.hpp"
 #include "Messages/PhoneNumber.hpp"
+#include "Config/MultiLineConfig.hpp"
 
 namespace ue
 {
@@ -24,6 +25,7 @@ public:
     virtual PhoneNumber getMyPhoneNumber() const = 0;
 
     virtual std::int32_t getProperty(std::string const& name, std::int32_t defaultValue) const = 0;
+    virtual const common::MultiLineConfig& getConfiguration() const = 0;
 };
 
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "IUeGui.hpp"
+#include "Messages/PhoneNumber.hpp"
+#include <vector>
 
 namespace ue
 {
@@ -14,6 +16,8 @@ public:
     virtual void clearIncomingText() = 0;
     virtual void clearOutgoingText() = 0;
     virtual std::string getOutgoingText() const = 0;
+    virtual PhoneNumber getInviteePhoneNumber() const = 0;
+    virtual void showParticipants(const std::vector<PhoneNumber>& participants) = 0;
 };
 
 }
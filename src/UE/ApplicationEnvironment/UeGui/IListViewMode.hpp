@@ -1,7 +1,10 @@
 #pragma once
 
 #include "IUeGui.hpp"
+#include <functional>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace ue
 {
@@ -11,12 +14,31 @@ class IUeGui::IListViewMode
 public:
     using Selection = unsigned;
     using OptionalSelection = std::pair<bool,Selection>;
+    using SearchCallback = std::function<void(const std::string& query)>;
+
+    struct Item
+    {
+        std::string label;
+        std::string tooltip;
+
+        bool operator==(const Item&) const = default;
+    };
+    using Items = std::vector<Item>;
 
     virtual ~IListViewMode() = default;
 
     virtual OptionalSelection getCurrentItemIndex() const = 0;
     virtual void addSelectionListItem(const std::string& label, const std::string& tooltip) = 0;
     virtual void clearSelectionList() = 0;
+    /**
+     * Replaces whole list at once - for long lists, instead of adding items one by one.
+     * Items are moved to the view, not copied.
+     */
+    virtual void setSelectionList(Items items) = 0;
+    /**
+     * Search field above the list, callback called on each edit of it. Empty callback hides the field.
+     */
+    virtual void setSearchCallback(SearchCallback) = 0;
 };
 
 }
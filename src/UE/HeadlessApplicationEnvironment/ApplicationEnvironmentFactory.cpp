@@ -0,0 +1,12 @@
+#include "ApplicationEnvironmentFactory.hpp"
+#include "HeadlessApplicationEnvironment.hpp"
+
+namespace ue
+{
+
+std::unique_ptr<IApplicationEnvironment> createApplicationEnvironment(int &argc, char* argv[])
+{
+    return std::make_unique<HeadlessApplicationEnvironment>(argc, argv);
+}
+
+}
@@ -0,0 +1,102 @@
+#include "HeadlessApplicationEnvironment.hpp"
+#include "ApplicationEnvironmentSetup.hpp"
+#include "Transport/TransportFactory.hpp"
+#include <cerrno>
+#include <iostream>
+#include <unistd.h>
+
+namespace ue
+{
+
+HeadlessApplicationEnvironment::HeadlessApplicationEnvironment(int& argc, char* argv[])
+    : configuration(readConfiguration(argc, argv)),
+      myPhoneNumber(PhoneNumber{configuration->getNumber<decltype(PhoneNumber::value)>("phone", 123)}),
+      logFile(logFilename(myPhoneNumber)),
+      loggerBase(logFile),
+      logger(loggerBase, logPrefix(myPhoneNumber)),
+      qApplication(argc, argv),
+      gui(std::cout),
+      transport(createTransport(*configuration, logger)),
+      commandNotifier(STDIN_FILENO, QSocketNotifier::Read)
+{
+    QObject::connect(&commandNotifier, &QSocketNotifier::activated, &qApplication, [this] { readCommands(); });
+}
+
+ue::IUeGui& HeadlessApplicationEnvironment::getUeGui()
+{
+    return gui;
+}
+
+ue::ITransport& HeadlessApplicationEnvironment::getTransportToBts()
+{
+    return *transport;
+}
+
+ILogger &HeadlessApplicationEnvironment::getLogger()
+{
+    return logger;
+}
+
+void HeadlessApplicationEnvironment::startMessageLoop()
+{
+    qApplication.exec();
+}
+
+void HeadlessApplicationEnvironment::readCommands()
+{
+    char buffer[4096];
+    const auto count = ::read(STDIN_FILENO, buffer, sizeof(buffer));
+    if (count < 0 and (errno == EINTR or errno == EAGAIN))
+    {
+        return;
+    }
+    if (count <= 0)
+    {
+        logger.logInfo("No more commands");
+        stopReadingCommands();
+        return;
+    }
+    pendingCommand.append(buffer, static_cast<std::size_t>(count));
+
+    std::size_t begin = 0u;
+    for (auto end = pendingCommand.find('\n'); end != std::string::npos; end = pendingCommand.find('\n', begin))
+    {
+        auto command = pendingCommand.substr(begin, end - begin);
+        begin = end + 1u;
+        if (not command.empty() and command.back() == '\r')
+        {
+            command.pop_back();
+        }
+        logger.logDebug("Command: ", command);
+        if (not gui.execute(command))
+        {
+            stopReadingCommands();
+            qApplication.quit();
+            return;
+        }
+    }
+    pendingCommand.erase(0u, begin);
+}
+
+void HeadlessApplicationEnvironment::stopReadingCommands()
+{
+    commandNotifier.setEnabled(false);
+    pendingCommand.clear();
+}
+
+PhoneNumber HeadlessApplicationEnvironment::getMyPhoneNumber() const
+{
+    return myPhoneNumber;
+}
+
+std::int32_t HeadlessApplicationEnvironment::getProperty(std::string const& name, std::int32_t defaultValue) const
+{
+    return configuration->getNumber<std::int32_t>(name, defaultValue);
+}
+
+const common::MultiLineConfig& HeadlessApplicationEnvironment::getConfiguration() const
+{
+    return *configuration;
+}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "IApplicationEnvironment.hpp"
+#include "Console/ConsoleUeGui.hpp"
+#include "Logger/Logger.hpp"
+#include "Logger/PrefixedLogger.hpp"
+#include "Config/MultiLineConfig.hpp"
+#include <QCoreApplication>
+#include <QSocketNotifier>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace ue
+{
+
+/**
+ * UE without windows (QtCore and QtNetwork only) - GUI is ConsoleUeGui on standard input/output.
+ * Commands are read while standard input is open, UE keeps working after its end
+ * (e.g. started with </dev/null), until "quit" command or signal.
+ */
+class HeadlessApplicationEnvironment : public IApplicationEnvironment
+{
+public:
+    HeadlessApplicationEnvironment(int &argc, char* argv[]);
+    IUeGui& getUeGui() override;
+    ITransport& getTransportToBts() override;
+    ILogger& getLogger() override;
+    PhoneNumber getMyPhoneNumber() const override;
+    std::int32_t getProperty(std::string const& name, std::int32_t defaultValue) const override;
+    const common::MultiLineConfig& getConfiguration() const override;
+
+    void startMessageLoop() override;
+
+private:
+    void readCommands();
+    void stopReadingCommands();
+
+    std::unique_ptr<common::MultiLineConfig> configuration;
+    PhoneNumber myPhoneNumber;
+    std::ofstream logFile;
+    common::Logger loggerBase;
+    common::PrefixedLogger logger;
+
+    QCoreApplication qApplication;
+    ConsoleUeGui gui;
+    std::unique_ptr<ITransport> transport;
+    QSocketNotifier commandNotifier;
+    // till end of line
+    std::string pendingCommand;
+};
+
+}
@@ -1,46 +1,21 @@
 #include <ApplicationEnvironment.hpp>
-#include <string>
+#include "ApplicationEnvironmentSetup.hpp"
+#include <QTimer>
 #include <iostream>
-#include <chrono>
-#include <ctime>
-#include <iomanip>
-#include <fstream>
-#include "Messages.hpp"
 
 namespace ue
 {
 
-namespace
-{
-
-std::string getPhoneNumberPrefix(PhoneNumber const& phoneNumber)
-{
-    return " [phone:" + to_string(phoneNumber) + "]";
-}
-
-std::string logFilename(PhoneNumber phoneNumber)
-{
-    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-    auto localNow = localtime(&now);
-    char timeBuff[20];
-    strftime(timeBuff, sizeof(timeBuff), "%Y%m%d%H%M%S", localNow);
-
-    std::ostringstream os;
-    os << "ue" << phoneNumber << "_syslog_" << timeBuff << ".txt";
-    return os.str();
-}
-
-} // namespace
-
 ApplicationEnvironment::ApplicationEnvironment(int& argc, char* argv[])
-    : configuration(ApplicationEnvironment::readConfiguration(argc, argv)),
+    : startTime(std::chrono::steady_clock::now()),
+      configuration(readConfiguration(argc, argv)),
       myPhoneNumber(PhoneNumber{configuration->getNumber<decltype(PhoneNumber::value)>("phone", 123)}),
       logFile(logFilename(myPhoneNumber)),
       loggerBase(logFile),
-      logger(loggerBase, getPhoneNumberPrefix(myPhoneNumber)),
+      logger(loggerBase, logPrefix(myPhoneNumber)),
       qApplication(argc, argv),
       gui(logger),
-      transport(*configuration, logger)
+      transport(createTransport(*configuration, logger))
 {
 }
 
@@ -51,7 +26,7 @@ ue::IUeGui& ApplicationEnvironment::getUeGui()
 
 ue::ITransport& ApplicationEnvironment::getTransportToBts()
 {
-    return transport;
+    return *transport;
 }
 
 ILogger &ApplicationEnvironment::getLogger()
@@ -61,30 +36,23 @@ ILogger &ApplicationEnvironment::getLogger()
 
 void ApplicationEnvironment::startMessageLoop()
 {
-    gui.start();
+    gui.start([this] { reportFirstFrame(); });
     qApplication.exec();
 }
 
-std::unique_ptr<common::MultiLineConfig> ApplicationEnvironment::readConfiguration(int argc, char *argv[])
+void ApplicationEnvironment::reportFirstFrame()
 {
-    auto commandLineConfig = std::make_unique<common::MultiLineConfig>(argc - 1, argv + 1);
-
-    std::string configFile = commandLineConfig->getString("config", "config");
-
-    try
-    {
-        std::ifstream configStream;
-        configStream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-        configStream.open(configFile);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+    const auto residentKiB = residentMemoryKiB();
+    logger.logInfo("First frame after ", elapsed.count(), " ms, resident memory: ", residentKiB, " KiB");
 
-        common::MultiLineConfig fileConfig(configStream);
-        commandLineConfig->insertFrom(fileConfig);
-    }
-    catch (...)
+    // startup benchmark: e.g. "UE startupBenchmark=1", run repeatedly
+    if (getProperty("startupBenchmark", 0) != 0)
     {
-        std::clog << "Note: config file: \"" << configFile << "\" is not present or reading failure.\n\t((only command line arguments are used))" << std::endl;
+        std::cout << "time-to-first-frame-ms " << elapsed.count()
+                  << " resident-memory-kib " << residentKiB << std::endl;
+        QTimer::singleShot(0, &qApplication, &QCoreApplication::quit);
     }
-    return commandLineConfig;
 }
 
 PhoneNumber ApplicationEnvironment::getMyPhoneNumber() const
@@ -97,4 +65,9 @@ std::int32_t ApplicationEnvironment::getProperty(std::string const& name, std::i
     return configuration->getNumber<std::int32_t>(name, defaultValue);
 }
 
+const common::MultiLineConfig& ApplicationEnvironment::getConfiguration() const
+{
+    return *configuration;
+}
+
 }
@@ -2,11 +2,12 @@
 
 #include "IApplicationEnvironment.hpp"
 #include "GUI/QtApplication.hpp"
-#include "Transport/Transport.hpp"
+#include "Transport/TransportFactory.hpp"
 #include <QApplication>
 #include "Logger/Logger.hpp"
 #include "Logger/PrefixedLogger.hpp"
 #include "Config/MultiLineConfig.hpp"
+#include <chrono>
 #include <fstream>
 
 namespace ue
@@ -21,10 +22,15 @@ public:
     ILogger& getLogger() override;
     PhoneNumber getMyPhoneNumber() const override;
     std::int32_t getProperty(std::string const& name, std::int32_t defaultValue) const override;
+    const common::MultiLineConfig& getConfiguration() const override;
 
     void startMessageLoop() override;
 
 private:
+    void reportFirstFrame();
+
+    // first - to measure whole startup
+    std::chrono::steady_clock::time_point startTime;
     std::unique_ptr<common::MultiLineConfig> configuration;
     PhoneNumber myPhoneNumber;
     std::ofstream logFile;
@@ -33,11 +39,7 @@ private:
 
     QApplication qApplication;
     QtUeGui gui;
-    Transport transport;
-
-    static std::unique_ptr<common::MultiLineConfig> readConfiguration(int argc, char* argv[]);
-
-
+    std::unique_ptr<ITransport> transport;
 };
 
 }
@@ -1,5 +1,8 @@
 #include "QtCallMode.hpp"
 
+#include <QScrollBar>
+#include <QTextCursor>
+
 namespace ue
 {
 
@@ -12,6 +15,7 @@ QtCallMode::QtCallMode(QtPhoneNumberEdit &phoneNumberEdit, QtStackedWidget &stac
 
 void QtCallMode::constructGUI()
 {
+    addChildWidget(&participantsLabel);
     addChildWidget(&outgoingTextEdit);
     addChildWidget(&incomingTextEdit);
 
@@ -20,7 +24,14 @@ void QtCallMode::constructGUI()
     incomingTextEdit.setText("Incoming text");
     //
     incomingTextEdit.setReadOnly(true);
+    incomingTextEdit.setUndoRedoEnabled(false);
+    incomingTextEdit.document()->setMaximumBlockCount(MAX_TALK_HISTORY_LINES);
+
+    talkTextFlushTimer.setSingleShot(true);
+    talkTextFlushTimer.setInterval(FRAME_INTERVAL_MS);
 
+    // visible only in conference
+    participantsLabel.hide();
     incomingTextEdit.show();
     outgoingTextEdit.show();
 }
@@ -28,14 +39,18 @@ void QtCallMode::constructGUI()
 void QtCallMode::connectSignals()
 {
     connect(&outgoingTextEdit, &QtSubmitTextEdit::submitted, [this](){ emit textEntered();});
-    connect(this,SIGNAL(appendTalkTextSignal(QString)),this,SLOT(appendTalkTextSlot(QString)));
+    connect(this,SIGNAL(talkTextPendingSignal()),this,SLOT(talkTextPendingSlot()));
+    connect(&talkTextFlushTimer,SIGNAL(timeout()),this,SLOT(flushTalkTextSlot()));
     connect(this,SIGNAL(activateForDialModeSignal()),this,SLOT(activateForDialModeSlot()));
+    connect(this,SIGNAL(showParticipantsSignal(QString)),this,SLOT(showParticipantsSlot(QString)));
 }
 
 void QtCallMode::activateSlot()
 {
     outgoingTextEdit.setEnabled(true);
-    activateWithPhoneNumberEditDisabled();
+    participantsLabel.hide();
+    // number entered during call (with no talk text) is invited to conference
+    activateWithPhoneNumberEditEnabled();
 }
 
 void QtCallMode::activateForDialModeSlot()
@@ -46,12 +61,31 @@ void QtCallMode::activateForDialModeSlot()
 
 void QtCallMode::clearIncomingText()
 {
+    {
+        std::lock_guard lock(pendingTalkTextMutex);
+        pendingTalkText.clear();
+    }
     incomingTextEdit.clear();
 }
 
 void QtCallMode::appendIncomingText(const std::string &text)
 {
-    emit appendTalkTextSignal(QString::fromStdString(text));
+    bool firstPending = false;
+    {
+        std::lock_guard lock(pendingTalkTextMutex);
+        firstPending = pendingTalkText.isEmpty();
+        pendingTalkText.append(QString::fromStdString(text));
+        // would be dropped by document anyway
+        while (pendingTalkText.size() > MAX_TALK_HISTORY_LINES)
+        {
+            pendingTalkText.removeFirst();
+        }
+    }
+    // one signal per flush, not per line - GUI event queue does not grow with talk rate
+    if (firstPending)
+    {
+        emit talkTextPendingSignal();
+    }
 }
 
 void QtCallMode::clearOutgoingText()
@@ -64,14 +98,73 @@ std::string QtCallMode::getOutgoingText() const
     return outgoingTextEdit.toPlainText().toStdString();
 }
 
+PhoneNumber QtCallMode::getInviteePhoneNumber() const
+{
+    return getPhoneNumber();
+}
+
+void QtCallMode::showParticipants(const std::vector<PhoneNumber>& participants)
+{
+    QString text = "Conference:";
+    for (auto participant : participants)
+    {
+        text += " " + QString::fromStdString(to_string(participant));
+    }
+    emit showParticipantsSignal(text);
+}
+
 void QtCallMode::activateForDialMode()
 {
     emit activateForDialModeSignal();
 }
 
-void QtCallMode::appendTalkTextSlot(QString text)
+void QtCallMode::talkTextPendingSlot()
+{
+    if (not talkTextFlushTimer.isActive())
+    {
+        talkTextFlushTimer.start();
+    }
+}
+
+void QtCallMode::flushTalkTextSlot()
+{
+    QStringList lines;
+    {
+        std::lock_guard lock(pendingTalkTextMutex);
+        lines.swap(pendingTalkText);
+    }
+    if (lines.isEmpty())
+    {
+        return;
+    }
+
+    QScrollBar* scrollBar = incomingTextEdit.verticalScrollBar();
+    const bool atBottom = scrollBar->value() == scrollBar->maximum();
+
+    // single edit block - document is laid out once for all lines
+    QTextCursor cursor(incomingTextEdit.document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+    for (const QString& line : lines)
+    {
+        if (not incomingTextEdit.document()->isEmpty())
+        {
+            cursor.insertBlock();
+        }
+        cursor.insertText(line);
+    }
+    cursor.endEditBlock();
+
+    if (atBottom)
+    {
+        scrollBar->setValue(scrollBar->maximum());
+    }
+}
+
+void QtCallMode::showParticipantsSlot(QString text)
 {
-    incomingTextEdit.append(text);
+    participantsLabel.setText(text);
+    participantsLabel.show();
 }
 
 }
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <QLabel>
+#include <QStringList>
 #include <QTextEdit>
+#include <QTimer>
+#include <mutex>
 
 #include "UeGui/ICallMode.hpp"
 #include "QtSubmitTextEdit.hpp"
@@ -23,23 +27,38 @@ public:
     void appendIncomingText(const std::string &text) override;
     void clearOutgoingText() override;
     std::string getOutgoingText() const override;
+    PhoneNumber getInviteePhoneNumber() const override;
+    void showParticipants(const std::vector<PhoneNumber>& participants) override;
 
 private:
+    // incoming text is shown at most once per frame, not per CallTalk
+    static constexpr int FRAME_INTERVAL_MS = 16;
+    // older lines are dropped from view
+    static constexpr int MAX_TALK_HISTORY_LINES = 500;
+
     void constructGUI();
     void connectSignals();
 
+    QLabel participantsLabel;
     QTextEdit incomingTextEdit;
     QtSubmitTextEdit outgoingTextEdit;
+    QTimer talkTextFlushTimer;
+    // lines not shown yet - appended by UE thread, taken by flushTalkTextSlot
+    std::mutex pendingTalkTextMutex;
+    QStringList pendingTalkText;
 
 signals:
     void activateForDialModeSignal();
-    void appendTalkTextSignal(QString);
+    void talkTextPendingSignal();
+    void showParticipantsSignal(QString);
     void textEntered();
 
 private slots:
     void activateSlot() override;
     void activateForDialModeSlot();
-    void appendTalkTextSlot(QString text);
+    void talkTextPendingSlot();
+    void flushTalkTextSlot();
+    void showParticipantsSlot(QString text);
 };
 
 }
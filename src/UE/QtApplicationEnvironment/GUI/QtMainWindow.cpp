@@ -36,4 +36,20 @@ void QtMainWindow::closeEvent(QCloseEvent *event)
     }
 }
 
+void QtMainWindow::setFirstFrameCallback(std::function<void()> callback)
+{
+    firstFrameCallback = std::move(callback);
+}
+
+void QtMainWindow::paintEvent(QPaintEvent* event)
+{
+    QMainWindow::paintEvent(event);
+    if (firstFrameCallback)
+    {
+        auto callback = std::move(firstFrameCallback);
+        firstFrameCallback = nullptr;
+        callback();
+    }
+}
+
 }
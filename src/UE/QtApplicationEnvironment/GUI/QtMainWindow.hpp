@@ -4,6 +4,7 @@
 #include <QMainWindow>
 #include <QKeyEvent>
 #include "Logger/ILogger.hpp"
+#include <functional>
 
 namespace ue
 {
@@ -15,9 +16,15 @@ public:
     QtMainWindow();
     void setCloseGuard(const IUeGui::CloseGuard &value);
     void closeEvent(QCloseEvent* event) override;
+    // called once, after next paint
+    void setFirstFrameCallback(std::function<void()> callback);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
 
 private:
     IUeGui::CloseGuard closeGuard;
+    std::function<void()> firstFrameCallback;
     bool closeAccepted();
 };
 
@@ -1,14 +1,13 @@
 #include "QtSelectionListMode.hpp"
 #include "QtUeGui.hpp"
 
-#include <QListWidgetItem>
-
 namespace ue
 {
 
 QtSelectionListMode::QtSelectionListMode(QtPhoneNumberEdit &phoneNumberTextEdit,
                                          QtStackedWidget &stackedWidget)
-    : QtUeModeWidget(phoneNumberTextEdit, stackedWidget)
+    : QtUeModeWidget(phoneNumberTextEdit, stackedWidget),
+      model(getItemFont())
 {
     constructGui();
     connectSignals();
@@ -27,34 +26,67 @@ QFont QtSelectionListMode::getItemFont()
 
 void QtSelectionListMode::addSelectionListItemSlot(QString label, QString tooltip)
 {
-    QListWidgetItem* newItem = new QListWidgetItem(label, &listWidget);
-    newItem->setFont(getItemFont());
-    if (not tooltip.isEmpty())
+    model.append(Item{label.toStdString(), tooltip.toStdString()});
+}
+
+void QtSelectionListMode::clearSelectionListSlot()
+{
+    model.clear();
+}
+
+void QtSelectionListMode::setSelectionListSlot()
+{
+    Items items;
     {
-        newItem->setToolTip(tooltip);
+        std::lock_guard lock(pendingItemsMutex);
+        items.swap(pendingItems);
     }
+    model.reset(std::move(items));
 }
 
-void QtSelectionListMode::clearSelectionListSlot()
+void QtSelectionListMode::setSearchVisibleSlot(bool visible)
 {
-    listWidget.clear();
+    searchEdit.clear();
+    searchEdit.setVisible(visible);
+    if (visible)
+    {
+        searchEdit.setFocus();
+    }
 }
 
 void QtSelectionListMode::constructGui()
 {
-    addChildWidget(&listWidget);
+    addChildWidget(&searchEdit);
+    addChildWidget(&listView);
 
-    listWidget.setStyleSheet( "QListWidget::item { border-bottom: 1px solid black; }");
-    listWidget.setStyleSheet( "QListWidget::item:selected { border-color: darkblue; background: rgba(100, 100, 100, 200);}" );
+    searchEdit.setPlaceholderText("Search (@number to filter by peer)");
+    searchEdit.hide();
 
-    listWidget.show();
+    listView.setModel(&model);
+    // rows laid out and drawn only when scrolled into view
+    listView.setUniformItemSizes(true);
+    listView.setLayoutMode(QListView::Batched);
+    listView.setEditTriggers(QAbstractItemView::NoEditTriggers);
+    listView.setStyleSheet( "QListView::item { border-bottom: 1px solid black; }");
+    listView.setStyleSheet( "QListView::item:selected { border-color: darkblue; background: rgba(100, 100, 100, 200);}" );
+
+    listView.show();
 }
 
 void QtSelectionListMode::connectSignals()
 {
-    connect(&listWidget, &QListWidget::doubleClicked, [this](const QModelIndex&){ emit itemDoubleClicked();});
+    connect(&listView, &QListView::doubleClicked, [this](const QModelIndex&){ emit itemDoubleClicked();});
     connect(this,SIGNAL(addSelectionListItemSignal(QString, QString)),this,SLOT(addSelectionListItemSlot(QString, QString)));
     connect(this,SIGNAL(clearSelectionListSignal()),this,SLOT(clearSelectionListSlot()));
+    connect(this,SIGNAL(setSelectionListSignal()),this,SLOT(setSelectionListSlot()));
+    connect(this,SIGNAL(setSearchVisibleSignal(bool)),this,SLOT(setSearchVisibleSlot(bool)));
+    connect(&searchEdit, &QLineEdit::textEdited, [this](const QString& text)
+    {
+        if (searchCallback)
+        {
+            searchCallback(text.toStdString());
+        }
+    });
 }
 
 void QtSelectionListMode::activateSlot()
@@ -64,10 +96,10 @@ void QtSelectionListMode::activateSlot()
 
 IUeGui::IListViewMode::OptionalSelection QtSelectionListMode::getCurrentItemIndex() const
 {
-    auto currentItem = listWidget.currentItem();
-    if (currentItem)
+    auto currentIndex = listView.currentIndex();
+    if (currentIndex.isValid())
     {
-        return std::make_pair(true, listWidget.row(currentItem));
+        return std::make_pair(true, static_cast<Selection>(currentIndex.row()));
     }
     return std::make_pair(false, 0);
 }
@@ -82,4 +114,20 @@ void QtSelectionListMode::clearSelectionList()
     emit clearSelectionListSignal();
 }
 
+void QtSelectionListMode::setSelectionList(Items items)
+{
+    {
+        std::lock_guard lock(pendingItemsMutex);
+        pendingItems = std::move(items);
+    }
+    emit setSelectionListSignal();
+}
+
+void QtSelectionListMode::setSearchCallback(SearchCallback callback)
+{
+    const bool visible = static_cast<bool>(callback);
+    searchCallback = std::move(callback);
+    emit setSearchVisibleSignal(visible);
+}
+
 }
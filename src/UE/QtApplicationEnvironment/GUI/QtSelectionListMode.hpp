@@ -2,9 +2,12 @@
 
 #include "UeGui/IListViewMode.hpp"
 #include "QtUeModeWidget.hpp"
+#include "QtSelectionListModel.hpp"
 
-#include <QListWidget>
+#include <QLineEdit>
+#include <QListView>
 #include <QFont>
+#include <mutex>
 
 namespace ue
 {
@@ -19,23 +22,34 @@ public:
     OptionalSelection getCurrentItemIndex() const override;
     void addSelectionListItem(const std::string& label, const std::string& tooltip) override;
     void clearSelectionList() override;
+    void setSelectionList(Items items) override;
+    void setSearchCallback(SearchCallback) override;
 
 private:
     void constructGui();
     void connectSignals();
-    QFont getItemFont();
+    static QFont getItemFont();
 
-    QListWidget listWidget;
+    QLineEdit searchEdit;
+    QListView listView;
+    QtSelectionListModel model;
+    SearchCallback searchCallback;
+    // passed to setSelectionListSlot - moved, not copied through signal
+    std::mutex pendingItemsMutex;
+    Items pendingItems;
 
 signals:
     void itemDoubleClicked();
     void addSelectionListItemSignal(QString, QString);
     void clearSelectionListSignal();
+    void setSelectionListSignal();
+    void setSearchVisibleSignal(bool);
 private slots:
     void addSelectionListItemSlot(QString label, QString);
     void clearSelectionListSlot();
+    void setSelectionListSlot();
+    void setSearchVisibleSlot(bool);
     void activateSlot() override;
 };
 
 }
-
@@ -0,0 +1,56 @@
+#include "QtSelectionListModel.hpp"
+
+namespace ue
+{
+
+QtSelectionListModel::QtSelectionListModel(QFont font, QObject* parent)
+    : QAbstractListModel(parent),
+      font(font)
+{}
+
+int QtSelectionListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(items.size());
+}
+
+QVariant QtSelectionListModel::data(const QModelIndex& index, int role) const
+{
+    if (not index.isValid() or index.row() >= rowCount())
+    {
+        return QVariant();
+    }
+    const auto& item = items[index.row()];
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        return QString::fromStdString(item.label);
+    case Qt::ToolTipRole:
+        return item.tooltip.empty() ? QVariant() : QString::fromStdString(item.tooltip);
+    case Qt::FontRole:
+        return font;
+    default:
+        return QVariant();
+    }
+}
+
+void QtSelectionListModel::append(Item item)
+{
+    const int row = rowCount();
+    beginInsertRows(QModelIndex(), row, row);
+    items.push_back(std::move(item));
+    endInsertRows();
+}
+
+void QtSelectionListModel::reset(Items newItems)
+{
+    beginResetModel();
+    items = std::move(newItems);
+    endResetModel();
+}
+
+void QtSelectionListModel::clear()
+{
+    reset({});
+}
+
+}
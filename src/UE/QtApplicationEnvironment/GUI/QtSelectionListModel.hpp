@@ -0,0 +1,35 @@
+#pragma once
+
+#include "UeGui/IListViewMode.hpp"
+
+#include <QAbstractListModel>
+#include <QFont>
+
+namespace ue
+{
+
+/**
+ * Items kept as given - QString made only for rows being drawn, so list of any length is set at once
+ */
+class QtSelectionListModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    using Item = IUeGui::IListViewMode::Item;
+    using Items = IUeGui::IListViewMode::Items;
+
+    explicit QtSelectionListModel(QFont font, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+
+    void append(Item item);
+    void reset(Items newItems);
+    void clear();
+
+private:
+    QFont font;
+    Items items;
+};
+
+}
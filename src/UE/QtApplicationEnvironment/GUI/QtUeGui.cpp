@@ -2,6 +2,7 @@
 
 #include <QPalette>
 #include <QApplication>
+#include <QThread>
 
 namespace ue
 {
@@ -13,13 +14,7 @@ QtUeGui::QtUeGui(ILogger &logger)
    frame(&centralWidget),
    acceptButton(&centralWidget),
    rejectButton(&centralWidget),
-   homeButton(&centralWidget),
-   listViewMode(phoneNumberEdit, stackedWidget),
-   callMode(phoneNumberEdit, stackedWidget),
-   dialMode(callMode, phoneNumberEdit),
-   smsComposeMode(phoneNumberEdit, stackedWidget),
-   alertMode(phoneNumberEdit, stackedWidget),
-   textViewMode(smsComposeMode)
+   homeButton(&centralWidget)
 {
     initGUI();
     initInternalSignals();
@@ -30,8 +25,9 @@ QtUeGui::~QtUeGui()
 
 }
 
-void QtUeGui::start()
+void QtUeGui::start(FrameCallback firstFrameCallback)
 {
+    mainWindow.setFirstFrameCallback(std::move(firstFrameCallback));
     mainWindow.show();
 }
 
@@ -59,7 +55,6 @@ void QtUeGui::initGUI()
 
     initLayout();
     addElements();
-    initModes();
 }
 
 void QtUeGui::initInternalSignals()
@@ -68,9 +63,6 @@ void QtUeGui::initInternalSignals()
     QObject::connect(&rejectButton,SIGNAL(clicked()),this, SLOT(onRejectClicked()));
     QObject::connect(&homeButton,SIGNAL(clicked()),this,SLOT(onHomeClicked()));
 
-    QObject::connect(&listViewMode,SIGNAL(itemDoubleClicked()),this,SLOT(onItemSelected()));
-    QObject::connect(&callMode,SIGNAL(textEntered()),this,SLOT(onTextEntered()));
-
     QObject::connect(this,SIGNAL(setConnectedStateSignal(QString, bool)),this,SLOT(setConnectedStateSlot(QString, bool)));
     QObject::connect(this,SIGNAL(setNewMessageSignal(bool)),this,SLOT(setNewMessageSlot(bool)));
 }
@@ -141,14 +133,83 @@ void QtUeGui::setButtonLayout(QPushButton &btn)
 
 }
 
-void QtUeGui::initModes()
+void QtUeGui::assertInGuiThread() const
+{
+    Q_ASSERT_X(QThread::currentThread() == thread(), "QtUeGui", "modes are created and used in GUI thread only");
+}
+
+QtCallMode& QtUeGui::getCallMode()
+{
+    assertInGuiThread();
+    if (not callMode)
+    {
+        logger.logDebug("GUI: creating call mode");
+        callMode = std::make_unique<QtCallMode>(phoneNumberEdit, stackedWidget);
+        callMode->init();
+        QObject::connect(callMode.get(),SIGNAL(textEntered()),this,SLOT(onTextEntered()));
+    }
+    return *callMode;
+}
+
+QtDialMode& QtUeGui::getDialMode()
+{
+    assertInGuiThread();
+    if (not dialMode)
+    {
+        auto& baseMode = getCallMode();
+        dialMode = std::make_unique<QtDialMode>(baseMode, phoneNumberEdit);
+        dialMode->init();
+    }
+    return *dialMode;
+}
+
+QtSelectionListMode& QtUeGui::getListViewMode()
 {
-    alertMode.init();
-    smsComposeMode.init();
-    listViewMode.init();
-    callMode.init();
-    dialMode.init();
-    textViewMode.init();
+    assertInGuiThread();
+    if (not listViewMode)
+    {
+        logger.logDebug("GUI: creating list view mode");
+        listViewMode = std::make_unique<QtSelectionListMode>(phoneNumberEdit, stackedWidget);
+        listViewMode->init();
+        QObject::connect(listViewMode.get(),SIGNAL(itemDoubleClicked()),this,SLOT(onItemSelected()));
+    }
+    return *listViewMode;
+}
+
+QtSmsComposeMode& QtUeGui::getSmsComposeMode()
+{
+    assertInGuiThread();
+    if (not smsComposeMode)
+    {
+        logger.logDebug("GUI: creating SMS compose mode");
+        smsComposeMode = std::make_unique<QtSmsComposeMode>(phoneNumberEdit, stackedWidget);
+        smsComposeMode->init();
+    }
+    return *smsComposeMode;
+}
+
+QtAlertMode& QtUeGui::getAlertMode()
+{
+    assertInGuiThread();
+    if (not alertMode)
+    {
+        logger.logDebug("GUI: creating alert mode");
+        alertMode = std::make_unique<QtAlertMode>(phoneNumberEdit, stackedWidget);
+        alertMode->init();
+    }
+    return *alertMode;
+}
+
+QtTextViewMode& QtUeGui::getTextViewMode()
+{
+    assertInGuiThread();
+    if (not textViewMode)
+    {
+        auto& baseMode = getSmsComposeMode();
+        textViewMode = std::make_unique<QtTextViewMode>(baseMode);
+        textViewMode->init();
+    }
+    return *textViewMode;
 }
 
 void QtUeGui::onAcceptClicked()
@@ -261,32 +322,32 @@ ModeObject& QtUeGui::activateMode(ModeObject& modeObject)
 
 IUeGui::IListViewMode& QtUeGui::setListViewMode()
 {
-    return activateMode(listViewMode);
+    return activateMode(getListViewMode());
 }
 
 IUeGui::ISmsComposeMode& QtUeGui::setSmsComposeMode()
 {
-    return activateMode(smsComposeMode);
+    return activateMode(getSmsComposeMode());
 }
 
 IUeGui::IDialMode& QtUeGui::setDialMode()
 {
-    return activateMode(dialMode);
+    return activateMode(getDialMode());
 }
 
 IUeGui::ICallMode& QtUeGui::setCallMode()
 {
-    return activateMode(callMode);
+    return activateMode(getCallMode());
 }
 
 IUeGui::ITextMode& QtUeGui::setAlertMode()
 {
-    return activateMode(alertMode);
+    return activateMode(getAlertMode());
 }
 
 IUeGui::ITextMode& QtUeGui::setViewTextMode()
 {
-    return activateMode(textViewMode);
+    return activateMode(getTextViewMode());
 }
 
 }
@@ -22,7 +22,8 @@
 #include <QObject>
 #include <QVBoxLayout>
 #include <QStackedWidget>
-
+#include <functional>
+#include <memory>
 
 #include "Logger/ILogger.hpp"
 
@@ -35,10 +36,13 @@ class QtUeGui : public QObject, public IUeGui
 {
     Q_OBJECT
 public:
+    using FrameCallback = std::function<void()>;
+
     QtUeGui(ILogger& logger);
     ~QtUeGui();
 
-    void start();
+    // firstFrameCallback called once, when main window is painted first time
+    void start(FrameCallback firstFrameCallback = nullptr);
     void setCloseGuard(CloseGuard closeGuard) override;
     void setAcceptCallback(Callback) override;
     void setRejectCallback(Callback) override;
@@ -82,7 +86,15 @@ private:
     void addPhoneNumberControls();
     void addButtons();
     void setButtonLayout(QPushButton &btn);
-    void initModes();
+    // all UE callbacks run in Qt thread - no other thread creates modes, nor uses them
+    void assertInGuiThread() const;
+
+    QtCallMode& getCallMode();
+    QtDialMode& getDialMode();
+    QtSelectionListMode& getListViewMode();
+    QtSmsComposeMode& getSmsComposeMode();
+    QtAlertMode& getAlertMode();
+    QtTextViewMode& getTextViewMode();
 
     ILogger& logger;
     // part of main widget
@@ -106,12 +118,14 @@ private:
     QPushButton rejectButton;
     QPushButton homeButton;
 
-    QtCallMode callMode;
-    QtDialMode dialMode;
-    QtSelectionListMode listViewMode;
-    QtSmsComposeMode smsComposeMode;
-    QtAlertMode alertMode;
-    QtTextViewMode textViewMode;
+    // created on first use - only modes UE gets to cost startup time and memory;
+    // dial and text view modes are over call and SMS compose ones, so declared after them
+    std::unique_ptr<QtCallMode> callMode;
+    std::unique_ptr<QtDialMode> dialMode;
+    std::unique_ptr<QtSelectionListMode> listViewMode;
+    std::unique_ptr<QtSmsComposeMode> smsComposeMode;
+    std::unique_ptr<QtAlertMode> alertMode;
+    std::unique_ptr<QtTextViewMode> textViewMode;
 
 
 private slots:
@@ -0,0 +1,193 @@
+#include "QtShmTransport.hpp"
+#include <QSocketNotifier>
+#include <QThread>
+#include <QTimer>
+#include "Config/MultiLineConfig.hpp"
+
+namespace ue
+{
+
+QtShmTransport::QtShmTransport(common::MultiLineConfig& configuration, common::ILogger &loggerBase)
+    : loggerBase(loggerBase),
+      logger(loggerBase, "[TRANSPORT]"),
+      path(configuration.getString("shmPath",
+                                   "/tmp/bts_" + std::to_string(configuration.getNumber("port", 8181)) + ".shm")),
+      ringCapacity(configuration.getNumber<std::size_t>("shmRingSize", common::ShmChannel::DEFAULT_RING_CAPACITY)),
+      backoff(std::chrono::milliseconds{configuration.getNumber("reconnectMinDelay", DEFAULT_RECONNECT_MIN_DELAY_MS)},
+              std::chrono::milliseconds{configuration.getNumber("reconnectMaxDelay", DEFAULT_RECONNECT_MAX_DELAY_MS)}),
+      outbox(configuration.getNumber<std::size_t>("outboxSize", DEFAULT_OUTBOX_SIZE))
+{
+    logger.logDebug("Selected configuration shm:", path, ", ring size: ", ringCapacity);
+    connectToServer();
+}
+
+QtShmTransport::~QtShmTransport()
+{
+    releaseConnection();
+    logger.logDebug("Bye");
+}
+
+void QtShmTransport::connectToServer()
+{
+    try
+    {
+        connection = std::make_unique<common::ShmTransport>(loggerBase, common::ShmChannel::connect(path, ringCapacity));
+    }
+    catch (common::UnixSocketEx& ex)
+    {
+        logger.logError(ex.what());
+        scheduleReconnect();
+        return;
+    }
+    logger.logInfo("Connected to: ", path);
+
+    connection->registerMessageCallback([this](BinaryMessage message)
+    {
+        if (messageCallback)
+        {
+            messageCallback(std::move(message));
+        }
+    });
+    connection->registerDisconnectedCallback([this] { handleClosingConnection(); });
+    connection->registerBackpressureCallback([this](bool congested)
+    {
+        if (backpressureCallback)
+        {
+            backpressureCallback(congested);
+        }
+    });
+
+    doorbellNotifier = std::make_unique<QSocketNotifier>(connection->doorbellFd(), QSocketNotifier::Read);
+    controlNotifier = std::make_unique<QSocketNotifier>(connection->controlFd(), QSocketNotifier::Read);
+    QObject::connect(doorbellNotifier.get(), &QSocketNotifier::activated, this, [this] { poll(); });
+    QObject::connect(controlNotifier.get(), &QSocketNotifier::activated, this, [this] { poll(); });
+
+    backoff.reset();
+    if (connectedCallback)
+    {
+        connectedCallback();
+    }
+}
+
+void QtShmTransport::poll()
+{
+    connection->poll();
+    // peer read something - maybe there is room for held messages now
+    flushOutbox();
+}
+
+void QtShmTransport::flushOutbox()
+{
+    if (not connection or outbox.empty())
+    {
+        return;
+    }
+    auto heldMessages = outbox.takeAll();
+    std::size_t sent = 0u;
+    while (sent < heldMessages.size() and connection->sendMessage(heldMessages[sent]))
+    {
+        ++sent;
+    }
+    for (auto i = sent; i < heldMessages.size(); ++i)
+    {
+        outbox.push(std::move(heldMessages[i]));
+    }
+    if (sent > 0u)
+    {
+        logger.logInfo("Outbox flushed, messages: ", sent, ", still held: ", outbox.size());
+    }
+}
+
+void QtShmTransport::scheduleReconnect()
+{
+    const auto delay = backoff.next();
+    logger.logInfo("Reconnecting in ", delay.count(), " ms, attempt: ", backoff.attempts());
+    QTimer::singleShot(delay, this, [this] { connectToServer(); });
+}
+
+void QtShmTransport::releaseConnection()
+{
+    doorbellNotifier.reset();
+    controlNotifier.reset();
+    connection.reset();
+    // sent into lost session - not to be replayed into the next one
+    outbox.clear();
+}
+
+void QtShmTransport::registerMessageCallback(MessageCallback newMessageCallback)
+{
+    this->messageCallback = newMessageCallback;
+}
+
+void QtShmTransport::registerDisconnectedCallback(ITransport::DisconnectedCallback disconnectedCallback)
+{
+    this->disconnectedCallback = disconnectedCallback;
+}
+
+void QtShmTransport::registerBackpressureCallback(ITransport::BackpressureCallback backpressureCallback)
+{
+    this->backpressureCallback = backpressureCallback;
+}
+
+void QtShmTransport::registerConnectedCallback(ITransport::ConnectedCallback connectedCallback)
+{
+    this->connectedCallback = connectedCallback;
+}
+
+bool QtShmTransport::sendMessage(BinaryMessage message)
+{
+    // ring is single producer - all writes from Qt thread
+    if (QThread::currentThread() != thread())
+    {
+        return QMetaObject::invokeMethod(this, [this, message = std::move(message)]() mutable
+        {
+            sendMessage(std::move(message));
+        }, Qt::QueuedConnection);
+    }
+    if (not connection)
+    {
+        // application holds what it wants to send after reconnection - it is attached again first
+        logger.logError("Connection not established - message dropped");
+        return false;
+    }
+    // held messages first - order is kept
+    if (outbox.empty() and connection->sendMessage(message))
+    {
+        return true;
+    }
+    if (not outbox.push(std::move(message)))
+    {
+        logger.logError("Ring full or connection lost, outbox full - oldest message dropped");
+    }
+    return true;
+}
+
+std::string QtShmTransport::addressToString() const
+{
+    if (not connection)
+    {
+        return "NotConnected";
+    }
+    return connection->addressToString();
+}
+
+void QtShmTransport::handleClosingConnection()
+{
+    // called from notifier - it must not be deleted before it returns
+    doorbellNotifier->setEnabled(false);
+    controlNotifier->setEnabled(false);
+    QTimer::singleShot(0, this, [this] { releaseConnection(); });
+    scheduleReconnect();
+
+    if (disconnectedCallback)
+    {
+        logger.logInfo("Connection lost!");
+        disconnectedCallback();
+    }
+    else
+    {
+        logger.logError("Connection lost! - application not interested!");
+    }
+}
+
+}
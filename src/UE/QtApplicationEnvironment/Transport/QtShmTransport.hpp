@@ -0,0 +1,64 @@
+#pragma once
+#include "ITransport.hpp"
+#include <memory>
+#include <QObject>
+#include "Logger/PrefixedLogger.hpp"
+#include "Transport/ShmTransport.hpp"
+#include "Transport/Reconnect.hpp"
+
+class QSocketNotifier;
+
+namespace common
+{
+class MultiLineConfig;
+}
+
+namespace ue
+{
+
+/**
+ * Transport to BTS running on the same host - over shared memory, see common::ShmTransport.
+ */
+class QtShmTransport : public QObject, public ITransport
+{
+    Q_OBJECT
+
+public:
+    QtShmTransport(common::MultiLineConfig& configuration, common::ILogger& logger);
+    ~QtShmTransport();
+    void registerMessageCallback(MessageCallback messageCallback) override;
+    void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
+    void registerBackpressureCallback(BackpressureCallback backpressureCallback) override;
+    void registerConnectedCallback(ConnectedCallback connectedCallback) override;
+    bool sendMessage(BinaryMessage message) override;
+    std::string addressToString() const override;
+
+private:
+    void connectToServer();
+    void handleClosingConnection();
+    void releaseConnection();
+    void scheduleReconnect();
+    void poll();
+    void flushOutbox();
+
+    static constexpr int DEFAULT_RECONNECT_MIN_DELAY_MS = 500;
+    static constexpr int DEFAULT_RECONNECT_MAX_DELAY_MS = 30000;
+    static constexpr std::size_t DEFAULT_OUTBOX_SIZE = 64u;
+
+    common::ILogger& loggerBase;
+    common::PrefixedLogger logger;
+    std::string path;
+    std::size_t ringCapacity;
+    std::unique_ptr<common::ShmTransport> connection;
+    std::unique_ptr<QSocketNotifier> doorbellNotifier;
+    std::unique_ptr<QSocketNotifier> controlNotifier;
+    common::ReconnectBackoff backoff;
+    // messages not fitting into ring - sent in order once peer made room
+    common::Outbox<> outbox;
+    MessageCallback messageCallback;
+    DisconnectedCallback disconnectedCallback;
+    BackpressureCallback backpressureCallback;
+    ConnectedCallback connectedCallback;
+};
+
+}
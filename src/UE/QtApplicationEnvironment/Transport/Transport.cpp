@@ -3,8 +3,7 @@
 #include <QtNetwork>
 #include <string>
 #include "Config/MultiLineConfig.hpp"
-#include "Messages/OutgoingMessage.hpp"
-#include "Messages/IncomingMessage.hpp"
+#include "Transport/UnixSocket.hpp"
 #include <functional>
 
 namespace ue
@@ -14,12 +13,25 @@ Transport::Transport(common::MultiLineConfig& configuration, common::ILogger &lo
     : logger(loggerBase, "[TRANSPORT]"),
       port(configuration.getNumber("port", 8181)),
       server(configuration.getString("server", "localhost")),
-      socket(new QTcpSocket())
+      socket(new QTcpSocket()),
+      backoff(std::chrono::milliseconds{configuration.getNumber("reconnectMinDelay", DEFAULT_RECONNECT_MIN_DELAY_MS)},
+              std::chrono::milliseconds{configuration.getNumber("reconnectMaxDelay", DEFAULT_RECONNECT_MAX_DELAY_MS)})
 {
-    logger.logDebug("Selected configuration ", server, ":", port);
+    reconnectTimer.setSingleShot(true);
+    QObject::connect(&reconnectTimer, &QTimer::timeout, this, &Transport::connectToServer);
+
+    if (configuration.getString("transport", "tcp") == "unix")
+    {
+        unixPath = configuration.getString("unixPath", "/tmp/bts_" + std::to_string(port) + ".sock");
+        logger.logDebug("Selected configuration unix:", unixPath);
+    }
+    else
+    {
+        logger.logDebug("Selected configuration ", server, ":", port);
+    }
 
     QNetworkConfigurationManager manager{};
-    if (manager.capabilities() & QNetworkConfigurationManager::NetworkSessionRequired)
+    if (unixPath.empty() and manager.capabilities() & QNetworkConfigurationManager::NetworkSessionRequired)
     {
         logger.logDebug("Session needed");
         session.reset(new QNetworkSession(manager.defaultConfiguration()));
@@ -34,29 +46,78 @@ Transport::Transport(common::MultiLineConfig& configuration, common::ILogger &lo
     void (QTcpSocket::* errorSignal) (QAbstractSocket::SocketError) = &QTcpSocket::error;
     QObject::connect(socket.get(), errorSignal, [this](auto socketError) {this->handleError(socketError);});
     QObject::connect(socket.get(), &QTcpSocket::readyRead, [this](){this->readData();});
+    QObject::connect(socket.get(), &QAbstractSocket::connected, [this](){this->handleConnected();});
     QObject::connect(socket.get(), &QAbstractSocket::disconnected, std::bind(&Transport::handleClosingConnection, this));
+    QObject::connect(socket.get(), &QAbstractSocket::bytesWritten, std::bind(&Transport::updateBackpressure, this));
 
     connect(this, SIGNAL(sendMessageSignal(QByteArray)), this, SLOT(sendMessageSlot(QByteArray)),Qt::QueuedConnection);
 }
 
 void Transport::connectToServer()
 {
+    if (not unixPath.empty())
+    {
+        connectToUnixSocket();
+        return;
+    }
     socket->connectToHost(server.data(), port);
 }
 
+void Transport::connectToUnixSocket()
+{
+    try
+    {
+        int fd = common::connectUnix(unixPath, SOCK_STREAM);
+        // Qt handles stream unix sockets as any other stream socket - as QLocalSocket does
+        if (socket->setSocketDescriptor(fd))
+        {
+            logger.logInfo("Connected to unix:", unixPath);
+            // no connected() signal for already connected descriptor
+            handleConnected();
+            return;
+        }
+        common::closeFd(fd);
+        logger.logError("Unix socket rejected: ", socket->errorString().toStdString());
+    }
+    catch (common::UnixSocketEx& ex)
+    {
+        logger.logError(ex.what());
+    }
+    scheduleReconnect();
+}
+
 bool Transport::sendMessageSlot(const QByteArray &message)
 {
     if(not isConnected())
     {
-        logger.logError("Could not send message, connection not established");
+        // application holds what it wants to send after reconnection - it is attached again first
+        logger.logError("Connection not established - message dropped");
         return false;
     }
     logger.logDebug("Send message of size: ", message.size());
     socket->write(message);
     socket->flush();
+    updateBackpressure();
     return true;
 }
 
+void Transport::updateBackpressure()
+{
+    const qint64 pending = socket->bytesToWrite();
+    const bool nowCongested = congested ? pending > LOW_WATERMARK
+                                        : pending > HIGH_WATERMARK;
+    if (nowCongested == congested)
+    {
+        return;
+    }
+    congested = nowCongested;
+    logger.logDebug((congested ? "Congested" : "Relieved"), ", bytes to write: ", pending);
+    if (backpressureCallback)
+    {
+        backpressureCallback(congested);
+    }
+}
+
 bool Transport::isConnected() const
 {
     return socket->state() == QAbstractSocket::ConnectedState;
@@ -77,15 +138,20 @@ void Transport::registerDisconnectedCallback(ITransport::DisconnectedCallback di
     this->disconnectedCallback = disconnectedCallback;
 }
 
-bool Transport::sendMessage(BinaryMessage message)
+void Transport::registerBackpressureCallback(ITransport::BackpressureCallback backpressureCallback)
+{
+    this->backpressureCallback = backpressureCallback;
+}
+
+void Transport::registerConnectedCallback(ITransport::ConnectedCallback connectedCallback)
 {
-    common::OutgoingMessage sizeEncoder;
-    sizeEncoder.writeNumber<BinaryMessage::SizeType>(message.value.size());
-    BinaryMessage size = sizeEncoder.getMessage();
+    this->connectedCallback = connectedCallback;
+}
 
-    QByteArray array{};
-    array.append(reinterpret_cast<char*>(size.value.data()), size.value.size());
-    array.append(reinterpret_cast<char*>(message.value.data()), message.value.size());
+bool Transport::sendMessage(BinaryMessage message)
+{
+    const common::FrameBytes frame = common::encodeFrame(message);
+    QByteArray array(reinterpret_cast<const char*>(frame.data()), frame.size());
     return emit sendMessageSignal(array);
 }
 
@@ -95,33 +161,30 @@ std::string Transport::addressToString() const
     {
         return "NotConnected";
     }
+    if (not unixPath.empty())
+    {
+        return "unix:" + unixPath;
+    }
     return socket->peerAddress().toString().toStdString() + "-" + std::to_string(socket->peerPort());
 }
 
 void Transport::readData()
 {
-    const std::size_t sizeSize = sizeof(BinaryMessage::SizeType);
-    quint64 bytesAvailable;
-    while ((bytesAvailable = socket->bytesAvailable()) >= sizeSize)
+    const QByteArray bytes = socket->readAll();
+    try
     {
-        BinaryMessage sizeEncoded{ BinaryMessage::Value(sizeSize) };
-        socket->read(reinterpret_cast<char*>(sizeEncoded.value.data()), sizeSize);
-        common::IncomingMessage sizeDecoder(sizeEncoded);
-        BinaryMessage::SizeType messageLength = sizeDecoder.readNumber<BinaryMessage::SizeType>();
-
-        if (bytesAvailable < sizeSize + messageLength)
-        {
-            logger.logError("Wrong size: ", std::size_t(messageLength),
-                            " - available bytes: ", bytesAvailable);
-            continue;
-        }
-
-        BinaryMessage message{ BinaryMessage::Value(messageLength) };
-        socket->read(reinterpret_cast<char*>(message.value.data()), messageLength);
-        if (messageCallback)
+        frameDecoder.feed(reinterpret_cast<const std::uint8_t*>(bytes.constData()), bytes.size(),
+                          [this](BinaryMessage message)
         {
-            messageCallback(std::move(message));
-        }
+            if (messageCallback)
+            {
+                messageCallback(std::move(message));
+            }
+        });
+    }
+    catch (common::FrameDecoder::FrameEx& ex)
+    {
+        logger.logError("Stream corrupted: ", ex.what());
     }
 }
 
@@ -141,12 +204,38 @@ void Transport::handleError(QAbstractSocket::SocketError socketError)
         default:
             logger.logError(socket->errorString().toStdString());
     }
-    //QTimer::singleShot(10000,[this](){this->connectToServer();});
-     QTimer::singleShot(10000, this, SLOT(connectToServer()));
+    if (not isConnected())
+    {
+        scheduleReconnect();
+    }
+}
+
+void Transport::scheduleReconnect()
+{
+    if (reconnectTimer.isActive())
+    {
+        return;
+    }
+    const auto delay = backoff.next();
+    logger.logInfo("Reconnecting in ", delay.count(), " ms, attempt: ", backoff.attempts());
+    reconnectTimer.start(delay);
+}
+
+void Transport::handleConnected()
+{
+    logger.logInfo("Connected to: ", addressToString());
+    reconnectTimer.stop();
+    backoff.reset();
+    frameDecoder.reset();
+    if (connectedCallback)
+    {
+        connectedCallback();
+    }
 }
 
 void Transport::handleClosingConnection()
 {
+    scheduleReconnect();
     if (disconnectedCallback)
     {
         logger.logInfo("Connection lost!");
@@ -2,7 +2,11 @@
 #include "ITransport.hpp"
 #include <memory>
 #include <QAbstractSocket>
+#include <QByteArray>
+#include <QTimer>
 #include "Logger/PrefixedLogger.hpp"
+#include "Transport/FrameCodec.hpp"
+#include "Transport/Reconnect.hpp"
 
 class QTcpSocket;
 class QNetworkSession;
@@ -26,6 +30,8 @@ public:
     ~Transport();
     void registerMessageCallback(MessageCallback messageCallback) override;
     void registerDisconnectedCallback(DisconnectedCallback disconnectedCallback) override;
+    void registerBackpressureCallback(BackpressureCallback backpressureCallback) override;
+    void registerConnectedCallback(ConnectedCallback connectedCallback) override;
     bool sendMessage(BinaryMessage message) override;
     std::string addressToString() const override;
 
@@ -38,15 +44,34 @@ private:
     void readData();
     void handleError(QAbstractSocket::SocketError socketError);
     void handleClosingConnection();
+    void handleConnected();
+    void scheduleReconnect();
+    void updateBackpressure();
 //    void connectToServer();
+    void connectToUnixSocket();
     bool isConnected() const;
+
+    // bytes queued inside socket, i.e. not yet accepted by OS
+    static constexpr qint64 HIGH_WATERMARK = 64 * 1024;
+    static constexpr qint64 LOW_WATERMARK = 16 * 1024;
+    static constexpr int DEFAULT_RECONNECT_MIN_DELAY_MS = 500;
+    static constexpr int DEFAULT_RECONNECT_MAX_DELAY_MS = 30000;
+
     common::PrefixedLogger logger;
     int port;
     std::string server;
+    // when not empty, BTS is connected via unix socket (co-located only)
+    std::string unixPath;
     std::unique_ptr<QTcpSocket> socket;
     std::unique_ptr<QNetworkSession> session;
+    common::FrameDecoder frameDecoder;
+    bool congested = false;
+    common::ReconnectBackoff backoff;
+    QTimer reconnectTimer;
     MessageCallback messageCallback;
     DisconnectedCallback disconnectedCallback;
+    BackpressureCallback backpressureCallback;
+    ConnectedCallback connectedCallback;
 };
 
 }
@@ -0,0 +1,19 @@
+#include "TransportFactory.hpp"
+#include "Transport.hpp"
+#include "QtShmTransport.hpp"
+#include "Config/MultiLineConfig.hpp"
+
+namespace ue
+{
+
+std::unique_ptr<ITransport> createTransport(common::MultiLineConfig& configuration, common::ILogger& logger)
+{
+    // "shm" or "unix" only when BTS runs on the same host, with given transport enabled
+    if (configuration.getString("transport", "tcp") == "shm")
+    {
+        return std::make_unique<QtShmTransport>(configuration, logger);
+    }
+    return std::make_unique<Transport>(configuration, logger);
+}
+
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ITransport.hpp"
+#include "Logger/ILogger.hpp"
+#include <memory>
+
+namespace common
+{
+class MultiLineConfig;
+}
+
+namespace ue
+{
+
+/**
+ * Transport to BTS selected by "transport" configuration - "tcp" (default, or unix socket) or "shm".
+ */
+std::unique_ptr<ITransport> createTransport(common::MultiLineConfig& configuration, common::ILogger& logger);
+
+}
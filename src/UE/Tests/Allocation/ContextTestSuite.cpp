@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "Application.hpp"
+#include "Context.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+namespace
+{
+std::atomic<std::size_t> allocations{0u};
+}
+
+// counts all allocations of this test program (only state switching tests in it) - only difference is checked
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* memory = std::malloc(size ? size : 1u))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace ue
+{
+using namespace ::testing;
+
+namespace
+{
+
+// gmock records calls in allocated memory - so plain stubs here
+
+struct SilentLogger : common::ILogger
+{
+    void log(Level, const std::string&) override {}
+    bool isEnabled(Level) const override
+    {
+        return false;
+    }
+};
+
+struct BtsPortStub : IBtsPort
+{
+    void sendAttachRequest(common::BtsId) override
+    {
+        ++attachRequests;
+    }
+    void sendSms(common::PhoneNumber, const std::string&) override {}
+    void sendGroupSms(const std::vector<common::PhoneNumber>&, const std::string&) override {}
+    void sendCallRequest(common::PhoneNumber) override
+    {
+        ++callRequests;
+    }
+    void sendCallAccepted(common::PhoneNumber) override {}
+    void sendCallDropped(common::PhoneNumber) override
+    {
+        ++callsDropped;
+    }
+    void sendCallTalk(common::PhoneNumber, const std::string&) override {}
+    void sendConferenceInvite(common::PhoneNumber) override {}
+
+    std::size_t attachRequests = 0u;
+    std::size_t callRequests = 0u;
+    std::size_t callsDropped = 0u;
+};
+
+struct ListViewModeStub : IUeGui::IListViewMode
+{
+    OptionalSelection getCurrentItemIndex() const override
+    {
+        return {true, selection};
+    }
+    void addSelectionListItem(const std::string&, const std::string&) override {}
+    void clearSelectionList() override {}
+    void setSelectionList(Items) override {}
+    void setSearchCallback(SearchCallback) override {}
+
+    Selection selection = 0u;
+};
+
+struct CallModeStub : IUeGui::ICallMode
+{
+    void appendIncomingText(const std::string&) override {}
+    void clearIncomingText() override {}
+    void clearOutgoingText() override {}
+    std::string getOutgoingText() const override
+    {
+        return outgoingText;
+    }
+    PhoneNumber getInviteePhoneNumber() const override
+    {
+        return PhoneNumber{};
+    }
+    void showParticipants(const std::vector<PhoneNumber>&) override {}
+
+    std::string outgoingText;
+};
+
+struct TextModeStub : IUeGui::ITextMode
+{
+    void setText(const std::string&) override {}
+};
+
+struct UserPortStub : IUserPort
+{
+    void showNotConnected() override
+    {
+        ++notConnectedShown;
+    }
+    void showConnecting() override {}
+    void showConnected() override {}
+    void showNewSms(bool) override {}
+    void showSmsListView() override {}
+    void showSmsComposerView() override {}
+    IUeGui::IListViewMode& getListViewMode() override
+    {
+        return listViewMode;
+    }
+    IUeGui::ISmsComposeMode& getSmsComposeMode() override
+    {
+        throw std::logic_error("not used");
+    }
+    IUeGui::ITextMode& showViewTextMode() override
+    {
+        return textMode;
+    }
+    IUeGui::ICallMode& setCallMode() override
+    {
+        return callMode;
+    }
+    // kept as GUI keeps them - replacing callback shall not allocate either
+    void setAcceptCallback(IUeGui::Callback callback) override
+    {
+        acceptCallback = std::move(callback);
+    }
+    void setRejectCallback(IUeGui::Callback callback) override
+    {
+        rejectCallback = std::move(callback);
+    }
+    void setHomeCallback(IUeGui::Callback callback) override
+    {
+        homeCallback = std::move(callback);
+    }
+
+    // copied - state handling it might replace it
+    static void click(const IUeGui::Callback& callback)
+    {
+        auto copy = callback;
+        copy();
+    }
+
+    ListViewModeStub listViewMode;
+    CallModeStub callMode;
+    TextModeStub textMode;
+    IUeGui::Callback acceptCallback;
+    IUeGui::Callback rejectCallback;
+    IUeGui::Callback homeCallback;
+    std::size_t notConnectedShown = 0u;
+};
+
+struct TimerPortStub : ITimerPort
+{
+    void startTimer(Duration) override {}
+    void stopTimer() override {}
+};
+
+}
+
+class ContextTestSuite : public Test
+{
+protected:
+    SilentLogger logger;
+    BtsPortStub bts;
+    UserPortStub user;
+    TimerPortStub timer;
+    SmsDb smsDb;
+    Context context{logger, bts, user, timer, smsDb};
+};
+
+TEST_F(ContextTestSuite, shallDispatchEventToCurrentState)
+{
+    context.handle([](auto&) { FAIL() << "no state yet"; });
+
+    context.setState<NotConnectedState>();
+    context.handle([](auto& state) { state.handleSib(common::BtsId{1}); });
+
+    EXPECT_TRUE(std::holds_alternative<ConnectingState>(context.state));
+    EXPECT_EQ(1u, bts.attachRequests);
+}
+
+TEST_F(ContextTestSuite, shallSwitchStatesWithoutHeapAllocation)
+{
+    constexpr std::size_t ROUNDS = 1000000u;
+    Application application{common::PhoneNumber{1}, logger, bts, user, timer, smsDb};
+
+    const auto allocationsBefore = allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0u; i < ROUNDS; ++i)
+    {
+        application.handleSib(common::BtsId{1});
+        application.handleAttachReject();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(allocationsBefore, allocations.load());
+    EXPECT_EQ(ROUNDS, bts.attachRequests);
+    EXPECT_EQ(ROUNDS + 1u, user.notConnectedShown);
+    std::cout << "[UE-FSM] " << 2u * ROUNDS << " transitions: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / (2u * ROUNDS)
+              << " ns each" << std::endl;
+}
+
+TEST_F(ContextTestSuite, shallSwitchCallStatesWithoutHeapAllocation)
+{
+    constexpr std::size_t ROUNDS = 100000u;
+    constexpr common::PhoneNumber PEER{2};
+    constexpr IUeGui::IListViewMode::Selection DIAL_ITEM = 2u;
+    Application application{common::PhoneNumber{1}, logger, bts, user, timer, smsDb};
+    application.handleSib(common::BtsId{1});
+    application.handleAttachAccept();
+    user.listViewMode.selection = DIAL_ITEM;
+    user.callMode.outgoingText = to_string(PEER);
+
+    const auto allocationsBefore = allocations.load();
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0u; i < ROUNDS; ++i)
+    {
+        // Connected -> Dialling -> Connected
+        UserPortStub::click(user.acceptCallback);
+        UserPortStub::click(user.rejectCallback);
+        // Connected -> Dialling -> Talking -> Connected
+        UserPortStub::click(user.acceptCallback);
+        UserPortStub::click(user.acceptCallback);
+        application.handleCallAccepted(PEER);
+        UserPortStub::click(user.rejectCallback);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(allocationsBefore, allocations.load());
+    EXPECT_EQ(ROUNDS, bts.callRequests);
+    EXPECT_EQ(ROUNDS, bts.callsDropped);
+    std::cout << "[UE-FSM] " << 5u * ROUNDS << " call transitions: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / (5u * ROUNDS)
+              << " ns each" << std::endl;
+}
+
+}
@@ -33,7 +33,8 @@ protected:
     NiceMock<IListViewModeMock> listViewModeMock;
     NiceMock<ISmsComposeModeMock> smsComposeModeMock;
     
-    Context context{loggerMock, btsPortMock, userPortMock, timerPortMock};
+    SmsDb smsDb;
+    Context context{loggerMock, btsPortMock, userPortMock, timerPortMock, smsDb};
     IUeGui::Callback acceptCallback;
     IUeGui::Callback rejectCallback;
     
@@ -23,11 +23,13 @@ struct ApplicationTestSuite : Test
     StrictMock<ITimerPortMock> timerPortMock;
 
     Expectation showNotConnected = EXPECT_CALL(userPortMock, showNotConnected());
+    SmsDb smsDb;
     Application objectUnderTest{PHONE_NUMBER,
                                 loggerMock,
                                 btsPortMock,
                                 userPortMock,
-                                timerPortMock};
+                                timerPortMock,
+                                smsDb};
 };
 
 struct ApplicationNotConnectedTestSuite : ApplicationTestSuite
@@ -81,6 +83,19 @@ TEST_F(ApplicationConnectingTestSuite, shallConnectOnAttachAccept)
     objectUnderTest.handleAttachAccept();
 }
 
+TEST_F(ApplicationConnectingTestSuite, shallAttachAgainOnSibWhenAttachRequestWasLost)
+{
+    EXPECT_CALL(timerPortMock, startTimer(_));
+    EXPECT_CALL(btsPortMock, sendAttachRequest(BTS_ID));
+    objectUnderTest.handleSib(BTS_ID);
+
+    EXPECT_CALL(timerPortMock, stopTimer());
+    EXPECT_CALL(userPortMock, showConnected());
+    EXPECT_CALL(userPortMock, getListViewMode()).Times(AnyNumber()).WillRepeatedly(ReturnRef(listViewModeMock));
+    EXPECT_CALL(userPortMock, setAcceptCallback(_)).Times(AnyNumber());
+    objectUnderTest.handleAttachAccept();
+}
+
 TEST_F(ApplicationConnectingTestSuite, shallDisConnectOnAttachReject)
 {
     EXPECT_CALL(timerPortMock, stopTimer());
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "States/ConferenceState.hpp"
+#include "Context.hpp"
+#include "Mocks/ILoggerMock.hpp"
+#include "Mocks/IBtsPortMock.hpp"
+#include "Mocks/IUserPortMock.hpp"
+#include "Mocks/ITimerPortMock.hpp"
+#include "Mocks/IUeGuiMock.hpp"
+
+namespace ue
+{
+using namespace ::testing;
+
+class ConferenceStateTestSuite : public Test
+{
+protected:
+    const common::PhoneNumber HOST_NUMBER{1};
+    const common::PhoneNumber FIRST_NUMBER{2};
+    const common::PhoneNumber SECOND_NUMBER{3};
+    const std::vector<common::PhoneNumber> MEMBERS{HOST_NUMBER, FIRST_NUMBER, SECOND_NUMBER};
+    NiceMock<common::ILoggerMock> loggerMock;
+    NiceMock<IBtsPortMock> btsPortMock;
+    NiceMock<IUserPortMock> userPortMock;
+    NiceMock<ITimerPortMock> timerPortMock;
+    NiceMock<ICallModeMock> callModeMock;
+    NiceMock<ITextModeMock> textModeMock;
+    NiceMock<IListViewModeMock> listViewModeMock;
+
+    SmsDb smsDb;
+    Context context{loggerMock, btsPortMock, userPortMock, timerPortMock, smsDb};
+    IUeGui::Callback acceptCallback;
+    IUeGui::Callback rejectCallback;
+
+    ConferenceStateTestSuite()
+    {
+        ON_CALL(userPortMock, setCallMode()).WillByDefault(ReturnRef(callModeMock));
+        ON_CALL(userPortMock, showViewTextMode()).WillByDefault(ReturnRef(textModeMock));
+        ON_CALL(userPortMock, getListViewMode()).WillByDefault(ReturnRef(listViewModeMock));
+        ON_CALL(userPortMock, setAcceptCallback(_)).WillByDefault(SaveArg<0>(&acceptCallback));
+        ON_CALL(userPortMock, setRejectCallback(_)).WillByDefault(SaveArg<0>(&rejectCallback));
+    }
+};
+
+TEST_F(ConferenceStateTestSuite, shallShowParticipantsWithoutClearingCallTexts)
+{
+    EXPECT_CALL(callModeMock, showParticipants(MEMBERS));
+    EXPECT_CALL(callModeMock, clearIncomingText()).Times(0);
+
+    ConferenceState objectUnderTest{context, FIRST_NUMBER, MEMBERS};
+}
+
+TEST_F(ConferenceStateTestSuite, shallShowTalkOfAnyMemberWithSpeaker)
+{
+    ConferenceState objectUnderTest{context, HOST_NUMBER, MEMBERS};
+
+    EXPECT_CALL(callModeMock, appendIncomingText(to_string(SECOND_NUMBER) + ": hello"));
+    objectUnderTest.handleCallTalk(SECOND_NUMBER, "hello");
+}
+
+TEST_F(ConferenceStateTestSuite, shallEndWhenHostDrops)
+{
+    ConferenceState objectUnderTest{context, HOST_NUMBER, MEMBERS};
+
+    EXPECT_CALL(textModeMock, setText(HasSubstr(to_string(HOST_NUMBER))));
+    EXPECT_CALL(userPortMock, showConnected());
+    objectUnderTest.handleCallDropped(HOST_NUMBER);
+}
+
+TEST_F(ConferenceStateTestSuite, shallContinueWhenParticipantDropsToHost)
+{
+    // host: peer is its first participant
+    ConferenceState objectUnderTest{context, FIRST_NUMBER, MEMBERS};
+
+    EXPECT_CALL(callModeMock, showParticipants(ElementsAre(HOST_NUMBER, SECOND_NUMBER)));
+    objectUnderTest.handleCallDropped(FIRST_NUMBER);
+    ::testing::Mock::VerifyAndClearExpectations(&callModeMock);
+
+    // ...and hangs up to one still there
+    EXPECT_CALL(btsPortMock, sendCallDropped(SECOND_NUMBER));
+    rejectCallback();
+}
+
+TEST_F(ConferenceStateTestSuite, shallNotLetParticipantInvite)
+{
+    ConferenceState objectUnderTest{context, HOST_NUMBER, MEMBERS};
+
+    ON_CALL(callModeMock, getOutgoingText()).WillByDefault(Return(""));
+    ON_CALL(callModeMock, getInviteePhoneNumber()).WillByDefault(Return(common::PhoneNumber{77}));
+    EXPECT_CALL(btsPortMock, sendConferenceInvite(_)).Times(0);
+    acceptCallback();
+}
+
+TEST_F(ConferenceStateTestSuite, shallTalkWithPeerWhenMembersMissing)
+{
+    ConferenceState objectUnderTest{context, HOST_NUMBER, MEMBERS};
+
+    EXPECT_CALL(callModeMock, showParticipants(_)).Times(0);
+    EXPECT_CALL(callModeMock, clearIncomingText());
+    objectUnderTest.handleConferenceMembers({});
+    ::testing::Mock::VerifyAndClearExpectations(&callModeMock);
+
+    EXPECT_CALL(btsPortMock, sendCallDropped(HOST_NUMBER));
+    rejectCallback();
+}
+
+}
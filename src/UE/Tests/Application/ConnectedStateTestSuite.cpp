@@ -24,7 +24,8 @@ protected:
     NiceMock<ISmsComposeModeMock> smsComposeModeMock;
     NiceMock<IListViewModeMock> listViewModeMock;
     
-    Context context{loggerMock, btsPortMock, userPortMock, timerPortMock};
+    SmsDb smsDb;
+    Context context{loggerMock, btsPortMock, userPortMock, timerPortMock, smsDb};
     IUeGui::Callback acceptCallback;
     
     ConnectedStateTestSuite()
@@ -107,7 +108,7 @@ TEST_F(ConnectedStateTestSuite, shallTransitionToDiallingStateWhenDialClicked)
     EXPECT_CALL(userPortMock, showConnected());
     EXPECT_CALL(userPortMock, getListViewMode()).WillOnce(ReturnRef(listViewModeMock));
     EXPECT_CALL(listViewModeMock, clearSelectionList());
-    EXPECT_CALL(listViewModeMock, addSelectionListItem(_, _)).Times(3);  // Three menu items
+    EXPECT_CALL(listViewModeMock, addSelectionListItem(_, _)).Times(4);  // Four menu items
     EXPECT_CALL(userPortMock, setAcceptCallback(_)).WillOnce(SaveArg<0>(&acceptCallback));
     
     objectUnderTest.handleHomeClicked();
@@ -133,4 +134,45 @@ TEST_F(ConnectedStateTestSuite, shallTransitionToDiallingStateWhenDialClicked)
  
 }
 
-}
\ No newline at end of file
+TEST_F(ConnectedStateTestSuite, shallSearchSmsFromMenuNewestFirst)
+{
+    smsDb.addSms(PhoneNumber{41}, "Quokka picnic at noon");
+    smsDb.addSms(PhoneNumber{42}, "quokkas everywhere");
+    smsDb.addSentSms(PhoneNumber{41}, "no quokka today");
+    ConnectedState objectUnderTest{context};
+    EXPECT_CALL(userPortMock, setAcceptCallback(_)).WillOnce(SaveArg<0>(&acceptCallback));
+    objectUnderTest.handleHomeClicked();
+
+    IListViewModeMock::SearchCallback searchCallback;
+    EXPECT_CALL(userPortMock, showSmsListView());
+    EXPECT_CALL(listViewModeMock, setSearchCallback(IsTrue())).WillOnce(SaveArg<0>(&searchCallback));
+    EXPECT_CALL(userPortMock, setAcceptCallback(_)).WillOnce(SaveArg<0>(&acceptCallback));
+    EXPECT_CALL(listViewModeMock, getCurrentItemIndex()).WillOnce(Return(std::make_pair(true, 3u)));
+    acceptCallback();
+    ASSERT_TRUE(searchCallback);
+
+    using Item = IListViewModeMock::Item;
+    EXPECT_CALL(listViewModeMock, setSelectionList(ElementsAre(Item{"To: 41", "no quokka today"},
+                                                               Item{"From: 41", "Quokka picnic at noon"})));
+    searchCallback("QUOK @41");
+}
+
+TEST_F(ConnectedStateTestSuite, shallShowWholeSmsListAtOnceAndMarkItRead)
+{
+    constexpr std::size_t INBOX_SIZE = 1000u;
+    for (std::size_t i = 0u; i < INBOX_SIZE; ++i)
+    {
+        smsDb.addSms(PhoneNumber{7}, "text " + std::to_string(i));
+    }
+    ConnectedState objectUnderTest{context};
+
+    EXPECT_CALL(userPortMock, showSmsListView());
+    EXPECT_CALL(listViewModeMock, addSelectionListItem(_, _)).Times(0);
+    EXPECT_CALL(listViewModeMock, setSelectionList(SizeIs(INBOX_SIZE)));
+    EXPECT_CALL(userPortMock, showNewSms(false));
+    objectUnderTest.handleSmsViewClicked();
+
+    EXPECT_FALSE(smsDb.hasUnreadSms());
+}
+
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "Console/ConsoleUeGui.hpp"
+#include <sstream>
+
+namespace ue
+{
+using namespace ::testing;
+
+class ConsoleUeGuiTestSuite : public Test
+{
+protected:
+    std::ostringstream output;
+    ConsoleUeGui objectUnderTest{output};
+};
+
+TEST_F(ConsoleUeGuiTestSuite, shallPrintWhatIsShown)
+{
+    objectUnderTest.showConnected();
+    objectUnderTest.setViewTextMode().setText("line1\nline2");
+    objectUnderTest.setCallMode().showParticipants({PhoneNumber{1}, PhoneNumber{2}});
+
+    EXPECT_EQ("mode alert\n"
+              "text Connected\n"
+              "status connected\n"
+              "mode view text\n"
+              "text line1\\nline2\n"
+              "mode call\n"
+              "participants 1 2\n", output.str());
+}
+
+TEST_F(ConsoleUeGuiTestSuite, shallCallButtonCallbacks)
+{
+    StrictMock<MockFunction<void()>> accept, reject, home;
+    objectUnderTest.setAcceptCallback(accept.AsStdFunction());
+    objectUnderTest.setRejectCallback(reject.AsStdFunction());
+    objectUnderTest.setHomeCallback(home.AsStdFunction());
+
+    InSequence sequence;
+    EXPECT_CALL(accept, Call());
+    EXPECT_CALL(home, Call());
+    EXPECT_CALL(reject, Call());
+    EXPECT_TRUE(objectUnderTest.execute("accept"));
+    EXPECT_TRUE(objectUnderTest.execute("# skipped"));
+    EXPECT_TRUE(objectUnderTest.execute("home"));
+    EXPECT_TRUE(objectUnderTest.execute(""));
+    EXPECT_TRUE(objectUnderTest.execute("reject"));
+}
+
+TEST_F(ConsoleUeGuiTestSuite, shallKeepEnteredNumberAndText)
+{
+    objectUnderTest.execute("number 17");
+    objectUnderTest.execute("text hello world");
+
+    auto& smsComposeMode = objectUnderTest.setSmsComposeMode();
+    EXPECT_EQ(PhoneNumber{17}, smsComposeMode.getPhoneNumber());
+    EXPECT_EQ("hello world", smsComposeMode.getSmsText());
+    EXPECT_EQ(PhoneNumber{17}, objectUnderTest.setDialMode().getPhoneNumber());
+
+    smsComposeMode.clearSmsText();
+    EXPECT_EQ("", objectUnderTest.setCallMode().getOutgoingText());
+}
+
+TEST_F(ConsoleUeGuiTestSuite, shallRejectWrongPhoneNumber)
+{
+    objectUnderTest.execute("number 7");
+    objectUnderTest.execute("number 256");
+    objectUnderTest.execute("number abc");
+
+    EXPECT_EQ(PhoneNumber{7}, objectUnderTest.setDialMode().getPhoneNumber());
+    EXPECT_THAT(output.str(), HasSubstr("error wrong phone number: 256\n"));
+    EXPECT_THAT(output.str(), HasSubstr("error wrong phone number: abc\n"));
+}
+
+TEST_F(ConsoleUeGuiTestSuite, shallSelectOnlyShownItem)
+{
+    auto& listViewMode = objectUnderTest.setListViewMode();
+    listViewMode.setSelectionList({{"first", ""}, {"second", ""}});
+    EXPECT_FALSE(listViewMode.getCurrentItemIndex().first);
+
+    objectUnderTest.execute("select 2");
+    EXPECT_FALSE(listViewMode.getCurrentItemIndex().first);
+
+    objectUnderTest.execute("select 1");
+    EXPECT_EQ(std::make_pair(true, 1u), listViewMode.getCurrentItemIndex());
+
+    listViewMode.clearSelectionList();
+    EXPECT_FALSE(listViewMode.getCurrentItemIndex().first);
+    EXPECT_EQ("mode list\n"
+              "clear list\n"
+              "item 0 first\n"
+              "item 1 second\n"
+              "error no item 2\n"
+              "clear list\n", output.str());
+}
+
+TEST_F(ConsoleUeGuiTestSuite, shallPassSearchQuery)
+{
+    StrictMock<MockFunction<void(const std::string&)>> search;
+    objectUnderTest.setListViewMode().setSearchCallback(search.AsStdFunction());
+
+    EXPECT_CALL(search, Call("hello @12"));
+    objectUnderTest.execute("search hello @12");
+}
+
+TEST_F(ConsoleUeGuiTestSuite, shallQuitOnlyWhenCloseGuardAccepts)
+{
+    bool accepted = false;
+    objectUnderTest.setCloseGuard([&accepted] { return accepted; });
+
+    EXPECT_TRUE(objectUnderTest.execute("quit"));
+    accepted = true;
+    EXPECT_FALSE(objectUnderTest.execute("quit"));
+}
+
+TEST_F(ConsoleUeGuiTestSuite, shallReportUnknownCommand)
+{
+    EXPECT_TRUE(objectUnderTest.execute("dance now"));
+    EXPECT_EQ("error unknown command: dance\n", output.str());
+}
+
+}
@@ -18,6 +18,7 @@ struct IApplicationEnvironmentMock : public IApplicationEnvironment
     MOCK_METHOD(void, startMessageLoop, (), (final));
     MOCK_METHOD(common::PhoneNumber, getMyPhoneNumber, (), (const, final));
     MOCK_METHOD(int32_t, getProperty, (const std::string &name, int32_t defaultValue), (const, final));
+    MOCK_METHOD(const common::MultiLineConfig&, getConfiguration, (), (const, final));
 };
 
 }
@@ -22,6 +22,8 @@ public:
     MOCK_METHOD(void, handleCallDropped, (common::PhoneNumber), (final));
     MOCK_METHOD(void, handleCallTalk, (common::PhoneNumber, const std::string&), (final));
     MOCK_METHOD(void, handleUnknownRecipient, (), (final));
+    MOCK_METHOD(void, handleGroupSmsResult, (const std::vector<common::PhoneNumber>&), (final));
+    MOCK_METHOD(void, handleConferenceMembers, (const std::vector<common::PhoneNumber>&), (final));
 };
 
 class IBtsPortMock : public IBtsPort
@@ -36,6 +38,8 @@ public:
     MOCK_METHOD(void, sendCallAccepted, (common::PhoneNumber), (final));
     MOCK_METHOD(void, sendCallDropped, (common::PhoneNumber), (final));
     MOCK_METHOD(void, sendCallTalk, (common::PhoneNumber, const std::string&), (final));
+    MOCK_METHOD(void, sendGroupSms, (const std::vector<common::PhoneNumber>&, const std::string&), (final));
+    MOCK_METHOD(void, sendConferenceInvite, (common::PhoneNumber), (final));
 };
 
 }
\ No newline at end of file
@@ -43,6 +43,8 @@ public:
     MOCK_METHOD(OptionalSelection, getCurrentItemIndex, (), (const, final));
     MOCK_METHOD(void, addSelectionListItem, (const std::string &label, const std::string &tooltip), (final));
     MOCK_METHOD(void, clearSelectionList, (), (final));
+    MOCK_METHOD(void, setSelectionList, (Items), (final));
+    MOCK_METHOD(void, setSearchCallback, (SearchCallback), (final));
 };
 
 class ITextModeMock : public IUeGui::ITextMode
@@ -75,6 +77,8 @@ public:
     MOCK_METHOD(void, appendIncomingText, (const std::string &text), (final));
     MOCK_METHOD(void, clearOutgoingText, (), (final));
     MOCK_METHOD(std::string, getOutgoingText, (), (const, final));
+    MOCK_METHOD(PhoneNumber, getInviteePhoneNumber, (), (const, final));
+    MOCK_METHOD(void, showParticipants, (const std::vector<PhoneNumber>& participants), (final));
 };
 
 class IDialModeMock : public IUeGui::IDialMode
@@ -8,6 +8,9 @@
 #include "Mocks/ITransportMock.hpp"
 #include "Messages/OutgoingMessage.hpp"
 #include "Messages/IncomingMessage.hpp"
+#include "Messages/MessageBatch.hpp"
+#include "Messages/MessageCompression.hpp"
+#include "Messages/AttachFeature.hpp"
 
 namespace ue
 {
@@ -23,6 +26,8 @@ protected:
     StrictMock<common::ITransportMock> transportMock;
     common::ITransport::MessageCallback messageCallback;
     common::ITransport::DisconnectedCallback disconnectedCallback;
+    common::ITransport::ConnectedCallback connectedCallback;
+    common::BinaryMessage sentMessage;
 
     BtsPort objectUnderTest{loggerMock, transportMock, PHONE_NUMBER};
 
@@ -32,13 +37,56 @@ protected:
                 .WillOnce(SaveArg<0>(&messageCallback));
         EXPECT_CALL(transportMock, registerDisconnectedCallback(_))
                 .WillOnce(SaveArg<0>(&disconnectedCallback));
+        EXPECT_CALL(transportMock, registerConnectedCallback(_))
+                .WillOnce(SaveArg<0>(&connectedCallback));
         objectUnderTest.start(handlerMock);
     }
+    void grantCredits(std::uint16_t credits)
+    {
+        common::OutgoingMessage msg{common::MessageId::CreditGrant,
+                                    common::PhoneNumber{},
+                                    PHONE_NUMBER};
+        msg.writeNumber(credits);
+        messageCallback(msg.getMessage());
+    }
+
+    static std::uint16_t groupSmsId(const common::BinaryMessage& groupSms)
+    {
+        common::IncomingMessage reader(groupSms);
+        reader.readMessageHeader();
+        return reader.readNumber<std::uint16_t>();
+    }
+
+    static auto isMessage(common::MessageId expected)
+    {
+        return Truly([expected](const common::BinaryMessage& msg)
+        {
+            return common::IncomingMessage(msg).readMessageId() == expected;
+        });
+    }
+
+    void acceptAttach(common::AttachFeatures features)
+    {
+        EXPECT_CALL(handlerMock, handleAttachAccept());
+        common::OutgoingMessage attachAccept{common::MessageId::AttachResponse,
+                                             common::PhoneNumber{},
+                                             PHONE_NUMBER};
+        attachAccept.writeNumber(true);
+        attachAccept.writeNumber(features);
+        messageCallback(attachAccept.getMessage());
+    }
+
+    void attach()
+    {
+        acceptAttach(common::get(common::AttachFeature::None));
+    }
+
     ~BtsPortTestSuite()
     {
 
         EXPECT_CALL(transportMock, registerMessageCallback(IsNull()));
         EXPECT_CALL(transportMock, registerDisconnectedCallback(IsNull()));
+        EXPECT_CALL(transportMock, registerConnectedCallback(IsNull()));
         objectUnderTest.stop();
     }
 };
@@ -64,6 +112,27 @@ TEST_F(BtsPortTestSuite, shallHandleSib)
     messageCallback(msg.getMessage());
 }
 
+TEST_F(BtsPortTestSuite, shallWaitForSibWhenConnectedFirstTime)
+{
+    connectedCallback();
+}
+
+TEST_F(BtsPortTestSuite, shallAttachToLastBtsRightAfterReconnection)
+{
+    EXPECT_CALL(handlerMock, handleSib(BTS_ID));
+    common::OutgoingMessage msg{common::MessageId::Sib,
+                                common::PhoneNumber{},
+                                PHONE_NUMBER};
+    msg.writeBtsId(BTS_ID);
+    messageCallback(msg.getMessage());
+
+    EXPECT_CALL(handlerMock, handleDisconnected());
+    disconnectedCallback();
+
+    EXPECT_CALL(handlerMock, handleSib(BTS_ID));
+    connectedCallback();
+}
+
 TEST_F(BtsPortTestSuite, shallHandleAttachAccept)
 {
     EXPECT_CALL(handlerMock, handleAttachAccept());
@@ -94,6 +163,7 @@ TEST_F(BtsPortTestSuite, shallSendAttachRequest)
     ASSERT_NO_THROW(EXPECT_EQ(PHONE_NUMBER, reader.readPhoneNumber()));
     ASSERT_NO_THROW(EXPECT_EQ(common::PhoneNumber{}, reader.readPhoneNumber()));
     ASSERT_NO_THROW(EXPECT_EQ(BTS_ID, reader.readBtsId()));
+    ASSERT_NO_THROW(EXPECT_EQ(common::ALL_ATTACH_FEATURES, reader.readNumber<std::uint8_t>()));
     ASSERT_NO_THROW(reader.checkEndOfMessage());
 }
 
@@ -171,6 +241,7 @@ TEST_F(BtsPortTestSuite, shallHandleCallTalkMessage)
 TEST_F(BtsPortTestSuite, shallSendCallRequest)
 {
     const common::PhoneNumber RECIPIENT_NUMBER{123};
+    attach();
     common::BinaryMessage msg;
     
     EXPECT_CALL(transportMock, sendMessage(_)).WillOnce([&msg](auto param) { 
@@ -190,6 +261,7 @@ TEST_F(BtsPortTestSuite, shallSendCallRequest)
 TEST_F(BtsPortTestSuite, shallSendCallAccepted)
 {
     const common::PhoneNumber RECIPIENT_NUMBER{123};
+    attach();
     common::BinaryMessage msg;
     
     EXPECT_CALL(transportMock, sendMessage(_)).WillOnce([&msg](auto param) { 
@@ -209,6 +281,7 @@ TEST_F(BtsPortTestSuite, shallSendCallAccepted)
 TEST_F(BtsPortTestSuite, shallSendCallDropped)
 {
     const common::PhoneNumber RECIPIENT_NUMBER{123};
+    attach();
     common::BinaryMessage msg;
     
     EXPECT_CALL(transportMock, sendMessage(_)).WillOnce([&msg](auto param) { 
@@ -228,6 +301,7 @@ TEST_F(BtsPortTestSuite, shallSendCallDropped)
 TEST_F(BtsPortTestSuite, shallSendCallTalk)
 {
     const common::PhoneNumber RECIPIENT_NUMBER{123};
+    attach();
     const std::string TALK_TEXT = "Hello, this is a test call message!";
     common::BinaryMessage msg;
     
@@ -245,4 +319,359 @@ TEST_F(BtsPortTestSuite, shallSendCallTalk)
     ASSERT_NO_THROW(EXPECT_EQ(TALK_TEXT, reader.readRemainingText()));
 }
 
-}
\ No newline at end of file
+TEST_F(BtsPortTestSuite, shallSendGroupSmsInOneMessage)
+{
+    attach();
+    const std::vector<common::PhoneNumber> RECIPIENTS{common::PhoneNumber{1}, common::PhoneNumber{2}};
+    common::BinaryMessage msg;
+    EXPECT_CALL(transportMock, sendMessage(_)).WillOnce([&msg](auto param) { msg = std::move(param); return true; });
+
+    objectUnderTest.sendGroupSms(RECIPIENTS, "hello all");
+
+    common::IncomingMessage reader(msg);
+    ASSERT_NO_THROW(EXPECT_EQ(common::MessageId::GroupSms, reader.readMessageId()));
+    ASSERT_NO_THROW(EXPECT_EQ(PHONE_NUMBER, reader.readPhoneNumber()));
+    ASSERT_NO_THROW(EXPECT_EQ(common::PhoneNumber{}, reader.readPhoneNumber()));
+    ASSERT_NO_THROW(reader.readNumber<std::uint16_t>());
+    ASSERT_NO_THROW(EXPECT_EQ(RECIPIENTS.size(), reader.readNumber<std::uint8_t>()));
+    ASSERT_NO_THROW(EXPECT_EQ(RECIPIENTS[0], reader.readPhoneNumber()));
+    ASSERT_NO_THROW(EXPECT_EQ(RECIPIENTS[1], reader.readPhoneNumber()));
+    ASSERT_NO_THROW(EXPECT_EQ("hello all", reader.readRemainingText()));
+}
+
+TEST_F(BtsPortTestSuite, shallReportFailedRecipientsOfGroupSms)
+{
+    std::vector<common::PhoneNumber> recipients;
+    for (std::uint8_t i = 1u; i <= 10u; ++i)
+    {
+        recipients.push_back(common::PhoneNumber{i});
+    }
+    attach();
+    EXPECT_CALL(transportMock, sendMessage(_)).WillOnce(DoAll(SaveArg<0>(&sentMessage), Return(true)));
+    objectUnderTest.sendGroupSms(recipients, "hello all");
+
+    common::OutgoingMessage result{common::MessageId::GroupSmsResult,
+                                   common::PhoneNumber{},
+                                   PHONE_NUMBER};
+    result.writeNumber(groupSmsId(sentMessage));
+    result.writeNumber(static_cast<std::uint8_t>(recipients.size()));
+    result.writeNumber(std::uint8_t{0b00000010});
+    result.writeNumber(std::uint8_t{0b00000010});
+    EXPECT_CALL(handlerMock, handleGroupSmsResult(ElementsAre(recipients[1], recipients[9])));
+    messageCallback(result.getMessage());
+}
+
+TEST_F(BtsPortTestSuite, shallReportGroupSmsNotAnsweredByBtsAsFailed)
+{
+    const std::vector<common::PhoneNumber> DROPPED_RECIPIENTS{common::PhoneNumber{1}, common::PhoneNumber{2}};
+    const std::vector<common::PhoneNumber> RECIPIENTS{common::PhoneNumber{3}, common::PhoneNumber{4}};
+    attach();
+    EXPECT_CALL(transportMock, sendMessage(_)).WillOnce(Return(true))
+                                              .WillOnce(DoAll(SaveArg<0>(&sentMessage), Return(true)));
+    objectUnderTest.sendGroupSms(DROPPED_RECIPIENTS, "throttled by BTS");
+    objectUnderTest.sendGroupSms(RECIPIENTS, "hello all");
+
+    common::OutgoingMessage result{common::MessageId::GroupSmsResult,
+                                   common::PhoneNumber{},
+                                   PHONE_NUMBER};
+    result.writeNumber(groupSmsId(sentMessage));
+    result.writeNumber(static_cast<std::uint8_t>(RECIPIENTS.size()));
+    result.writeNumber(std::uint8_t{0b00000000});
+    InSequence seq;
+    EXPECT_CALL(handlerMock, handleGroupSmsResult(DROPPED_RECIPIENTS));
+    EXPECT_CALL(handlerMock, handleGroupSmsResult(IsEmpty()));
+    messageCallback(result.getMessage());
+    // answered ones are forgotten
+    messageCallback(result.getMessage());
+}
+
+TEST_F(BtsPortTestSuite, shallReportGroupSmsDroppedFromPendingAsFailed)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    const std::vector<common::PhoneNumber> RECIPIENTS{common::PhoneNumber{1}, common::PhoneNumber{2}};
+    acceptAttach(common::get(common::AttachFeature::FlowControl));
+
+    objectUnderTest.sendGroupSms(RECIPIENTS, "never sent");
+    for (std::size_t i = 0; i < BtsPort::MAX_PENDING_MESSAGES - 1u; ++i)
+    {
+        objectUnderTest.sendCallTalk(RECIPIENT_NUMBER, "talk");
+    }
+    EXPECT_CALL(handlerMock, handleGroupSmsResult(RECIPIENTS));
+    objectUnderTest.sendCallTalk(RECIPIENT_NUMBER, "talk");
+}
+
+TEST_F(BtsPortTestSuite, shallHandleConferenceInviteAsCallRequest)
+{
+    const common::PhoneNumber HOST_NUMBER{9};
+    EXPECT_CALL(handlerMock, handleCallRequest(HOST_NUMBER));
+    common::OutgoingMessage msg{common::MessageId::ConferenceInvite,
+                                HOST_NUMBER,
+                                PHONE_NUMBER};
+    messageCallback(msg.getMessage());
+}
+
+TEST_F(BtsPortTestSuite, shallHandleConferenceMembers)
+{
+    const std::vector<common::PhoneNumber> MEMBERS{common::PhoneNumber{9}, PHONE_NUMBER, common::PhoneNumber{7}};
+    EXPECT_CALL(handlerMock, handleConferenceMembers(MEMBERS));
+    common::OutgoingMessage msg{common::MessageId::ConferenceMembers,
+                                common::PhoneNumber{},
+                                PHONE_NUMBER};
+    msg.writeNumber(static_cast<std::uint8_t>(MEMBERS.size()));
+    for (auto member : MEMBERS)
+    {
+        msg.writePhoneNumber(member);
+    }
+    messageCallback(msg.getMessage());
+}
+
+TEST_F(BtsPortTestSuite, shallWaitForFirstGrantAfterAttachAcceptWithFlowControl)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    acceptAttach(common::get(common::AttachFeature::FlowControl));
+    objectUnderTest.sendSms(RECIPIENT_NUMBER, "first");
+    Mock::VerifyAndClearExpectations(&transportMock);
+
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::Sms))).WillOnce(Return(true));
+    grantCredits(1);
+}
+
+TEST_F(BtsPortTestSuite, shallSendWithoutCreditsWhenFlowControlNotAccepted)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    acceptAttach(common::get(common::AttachFeature::None));
+
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::Sms))).WillOnce(Return(true));
+    objectUnderTest.sendSms(RECIPIENT_NUMBER, "first");
+}
+
+TEST_F(BtsPortTestSuite, shallQueueMessagesWhenOutOfCredits)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    acceptAttach(common::get(common::AttachFeature::FlowControl));
+    grantCredits(1);
+
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::Sms))).WillOnce(Return(true));
+    objectUnderTest.sendSms(RECIPIENT_NUMBER, "first");
+    objectUnderTest.sendCallTalk(RECIPIENT_NUMBER, "second");
+    Mock::VerifyAndClearExpectations(&transportMock);
+
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::CallTalk))).WillOnce(Return(true));
+    grantCredits(2);
+}
+
+TEST_F(BtsPortTestSuite, shallDropOldestBulkPendingMessageWhenQueueFull)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    acceptAttach(common::get(common::AttachFeature::FlowControl));
+
+    objectUnderTest.sendCallRequest(RECIPIENT_NUMBER);
+    for (std::size_t i = 0; i < BtsPort::MAX_PENDING_MESSAGES; ++i)
+    {
+        objectUnderTest.sendCallTalk(RECIPIENT_NUMBER, "talk");
+    }
+
+    InSequence seq;
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::CallRequest))).WillOnce(Return(true));
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::CallTalk)))
+            .Times(BtsPort::MAX_PENDING_MESSAGES - 1u).WillRepeatedly(Return(true));
+    grantCredits(BtsPort::MAX_PENDING_MESSAGES + 1u);
+}
+
+TEST_F(BtsPortTestSuite, shallNotDropPendingCallControlBehindSms)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    acceptAttach(common::get(common::AttachFeature::FlowControl));
+
+    for (std::size_t i = 0; i < BtsPort::MAX_PENDING_MESSAGES; ++i)
+    {
+        objectUnderTest.sendSms(RECIPIENT_NUMBER, "sms");
+    }
+    objectUnderTest.sendCallDropped(RECIPIENT_NUMBER);
+
+    InSequence seq;
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::Sms)))
+            .Times(BtsPort::MAX_PENDING_MESSAGES - 1u).WillRepeatedly(Return(true));
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::CallDropped))).WillOnce(Return(true));
+    grantCredits(BtsPort::MAX_PENDING_MESSAGES);
+}
+
+TEST_F(BtsPortTestSuite, shallHoldMessagesTillAttached)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    objectUnderTest.sendSms(RECIPIENT_NUMBER, "before attach");
+
+    InSequence seq;
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::Sms))).WillOnce(Return(true));
+    attach();
+}
+
+TEST_F(BtsPortTestSuite, shallForgetCreditsOnReattach)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    acceptAttach(common::get(common::AttachFeature::FlowControl));
+    grantCredits(1);
+
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::AttachRequest))).WillOnce(Return(true));
+    objectUnderTest.sendAttachRequest(BTS_ID);
+    objectUnderTest.sendCallRequest(RECIPIENT_NUMBER);
+    Mock::VerifyAndClearExpectations(&transportMock);
+
+    acceptAttach(common::get(common::AttachFeature::FlowControl));
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::CallRequest))).WillOnce(Return(true));
+    grantCredits(1);
+}
+
+TEST_F(BtsPortTestSuite, shallSendMessagesHeldOverReconnectionOnlyAfterAttachAndGrant)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    acceptAttach(common::get(common::AttachFeature::FlowControl) | common::get(common::AttachFeature::Compression));
+    EXPECT_CALL(handlerMock, handleDisconnected());
+    disconnectedCallback();
+
+    const std::string LONG_TEXT(200u, 'a');
+    objectUnderTest.sendSms(RECIPIENT_NUMBER, LONG_TEXT);
+    objectUnderTest.sendCallTalk(RECIPIENT_NUMBER, "second");
+
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::AttachRequest))).WillOnce(Return(true));
+    objectUnderTest.sendAttachRequest(BTS_ID);
+    acceptAttach(common::get(common::AttachFeature::FlowControl));
+    Mock::VerifyAndClearExpectations(&transportMock);
+
+    // new session without compression - held message goes as built
+    common::BinaryMessage msg;
+    EXPECT_CALL(transportMock, sendMessage(_)).WillOnce([&msg](auto param) { msg = std::move(param); return true; });
+    grantCredits(1);
+    ASSERT_FALSE(common::isCompressed(msg));
+    ASSERT_EQ(common::MessageId::Sms, common::IncomingMessage(msg).readMessageId());
+    Mock::VerifyAndClearExpectations(&transportMock);
+
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::CallTalk))).WillOnce(Return(true));
+    grantCredits(1);
+}
+
+TEST_F(BtsPortTestSuite, shallDropHeldMessagesWhenAttachRejected)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    objectUnderTest.sendSms(RECIPIENT_NUMBER, "never sent");
+
+    EXPECT_CALL(handlerMock, handleAttachReject());
+    common::OutgoingMessage attachReject{common::MessageId::AttachResponse, common::PhoneNumber{}, PHONE_NUMBER};
+    attachReject.writeNumber(false);
+    messageCallback(attachReject.getMessage());
+
+    attach();
+}
+
+TEST_F(BtsPortTestSuite, shallAttachAgainOnSibWhenAttachedKeepingPendingMessages)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    acceptAttach(common::get(common::AttachFeature::FlowControl));
+    objectUnderTest.sendCallRequest(RECIPIENT_NUMBER);
+
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::AttachRequest))).WillOnce(Return(true));
+    common::OutgoingMessage sib{common::MessageId::Sib, common::PhoneNumber{}, PHONE_NUMBER};
+    sib.writeBtsId(BTS_ID);
+    messageCallback(sib.getMessage());
+    Mock::VerifyAndClearExpectations(&transportMock);
+
+    // no state change - UE is still attached
+    objectUnderTest.sendCallTalk(RECIPIENT_NUMBER, "held till accept");
+    common::OutgoingMessage attachAccept{common::MessageId::AttachResponse, common::PhoneNumber{}, PHONE_NUMBER};
+    attachAccept.writeNumber(true);
+    attachAccept.writeNumber(common::get(common::AttachFeature::FlowControl));
+    messageCallback(attachAccept.getMessage());
+
+    InSequence seq;
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::CallRequest))).WillOnce(Return(true));
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::CallTalk))).WillOnce(Return(true));
+    grantCredits(2);
+}
+
+TEST_F(BtsPortTestSuite, shallReportDisconnectedWhenAttachAgainRejected)
+{
+    acceptAttach(common::get(common::AttachFeature::None));
+
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::AttachRequest))).WillOnce(Return(true));
+    common::OutgoingMessage sib{common::MessageId::Sib, common::PhoneNumber{}, PHONE_NUMBER};
+    sib.writeBtsId(BTS_ID);
+    messageCallback(sib.getMessage());
+
+    EXPECT_CALL(handlerMock, handleDisconnected());
+    common::OutgoingMessage attachReject{common::MessageId::AttachResponse, common::PhoneNumber{}, PHONE_NUMBER};
+    attachReject.writeNumber(false);
+    messageCallback(attachReject.getMessage());
+}
+
+TEST_F(BtsPortTestSuite, shallHandleEachMessageOfBatch)
+{
+    const common::PhoneNumber SENDER_NUMBER{123};
+    common::MessageBatch batch{common::PhoneNumber{}, PHONE_NUMBER};
+    common::OutgoingMessage sms{common::MessageId::Sms, SENDER_NUMBER, PHONE_NUMBER};
+    sms.writeText("first");
+    batch.add(sms.getMessage());
+    batch.add(common::OutgoingMessage{common::MessageId::CallRequest, SENDER_NUMBER, PHONE_NUMBER}.getMessage());
+
+    InSequence seq;
+    EXPECT_CALL(handlerMock, handleSms(SENDER_NUMBER, "first"));
+    EXPECT_CALL(handlerMock, handleCallRequest(SENDER_NUMBER));
+    messageCallback(batch.take());
+}
+
+TEST_F(BtsPortTestSuite, shallPackMessagesReleasedByCreditsWhenBatchingAccepted)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    acceptAttach(common::get(common::AttachFeature::Batching));
+
+    grantCredits(0);
+    objectUnderTest.sendSms(RECIPIENT_NUMBER, "first");
+    objectUnderTest.sendCallTalk(RECIPIENT_NUMBER, "second");
+
+    common::BinaryMessage msg;
+    EXPECT_CALL(transportMock, sendMessage(_)).WillOnce([&msg](auto param) { msg = std::move(param); return true; });
+    grantCredits(2);
+    const auto messages = common::MessageBatch::unpack(msg);
+    ASSERT_EQ(2u, messages.size());
+    ASSERT_EQ(common::MessageId::Sms, common::IncomingMessage(messages[0]).readMessageId());
+    ASSERT_EQ(common::MessageId::CallTalk, common::IncomingMessage(messages[1]).readMessageId());
+}
+
+TEST_F(BtsPortTestSuite, shallSendLongTextCompressedWhenAccepted)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    const std::string LONG_TEXT(200u, 'a');
+    acceptAttach(common::get(common::AttachFeature::Compression));
+
+    common::BinaryMessage msg;
+    EXPECT_CALL(transportMock, sendMessage(_)).WillOnce([&msg](auto param) { msg = std::move(param); return true; });
+    objectUnderTest.sendSms(RECIPIENT_NUMBER, LONG_TEXT);
+
+    ASSERT_TRUE(common::isCompressed(msg));
+    const common::BinaryMessage decompressed = common::decompressMessage(msg);
+    common::IncomingMessage reader(decompressed);
+    ASSERT_EQ(common::MessageId::Sms, reader.readMessageId());
+    reader.readPhoneNumber();
+    reader.readPhoneNumber();
+    ASSERT_EQ(LONG_TEXT, reader.readRemainingText());
+}
+
+TEST_F(BtsPortTestSuite, shallNotCompressWithoutFeatureAccepted)
+{
+    const common::PhoneNumber RECIPIENT_NUMBER{123};
+    attach();
+    EXPECT_CALL(transportMock, sendMessage(isMessage(common::MessageId::Sms))).WillOnce(Return(true));
+    objectUnderTest.sendSms(RECIPIENT_NUMBER, std::string(200u, 'a'));
+}
+
+TEST_F(BtsPortTestSuite, shallHandleCompressedCallTalk)
+{
+    const common::PhoneNumber SENDER_NUMBER{123};
+    const std::string LONG_TEXT(200u, 'b');
+    common::OutgoingMessage msg{common::MessageId::CallTalk, SENDER_NUMBER, PHONE_NUMBER};
+    msg.writeText(LONG_TEXT);
+
+    EXPECT_CALL(handlerMock, handleCallTalk(SENDER_NUMBER, LONG_TEXT));
+    messageCallback(*common::compressMessage(msg.getMessage()));
+}
+
+}
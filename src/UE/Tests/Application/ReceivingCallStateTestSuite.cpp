@@ -27,7 +27,8 @@ protected:
     NiceMock<IListViewModeMock> listViewModeMock;
     NiceMock<ICallModeMock> callModeMock;
     
-    Context context{loggerMock, btsPortMock, userPortMock, timerPortMock};
+    SmsDb smsDb;
+    Context context{loggerMock, btsPortMock, userPortMock, timerPortMock, smsDb};
     IUeGui::Callback acceptCallback;
     IUeGui::Callback rejectCallback;
     
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
+#include <gmock/gmock.h>
 #include "SmsDb.hpp"
+#include <chrono>
+#include <thread>
 
 namespace ue
 {
@@ -163,4 +166,156 @@ TEST_F(SmsDbTestSuite, shallDistinguishBetweenReceivedAndSentMessages)
     EXPECT_EQ(receivedText, messages[1].text);
 }
 
-}
\ No newline at end of file
+TEST_F(SmsDbTestSuite, shallCountUnreadMessages)
+{
+    objectUnderTest.addSms(common::PhoneNumber{1}, "first");
+    objectUnderTest.addSentSms(common::PhoneNumber{2}, "sent");
+    objectUnderTest.addSms(common::PhoneNumber{3}, "second");
+    EXPECT_EQ(2u, objectUnderTest.unreadCount());
+
+    objectUnderTest.markAsRead(0);
+    objectUnderTest.markAsRead(0);
+    EXPECT_EQ(1u, objectUnderTest.unreadCount());
+
+    objectUnderTest.markAllAsRead();
+    EXPECT_EQ(0u, objectUnderTest.unreadCount());
+    EXPECT_TRUE(objectUnderTest.at(2).isRead);
+}
+
+TEST_F(SmsDbTestSuite, shallMarkSelectedMessagesAsRead)
+{
+    objectUnderTest.addSms(common::PhoneNumber{1}, "first");
+    objectUnderTest.addSms(common::PhoneNumber{2}, "second");
+    objectUnderTest.addSms(common::PhoneNumber{1}, "third");
+
+    const auto conversation = objectUnderTest.getConversation(common::PhoneNumber{1});
+    const std::vector<std::size_t> indices{conversation.indexAt(0), conversation.indexAt(1)};
+    objectUnderTest.markAsRead(indices);
+
+    EXPECT_EQ(1u, objectUnderTest.unreadCount());
+    EXPECT_FALSE(objectUnderTest.at(1).isRead);
+}
+
+TEST_F(SmsDbTestSuite, shallGetConversationWithPeer)
+{
+    const common::PhoneNumber peer{5};
+    objectUnderTest.addSms(peer, "question");
+    objectUnderTest.addSms(common::PhoneNumber{6}, "other");
+    objectUnderTest.addSentSms(peer, "answer");
+
+    const auto conversation = objectUnderTest.getConversation(peer);
+    ASSERT_EQ(2u, conversation.size());
+    EXPECT_EQ("question", conversation[0].text);
+    EXPECT_EQ("answer", conversation[1].text);
+    EXPECT_EQ(2u, objectUnderTest.getReceivedMessages().size());
+}
+
+TEST_F(SmsDbTestSuite, shallGetPages)
+{
+    for (int i = 0; i < 5; ++i)
+    {
+        objectUnderTest.addSms(common::PhoneNumber{1}, std::to_string(i));
+    }
+
+    auto page = objectUnderTest.getPage(3, 10);
+    ASSERT_EQ(2u, page.size());
+    EXPECT_EQ("3", page[0].text);
+    EXPECT_TRUE(objectUnderTest.getPage(7, 10).empty());
+}
+
+TEST_F(SmsDbTestSuite, shallKeepLargeInboxOperationsCheap)
+{
+    constexpr std::size_t INBOX_SIZE = 100000u;
+    for (std::size_t i = 0; i < INBOX_SIZE; ++i)
+    {
+        objectUnderTest.addSms(common::PhoneNumber{static_cast<std::uint8_t>(i)}, "message");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(INBOX_SIZE, objectUnderTest.getSmsMessages().size());
+    EXPECT_EQ(INBOX_SIZE / 256u + 1u, objectUnderTest.getConversation(common::PhoneNumber{0}).size());
+    EXPECT_TRUE(objectUnderTest.hasUnreadSms());
+    objectUnderTest.markAllAsRead();
+    EXPECT_FALSE(objectUnderTest.hasUnreadSms());
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "[SMSDB] " << INBOX_SIZE << " messages: view + mark all as read "
+              << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() << " us" << std::endl;
+}
+
+TEST_F(SmsDbTestSuite, shallSearchWordPrefixesOfAllTerms)
+{
+    objectUnderTest.addSms(common::PhoneNumber{1}, "Meeting moved to Friday");
+    objectUnderTest.addSentSms(common::PhoneNumber{2}, "friday works, see you at the meeting");
+    objectUnderTest.addSms(common::PhoneNumber{1}, "Fridge is empty");
+
+    EXPECT_THAT(objectUnderTest.search("fri"), ElementsAre(0u, 1u, 2u));
+    EXPECT_THAT(objectUnderTest.search("MEET friday"), ElementsAre(0u, 1u));
+    EXPECT_THAT(objectUnderTest.search("fri", common::PhoneNumber{1}), ElementsAre(0u, 2u));
+    EXPECT_THAT(objectUnderTest.search("", common::PhoneNumber{2}), ElementsAre(1u));
+    EXPECT_THAT(objectUnderTest.search("ting"), IsEmpty());
+    EXPECT_THAT(objectUnderTest.search(" ,. "), IsEmpty());
+}
+
+TEST_F(SmsDbTestSuite, shallTokenizeCaseInsensitiveWords)
+{
+    EXPECT_THAT(SmsSearchIndex::tokenize("Hi, it's 5pm!  Łódź"), ElementsAre("hi", "it", "s", "5pm", "Łódź"));
+}
+
+TEST_F(SmsDbTestSuite, shallSearchLargeInboxQuickly)
+{
+    constexpr std::size_t INBOX_SIZE = 100000u;
+    for (std::size_t i = 0; i < INBOX_SIZE; ++i)
+    {
+        objectUnderTest.addSms(common::PhoneNumber{static_cast<std::uint8_t>(i)},
+                               "message number " + std::to_string(i) + " about topic" + std::to_string(i % 100u));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(1u, objectUnderTest.search("number 12345").size());
+    EXPECT_EQ(INBOX_SIZE / 100u, objectUnderTest.search("topic42").size());
+    EXPECT_EQ(INBOX_SIZE / 256u + 1u, objectUnderTest.search("message", common::PhoneNumber{0}).size());
+    EXPECT_EQ(11u, objectUnderTest.search("about 1234").size());
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "[SMSDB] " << INBOX_SIZE << " messages: 4 searches "
+              << std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() << " us" << std::endl;
+}
+
+TEST_F(SmsDbTestSuite, shallLetOtherThreadsReadWhileOwnerWrites)
+{
+    constexpr std::size_t MESSAGES = 20000u;
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        std::size_t lastSize = 0u;
+        while (not done)
+        {
+            const auto size = objectUnderTest.size();
+            EXPECT_GE(size, lastSize);
+            lastSize = size;
+            EXPECT_LE(objectUnderTest.unreadCount(), size);
+            const auto page = objectUnderTest.copyPage(size > 10u ? size - 10u : 0u, 10u);
+            for (const auto& message : page)
+            {
+                EXPECT_EQ(0u, message.text.find("text "));
+            }
+            objectUnderTest.search("text", common::PhoneNumber{7});
+        }
+    });
+
+    for (std::size_t i = 0; i < MESSAGES; ++i)
+    {
+        objectUnderTest.addSms(common::PhoneNumber{static_cast<std::uint8_t>(i)}, "text " + std::to_string(i));
+        if (i % 3u == 0u)
+        {
+            objectUnderTest.markAsRead(i);
+        }
+    }
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(MESSAGES, objectUnderTest.size());
+    EXPECT_EQ(MESSAGES - (MESSAGES + 2u) / 3u, objectUnderTest.unreadCount());
+}
+
+}
@@ -0,0 +1,317 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "SmsLog.hpp"
+#include "Config/MultiLineConfig.hpp"
+#include "Mocks/ILoggerMock.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace ue
+{
+using namespace ::testing;
+
+class SmsLogTestSuite : public Test
+{
+protected:
+    const std::string path = (std::filesystem::temp_directory_path()
+                              / ("ue_sms_log_ut_" + std::to_string(::getpid()) + ".log")).string();
+    const std::string indexPath = path + ".idx";
+    // of counts in log and index headers, see SmsLog.cpp
+    static constexpr std::streamoff LOG_SMS_COUNT_OFFSET = 32;
+    static constexpr std::streamoff INDEX_COUNT_OFFSET = 16;
+    NiceMock<common::ILoggerMock> loggerMock;
+    SmsLog::Options options;
+
+    SmsLogTestSuite()
+    {
+        options.path = path;
+        removeFiles();
+    }
+    ~SmsLogTestSuite() override
+    {
+        removeFiles();
+    }
+
+    void removeFiles()
+    {
+        std::filesystem::remove(path);
+        std::filesystem::remove(indexPath);
+    }
+
+    std::unique_ptr<SmsLog> openLog()
+    {
+        return std::make_unique<SmsLog>(options, loggerMock);
+    }
+
+    static SmsMessage received(std::uint8_t from, const std::string& text)
+    {
+        return SmsMessage{PhoneNumber{from}, PhoneNumber{}, text, false, false};
+    }
+};
+
+TEST_F(SmsLogTestSuite, shallStartEmpty)
+{
+    auto objectUnderTest = openLog();
+
+    EXPECT_EQ(0u, objectUnderTest->size());
+    EXPECT_EQ(0u, objectUnderTest->garbageBytes());
+}
+
+TEST_F(SmsLogTestSuite, shallReloadMessagesWithReadState)
+{
+    {
+        auto objectUnderTest = openLog();
+        objectUnderTest->append(received(11, "first"));
+        objectUnderTest->append(SmsMessage{PhoneNumber{}, PhoneNumber{22}, "sent", true, true});
+        objectUnderTest->append(received(33, "third"));
+        objectUnderTest->markAsRead(0u);
+    }
+
+    auto objectUnderTest = openLog();
+
+    ASSERT_EQ(3u, objectUnderTest->size());
+    const auto first = objectUnderTest->read(0u);
+    EXPECT_EQ(PhoneNumber{11}, first.from);
+    EXPECT_EQ("first", first.text);
+    EXPECT_TRUE(first.isRead);
+    const auto sent = objectUnderTest->read(1u);
+    EXPECT_EQ(PhoneNumber{22}, sent.to);
+    EXPECT_TRUE(sent.isSent);
+    EXPECT_FALSE(objectUnderTest->read(2u).isRead);
+}
+
+TEST_F(SmsLogTestSuite, shallIgnoreBytesPastCommittedEnd)
+{
+    std::uintmax_t committedEnd;
+    {
+        auto objectUnderTest = openLog();
+        objectUnderTest->append(received(11, "kept"));
+        committedEnd = objectUnderTest->fileSize();
+    }
+    {
+        // as left by process killed during append
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(committedEnd);
+        file << std::string(100u, '\x5A');
+    }
+
+    auto objectUnderTest = openLog();
+    objectUnderTest->append(received(22, "next"));
+
+    ASSERT_EQ(2u, objectUnderTest->size());
+    EXPECT_EQ("kept", objectUnderTest->read(0u).text);
+    EXPECT_EQ("next", objectUnderTest->read(1u).text);
+}
+
+TEST_F(SmsLogTestSuite, shallCountMessageCommittedButNotCounted)
+{
+    {
+        auto objectUnderTest = openLog();
+        objectUnderTest->append(received(11, "first"));
+        objectUnderTest->append(received(22, "second"));
+    }
+    {
+        // as left by process killed between commit and count of the second message
+        const std::uint64_t count = 1u;
+        std::fstream log(path, std::ios::in | std::ios::out | std::ios::binary);
+        log.seekp(LOG_SMS_COUNT_OFFSET);
+        log.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        std::fstream index(indexPath, std::ios::in | std::ios::out | std::ios::binary);
+        index.seekp(INDEX_COUNT_OFFSET);
+        index.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    auto objectUnderTest = openLog();
+    objectUnderTest->append(received(33, "third"));
+    objectUnderTest->markAsRead(2u);
+
+    ASSERT_EQ(3u, objectUnderTest->size());
+    EXPECT_EQ("second", objectUnderTest->read(1u).text);
+    EXPECT_FALSE(objectUnderTest->read(1u).isRead);
+    EXPECT_TRUE(objectUnderTest->read(2u).isRead);
+}
+
+TEST_F(SmsLogTestSuite, shallRebuildMissingIndex)
+{
+    {
+        auto objectUnderTest = openLog();
+        objectUnderTest->append(received(11, "first"));
+        objectUnderTest->append(received(22, "second"));
+        objectUnderTest->markAsRead(1u);
+    }
+    std::filesystem::remove(indexPath);
+
+    auto objectUnderTest = openLog();
+
+    ASSERT_EQ(2u, objectUnderTest->size());
+    EXPECT_FALSE(objectUnderTest->read(0u).isRead);
+    EXPECT_TRUE(objectUnderTest->read(1u).isRead);
+    EXPECT_EQ("second", objectUnderTest->read(1u).text);
+}
+
+TEST_F(SmsLogTestSuite, shallDropDamagedTailWhenRebuildingIndex)
+{
+    std::uintmax_t damagedOffset;
+    {
+        auto objectUnderTest = openLog();
+        objectUnderTest->append(received(11, "intact"));
+        damagedOffset = objectUnderTest->fileSize() + 12u;
+        objectUnderTest->append(received(22, "damaged"));
+    }
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(damagedOffset);
+        file << 'X';
+    }
+    std::filesystem::remove(indexPath);
+
+    auto objectUnderTest = openLog();
+
+    ASSERT_EQ(1u, objectUnderTest->size());
+    EXPECT_EQ("intact", objectUnderTest->read(0u).text);
+}
+
+TEST_F(SmsLogTestSuite, shallRejectOtherFile)
+{
+    {
+        std::ofstream file(path);
+        file << "this is not an SMS log, but some other file which shall not be overwritten";
+    }
+
+    EXPECT_THROW(openLog(), SmsLog::Error);
+}
+
+TEST_F(SmsLogTestSuite, shallCompactReadMarksKeepingMessagesAppendedMeanwhile)
+{
+    constexpr std::size_t COUNT = 1000u;
+    options.compactionMinBytes = 1024u;
+    options.compactionPercent = 10u;
+    auto objectUnderTest = openLog();
+    for (std::size_t i = 0u; i < COUNT; ++i)
+    {
+        objectUnderTest->append(received(i % 200u, "message " + std::to_string(i)));
+    }
+    std::size_t read = 0u;
+    while (not objectUnderTest->isCompacting())
+    {
+        ASSERT_LT(read, COUNT);
+        objectUnderTest->markAsRead(read++);
+    }
+    const auto sizeBeforeCompaction = objectUnderTest->fileSize();
+    objectUnderTest->append(received(7, "appended during compaction"));
+    objectUnderTest->markAsRead(read++);
+
+    objectUnderTest->waitForCompaction();
+
+    EXPECT_FALSE(objectUnderTest->isCompacting());
+    EXPECT_LT(objectUnderTest->fileSize(), sizeBeforeCompaction);
+    objectUnderTest.reset();
+    auto reopened = openLog();
+    ASSERT_EQ(COUNT + 1u, reopened->size());
+    for (std::size_t i = 0u; i < COUNT; ++i)
+    {
+        const auto message = reopened->read(i);
+        EXPECT_EQ("message " + std::to_string(i), message.text);
+        EXPECT_EQ(i < read, message.isRead) << i;
+    }
+    EXPECT_EQ("appended during compaction", reopened->read(COUNT).text);
+
+    // index rebuilt from compacted log tells the same
+    reopened.reset();
+    std::filesystem::remove(indexPath);
+    reopened = openLog();
+    ASSERT_EQ(COUNT + 1u, reopened->size());
+    EXPECT_TRUE(reopened->read(read - 1u).isRead);
+    EXPECT_FALSE(reopened->read(read).isRead);
+}
+
+TEST_F(SmsLogTestSuite, shallKeepAppendingToCompactedLogWhenItsIndexIsNotRenamed)
+{
+    options.compactionMinBytes = 1024u;
+    options.compactionPercent = 10u;
+    auto objectUnderTest = openLog();
+    std::size_t count = 0u;
+    for (; count < 100u; ++count)
+    {
+        objectUnderTest->append(received(11, "message " + std::to_string(count)));
+    }
+    for (std::size_t read = 0u; not objectUnderTest->isCompacting(); ++read)
+    {
+        ASSERT_LT(read, count);
+        objectUnderTest->markAsRead(read);
+    }
+    // index cannot be replaced - only after the log is
+    std::filesystem::remove(indexPath);
+    std::filesystem::create_directories(std::filesystem::path(indexPath) / "blocker");
+
+    objectUnderTest->waitForCompaction();
+    objectUnderTest->append(received(22, "after compaction"));
+    objectUnderTest.reset();
+
+    std::filesystem::remove_all(indexPath);
+    auto reopened = openLog();
+    ASSERT_EQ(count + 1u, reopened->size());
+    EXPECT_EQ("message 0", reopened->read(0u).text);
+    EXPECT_TRUE(reopened->read(0u).isRead);
+    EXPECT_EQ("after compaction", reopened->read(count).text);
+}
+
+TEST_F(SmsLogTestSuite, shallPersistSmsDb)
+{
+    {
+        SmsDb smsDb;
+        smsDb.persistTo(openLog());
+        smsDb.addSms(PhoneNumber{11}, "hello");
+        smsDb.addSentSms(PhoneNumber{11}, "hi");
+        smsDb.addSms(PhoneNumber{22}, "unread");
+        smsDb.markAsRead(0u);
+    }
+
+    SmsDb smsDb;
+    smsDb.persistTo(openLog());
+
+    ASSERT_EQ(3u, smsDb.size());
+    EXPECT_EQ(1u, smsDb.unreadCount());
+    EXPECT_EQ(2u, smsDb.getConversation(PhoneNumber{11}).size());
+    EXPECT_EQ("unread", smsDb.getReceivedMessages()[1].text);
+}
+
+TEST_F(SmsLogTestSuite, shallNotPersistSmsDbToLogNotLoaded)
+{
+    std::uintmax_t damagedOffset;
+    {
+        auto objectUnderTest = openLog();
+        // not the last one - its damage is found on open already
+        damagedOffset = objectUnderTest->fileSize() + 12u;
+        objectUnderTest->append(received(11, "damaged"));
+        objectUnderTest->append(received(22, "intact"));
+    }
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(damagedOffset);
+        file << 'X';
+    }
+
+    SmsDb smsDb;
+    EXPECT_THROW(smsDb.persistTo(openLog()), SmsLog::Error);
+    smsDb.addSms(PhoneNumber{33}, "not stored");
+
+    EXPECT_EQ(2u, openLog()->size());
+}
+
+TEST_F(SmsLogTestSuite, shallReadOptionsFromConfig)
+{
+    std::istringstream input("smsLog = /tmp/inbox.log\nsmsLogCompactionPercent = 25\n");
+    common::MultiLineConfig configuration(input);
+
+    const auto configured = SmsLog::Options::fromConfig(configuration, PhoneNumber{12});
+
+    EXPECT_EQ("/tmp/inbox.log", configured.path);
+    EXPECT_EQ(25u, configured.compactionPercent);
+    EXPECT_EQ(SmsLog::Options{}.compactionMinBytes, configured.compactionMinBytes);
+    EXPECT_EQ("ue12_sms.log", SmsLog::Options::fromConfig(common::MultiLineConfig(0, nullptr), PhoneNumber{12}).path);
+}
+
+}
@@ -26,7 +26,8 @@ protected:
     NiceMock<ITextModeMock> textModeMock;
     NiceMock<IListViewModeMock> listViewModeMock;
     
-    Context context{loggerMock, btsPortMock, userPortMock, timerPortMock};
+    SmsDb smsDb;
+    Context context{loggerMock, btsPortMock, userPortMock, timerPortMock, smsDb};
     IUeGui::Callback acceptCallback;
     IUeGui::Callback rejectCallback;
     
@@ -158,4 +159,31 @@ TEST_F(TalkingStateTestSuite, shallIgnoreCallDroppedFromWrongNumber)
     objectUnderTest.handleCallDropped(WRONG_NUMBER);
 }
 
-}
\ No newline at end of file
+TEST_F(TalkingStateTestSuite, shallInviteNumberEnteredWithoutTalkText)
+{
+    const common::PhoneNumber INVITEE_NUMBER{77};
+    TalkingState objectUnderTest{context, PEER_NUMBER};
+    ::testing::Mock::VerifyAndClearExpectations(&userPortMock);
+    ::testing::Mock::VerifyAndClearExpectations(&btsPortMock);
+    ::testing::Mock::VerifyAndClearExpectations(&callModeMock);
+
+    EXPECT_CALL(userPortMock, setCallMode());
+    EXPECT_CALL(callModeMock, getOutgoingText()).WillOnce(Return(""));
+    EXPECT_CALL(callModeMock, getInviteePhoneNumber()).WillOnce(Return(INVITEE_NUMBER));
+    EXPECT_CALL(btsPortMock, sendConferenceInvite(INVITEE_NUMBER));
+
+    acceptCallback();
+}
+
+TEST_F(TalkingStateTestSuite, shallIgnoreConferenceWithoutMembers)
+{
+    TalkingState objectUnderTest{context, PEER_NUMBER};
+    ::testing::Mock::VerifyAndClearExpectations(&callModeMock);
+
+    EXPECT_CALL(callModeMock, showParticipants(_)).Times(0);
+
+    objectUnderTest.handleConferenceMembers({});
+    objectUnderTest.handleConferenceMembers({PEER_NUMBER});
+}
+
+}
@@ -3,6 +3,7 @@
 #include "Ports/BtsPort.hpp"
 #include "Ports/UserPort.hpp"
 #include "Ports/TimerPort.hpp"
+#include "SmsLog.hpp"
 
 int main(int argc, char* argv[])
 {
@@ -15,10 +16,24 @@ int main(int argc, char* argv[])
     auto& gui = appEnv->getUeGui();
     auto phoneNumber = appEnv->getMyPhoneNumber();
 
+    SmsDb smsDb;
+    auto smsLogOptions = SmsLog::Options::fromConfig(appEnv->getConfiguration(), phoneNumber);
+    if (not smsLogOptions.path.empty())
+    {
+        try
+        {
+            smsDb.persistTo(std::make_unique<SmsLog>(smsLogOptions, logger));
+        }
+        catch (std::exception& ex)
+        {
+            logger.logError("SMS log not used: ", ex.what());
+        }
+    }
+
     BtsPort bts(logger, tranport, phoneNumber);
     UserPort user(logger, gui, phoneNumber);
     TimerPort timer(logger);
-    Application app(phoneNumber, logger, bts, user, timer);
+    Application app(phoneNumber, logger, bts, user, timer, smsDb);
     bts.start(app);
     user.start(app);
     timer.start(app);
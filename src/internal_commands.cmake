@@ -16,11 +16,25 @@ include_directories(${Qt5Network_INCLUDES})
 add_definitions(${Qt5Network_DEFINITIONS})
 endmacro()
 
+# without QtWidgets - for headless UE and its transport
+macro(set_qt_core_options)
+set(CMAKE_AUTOMOC ON)
+set(CMAKE_CXX_FLAGS ${Qt5Network_EXECUTABLE_COMPILE_FLAGS} ${CMAKE_CXX_FLAGS})
+find_package(Qt5Network REQUIRED)
+include_directories(${Qt5Network_INCLUDES})
+add_definitions(${Qt5Network_DEFINITIONS})
+endmacro()
+
 macro(target_link_qt)
 set_property(TARGET ${PROJECT_NAME} PROPERTY CXX_STANDARD 20)
 target_link_libraries(${PROJECT_NAME} ${Qt5Widgets_LIBRARIES} ${Qt5Network_LIBRARIES} pthread)
 endmacro()
 
+macro(target_link_qt_core)
+set_property(TARGET ${PROJECT_NAME} PROPERTY CXX_STANDARD 20)
+target_link_libraries(${PROJECT_NAME} ${Qt5Network_LIBRARIES} pthread)
+endmacro()
+
 macro(set_gtest_options)
 set(GMOCK_DIR ${CMAKE_SOURCE_DIR}/googletest/googletest)
 set(GTEST_DIR ${CMAKE_SOURCE_DIR}/googletest/googlemock)